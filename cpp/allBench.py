@@ -0,0 +1,31 @@
+#!/usr/bin/env python
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+import os, sys
+sys.path.append(os.path.join(os.path.dirname(__file__), "..", "scripts"))
+
+from Util import *
+
+#
+# Run the benchmarks from the bench directory with the test driver, the
+# same options as allTests.py are supported (e.g.: --protocol, --config,
+# --filter). The results are printed as JSON objects, one per line, and
+# are also appended to the file specified with the ICE_BENCH_OUTPUT
+# environment variable if set.
+#
+getTestDir = component.getTestDir
+component.getTestDir = lambda mapping: \
+    os.path.join(mapping.getPath(), "bench") if isinstance(mapping, CppMapping) else getTestDir(mapping)
+
+if os.environ.get("ICE_BENCH_OUTPUT"):
+    getProps = CppMapping.getProps
+    def getBenchProps(self, process, current):
+        props = getProps(self, process, current)
+        if isinstance(process, Client):
+            props["Bench.Output"] = os.path.abspath(os.environ["ICE_BENCH_OUTPUT"])
+        return props
+    CppMapping.getProps = getBenchProps
+
+runTestsWithPath(__file__)
@@ -0,0 +1,235 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <Ice/UniquePtr.h>
+#include <BenchHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+//
+// Measures the latency and throughput of twoway, oneway and batch oneway
+// invocations for each of the transports listed in Bench.Transports. The
+// transports are the protocols supported by the server endpoints (the
+// configured test protocol and udp) and "collocated" for invocations on
+// a servant registered with an adapter of the client communicator.
+//
+// The following properties configure the benchmarks:
+//
+// Bench.Transports: the transports to benchmark (default: the test protocol)
+// Bench.Iterations: the number of invocations of each benchmark (default: 10000)
+// Bench.Warmup: the number of invocations before each benchmark (default: 1000)
+// Bench.BatchSize: the number of batch oneway invocations per flush (default: 100)
+// Bench.PayloadSize: the size of the byte sequence sent by the payload benchmark (default: 64KB)
+//
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+
+private:
+
+    void twoway(const string&, const Test::LatencyPrxPtr&);
+    void oneway(const string&, const Test::LatencyPrxPtr&, const Test::LatencyPrxPtr&);
+    void batchOneway(const string&, const Test::LatencyPrxPtr&, const Test::LatencyPrxPtr&);
+    void payload(const string&, const Test::LatencyPrxPtr&);
+
+    IceInternal::UniquePtr<Bench::Report> _report;
+    int _iterations;
+    int _warmup;
+    int _batchSize;
+    vector<Ice::Byte> _payload;
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->parseCommandLineOptions("Bench", Ice::argsToStringSeq(argc, argv));
+
+    _report.reset(new Bench::Report(properties));
+    _iterations = max(properties->getPropertyAsIntWithDefault("Bench.Iterations", 10000), 1);
+    _warmup = max(properties->getPropertyAsIntWithDefault("Bench.Warmup", 1000), 0);
+    _batchSize = max(properties->getPropertyAsIntWithDefault("Bench.BatchSize", 100), 1);
+    _payload.resize(static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("Bench.PayloadSize", 64 * 1024),
+                                            1)));
+
+    Ice::StringSeq transports = properties->getPropertyAsListWithDefault("Bench.Transports",
+                                                                         Ice::StringSeq(1, getTestProtocol()));
+
+    Test::LatencyPrxPtr proxy = ICE_UNCHECKED_CAST(Test::LatencyPrx,
+                                                   communicator->stringToProxy("latency:" + getTestEndpoint()));
+    for(Ice::StringSeq::const_iterator p = transports.begin(); p != transports.end(); ++p)
+    {
+        if(*p == "collocated")
+        {
+            Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("");
+            Test::LatencyPrxPtr collocated =
+                ICE_UNCHECKED_CAST(Test::LatencyPrx, adapter->addWithUUID(ICE_MAKE_SHARED(LatencyI)));
+            adapter->activate();
+
+            twoway(*p, collocated);
+            oneway(*p, collocated->ice_oneway(), collocated);
+            batchOneway(*p, collocated->ice_batchOneway(), collocated);
+            payload(*p, collocated);
+
+            adapter->destroy();
+        }
+        else if(*p == "udp")
+        {
+            //
+            // Datagrams are not acknowledged, the measures only include the
+            // time to send the requests.
+            //
+            Test::LatencyPrxPtr datagram = ICE_UNCHECKED_CAST(Test::LatencyPrx,
+                communicator->stringToProxy("latency:" + getTestEndpoint(0, "udp")));
+            oneway(*p, datagram->ice_datagram(), ICE_NULLPTR);
+            batchOneway(*p, datagram->ice_batchDatagram(), ICE_NULLPTR);
+        }
+        else if(*p == getTestProtocol())
+        {
+            twoway(*p, proxy);
+            oneway(*p, proxy->ice_oneway(), proxy);
+            batchOneway(*p, proxy->ice_batchOneway(), proxy);
+            payload(*p, proxy);
+        }
+        else
+        {
+            ostringstream os;
+            os << "unsupported transport `" << *p << "', the server only listens on `" << getTestProtocol()
+               << "' and `udp'";
+            throw invalid_argument(os.str());
+        }
+    }
+
+    proxy->shutdown();
+}
+
+void
+Client::twoway(const string& transport, const Test::LatencyPrxPtr& proxy)
+{
+    for(int i = 0; i < _warmup; ++i)
+    {
+        proxy->ping();
+    }
+
+    Bench::Result result("latency", "twoway", transport);
+    result.start(static_cast<size_t>(_iterations));
+    for(int i = 0; i < _iterations; ++i)
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        proxy->ping();
+        result.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+    }
+    result.stop();
+    _report->add(result);
+}
+
+void
+Client::oneway(const string& transport, const Test::LatencyPrxPtr& proxy, const Test::LatencyPrxPtr& twowayProxy)
+{
+    for(int i = 0; i < _warmup; ++i)
+    {
+        proxy->ping();
+    }
+    if(twowayProxy)
+    {
+        twowayProxy->ping();
+    }
+
+    //
+    // The latency is the time to send each request. If a twoway proxy is
+    // provided, a twoway request is sent last to include the dispatch of
+    // the oneway requests in the throughput.
+    //
+    Bench::Result result("latency", "oneway", transport);
+    result.start(static_cast<size_t>(_iterations));
+    for(int i = 0; i < _iterations; ++i)
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        proxy->ping();
+        result.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+    }
+    if(twowayProxy)
+    {
+        twowayProxy->ping();
+    }
+    result.stop();
+    _report->add(result);
+}
+
+void
+Client::batchOneway(const string& transport, const Test::LatencyPrxPtr& proxy,
+                    const Test::LatencyPrxPtr& twowayProxy)
+{
+    for(int i = 0; i < _warmup; ++i)
+    {
+        proxy->ping();
+        if((i + 1) % _batchSize == 0)
+        {
+            proxy->ice_flushBatchRequests();
+        }
+    }
+    proxy->ice_flushBatchRequests();
+    if(twowayProxy)
+    {
+        twowayProxy->ping();
+    }
+
+    //
+    // The latency is the time to queue and flush each batch.
+    //
+    Bench::Result result("latency", "batch-oneway", transport);
+    int batches = (_iterations + _batchSize - 1) / _batchSize;
+    result.start(static_cast<size_t>(batches));
+    for(int i = 0; i < batches; ++i)
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        for(int j = 0; j < _batchSize; ++j)
+        {
+            proxy->ping();
+        }
+        proxy->ice_flushBatchRequests();
+        result.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+    }
+    if(twowayProxy)
+    {
+        twowayProxy->ping();
+    }
+    result.stop(static_cast<Ice::Long>(batches) * _batchSize);
+    _report->add(result);
+}
+
+void
+Client::payload(const string& transport, const Test::LatencyPrxPtr& proxy)
+{
+    pair<const Ice::Byte*, const Ice::Byte*> seq(&_payload[0], &_payload[0] + _payload.size());
+
+    //
+    // Large requests are much slower than pings, only run a tenth of the
+    // iterations.
+    //
+    int iterations = max(_iterations / 10, 1);
+    for(int i = 0; i < _warmup / 10; ++i)
+    {
+        proxy->sendBytes(seq);
+    }
+
+    Bench::Result result("latency", "twoway-payload", transport);
+    result.start(static_cast<size_t>(iterations));
+    for(int i = 0; i < iterations; ++i)
+    {
+        IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        proxy->sendBytes(seq);
+        result.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+    }
+    result.stop(iterations, static_cast<Ice::Long>(iterations) * static_cast<Ice::Long>(_payload.size()));
+    _report->add(result);
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,45 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::PropertiesPtr properties = createTestProperties(argc, argv);
+
+    //
+    // The payload size of the byte sequence benchmark is configurable by
+    // the client, disable the message size limit.
+    //
+    properties->setProperty("Ice.MessageSizeMax", "0");
+    Ice::CommunicatorHolder communicator = initialize(argc, argv, properties);
+
+    //
+    // The server listens on the endpoint of the configured protocol and on
+    // an UDP endpoint for the datagram benchmarks.
+    //
+    communicator->getProperties()->setProperty("TestAdapter.Endpoints",
+                                               getTestEndpoint() + ":" + getTestEndpoint(0, "udp"));
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("TestAdapter");
+    adapter->add(ICE_MAKE_SHARED(LatencyI), Ice::stringToIdentity("latency"));
+    adapter->activate();
+
+    serverReady();
+
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
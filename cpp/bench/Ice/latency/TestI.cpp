@@ -0,0 +1,28 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+void
+LatencyI::ping(const Ice::Current&)
+{
+}
+
+void
+#ifdef ICE_CPP11_MAPPING
+LatencyI::sendBytes(pair<const Ice::Byte*, const Ice::Byte*>, const Ice::Current&)
+#else
+LatencyI::sendBytes(const pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&)
+#endif
+{
+}
+
+void
+LatencyI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
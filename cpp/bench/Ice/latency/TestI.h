@@ -0,0 +1,25 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+
+class LatencyI : public Test::Latency
+{
+public:
+
+    virtual void ping(const Ice::Current&);
+
+#ifdef ICE_CPP11_MAPPING
+    virtual void sendBytes(std::pair<const Ice::Byte*, const Ice::Byte*>, const Ice::Current&);
+#else
+    virtual void sendBytes(const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+#endif
+
+    virtual void shutdown(const Ice::Current&);
+};
+
+#endif
@@ -0,0 +1,15 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# The UDP and collocated benchmarks don't depend on the configured protocol,
+# they only run with tcp.
+#
+def transports(process, current):
+    if current.config.protocol == "tcp":
+        return { "Bench.Transports" : "tcp udp collocated" }
+    return {}
+
+TestSuite(__name__, [ ClientServerTestCase(client=Client(props=transports)) ])
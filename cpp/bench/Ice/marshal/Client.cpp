@@ -0,0 +1,261 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <BenchHelper.h>
+#include <Test.h>
+
+using namespace std;
+using namespace Test;
+
+//
+// Measures the cost of marshaling and unmarshaling sequences, structs,
+// classes and optionals with the stream API. Each benchmark encodes or
+// decodes a sequence of Bench.SequenceSize elements (default: 1000),
+// Bench.Iterations times (default: 1000) after Bench.Warmup iterations
+// (default: 100).
+//
+
+namespace
+{
+
+class Marshal
+{
+public:
+
+    Marshal(const Ice::CommunicatorPtr& communicator, Bench::Report& report) :
+        _communicator(communicator),
+        _report(report)
+    {
+        Ice::PropertiesPtr properties = communicator->getProperties();
+        _iterations = max(properties->getPropertyAsIntWithDefault("Bench.Iterations", 1000), 1);
+        _warmup = max(properties->getPropertyAsIntWithDefault("Bench.Warmup", 100), 0);
+    }
+
+    template<typename T> void
+    measure(const string& name, const T& value)
+    {
+        vector<Ice::Byte> data;
+        encode(value, data);
+        for(int i = 0; i < _warmup; ++i)
+        {
+            encode(value, data);
+            T v;
+            decode(data, v);
+        }
+
+        Ice::Long bytes = static_cast<Ice::Long>(data.size()) * _iterations;
+
+        Bench::Result encodeResult("marshal", name + "-encode", "stream");
+        encodeResult.start(static_cast<size_t>(_iterations));
+        for(int i = 0; i < _iterations; ++i)
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            Ice::OutputStream out(_communicator);
+            out.write(value);
+            out.writePendingValues();
+            encodeResult.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+        encodeResult.stop(_iterations, bytes);
+        _report.add(encodeResult);
+
+        Bench::Result decodeResult("marshal", name + "-decode", "stream");
+        decodeResult.start(static_cast<size_t>(_iterations));
+        for(int i = 0; i < _iterations; ++i)
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            T v;
+            decode(data, v);
+            decodeResult.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+        decodeResult.stop(_iterations, bytes);
+        _report.add(decodeResult);
+    }
+
+private:
+
+    template<typename T> void
+    encode(const T& value, vector<Ice::Byte>& data)
+    {
+        Ice::OutputStream out(_communicator);
+        out.write(value);
+        out.writePendingValues();
+        out.finished(data);
+    }
+
+    template<typename T> void
+    decode(const vector<Ice::Byte>& data, T& value)
+    {
+        Ice::InputStream in(_communicator, data);
+        in.read(value);
+        in.readPendingValues();
+    }
+
+    const Ice::CommunicatorPtr _communicator;
+    Bench::Report& _report;
+    int _iterations;
+    int _warmup;
+};
+
+Fixed
+makeFixed(int i)
+{
+    Fixed f;
+    f.i = i;
+    f.l = static_cast<Ice::Long>(i) << 32;
+    f.d = i / 3.0;
+    f.c = i % 2 == 0 ? ICE_ENUM(Color, Green) : ICE_ENUM(Color, Blue);
+    return f;
+}
+
+Variable
+makeVariable(int i)
+{
+    ostringstream os;
+    os << "variable-" << i;
+
+    Variable v;
+    v.s = os.str();
+    v.seq = IntSeq(10, i);
+    v.f = makeFixed(i);
+    return v;
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->parseCommandLineOptions("Bench", Ice::argsToStringSeq(argc, argv));
+
+    Bench::Report report(properties);
+    Marshal marshal(communicator.communicator(), report);
+
+    int size = max(properties->getPropertyAsIntWithDefault("Bench.SequenceSize", 1000), 1);
+
+    {
+        ByteSeq seq(static_cast<size_t>(size));
+        for(int i = 0; i < size; ++i)
+        {
+            seq[static_cast<size_t>(i)] = static_cast<Ice::Byte>(i);
+        }
+        marshal.measure("byte-seq", seq);
+    }
+
+    {
+        IntSeq seq(static_cast<size_t>(size));
+        for(int i = 0; i < size; ++i)
+        {
+            seq[static_cast<size_t>(i)] = i;
+        }
+        marshal.measure("int-seq", seq);
+    }
+
+    {
+        DoubleSeq seq(static_cast<size_t>(size));
+        for(int i = 0; i < size; ++i)
+        {
+            seq[static_cast<size_t>(i)] = i / 3.0;
+        }
+        marshal.measure("double-seq", seq);
+    }
+
+    {
+        StringSeq seq;
+        for(int i = 0; i < size; ++i)
+        {
+            ostringstream os;
+            os << "string-" << i;
+            seq.push_back(os.str());
+        }
+        marshal.measure("string-seq", seq);
+    }
+
+    {
+        FixedSeq seq;
+        for(int i = 0; i < size; ++i)
+        {
+            seq.push_back(makeFixed(i));
+        }
+        marshal.measure("fixed-struct-seq", seq);
+    }
+
+    {
+        VariableSeq seq;
+        for(int i = 0; i < size; ++i)
+        {
+            seq.push_back(makeVariable(i));
+        }
+        marshal.measure("variable-struct-seq", seq);
+    }
+
+    {
+        //
+        // Each node references the previous node of the sequence, which is
+        // marshaled as an instance index. Half of the nodes are derived
+        // nodes.
+        //
+        NodeSeq seq;
+        for(int i = 0; i < size; ++i)
+        {
+            ostringstream os;
+            os << "node-" << i;
+
+            NodePtr node;
+            if(i % 2 == 0)
+            {
+                node = ICE_MAKE_SHARED(Node);
+            }
+            else
+            {
+                DerivedNodePtr derived = ICE_MAKE_SHARED(DerivedNode);
+                derived->weight = i / 3.0;
+                derived->tags.push_back(os.str());
+                node = derived;
+            }
+            node->value = i;
+            node->name = os.str();
+            node->next = seq.empty() ? NodePtr() : seq.back();
+            seq.push_back(node);
+        }
+        marshal.measure("class-seq", seq);
+    }
+
+    {
+        //
+        // Half of the optionals are set.
+        //
+        OptionalsSeq seq;
+        for(int i = 0; i < size; ++i)
+        {
+            OptionalsPtr o = ICE_MAKE_SHARED(Optionals);
+            if(i % 2 == 0)
+            {
+                o->i = i;
+                o->f = makeFixed(i);
+                o->v = makeVariable(i);
+            }
+            else
+            {
+                ostringstream os;
+                os << "optional-" << i;
+                o->s = os.str();
+                o->seq = IntSeq(10, i);
+            }
+            seq.push_back(o);
+        }
+        marshal.measure("optional-seq", seq);
+    }
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,211 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Random.h>
+#include <IceUtil/Thread.h>
+#include <BenchHelper.h>
+#include <Test.h>
+
+using namespace std;
+
+//
+// Measures the dispatch throughput of an object adapter depending on the
+// number of servants registered with it. For each count of Bench.ServantCounts
+// (default: 1000 100000 10000000), the adapter is filled with servants and
+// Bench.Threads threads (default: 4) invoke a collocated operation on
+// Bench.Proxies proxies (default: 10000) with random identities, for a total
+// of Bench.Iterations invocations (default: 100000) after Bench.Warmup
+// invocations (default: 10000). The time to register the servants is also
+// reported.
+//
+// A single servant instance is registered with all the identities to keep
+// the memory used by the 10 million servants benchmark reasonable.
+//
+
+namespace
+{
+
+class ServantI : public Test::Servant
+{
+public:
+
+    virtual void
+    ping(const Ice::Current&)
+    {
+    }
+};
+
+class InvokeThread : public IceUtil::Thread
+{
+public:
+
+    InvokeThread(const vector<Test::ServantPrxPtr>& proxies, size_t offset, int iterations) :
+        _proxies(proxies),
+        _offset(offset),
+        _iterations(iterations)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _samples.reserve(static_cast<size_t>(_iterations));
+        for(int i = 0; i < _iterations; ++i)
+        {
+            const Test::ServantPrxPtr& proxy = _proxies[(_offset + static_cast<size_t>(i)) % _proxies.size()];
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            proxy->ping();
+            _samples.push_back(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+    }
+
+    const vector<IceUtil::Time>&
+    samples() const
+    {
+        return _samples;
+    }
+
+private:
+
+    const vector<Test::ServantPrxPtr>& _proxies;
+    const size_t _offset;
+    const int _iterations;
+    vector<IceUtil::Time> _samples;
+};
+typedef IceUtil::Handle<InvokeThread> InvokeThreadPtr;
+
+Ice::Identity
+servantIdentity(int i)
+{
+    ostringstream os;
+    os << "servant-" << i;
+    Ice::Identity ident;
+    ident.name = os.str();
+    return ident;
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+
+private:
+
+    void dispatch(const vector<Test::ServantPrxPtr>&, int, Bench::Result*);
+
+    int _threads;
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->parseCommandLineOptions("Bench", Ice::argsToStringSeq(argc, argv));
+
+    Bench::Report report(properties);
+    _threads = max(properties->getPropertyAsIntWithDefault("Bench.Threads", 4), 1);
+    int iterations = max(properties->getPropertyAsIntWithDefault("Bench.Iterations", 100000), 1);
+    int warmup = max(properties->getPropertyAsIntWithDefault("Bench.Warmup", 10000), 0);
+    int proxyCount = max(properties->getPropertyAsIntWithDefault("Bench.Proxies", 10000), 1);
+
+    Ice::StringSeq defaultCounts;
+    defaultCounts.push_back("1000");
+    defaultCounts.push_back("100000");
+    defaultCounts.push_back("10000000");
+    Ice::StringSeq counts = properties->getPropertyAsListWithDefault("Bench.ServantCounts", defaultCounts);
+
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("");
+    adapter->activate();
+
+    Ice::ObjectPtr servant = ICE_MAKE_SHARED(ServantI);
+    int registered = 0;
+    for(Ice::StringSeq::const_iterator p = counts.begin(); p != counts.end(); ++p)
+    {
+        int count;
+        istringstream is(*p);
+        if(!(is >> count) || count < 1)
+        {
+            throw invalid_argument("invalid servant count `" + *p + "'");
+        }
+
+        //
+        // The servants registered for a count are kept for the next counts,
+        // only the missing servants are added.
+        //
+        if(count > registered)
+        {
+            Bench::Result result("servantMap", "register-" + *p, "collocated");
+            result.start(0);
+            int first = registered;
+            for(; registered < count; ++registered)
+            {
+                adapter->add(servant, servantIdentity(registered));
+            }
+            result.stop(registered - first);
+            report.add(result);
+        }
+
+        vector<Test::ServantPrxPtr> proxies;
+        for(int i = 0; i < proxyCount; ++i)
+        {
+            int n = static_cast<int>(IceUtilInternal::random(registered));
+            proxies.push_back(ICE_UNCHECKED_CAST(Test::ServantPrx, adapter->createProxy(servantIdentity(n))));
+        }
+
+        dispatch(proxies, warmup, ICE_NULLPTR);
+
+        Bench::Result result("servantMap", "dispatch-" + *p, "collocated");
+        dispatch(proxies, iterations, &result);
+        report.add(result);
+    }
+
+    adapter->destroy();
+}
+
+void
+Client::dispatch(const vector<Test::ServantPrxPtr>& proxies, int iterations, Bench::Result* result)
+{
+    vector<InvokeThreadPtr> threads;
+    for(int i = 0; i < _threads; ++i)
+    {
+        //
+        // Each thread starts at a different position of the proxy list and
+        // gets its share of the iterations.
+        //
+        int n = iterations / _threads + (i < iterations % _threads ? 1 : 0);
+        threads.push_back(new InvokeThread(proxies, proxies.size() * static_cast<size_t>(i) / static_cast<size_t>(_threads), n));
+    }
+
+    if(result)
+    {
+        result->start(static_cast<size_t>(iterations));
+    }
+    for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->start();
+    }
+    for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    if(result)
+    {
+        result->stop(iterations);
+        for(vector<InvokeThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            const vector<IceUtil::Time>& samples = (*p)->samples();
+            for(vector<IceUtil::Time>::const_iterator q = samples.begin(); q != samples.end(); ++q)
+            {
+                result->add(*q);
+            }
+        }
+    }
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,6 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+TestSuite(__name__, [ ClientTestCase() ])
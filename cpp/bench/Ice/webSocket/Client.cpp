@@ -0,0 +1,113 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <Ice/WSUtil.h>
+#include <BenchHelper.h>
+
+using namespace std;
+
+//
+// Measures the throughput of the WebSocket payload masking and of the
+// UTF-8 validation for frames of 1KB to Bench.MaxFrameSize (default: 1MB).
+// The masking is also measured with a byte at a time loop for reference.
+// Each size is processed Bench.Iterations times (default: 1000).
+//
+
+namespace
+{
+
+void
+maskBytes(Ice::Byte* dst, const Ice::Byte* src, size_t n, const Ice::Byte* mask, size_t offset)
+{
+    for(size_t i = 0; i < n; ++i)
+    {
+        dst[i] = static_cast<Ice::Byte>(src[i] ^ mask[(offset + i) % 4]);
+    }
+}
+
+string
+sizeName(size_t size)
+{
+    ostringstream os;
+    if(size >= 1024 * 1024)
+    {
+        os << size / (1024 * 1024) << "MB";
+    }
+    else
+    {
+        os << size / 1024 << "KB";
+    }
+    return os.str();
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->parseCommandLineOptions("Bench", Ice::argsToStringSeq(argc, argv));
+
+    Bench::Report report(properties);
+    int iterations = max(properties->getPropertyAsIntWithDefault("Bench.Iterations", 1000), 1);
+    size_t maxFrameSize = static_cast<size_t>(max(properties->getPropertyAsIntWithDefault("Bench.MaxFrameSize",
+                                                                                          1024 * 1024), 1024));
+
+    const Ice::Byte mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+    vector<Ice::Byte> src(maxFrameSize);
+    for(size_t i = 0; i < src.size(); ++i)
+    {
+        src[i] = static_cast<Ice::Byte>('a' + i % 26);
+    }
+    vector<Ice::Byte> dst(maxFrameSize);
+
+    for(size_t size = 1024; size <= maxFrameSize; size *= 4)
+    {
+        Ice::Long bytes = static_cast<Ice::Long>(size) * iterations;
+
+        Bench::Result mask1("websocket", "mask-" + sizeName(size), "ws");
+        mask1.start(static_cast<size_t>(iterations));
+        for(int i = 0; i < iterations; ++i)
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            IceInternal::wsMask(&dst[0], &src[0], size, mask, 0);
+            mask1.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+        mask1.stop(iterations, bytes);
+        report.add(mask1);
+
+        Bench::Result mask2("websocket", "mask-bytewise-" + sizeName(size), "ws");
+        mask2.start(static_cast<size_t>(iterations));
+        for(int i = 0; i < iterations; ++i)
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            maskBytes(&dst[0], &src[0], size, mask, 0);
+            mask2.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+        mask2.stop(iterations, bytes);
+        report.add(mask2);
+
+        Bench::Result utf8("websocket", "utf8-" + sizeName(size), "ws");
+        utf8.start(static_cast<size_t>(iterations));
+        for(int i = 0; i < iterations; ++i)
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            test(IceInternal::wsIsValidUTF8(&src[0], size));
+            utf8.add(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+        utf8.stop(iterations, bytes);
+        report.add(utf8);
+    }
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,178 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
+#include <BenchHelper.h>
+#include <Test.h>
+
+using namespace std;
+
+//
+// Measures the throughput and latency of a server thread pool in the
+// LeaderFollower and WorkStealing modes. For each thread count (1, 2, 4, ...
+// up to Bench.Threads, default: 64), as many client threads invoke a no-op
+// operation over their own connection for Bench.Duration seconds (default:
+// 2), with the server thread pool configured with as many threads.
+//
+
+namespace
+{
+
+class TestIntfI : public Test::TestIntf
+{
+public:
+
+    virtual void
+    op(const Ice::Current&)
+    {
+    }
+};
+
+class InvokeThread : public IceUtil::Thread
+{
+public:
+
+    InvokeThread(const Test::TestIntfPrxPtr& proxy, const IceUtil::Time& duration) :
+        _proxy(proxy),
+        _duration(duration)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _proxy->ice_ping();
+
+        IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + _duration;
+        IceUtil::Time now;
+        do
+        {
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            _proxy->op();
+            now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            _samples.push_back(now - start);
+        }
+        while(now < end);
+    }
+
+    //
+    // The latency of each invocation, only valid once the thread is joined.
+    //
+    const vector<IceUtil::Time>&
+    samples() const
+    {
+        return _samples;
+    }
+
+private:
+
+    const Test::TestIntfPrxPtr _proxy;
+    const IceUtil::Time _duration;
+    vector<IceUtil::Time> _samples;
+};
+typedef IceUtil::Handle<InvokeThread> InvokeThreadPtr;
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+
+private:
+
+    void measure(const string&, int, const IceUtil::Time&, Bench::Report&);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->parseCommandLineOptions("Bench", Ice::argsToStringSeq(argc, argv));
+
+    Bench::Report report(properties);
+    int maxThreads = min(max(properties->getPropertyAsIntWithDefault("Bench.Threads", 64), 1), 64);
+    IceUtil::Time duration = IceUtil::Time::seconds(properties->getPropertyAsIntWithDefault("Bench.Duration", 2));
+
+    const char* modes[] = { "LeaderFollower", "WorkStealing" };
+    for(int threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        for(size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); ++i)
+        {
+            measure(modes[i], threads, duration, report);
+        }
+    }
+}
+
+void
+Client::measure(const string& mode, int threads, const IceUtil::Time& duration, Bench::Report& report)
+{
+    ostringstream os;
+    os << threads;
+
+    Ice::InitializationData serverInitData;
+    serverInitData.properties = communicator()->getProperties()->clone();
+    serverInitData.properties->setProperty("Ice.ThreadPool.Server.Size", os.str());
+    serverInitData.properties->setProperty("Ice.ThreadPool.Server.SizeMax", os.str());
+    serverInitData.properties->setProperty("Ice.ThreadPool.Server.Mode", mode);
+    serverInitData.properties->setProperty("Ice.Warn.Connections", "0");
+    Ice::CommunicatorHolder server = Ice::initialize(serverInitData);
+
+    server->getProperties()->setProperty("BenchAdapter.Endpoints", getTestEndpoint(0));
+    Ice::ObjectAdapterPtr adapter = server->createObjectAdapter("BenchAdapter");
+    Ice::ObjectPrxPtr obj = adapter->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("bench"));
+    adapter->activate();
+
+    Ice::InitializationData clientInitData;
+    clientInitData.properties = communicator()->getProperties()->clone();
+    clientInitData.properties->setProperty("Ice.ThreadPool.Client.Size", os.str());
+    clientInitData.properties->setProperty("Ice.ThreadPool.Client.SizeMax", os.str());
+    Ice::CommunicatorHolder client = Ice::initialize(clientInitData);
+
+    Test::TestIntfPrxPtr proxy =
+        ICE_UNCHECKED_CAST(Test::TestIntfPrx, client->stringToProxy(server->proxyToString(obj)));
+
+    vector<InvokeThreadPtr> invokeThreads;
+    for(int i = 0; i < threads; ++i)
+    {
+        ostringstream connectionId;
+        connectionId << "bench-" << i;
+        invokeThreads.push_back(new InvokeThread(ICE_UNCHECKED_CAST(Test::TestIntfPrx,
+                                                                    proxy->ice_connectionId(connectionId.str())),
+                                                 duration));
+    }
+
+    ostringstream name;
+    name << mode << "-" << threads;
+    Bench::Result result("workStealing", name.str(), getTestProtocol());
+    result.start(0);
+    vector<IceUtil::ThreadControl> controls;
+    for(vector<InvokeThreadPtr>::const_iterator p = invokeThreads.begin(); p != invokeThreads.end(); ++p)
+    {
+        controls.push_back((*p)->start());
+    }
+
+    Ice::Long count = 0;
+    for(size_t i = 0; i < controls.size(); ++i)
+    {
+        controls[i].join();
+        count += static_cast<Ice::Long>(invokeThreads[i]->samples().size());
+    }
+    result.stop(count);
+
+    for(vector<InvokeThreadPtr>::const_iterator p = invokeThreads.begin(); p != invokeThreads.end(); ++p)
+    {
+        const vector<IceUtil::Time>& samples = (*p)->samples();
+        for(vector<IceUtil::Time>::const_iterator q = samples.begin(); q != samples.end(); ++q)
+        {
+            result.add(*q);
+        }
+    }
+    report.add(result);
+}
+
+DEFINE_TEST(Client)
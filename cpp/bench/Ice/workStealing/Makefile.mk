@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs := client
+
+$(test)_client_sources  := Client.cpp Test.ice
+
+tests += $(test)
@@ -0,0 +1,167 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <Ice/UniquePtr.h>
+#include <IceUtil/Thread.h>
+#include <BenchHelper.h>
+
+using namespace std;
+
+//
+// Measures the latency and throughput of the registration of adapters with
+// an IceGrid registry. Bench.Threads threads concurrently register
+// Bench.Adapters adapters with the locator registry of the registry
+// configured with Ice.Default.Locator, and then unregister them. The
+// registry must allow dynamic registration, run it with different values
+// for the IceGrid.Registry.LMDB.GroupCommitWindow property to compare the
+// throughput with and without group commit.
+//
+// The following properties configure the benchmarks:
+//
+// Bench.Adapters: the number of adapters to register (default: 10000)
+// Bench.Threads: the number of registering threads (default: 16)
+// Bench.GroupCommitWindow: the group commit window of the registry in
+// milliseconds, only used to name the results (default: 0)
+//
+
+namespace
+{
+
+class RegisterThread : public IceUtil::Thread
+{
+public:
+
+    RegisterThread(const Ice::LocatorRegistryPrxPtr& registry, const Ice::ObjectPrxPtr& proxy, int first, int count) :
+        _registry(registry),
+        _proxy(proxy),
+        _first(first),
+        _count(count)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _samples.reserve(static_cast<size_t>(_count));
+        for(int i = _first; i < _first + _count; ++i)
+        {
+            ostringstream os;
+            os << "BenchAdapter-" << i;
+            IceUtil::Time start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            _registry->setAdapterDirectProxy(os.str(), _proxy);
+            _samples.push_back(IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+        }
+    }
+
+    //
+    // The latency of each registration, only valid once the thread is
+    // joined.
+    //
+    const vector<IceUtil::Time>&
+    samples() const
+    {
+        return _samples;
+    }
+
+private:
+
+    const Ice::LocatorRegistryPrxPtr _registry;
+    const Ice::ObjectPrxPtr _proxy;
+    const int _first;
+    const int _count;
+    vector<IceUtil::Time> _samples;
+};
+typedef IceUtil::Handle<RegisterThread> RegisterThreadPtr;
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+
+private:
+
+    void measure(const string&, const Ice::LocatorRegistryPrxPtr&, const Ice::ObjectPrxPtr&);
+
+    IceInternal::UniquePtr<Bench::Report> _report;
+    int _adapters;
+    int _threads;
+    string _suffix;
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    properties->parseCommandLineOptions("Bench", Ice::argsToStringSeq(argc, argv));
+
+    _report.reset(new Bench::Report(properties));
+    _adapters = max(properties->getPropertyAsIntWithDefault("Bench.Adapters", 10000), 1);
+    _threads = max(properties->getPropertyAsIntWithDefault("Bench.Threads", 16), 1);
+
+    int window = properties->getPropertyAsInt("Bench.GroupCommitWindow");
+    if(window > 0)
+    {
+        ostringstream os;
+        os << "-group-commit-" << window << "ms";
+        _suffix = os.str();
+    }
+
+    Ice::LocatorPrxPtr locator = communicator->getDefaultLocator();
+    if(!locator)
+    {
+        throw invalid_argument("Ice.Default.Locator is not set");
+    }
+    Ice::LocatorRegistryPrxPtr registry = locator->getRegistry();
+
+    measure("register", registry, communicator->stringToProxy("bench:tcp -h 127.0.0.1 -p 12345"));
+    measure("unregister", registry, ICE_NULLPTR);
+}
+
+void
+Client::measure(const string& name, const Ice::LocatorRegistryPrxPtr& registry, const Ice::ObjectPrxPtr& proxy)
+{
+    vector<RegisterThreadPtr> registerThreads;
+    int first = 0;
+    for(int i = 0; i < _threads; ++i)
+    {
+        ostringstream connectionId;
+        connectionId << "bench-" << i;
+        int count = _adapters / _threads + (i < _adapters % _threads ? 1 : 0);
+        registerThreads.push_back(new RegisterThread(ICE_UNCHECKED_CAST(Ice::LocatorRegistryPrx,
+                                                                        registry->ice_connectionId(connectionId.str())),
+                                                     proxy, first, count));
+        first += count;
+    }
+
+    Bench::Result result("icegrid", name + _suffix, getTestProtocol());
+    result.start(static_cast<size_t>(_adapters));
+    vector<IceUtil::ThreadControl> controls;
+    for(vector<RegisterThreadPtr>::const_iterator p = registerThreads.begin(); p != registerThreads.end(); ++p)
+    {
+        controls.push_back((*p)->start());
+    }
+
+    for(vector<IceUtil::ThreadControl>::iterator p = controls.begin(); p != controls.end(); ++p)
+    {
+        p->join();
+    }
+    result.stop(_adapters);
+
+    for(vector<RegisterThreadPtr>::const_iterator p = registerThreads.begin(); p != registerThreads.end(); ++p)
+    {
+        const vector<IceUtil::Time>& samples = (*p)->samples();
+        for(vector<IceUtil::Time>::const_iterator q = samples.begin(); q != samples.end(); ++q)
+        {
+            result.add(*q);
+        }
+    }
+    _report->add(result);
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,9 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs := client
+
+$(test)_dependencies := IceGrid Glacier2 TestCommon Ice
+
+tests += $(test)
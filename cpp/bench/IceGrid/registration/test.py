@@ -0,0 +1,23 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# Run the benchmark without and with group commit, the registry must allow
+# the dynamic registration of the adapters.
+#
+def registries(window):
+    return [IceGridRegistryMaster(props={ "IceGrid.Registry.DynamicRegistration" : 1,
+                                          "IceGrid.Registry.LMDB.GroupCommitWindow" : window })]
+
+def benchClient(window):
+    return IceGridClient(props={ "Bench.GroupCommitWindow" : window })
+
+if isinstance(platform, Windows) or os.getuid() != 0:
+    TestSuite(__name__, [
+        IceGridTestCase("without group commit", application=None, icegridregistry=registries(0),
+                        client=benchClient(0)),
+        IceGridTestCase("with group commit", application=None, icegridregistry=registries(5),
+                        client=benchClient(5))
+    ], multihost=False)
@@ -0,0 +1,168 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef BENCH_HELPER_H
+#define BENCH_HELPER_H
+
+#include <Ice/Ice.h>
+#include <IceUtil/Time.h>
+#include <TestHelper.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace Bench
+{
+
+//
+// The result of a benchmark: the latency samples of each iteration and
+// the throughput measured over all the iterations. A result is printed
+// as a single line JSON object, latencies are in microseconds.
+//
+class Result
+{
+public:
+
+    Result(const std::string& suite, const std::string& name, const std::string& transport) :
+        _suite(suite),
+        _name(name),
+        _transport(transport),
+        _bytes(0)
+    {
+    }
+
+    void
+    start(size_t iterations)
+    {
+        _samples.clear();
+        _samples.reserve(iterations);
+        _start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+
+    void
+    add(const IceUtil::Time& sample)
+    {
+        _samples.push_back(static_cast<double>(sample.toMicroSeconds()));
+    }
+
+    //
+    // Stops the measure. The number of operations is the number of
+    // samples unless explicitly given (e.g.: for batches, a sample is
+    // recorded for each flush). The number of bytes is only reported if
+    // non-zero.
+    //
+    void
+    stop(Ice::Long operations = -1, Ice::Long bytes = 0)
+    {
+        _elapsed = IceUtil::Time::now(IceUtil::Time::Monotonic) - _start;
+        _operations = operations < 0 ? static_cast<Ice::Long>(_samples.size()) : operations;
+        _bytes = bytes;
+    }
+
+    std::string
+    toJson()
+    {
+        std::sort(_samples.begin(), _samples.end());
+
+        double sum = 0;
+        for(std::vector<double>::const_iterator p = _samples.begin(); p != _samples.end(); ++p)
+        {
+            sum += *p;
+        }
+
+        double seconds = _elapsed.toSecondsDouble();
+
+        std::ostringstream os;
+        os << std::fixed << std::setprecision(3);
+        os << "{\"suite\": \"" << _suite << "\", \"benchmark\": \"" << _name << "\", \"transport\": \""
+           << _transport << "\", \"mapping\": \""
+#ifdef ICE_CPP11_MAPPING
+           << "cpp11"
+#else
+           << "cpp98"
+#endif
+           << "\", \"operations\": " << _operations << ", \"elapsed\": " << seconds
+           << ", \"throughput\": " << (seconds > 0 ? _operations / seconds : 0.0);
+        if(_bytes > 0)
+        {
+            os << ", \"bytes\": " << _bytes << ", \"bandwidth\": " << (seconds > 0 ? _bytes / seconds : 0.0);
+        }
+        os << ", \"latency\": {\"samples\": " << _samples.size();
+        if(!_samples.empty())
+        {
+            os << ", \"min\": " << _samples.front()
+               << ", \"mean\": " << sum / static_cast<double>(_samples.size())
+               << ", \"p50\": " << percentile(50)
+               << ", \"p90\": " << percentile(90)
+               << ", \"p99\": " << percentile(99)
+               << ", \"p99.9\": " << percentile(99.9)
+               << ", \"max\": " << _samples.back();
+        }
+        os << "}}";
+        return os.str();
+    }
+
+private:
+
+    //
+    // Nearest-rank percentile, the samples must be sorted.
+    //
+    double
+    percentile(double p) const
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * static_cast<double>(_samples.size())));
+        return _samples[rank > 0 ? rank - 1 : 0];
+    }
+
+    const std::string _suite;
+    const std::string _name;
+    const std::string _transport;
+    std::vector<double> _samples;
+    IceUtil::Time _start;
+    IceUtil::Time _elapsed;
+    Ice::Long _operations;
+    Ice::Long _bytes;
+};
+
+//
+// Collects the results of a benchmark run. Each result is printed on the
+// standard output as soon as it's added. If the Bench.Output property is
+// set, the results are also appended to the given file, one JSON object
+// per line.
+//
+class Report
+{
+public:
+
+    Report(const Ice::PropertiesPtr& properties) :
+        _output(properties->getProperty("Bench.Output"))
+    {
+    }
+
+    void
+    add(Result& result)
+    {
+        std::string json = result.toJson();
+        std::cout << json << std::endl;
+        if(!_output.empty())
+        {
+            std::ofstream out(_output.c_str(), std::ios_base::app);
+            if(!out)
+            {
+                throw Ice::FileException(__FILE__, __LINE__, IceInternal::getSystemErrno(), _output);
+            }
+            out << json << std::endl;
+        }
+    }
+
+private:
+
+    const std::string _output;
+};
+
+}
+
+#endif
@@ -6,10 +6,14 @@
 #define ICE_BUFFER_H
 
 #include <Ice/Config.h>
+#include <vector>
 
 namespace IceInternal
 {
 
+class BufferPool;
+class BufferSegments;
+
 class ICE_API Buffer : private IceUtil::noncopyable
 {
 public:
@@ -21,6 +25,30 @@ public:
 
     void swapBuffer(Buffer&);
 
+    //
+    // Returns the number of bytes referenced by the buffer rather than
+    // copied into b at or after the given offset of b, see BufferSegments.
+    //
+    size_t segmentsSize(size_t = 0) const;
+
+    //
+    // Returns the number of bytes before the current position, including
+    // the referenced bytes.
+    //
+    size_t position() const;
+
+    //
+    // Moves the current position forward by the given number of bytes,
+    // including the referenced bytes.
+    //
+    void advance(size_t);
+
+    //
+    // Copies the referenced bytes into b, the current position is
+    // preserved.
+    //
+    void copySegments();
+
     class ICE_API Container : private IceUtil::noncopyable
     {
     public:
@@ -78,6 +106,20 @@ public:
 
         void clear();
 
+        //
+        // Allocate the memory of the container from the given pool. This
+        // has no effect if the container already holds memory.
+        //
+        void setPool(BufferPool*);
+
+        //
+        // Returns the segments referenced by the container, or null if it
+        // doesn't reference any data. setSegments() transfers the ownership
+        // of the segments to the container, which must hold memory.
+        //
+        BufferSegments* segments() const;
+        void setSegments(BufferSegments*);
+
         void resize(size_type n) // Inlined for performance reasons.
         {
             if(n == 0)
@@ -137,6 +179,7 @@ public:
         Container(const Container&);
         void operator=(const Container&);
         void reserve(size_type);
+        void release();
 
         pointer _buf;
         size_type _size;
@@ -18,6 +18,7 @@
 #include <Ice/ObserverHelper.h>
 #include <Ice/LocalException.h>
 #include <Ice/UniquePtr.h>
+#include <Ice/Current.h>
 
 #ifndef ICE_CPP11_MAPPING
 #    include <Ice/AsyncResult.h>
@@ -108,7 +109,7 @@ public:
 
     void attachRemoteObserver(const Ice::ConnectionInfoPtr& c, const Ice::EndpointPtr& endpt, Ice::Int requestId)
     {
-        const Ice::Int size = static_cast<Ice::Int>(_os.b.size() - headerSize - 4);
+        const Ice::Int size = static_cast<Ice::Int>(_os.b.size() + _os.segmentsSize() - headerSize - 4);
         _childObserver.attach(getObserver().getRemoteObserver(c, endpt, requestId, size));
     }
 
@@ -290,6 +291,18 @@ public:
 
 protected:
 
+#ifdef ICE_CPP11_MAPPING
+    //
+    // Direct dispatch of synchronous collocated invocations: the servant is called with
+    // the typed parameters, the request and reply are not marshaled. See
+    // OutgoingAsyncT::invokeCollocated.
+    //
+    Ice::ObjectPtr startCollocatedDispatch(const std::string&, Ice::OperationMode, const Ice::Context&,
+                                           Ice::Current&);
+    void finishCollocatedDispatch(Ice::Current&);
+    void throwCollocatedException(const Ice::Current&);
+#endif
+
     const Ice::EncodingVersion _encoding;
 
 #ifdef ICE_CPP11_MAPPING
@@ -427,8 +440,55 @@ public:
         OutgoingAsync::invoke(operation, mode, format, ctx, std::move(write));
     }
 
+    //
+    // Dispatch the invocation directly to the collocated servant of type S if the direct
+    // dispatch is enabled and possible for this invocation. Returns false if the invocation
+    // must be sent with invoke() instead.
+    //
+    template<typename S, typename F>
+    bool
+    invokeCollocated(const std::string& operation,
+                     Ice::OperationMode mode,
+                     const Ice::Context& ctx,
+                     F dispatch,
+                     std::function<void(const Ice::UserException&)> userException)
+    {
+        Ice::Current current;
+        Ice::ObjectPtr servant = startCollocatedDispatch(operation, mode, ctx, current);
+        if(!servant)
+        {
+            return false;
+        }
+
+        S* s = dynamic_cast<S*>(servant.get());
+        if(!s)
+        {
+            finishCollocatedDispatch(current);
+            return false;
+        }
+
+        try
+        {
+            T v = dispatch(s, current);
+            finishCollocatedDispatch(current);
+            collocatedResponse(std::move(v));
+        }
+        catch(...)
+        {
+            finishCollocatedDispatch(current);
+            _userException = std::move(userException);
+            throwCollocatedException(current);
+        }
+        return true;
+    }
+
 protected:
 
+    virtual void collocatedResponse(T&&)
+    {
+        assert(false); // Only synchronous invocations are dispatched directly.
+    }
+
     std::function<T(Ice::InputStream*)> _read;
 };
 
@@ -450,6 +510,50 @@ public:
         _userException = std::move(userException);
         OutgoingAsync::invoke(operation, mode, format, ctx, std::move(write));
     }
+
+    template<typename S, typename F>
+    bool
+    invokeCollocated(const std::string& operation,
+                     Ice::OperationMode mode,
+                     const Ice::Context& ctx,
+                     F dispatch,
+                     std::function<void(const Ice::UserException&)> userException)
+    {
+        Ice::Current current;
+        Ice::ObjectPtr servant = startCollocatedDispatch(operation, mode, ctx, current);
+        if(!servant)
+        {
+            return false;
+        }
+
+        S* s = dynamic_cast<S*>(servant.get());
+        if(!s)
+        {
+            finishCollocatedDispatch(current);
+            return false;
+        }
+
+        try
+        {
+            dispatch(s, current);
+            finishCollocatedDispatch(current);
+            collocatedResponse();
+        }
+        catch(...)
+        {
+            finishCollocatedDispatch(current);
+            _userException = std::move(userException);
+            throwCollocatedException(current);
+        }
+        return true;
+    }
+
+protected:
+
+    virtual void collocatedResponse()
+    {
+        assert(false); // Only synchronous invocations are dispatched directly.
+    }
 };
 
 template<typename R>
@@ -588,6 +692,13 @@ public:
             }
         };
     }
+
+protected:
+
+    virtual void collocatedResponse(R&& v) override
+    {
+        this->_promise.set_value(std::move(v));
+    }
 };
 
 template<typename P>
@@ -629,6 +740,13 @@ public:
         }
         return false;
     }
+
+protected:
+
+    virtual void collocatedResponse() override
+    {
+        this->_promise.set_value();
+    }
 };
 
 #else
@@ -221,8 +221,8 @@ public:
     {
         assert(_currentEncaps);
 
-        // Size includes size and version.
-        const Int sz = static_cast<Int>(b.size() - _currentEncaps->start);
+        // Size includes size, version and the referenced bytes.
+        const Int sz = static_cast<Int>(b.size() - _currentEncaps->start + segmentsSize(_currentEncaps->start));
         write(sz, &(*(b.begin() + _currentEncaps->start)));
 
         Encaps* oldEncaps = _currentEncaps;
@@ -363,7 +363,7 @@ public:
      */
     void endSize(size_type position)
     {
-        rewrite(static_cast<Int>(b.size() - position) - 4, position);
+        rewrite(static_cast<Int>(b.size() - position + segmentsSize(position)) - 4, position);
     }
 
     /**
@@ -862,6 +862,13 @@ public:
 
     // Optionals
     bool writeOptImpl(Int, OptionalFormat);
+
+    //
+    // Byte sequences of at least the given size are referenced by the
+    // stream rather than copied into it, see BufferSegments. The data
+    // must remain valid until the stream is sent. Zero disables it.
+    //
+    void setZeroCopySize(size_t);
     /// \endcond
 
 private:
@@ -50,6 +50,16 @@ const ::Ice::Byte replyMsg = 2;
 const ::Ice::Byte validateConnectionMsg = 3;
 const ::Ice::Byte closeConnectionMsg = 4;
 
+//
+// A fragment of a message, only sent to peers that set fragmentsSupported in
+// the compression status of their validate connection message. The body of a
+// fragment is the id of the fragmented message (Int), the size of the
+// fragmented message (Int) and the fragment bytes. The fragments of a message
+// are sent in order, possibly interleaved with other messages.
+//
+const ::Ice::Byte fragmentMsg = 5;
+const ::Ice::Byte fragmentsSupported = 0x80;
+
 //
 // The request header, batch request header and reply header.
 //
@@ -67,6 +67,28 @@ public:
 };
 typedef IceUtil::Handle<PatcherFeedback> PatcherFeedbackPtr;
 
+//
+// The IcePatch2::PatcherThroughputFeedback class can also be implemented
+// by the PatcherFeedback of IcePatch2 clients to be notified of the
+// download throughput.
+//
+class ICEPATCH2_API PatcherThroughputFeedback
+{
+public:
+
+    virtual ~PatcherThroughputFeedback();
+
+    //
+    // This method is called about once per second during the file
+    // patching to report the download throughput in bytes per second.
+    // Files are downloaded in parallel, the throughput and the total
+    // progress reported to the PatcherFeedback include all the files
+    // being downloaded. This method should return false to interrupt
+    // the patching, true otherwise.
+    //
+    virtual bool patchThroughput(Ice::Long) = 0;
+};
+
 //
 // IcePatch2 clients instantiate the IcePatch2::Patcher class to patch
 // a given local data directory.
@@ -126,6 +148,7 @@ public:
     // - IcePatch2.Thorough
     // - IcePatch2.ChunkSize
     // - IcePatch2.Remove
+    // - IcePatch2Client.Concurrency
     //
     // See the Ice manual for more information on these properties.
     //
@@ -134,6 +157,8 @@ public:
     //
     // Create a patcher with the given parameters. These parameters
     // are equivalent to the configuration properties described above.
+    // The IcePatch2Client.Concurrency property is read from the
+    // communicator of the given proxy.
     //
     static PatcherPtr create(const FileServerPrx&, const PatcherFeedbackPtr&, const std::string&, bool, Ice::Int, Ice::Int);
 };
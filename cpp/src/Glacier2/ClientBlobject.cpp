@@ -32,14 +32,24 @@ Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&
                                            const std::pair<const Byte*, const Byte*>& inParams,
                                            const Current& current)
 {
+    //
+    // Get the current filter indexes once, the filters can be updated
+    // concurrently. A request is accepted as soon as one of the filters
+    // matches, the remaining filters are only checked to trace the
+    // rejected filters.
+    //
+    StringSetI::IndexPtr categories = _filters->categories()->index();
+    IdentitySetI::IndexPtr identities = _filters->identities()->index();
+    StringSetI::IndexPtr adapterIds = _filters->adapterIds()->index();
+
     bool matched = false;
     bool hasFilters = false;
     string rejectedFilters;
 
-    if(!_filters->categories()->empty())
+    if(!categories->empty())
     {
         hasFilters = true;
-        if(_filters->categories()->match(current.id.category))
+        if(categories->match(current.id.category))
         {
             matched = true;
         }
@@ -54,10 +64,10 @@ Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&
         }
     }
 
-    if(!_filters->identities()->empty())
+    if(!identities->empty() && (!matched || _rejectTraceLevel >= 1))
     {
         hasFilters = true;
-        if(_filters->identities()->match(current.id))
+        if(identities->match(current.id))
         {
             matched = true;
         }
@@ -84,23 +94,25 @@ Glacier2::ClientBlobject::ice_invoke_async(const Ice::AMD_Object_ice_invokePtr&
         throw ObjectNotExistException(__FILE__, __LINE__, current.id, current.facet, "ice_add_proxy");
     }
 
-    string adapterId = proxy->ice_getAdapterId();
-
-    if(!adapterId.empty() && !_filters->adapterIds()->empty())
+    if(!adapterIds->empty() && (!matched || _rejectTraceLevel >= 1))
     {
-        hasFilters = true;
-        if(_filters->adapterIds()->match(adapterId))
+        string adapterId = proxy->ice_getAdapterId();
+        if(!adapterId.empty())
         {
-            matched = true;
-        }
-        else if(_rejectTraceLevel >= 1)
-        {
-            if(rejectedFilters.size() != 0)
+            hasFilters = true;
+            if(adapterIds->match(adapterId))
             {
-                rejectedFilters += ", ";
+                matched = true;
+            }
+            else if(_rejectTraceLevel >= 1)
+            {
+                if(rejectedFilters.size() != 0)
+                {
+                    rejectedFilters += ", ";
 
+                }
+                rejectedFilters += "adapter id filter";
             }
-            rejectedFilters += "adapter id filter";
         }
     }
 
@@ -9,7 +9,8 @@
 #include <Ice/Identity.h>
 #include <string>
 #include <vector>
-#include <list>
+#include <algorithm>
+#include <iterator>
 
 #ifdef _MSC_VER
 #   pragma warning(disable:4505) // unreferenced local function has been removed
@@ -18,18 +19,105 @@
 namespace Glacier2
 {
 
-template <typename T, class P>
-class FilterT : public P, public IceUtil::Monitor<IceUtil::Mutex>
+//
+// FNV-1a hash of the filter items.
+//
+inline unsigned int
+filterHash(const std::string& s, unsigned int h = 2166136261U)
+{
+    for(std::string::const_iterator p = s.begin(); p != s.end(); ++p)
+    {
+        h ^= static_cast<unsigned char>(*p);
+        h *= 16777619U;
+    }
+    return h;
+}
+
+inline unsigned int
+filterHash(const Ice::Identity& id)
+{
+    return filterHash(id.name, filterHash(id.category) * 16777619U);
+}
+
+//
+// Immutable hashed index of the filter items. Filter updates build a new
+// index and swap it in, requests are matched against the current index
+// with an open addressing lookup which doesn't lock or allocate.
+//
+template<typename T>
+class FilterIndexT : public IceUtil::Shared
 {
 public:
 
     //
-    // These typedefs are a compiler workaround for GCC and iterators
-    // depending on nested templates.
+    // The items must be sorted and without duplicates.
     //
-    typedef typename std::vector<T>::const_iterator const_iterator;
-    typedef typename std::vector<T>::iterator iterator;
-    typedef typename std::list<iterator>::iterator literator;
+    FilterIndexT(const std::vector<T>& items) :
+        _items(items),
+        _hashes(items.size())
+    {
+        size_t size = 16;
+        while(size < _items.size() * 2)
+        {
+            size *= 2;
+        }
+        _mask = size - 1;
+        _slots.resize(size, -1);
+
+        for(size_t i = 0; i < _items.size(); ++i)
+        {
+            _hashes[i] = filterHash(_items[i]);
+            size_t j = _hashes[i] & _mask;
+            while(_slots[j] >= 0)
+            {
+                j = (j + 1) & _mask;
+            }
+            _slots[j] = static_cast<int>(i);
+        }
+    }
+
+    bool
+    match(const T& candidate) const
+    {
+        const unsigned int h = filterHash(candidate);
+        for(size_t j = h & _mask; _slots[j] >= 0; j = (j + 1) & _mask)
+        {
+            const size_t i = static_cast<size_t>(_slots[j]);
+            if(_hashes[i] == h && _items[i] == candidate)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool
+    empty() const
+    {
+        return _items.empty();
+    }
+
+    const std::vector<T>&
+    items() const
+    {
+        return _items;
+    }
+
+private:
+
+    const std::vector<T> _items;
+    std::vector<unsigned int> _hashes;
+    std::vector<int> _slots;
+    size_t _mask;
+};
+
+template <typename T, class P>
+class FilterT : public P, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    typedef FilterIndexT<T> Index;
+    typedef IceUtil::Handle<Index> IndexPtr;
 
     FilterT(const std::vector<T>&);
 
@@ -43,39 +131,47 @@ public:
     //
     // Internal functions.
     //
+    IndexPtr
+    index() const
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
+        return _index;
+    }
+
     bool
     match(const T& candidate) const
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
         //
         // Empty vectors mean no filtering, so all matches will succeed.
         //
-        if(_items.size() == 0)
-        {
-            return true;
-        }
-
-        return binary_search(_items.begin(), _items.end(), candidate);
+        IndexPtr index = this->index();
+        return index->empty() || index->match(candidate);
     }
 
     bool
     empty() const
     {
-        IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-        return _items.size() == 0;
+        return index()->empty();
     }
 
 private:
 
-    std::vector<T> _items;
+    void setIndex(const std::vector<T>&);
+
+    //
+    // Serializes the updates, the index is only locked to swap it in.
+    //
+    IceUtil::Mutex _updateMutex;
+    IndexPtr _index;
 };
 
 template<class T, class P>
-FilterT<T, P>::FilterT(const std::vector<T>& accept):
-    _items(accept)
+FilterT<T, P>::FilterT(const std::vector<T>& accept)
 {
-    sort(_items.begin(), _items.end());
-    _items.erase(unique(_items.begin(), _items.end()), _items.end());
+    std::vector<T> items(accept);
+    sort(items.begin(), items.end());
+    items.erase(unique(items.begin(), items.end()), items.end());
+    _index = new Index(items);
 }
 
 template<class T, class P> void
@@ -89,83 +185,49 @@ FilterT<T, P>::add(const std::vector<T>& additions, const Ice::Current&)
     sort(newItems.begin(), newItems.end());
     newItems.erase(unique(newItems.begin(), newItems.end()), newItems.end());
 
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    std::vector<T> merged(_items.size() + newItems.size());
-    merge(newItems.begin(), newItems.end(), _items.begin(), _items.end(), merged.begin());
+    IceUtil::Mutex::Lock sync(_updateMutex);
+    IndexPtr current = index();
+    const std::vector<T>& items = current->items();
+    std::vector<T> merged(items.size() + newItems.size());
+    merge(newItems.begin(), newItems.end(), items.begin(), items.end(), merged.begin());
     merged.erase(unique(merged.begin(), merged.end()), merged.end());
-    swap(_items, merged);
+    setIndex(merged);
 }
 
 template<class T, class P> void
 FilterT<T, P>::remove(const std::vector<T>& deletions, const Ice::Current&)
 {
     //
-    // Our removal algorithm depends on the filter elements to be
-    // removed to be sorted in the same order as our current elements.
+    // Both vectors are sorted, the remaining items are their difference.
     //
     std::vector<T> toRemove(deletions);
     sort(toRemove.begin(), toRemove.end());
-    toRemove.erase(unique(toRemove.begin(), toRemove.end()), toRemove.end());
 
-    IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-
-    //
-    // Our vectors are both sorted, so if we keep track of our first
-    // match between the current set and the set of items to be removed,
-    // we do not need to traverse the whole of the current set each
-    // time. We also use a list of deletions instead of erasing things
-    // itemwise.
-    //
-
-    //
-    // The presence of the 'typename' is a GCC specific workaround. The
-    // iterator types apparently resolve to a 'void' in GCC type
-    // causing compiler errors.
-    //
-    const_iterator r = toRemove.begin();
-    iterator mark = _items.begin();
-    std::list<iterator> deleteList;
-
-    while(r != toRemove.end())
-    {
-        iterator i = mark;
-        while(i != _items.end() && r != toRemove.end())
-        {
-            if(*r == *i)
-            {
-                //
-                // We want this list to be in LIFO order because we are
-                // going to erase things from the tail forward.
-                //
-                deleteList.push_front(i);
-                ++i;
-                ++r;
-                mark = i;
-            }
-            else
-            {
-                ++i;
-            }
-        }
-
-        if(r == toRemove.end())
-        {
-            break;
-        }
-        ++r;
-    }
-
-    for(literator i = deleteList.begin(); i != deleteList.end(); ++i)
-    {
-        _items.erase(*i);
-    }
+    IceUtil::Mutex::Lock sync(_updateMutex);
+    IndexPtr current = index();
+    const std::vector<T>& items = current->items();
+    std::vector<T> remaining;
+    remaining.reserve(items.size());
+    set_difference(items.begin(), items.end(), toRemove.begin(), toRemove.end(), back_inserter(remaining));
+    setIndex(remaining);
 }
 
 template<class T, class P> std::vector<T>
 FilterT<T, P>::get(const Ice::Current&)
 {
+    return index()->items();
+}
+
+template<class T, class P> void
+FilterT<T, P>::setIndex(const std::vector<T>& items)
+{
+    //
+    // Build the new index before locking, requests keep using the
+    // current index until it's swapped in.
+    //
+    IndexPtr index = new Index(items);
     IceUtil::Monitor<IceUtil::Mutex>::Lock lock(*this);
-    return _items;
+    _index = index;
 }
 
 typedef FilterT<Ice::Identity, Glacier2::IdentitySet> IdentitySetI;
@@ -7,6 +7,8 @@
 
 #include <vector>
 #include <string>
+#include <algorithm>
+#include <climits>
 
 using namespace std;
 using namespace Ice;
@@ -94,6 +96,47 @@ parseGroup(const string& parameter, vector<int>& validPorts, vector<Range>& rang
     }
 }
 
+//
+// Parses the integer at the given position of the string like the stream
+// extraction operator but without copying the string into a stream. Returns
+// the number of characters read or 0 if there's no integer at this position.
+//
+static string::size_type
+parseNumber(const string& s, string::size_type pos, int& value)
+{
+    string::size_type p = pos;
+    while(p < s.size() && isspace(static_cast<unsigned char>(s[p])))
+    {
+        ++p;
+    }
+
+    bool negative = false;
+    if(p < s.size() && (s[p] == '-' || s[p] == '+'))
+    {
+        negative = s[p] == '-';
+        ++p;
+    }
+
+    const string::size_type digits = p;
+    Long v = 0;
+    while(p < s.size() && s[p] >= '0' && s[p] <= '9')
+    {
+        v = v * 10 + (s[p] - '0');
+        if(v > static_cast<Long>(INT_MAX) + 1)
+        {
+            return 0;
+        }
+        ++p;
+    }
+
+    if(p == digits || (!negative && v > INT_MAX))
+    {
+        return 0;
+    }
+    value = static_cast<int>(negative ? -v : v);
+    return p - pos;
+}
+
 //
 // Base class for address matching operations.
 //
@@ -204,6 +247,12 @@ public:
         return _description.c_str();
     }
 
+    const string&
+    criteria() const
+    {
+        return _criteria;
+    }
+
 private:
     string _criteria;
     string _description;
@@ -337,13 +386,13 @@ public:
     bool
     match(const string & space, string::size_type& pos)
     {
-        istringstream istr(space.substr(pos));
         int val;
-        if(!(istr >> val))
+        string::size_type length = parseNumber(space, pos, val);
+        if(length == 0)
         {
             return false;
         }
-        pos += static_cast<string::size_type>(istr.tellg());
+        pos += length;
         {
             for(vector<int>::const_iterator i = _values.begin(); i != _values.end(); ++i)
             {
@@ -538,61 +587,93 @@ public:
     }
 
     virtual bool
-    check(const ObjectPrx& prx) const
+    check(const ObjectPrx&, const vector<EndpointAddress>& addresses) const
     {
-        EndpointSeq endpoints = prx->ice_getEndpoints();
-        if(endpoints.size() == 0)
+        if(addresses.size() == 0)
         {
             return false;
         }
 
-        for(EndpointSeq::const_iterator i = endpoints.begin(); i != endpoints.end(); ++i)
+        for(vector<EndpointAddress>::const_iterator i = addresses.begin(); i != addresses.end(); ++i)
         {
-            string info = (*i)->toString();
-            string host;
-            if(!extractPart("-h ", info, host))
-            {
-                return false;
-            }
-            string port;
-            if(!extractPart("-p ", info, port))
+            if(!match(*i))
             {
                 return false;
             }
+        }
+        return true;
+    }
+
+    bool
+    match(const EndpointAddress& address) const
+    {
+        if(!matchPort(address.port))
+        {
+            return false;
+        }
 
-            string::size_type pos = 0;
-            if(_portMatcher && !_portMatcher->match(port, pos))
+        string::size_type pos = 0;
+        for(vector<AddressMatcher*>::const_iterator j = _addressRules.begin(); j != _addressRules.end(); ++j)
+        {
+            if(!(*j)->match(address.host, pos))
             {
                 if(_traceLevel >= 3)
                 {
                     Trace out(_communicator->getLogger(), "Glacier2");
-                    out << _portMatcher->toString() << " failed to match " << port << " at pos=" << pos << "\n";
+                    out << (*j)->toString() << " failed to match " << address.host << " at pos=" << pos << "\n";
                 }
                 return false;
             }
+            if(_traceLevel >= 3)
+            {
+                Trace out(_communicator->getLogger(), "Glacier2");
+                out << (*j)->toString() << " matched " << address.host << " at pos=" << pos << "\n";
+            }
+        }
+        return true;
+    }
 
-            pos = 0;
-            for(vector<AddressMatcher*>::const_iterator j = _addressRules.begin(); j != _addressRules.end(); ++j)
+    bool
+    matchPort(const string& port) const
+    {
+        string::size_type pos = 0;
+        if(_portMatcher && !_portMatcher->match(port, pos))
+        {
+            if(_traceLevel >= 3)
             {
-                if(!(*j)->match(host, pos))
-                {
-                    if(_traceLevel >= 3)
-                    {
-                        Trace out(_communicator->getLogger(), "Glacier2");
-                        out << (*j)->toString() << " failed to match " << host << " at pos=" << pos << "\n";
-                    }
-                    return false;
-                }
-                if(_traceLevel >= 3)
-                {
-                    Trace out(_communicator->getLogger(), "Glacier2");
-                    out << (*j)->toString() << " matched " << host << " at pos=" << pos << "\n";
-                }
+                Trace out(_communicator->getLogger(), "Glacier2");
+                out << _portMatcher->toString() << " failed to match " << port << " at pos=" << pos << "\n";
             }
+            return false;
         }
         return true;
     }
 
+    //
+    // Returns true if the rule only matches the end of the host, the
+    // suffix is empty if the rule matches any host.
+    //
+    bool
+    hostSuffix(string& suffix) const
+    {
+        if(_addressRules.size() != 1)
+        {
+            return false;
+        }
+        if(dynamic_cast<MatchesAny*>(_addressRules[0]))
+        {
+            suffix.clear();
+            return true;
+        }
+        EndsWithString* endsWith = dynamic_cast<EndsWithString*>(_addressRules[0]);
+        if(endsWith)
+        {
+            suffix = endsWith->criteria();
+            return true;
+        }
+        return false;
+    }
+
     void
     dump() const
     {
@@ -610,33 +691,54 @@ public:
 
 private:
 
-    bool
-    extractPart(const char* opt, const string& source, string& result) const
-    {
-        string::size_type start = source.find(opt);
-        if(start == string::npos)
-        {
-            return false;
-        }
-        start += strlen(opt);
-        string::size_type end = source.find(' ', start);
-        if(end != string::npos)
-        {
-            result = source.substr(start, end - start);
-        }
-        else
-        {
-            result = source.substr(start);
-        }
-        return true;
-    }
-
     CommunicatorPtr _communicator;
     vector<AddressMatcher*> _addressRules;
     MatchesNumber* _portMatcher;
     const int _traceLevel;
 };
 
+static bool
+extractPart(const char* opt, const string& source, string& result)
+{
+    string::size_type start = source.find(opt);
+    if(start == string::npos)
+    {
+        return false;
+    }
+    start += strlen(opt);
+    string::size_type end = source.find(' ', start);
+    if(end != string::npos)
+    {
+        result = source.substr(start, end - start);
+    }
+    else
+    {
+        result = source.substr(start);
+    }
+    return true;
+}
+
+//
+// Extracts the host and port of the proxy endpoints. The addresses are left
+// empty if the proxy has no endpoints or if an endpoint has no host or port,
+// address rules don't match such proxies.
+//
+static void
+extractAddresses(const ObjectPrx& proxy, vector<EndpointAddress>& addresses)
+{
+    EndpointSeq endpoints = proxy->ice_getEndpoints();
+    addresses.resize(endpoints.size());
+    for(EndpointSeq::size_type i = 0; i < endpoints.size(); ++i)
+    {
+        string info = endpoints[i]->toString();
+        if(!extractPart("-h ", info, addresses[i].host) || !extractPart("-p ", info, addresses[i].port))
+        {
+            addresses.clear();
+            return;
+        }
+    }
+}
+
 static void
 parseProperty(const Ice::CommunicatorPtr& communicator, const string& property, vector<ProxyRule*>& rules,
               const int traceLevel)
@@ -800,20 +902,159 @@ parseProperty(const Ice::CommunicatorPtr& communicator, const string& property,
 }
 
 //
-// Helper function for checking a rule set.
+// A compiled set of proxy rules. The address rules which only match the end
+// of the host (rules without wildcards or groups, or matching any host) are
+// stored in a trie of the reversed host suffixes: the host of the first
+// proxy endpoint is matched against all these rules with a single walk of
+// the trie, from the last character of the host. The other rules are
+// checked one after the other.
 //
-static bool
-match(const vector<ProxyRule*>& rules, const ObjectPrx& proxy)
+class ProxyRuleSet
 {
-    for(vector<ProxyRule*>::const_iterator i = rules.begin(); i != rules.end(); ++i)
+public:
+
+    ProxyRuleSet(const vector<ProxyRule*>& rules, int traceLevel) :
+        _rules(rules),
+        _hasAddressRules(false),
+        _trie(1)
     {
-        if((*i)->check(proxy))
+        for(vector<ProxyRule*>::const_iterator p = _rules.begin(); p != _rules.end(); ++p)
         {
-            return true;
+            AddressRule* rule = dynamic_cast<AddressRule*>(*p);
+            if(rule)
+            {
+                _hasAddressRules = true;
+            }
+
+            //
+            // Rules are checked one by one to trace the matching of each
+            // address matcher.
+            //
+            string suffix;
+            if(traceLevel < 3 && rule && rule->hostSuffix(suffix))
+            {
+                size_t node = 0;
+                for(string::size_type i = suffix.size(); i > 0; --i)
+                {
+                    node = addChild(node, suffix[i - 1]);
+                }
+                _trie[node].rules.push_back(rule);
+            }
+            else
+            {
+                _otherRules.push_back(*p);
+            }
         }
     }
-    return false;
-}
+
+    ~ProxyRuleSet()
+    {
+        for(vector<ProxyRule*>::const_iterator p = _rules.begin(); p != _rules.end(); ++p)
+        {
+            delete *p;
+        }
+    }
+
+    bool
+    empty() const
+    {
+        return _rules.empty();
+    }
+
+    bool
+    hasAddressRules() const
+    {
+        return _hasAddressRules;
+    }
+
+    bool
+    match(const ObjectPrx& proxy, const vector<EndpointAddress>& addresses) const
+    {
+        if(!addresses.empty())
+        {
+            const string& host = addresses[0].host;
+            size_t node = 0;
+            string::size_type i = host.size();
+            do
+            {
+                for(vector<AddressRule*>::const_iterator p = _trie[node].rules.begin(); p != _trie[node].rules.end();
+                    ++p)
+                {
+                    if(matchSuffixRule(*p, addresses))
+                    {
+                        return true;
+                    }
+                }
+            }
+            while(i > 0 && (node = child(node, host[--i])) != 0);
+        }
+
+        for(vector<ProxyRule*>::const_iterator p = _otherRules.begin(); p != _otherRules.end(); ++p)
+        {
+            if((*p)->check(proxy, addresses))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+
+    //
+    // The host of the first address is known to match the rule suffix.
+    //
+    static bool
+    matchSuffixRule(const AddressRule* rule, const vector<EndpointAddress>& addresses)
+    {
+        if(!rule->matchPort(addresses[0].port))
+        {
+            return false;
+        }
+        for(vector<EndpointAddress>::const_iterator p = addresses.begin() + 1; p != addresses.end(); ++p)
+        {
+            if(!rule->match(*p))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t
+    child(size_t node, char c) const
+    {
+        const vector<pair<char, size_t> >& children = _trie[node].children;
+        vector<pair<char, size_t> >::const_iterator p =
+            lower_bound(children.begin(), children.end(), make_pair(c, static_cast<size_t>(0)));
+        return p != children.end() && p->first == c ? p->second : 0;
+    }
+
+    size_t
+    addChild(size_t node, char c)
+    {
+        size_t n = child(node, c);
+        if(n == 0)
+        {
+            n = _trie.size();
+            vector<pair<char, size_t> >& children = _trie[node].children;
+            children.insert(lower_bound(children.begin(), children.end(), make_pair(c, n)), make_pair(c, n));
+            _trie.push_back(Node());
+        }
+        return n;
+    }
+
+    struct Node
+    {
+        vector<pair<char, size_t> > children; // Sorted by character.
+        vector<AddressRule*> rules;
+    };
+
+    const vector<ProxyRule*> _rules;
+    vector<ProxyRule*> _otherRules;
+    bool _hasAddressRules;
+    vector<Node> _trie;
+};
 
 //
 // ProxyLengthRule returns 'true' if the string form of the proxy exceeds the configured
@@ -838,7 +1079,7 @@ public:
     }
 
     bool
-    check(const ObjectPrx& p) const
+    check(const ObjectPrx& p, const vector<EndpointAddress>&) const
     {
         string s = p->ice_toString();
         bool result = (s.size() > _count);
@@ -867,12 +1108,14 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     // Evaluation order is dependant on how the rules are stored to the
     // rules vectors.
     //
+    vector<ProxyRule*> acceptRules;
+    vector<ProxyRule*> rejectRules;
     string s = communicator->getProperties()->getProperty("Glacier2.Filter.Address.Accept");
     if(s != "")
     {
         try
         {
-            Glacier2::parseProperty(communicator, s, _acceptRules, _traceLevel);
+            Glacier2::parseProperty(communicator, s, acceptRules, _traceLevel);
         }
         catch(const exception& ex)
         {
@@ -887,7 +1130,7 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     {
         try
         {
-            Glacier2::parseProperty(communicator, s, _rejectRules, _traceLevel);
+            Glacier2::parseProperty(communicator, s, rejectRules, _traceLevel);
         }
         catch(const exception& ex)
         {
@@ -902,8 +1145,7 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
     {
         try
         {
-            _rejectRules.push_back(new ProxyLengthRule(communicator, s, _traceLevel));
-
+            rejectRules.push_back(new ProxyLengthRule(communicator, s, _traceLevel));
         }
         catch(const exception& ex)
         {
@@ -912,18 +1154,13 @@ Glacier2::ProxyVerifier::ProxyVerifier(const CommunicatorPtr& communicator):
             throw InitializationException(__FILE__, __LINE__, os.str());
         }
     }
+
+    _acceptRules.reset(new ProxyRuleSet(acceptRules, _traceLevel));
+    _rejectRules.reset(new ProxyRuleSet(rejectRules, _traceLevel));
 }
 
 Glacier2::ProxyVerifier::~ProxyVerifier()
 {
-    for(vector<ProxyRule*>::const_iterator i = _acceptRules.begin(); i != _acceptRules.end(); ++i)
-    {
-        delete (*i);
-    }
-    for(vector<ProxyRule*>::const_iterator j = _rejectRules.begin(); j != _rejectRules.end(); ++j)
-    {
-        delete (*j);
-   }
 }
 
 bool
@@ -932,32 +1169,38 @@ Glacier2::ProxyVerifier::verify(const ObjectPrx& proxy)
     //
     // No rules have been defined so we accept all.
     //
-    if(_acceptRules.size() == 0 && _rejectRules.size() == 0)
+    if(_acceptRules->empty() && _rejectRules->empty())
     {
         return true;
     }
 
+    vector<EndpointAddress> addresses;
+    if(_acceptRules->hasAddressRules() || _rejectRules->hasAddressRules())
+    {
+        extractAddresses(proxy, addresses);
+    }
+
     bool result = false;
 
-    if(_rejectRules.size() == 0)
+    if(_rejectRules->empty())
     {
         //
         // If there are no reject rules, we assume "reject all".
         //
-        result = match(_acceptRules, proxy);
+        result = _acceptRules->match(proxy, addresses);
     }
-    else if(_acceptRules.size() == 0)
+    else if(_acceptRules->empty())
     {
         //
         // If no accept rules are defined we assume accept all.
         //
-        result = !match(_rejectRules, proxy);
+        result = !_rejectRules->match(proxy, addresses);
     }
     else
     {
-        if(match(_acceptRules, proxy))
+        if(_acceptRules->match(proxy, addresses))
         {
-            result = !match(_rejectRules, proxy);
+            result = !_rejectRules->match(proxy, addresses);
         }
     }
 
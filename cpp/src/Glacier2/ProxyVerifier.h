@@ -6,11 +6,21 @@
 #define ICE_PROXY_VERIFIER_H
 
 #include <Ice/Ice.h>
+#include <Ice/UniquePtr.h>
 #include <vector>
 
 namespace Glacier2
 {
 
+//
+// The host and port of a proxy endpoint.
+//
+struct EndpointAddress
+{
+    std::string host;
+    std::string port;
+};
+
 //
 // Base class for proxy rule implementations.
 //
@@ -22,11 +32,14 @@ public:
     virtual ~ProxyRule() {}
 
     //
-    // Checks to see if the proxy passes.
+    // Checks to see if the proxy passes. The addresses of the proxy
+    // endpoints are extracted once by the verifier for all the rules.
     //
-    virtual bool check(const Ice::ObjectPrx&) const = 0;
+    virtual bool check(const Ice::ObjectPrx&, const std::vector<EndpointAddress>&) const = 0;
 };
 
+class ProxyRuleSet;
+
 class ProxyVerifier : public IceUtil::Shared
 {
 public:
@@ -45,8 +58,8 @@ private:
     const Ice::CommunicatorPtr _communicator;
     const int _traceLevel;
 
-    std::vector<ProxyRule*> _acceptRules;
-    std::vector<ProxyRule*> _rejectRules;
+    IceInternal::UniquePtr<ProxyRuleSet> _acceptRules;
+    IceInternal::UniquePtr<ProxyRuleSet> _rejectRules;
 };
 typedef IceUtil::Handle<ProxyVerifier> ProxyVerifierPtr;
 
@@ -18,6 +18,11 @@ namespace
 
 const int udpOverhead = 20 + 8;
 
+//
+// The smallest batch size of the adaptive auto flush.
+//
+const size_t adaptiveMinFlushSize = 4 * 1024;
+
 class BatchRequestI : public Ice::BatchRequest
 {
 public:
@@ -59,15 +64,42 @@ private:
     const int _size;
 };
 
+class AutoFlushTimerTask : public IceUtil::TimerTask
+{
+public:
+
+    AutoFlushTimerTask(const BatchRequestQueuePtr& queue, const Ice::ObjectPrxPtr& proxy) :
+        _queue(queue), _proxy(proxy)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _queue->flushTimedOut(_proxy);
+    }
+
+private:
+
+    const BatchRequestQueuePtr _queue;
+    const Ice::ObjectPrxPtr _proxy;
+};
+
 }
 
-BatchRequestQueue::BatchRequestQueue(const InstancePtr& instance, bool datagram) :
+BatchRequestQueue::BatchRequestQueue(const InstancePtr& instance, bool datagram, int flushDelay) :
     _interceptor(instance->initializationData().batchRequestInterceptor),
     _batchStream(instance.get(), Ice::currentProtocolEncoding),
     _batchStreamInUse(false),
     _batchStreamCanFlush(false),
     _batchCompress(false),
-    _batchRequestNum(0)
+    _batchRequestNum(0),
+    _flushDelay(IceUtil::Time::milliSeconds(flushDelay)),
+    _flushScheduled(false),
+    _adaptive(false),
+    _minFlushSize(0),
+    _flushSize(0),
+    _pendingFlushes(0)
 {
     _batchStream.writeBlob(requestBatchHdr, sizeof(requestBatchHdr));
     _batchMarker = _batchStream.b.size();
@@ -82,6 +114,19 @@ BatchRequestQueue::BatchRequestQueue(const InstancePtr& instance, bool datagram)
             _maxSize = udpSndSize;
         }
     }
+
+    _flushSize = _maxSize;
+    if(_maxSize > 0 && instance->batchAutoFlushAdaptive())
+    {
+        _adaptive = true;
+        _minFlushSize = min(_maxSize, adaptiveMinFlushSize);
+        _flushSize = _minFlushSize;
+    }
+
+    if(flushDelay > 0)
+    {
+        _timer = instance->timer();
+    }
 }
 
 void
@@ -111,15 +156,16 @@ BatchRequestQueue::finishBatchRequest(OutputStream* os,
 
     try
     {
-        _batchStreamCanFlush = true; // Allow flush to proceed even if the stream is marked in use.
+        bool flush;
+        {
+            Lock sync(*this);
+            _batchStreamCanFlush = true; // Allow flush to proceed even if the stream is marked in use.
+            flush = checkAutoFlushSize();
+        }
 
-        if(_maxSize > 0 && _batchStream.b.size() >= _maxSize)
+        if(flush)
         {
-#ifdef ICE_CPP11_MAPPING
-            proxy->ice_flushBatchRequestsAsync();
-#else
-            proxy->begin_ice_flushBatchRequests();
-#endif
+            autoFlush(proxy);
         }
 
         assert(_batchMarker < _batchStream.b.size());
@@ -143,11 +189,39 @@ BatchRequestQueue::finishBatchRequest(OutputStream* os,
             ++_batchRequestNum;
         }
 
-        Lock sync(*this);
-        _batchStream.resize(_batchMarker);
-        _batchStreamInUse = false;
-        _batchStreamCanFlush = false;
-        notifyAll();
+        bool timedOut = false;
+        {
+            Lock sync(*this);
+            _batchStream.resize(_batchMarker);
+            _batchStreamInUse = false;
+            _batchStreamCanFlush = false;
+            if(_timer && _batchRequestNum > 0)
+            {
+                if(_flushDeadline == IceUtil::Time())
+                {
+                    _flushDeadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + _flushDelay;
+                    if(!_flushScheduled)
+                    {
+                        scheduleAutoFlush(proxy, _flushDelay);
+                    }
+                }
+                else if(!_flushScheduled)
+                {
+                    //
+                    // The timer task ran while the stream was in use, we
+                    // flush the batch on its behalf.
+                    //
+                    _flushDeadline = IceUtil::Time();
+                    timedOut = true;
+                }
+            }
+            notifyAll();
+        }
+
+        if(timedOut)
+        {
+            autoFlush(proxy);
+        }
     }
     catch(const std::exception&)
     {
@@ -177,6 +251,7 @@ int
 BatchRequestQueue::swap(OutputStream* os, bool& compress)
 {
     Lock sync(*this);
+    cancelAutoFlush();
     if(_batchRequestNum == 0)
     {
         return 0;
@@ -213,6 +288,7 @@ void
 BatchRequestQueue::destroy(const Ice::LocalException& ex)
 {
     Lock sync(*this);
+    cancelAutoFlush();
 #ifdef ICE_CPP11_MAPPING
     _exception = ex.ice_clone();
 #else
@@ -248,3 +324,153 @@ BatchRequestQueue::enqueueBatchRequest(const Ice::ObjectPrxPtr& proxy)
     _batchMarker = _batchStream.b.size();
     ++_batchRequestNum;
 }
+
+void
+BatchRequestQueue::autoFlush(const Ice::ObjectPrxPtr& proxy)
+{
+    if(!_adaptive)
+    {
+#ifdef ICE_CPP11_MAPPING
+        proxy->ice_flushBatchRequestsAsync();
+#else
+        proxy->begin_ice_flushBatchRequests();
+#endif
+        return;
+    }
+
+    {
+        Lock sync(*this);
+        ++_pendingFlushes;
+    }
+
+#ifdef ICE_CPP11_MAPPING
+    BatchRequestQueuePtr self = this;
+    proxy->ice_flushBatchRequestsAsync([self](exception_ptr) { self->flushCompleted(false); },
+                                       [self](bool sentSynchronously) { self->flushCompleted(sentSynchronously); });
+#else
+    proxy->begin_ice_flushBatchRequests(Ice::newCallback_Object_ice_flushBatchRequests(this,
+                                                                                       &BatchRequestQueue::flushException,
+                                                                                       &BatchRequestQueue::flushSent));
+#endif
+}
+
+void
+BatchRequestQueue::flushTimedOut(const Ice::ObjectPrxPtr& proxy)
+{
+    {
+        Lock sync(*this);
+        _flushScheduled = false;
+        if(_flushDeadline == IceUtil::Time())
+        {
+            return; // The batch was flushed or the queue destroyed since the task was scheduled.
+        }
+
+        if(_batchStreamInUse)
+        {
+            //
+            // Don't swap the stream while a request is being added to the
+            // batch, finishBatchRequest flushes the batch once the request
+            // is added.
+            //
+            return;
+        }
+
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(now < _flushDeadline)
+        {
+            //
+            // The batch was flushed and a new batch started since the task
+            // was scheduled, wait for the deadline of the new batch.
+            //
+            scheduleAutoFlush(proxy, _flushDeadline - now);
+            return;
+        }
+        _flushDeadline = IceUtil::Time();
+    }
+    autoFlush(proxy);
+}
+
+bool
+BatchRequestQueue::checkAutoFlushSize()
+{
+    //
+    // Called with the mutex locked.
+    //
+    size_t size = _batchStream.b.size();
+    if(_maxSize == 0 || size < _flushSize)
+    {
+        return false;
+    }
+    else if(size >= _maxSize)
+    {
+        return true;
+    }
+
+    //
+    // Adaptive auto flush: if the previous flush isn't sent yet, the
+    // connection can't keep up with the requests, so we let the batch
+    // grow instead of queuing another small batch.
+    //
+    assert(_adaptive);
+    if(_pendingFlushes > 0)
+    {
+        _flushSize = min(_flushSize * 2, _maxSize);
+        return false;
+    }
+    return true;
+}
+
+void
+BatchRequestQueue::scheduleAutoFlush(const Ice::ObjectPrxPtr& proxy, const IceUtil::Time& delay)
+{
+    assert(!_flushScheduled);
+    try
+    {
+        _timer->schedule(ICE_MAKE_SHARED(AutoFlushTimerTask, this, proxy), delay);
+        _flushScheduled = true;
+    }
+    catch(const IceUtil::IllegalArgumentException&) // Expected if the communicator destroyed the timer.
+    {
+        _flushDeadline = IceUtil::Time();
+    }
+}
+
+void
+BatchRequestQueue::cancelAutoFlush()
+{
+    //
+    // The scheduled task, if any, does nothing when it runs.
+    //
+    _flushDeadline = IceUtil::Time();
+}
+
+void
+BatchRequestQueue::flushCompleted(bool sentSynchronously)
+{
+    //
+    // Adaptive auto flush: if the flush was sent without waiting, the
+    // connection keeps up with the requests and we shrink the batches
+    // to reduce the latency.
+    //
+    Lock sync(*this);
+    assert(_pendingFlushes > 0);
+    --_pendingFlushes;
+    if(sentSynchronously)
+    {
+        _flushSize = max(_flushSize / 2, _minFlushSize);
+    }
+}
+
+#ifndef ICE_CPP11_MAPPING
+void
+BatchRequestQueue::flushSent(bool sentSynchronously)
+{
+    flushCompleted(sentSynchronously);
+}
+
+void
+BatchRequestQueue::flushException(const Ice::Exception&)
+{
+    flushCompleted(false);
+}
+#endif
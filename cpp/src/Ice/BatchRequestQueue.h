@@ -8,6 +8,7 @@
 #include <IceUtil/Shared.h>
 #include <IceUtil/Mutex.h>
 #include <IceUtil/Monitor.h>
+#include <IceUtil/Timer.h>
 #include <Ice/UniquePtr.h>
 
 #include <Ice/BatchRequestInterceptor.h>
@@ -22,7 +23,7 @@ class BatchRequestQueue : public IceUtil::Shared, private IceUtil::Monitor<IceUt
 {
 public:
 
-    BatchRequestQueue(const InstancePtr&, bool);
+    BatchRequestQueue(const InstancePtr&, bool, int);
 
     void prepareBatchRequest(Ice::OutputStream*);
     void finishBatchRequest(Ice::OutputStream*, const Ice::ObjectPrxPtr&, const std::string&);
@@ -35,9 +36,20 @@ public:
 
     void enqueueBatchRequest(const Ice::ObjectPrxPtr&);
 
+    void autoFlush(const Ice::ObjectPrxPtr&);
+    void flushTimedOut(const Ice::ObjectPrxPtr&);
+
 private:
 
     void waitStreamInUse(bool);
+    bool checkAutoFlushSize();
+    void scheduleAutoFlush(const Ice::ObjectPrxPtr&, const IceUtil::Time&);
+    void cancelAutoFlush();
+    void flushCompleted(bool);
+#ifndef ICE_CPP11_MAPPING
+    void flushSent(bool);
+    void flushException(const Ice::Exception&);
+#endif
 
 #ifdef ICE_CPP11_MAPPING
     std::function<void(const Ice::BatchRequest&, int, int)> _interceptor;
@@ -52,6 +64,29 @@ private:
     size_t _batchMarker;
     IceInternal::UniquePtr<Ice::LocalException> _exception;
     size_t _maxSize;
+
+    //
+    // With the time-based auto flush, the batch is flushed at the latest
+    // _flushDelay after its first request was queued. The queue doesn't
+    // keep a reference on the timer task, which references the queue and
+    // the proxy: the task checks _flushDeadline when it runs and is
+    // released by the timer. If the task runs while a request is being
+    // added to the batch, the batch is flushed by finishBatchRequest.
+    //
+    IceUtil::TimerPtr _timer;
+    IceUtil::Time _flushDelay;
+    IceUtil::Time _flushDeadline;
+    bool _flushScheduled;
+
+    //
+    // With the adaptive auto flush, the batch is flushed when it reaches
+    // _flushSize, which varies between _minFlushSize and _maxSize depending
+    // on whether the previous flushes could be sent right away.
+    //
+    bool _adaptive;
+    size_t _minFlushSize;
+    size_t _flushSize;
+    int _pendingFlushes;
 };
 
 };
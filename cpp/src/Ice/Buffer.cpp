@@ -3,6 +3,7 @@
 //
 
 #include <Ice/Buffer.h>
+#include <Ice/BufferPool.h>
 #include <Ice/LocalException.h>
 
 using namespace std;
@@ -16,6 +17,122 @@ IceInternal::Buffer::swapBuffer(Buffer& other)
     std::swap(i, other.i);
 }
 
+size_t
+IceInternal::Buffer::segmentsSize(size_t offset) const
+{
+    const BufferSegments* s = b.segments();
+    if(!s)
+    {
+        return 0;
+    }
+
+    size_t sz = 0;
+    for(vector<BufferSegment>::const_reverse_iterator p = s->segments.rbegin();
+        p != s->segments.rend() && p->offset >= offset; ++p)
+    {
+        sz += static_cast<size_t>(p->end - p->begin);
+    }
+    return sz;
+}
+
+size_t
+IceInternal::Buffer::position() const
+{
+    size_t offset = static_cast<size_t>(i - b.begin());
+    const BufferSegments* s = b.segments();
+    if(!s)
+    {
+        return offset;
+    }
+
+    size_t pos = offset;
+    for(vector<BufferSegment>::const_iterator p = s->segments.begin();
+        p != s->segments.end() && p->offset <= offset; ++p)
+    {
+        pos += p->offset < offset ? static_cast<size_t>(p->end - p->begin) : s->segmentPos;
+    }
+    return pos;
+}
+
+void
+IceInternal::Buffer::advance(size_t n)
+{
+    BufferSegments* s = b.segments();
+    if(!s)
+    {
+        i += n;
+        return;
+    }
+
+    size_t offset = static_cast<size_t>(i - b.begin());
+    vector<BufferSegment>::const_iterator p = s->segments.begin();
+    while(p != s->segments.end() && p->offset < offset)
+    {
+        ++p;
+    }
+
+    while(n > 0)
+    {
+        if(p != s->segments.end() && p->offset == offset)
+        {
+            //
+            // Consume the segment at the current position.
+            //
+            size_t sz = min(n, static_cast<size_t>(p->end - p->begin) - s->segmentPos);
+            s->segmentPos += sz;
+            n -= sz;
+            if(s->segmentPos == static_cast<size_t>(p->end - p->begin))
+            {
+                ++p;
+            }
+        }
+        else
+        {
+            //
+            // Consume the bytes of b up to the next segment.
+            //
+            size_t next = p != s->segments.end() ? p->offset : b.size();
+            size_t sz = min(n, next - offset);
+            assert(sz > 0);
+            i += sz;
+            offset += sz;
+            n -= sz;
+            s->segmentPos = 0;
+        }
+    }
+}
+
+void
+IceInternal::Buffer::copySegments()
+{
+    if(!b.segments())
+    {
+        return;
+    }
+
+    size_t pos = position();
+    size_t sz = b.size() + segmentsSize();
+
+    //
+    // Adopt the memory of b and its segments, b keeps its pool to allocate
+    // the new memory.
+    //
+    Container c(b, true);
+    const BufferSegments* s = c.segments();
+    b.resize(sz);
+    Container::iterator q = b.begin();
+    size_t offset = 0;
+    for(vector<BufferSegment>::const_iterator p = s->segments.begin(); p != s->segments.end(); ++p)
+    {
+        q = copy(c.begin() + offset, c.begin() + p->offset, q);
+        q = copy(p->begin, p->end, q);
+        offset = p->offset;
+    }
+    copy(c.begin() + offset, c.end(), q);
+
+    i = b.begin() + pos;
+}
+
 IceInternal::Buffer::Container::Container() :
     _buf(0),
     _size(0),
@@ -63,7 +180,10 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
         _shrinkCounter = other._shrinkCounter;
         _owned = other._owned;
 
-        other._buf = 0;
+        //
+        // The other container keeps its pool for its next allocations.
+        //
+        other._buf = _owned && _buf ? BufferPool::allocate(BufferPool::getPool(_buf), 0) : 0;
         other._size = 0;
         other._capacity = 0;
         other._shrinkCounter = 0;
@@ -81,10 +201,7 @@ IceInternal::Buffer::Container::Container(Container& other, bool adopt)
 
 IceInternal::Buffer::Container::~Container()
 {
-    if(_buf && _owned)
-    {
-        ::free(_buf);
-    }
+    release();
 }
 
 void
@@ -100,56 +217,124 @@ IceInternal::Buffer::Container::swap(Container& other)
 void
 IceInternal::Buffer::Container::clear()
 {
-    if(_buf && _owned)
-    {
-        ::free(_buf);
-    }
+    //
+    // Keep the pool of the memory, if any, for the next allocations.
+    //
+    pointer p = _owned && _buf ? BufferPool::allocate(BufferPool::getPool(_buf), 0) : 0;
+    release();
 
-    _buf = 0;
+    _buf = p;
     _size = 0;
     _capacity = 0;
     _shrinkCounter = 0;
     _owned = true;
 }
 
+void
+IceInternal::Buffer::Container::setPool(BufferPool* pool)
+{
+    if(pool && _owned && _capacity == 0)
+    {
+        pointer p = BufferPool::allocate(pool, 0);
+        release();
+        _buf = p;
+    }
+}
+
+BufferSegments*
+IceInternal::Buffer::Container::segments() const
+{
+    //
+    // Only owned memory blocks have a header, the empty block of a pool
+    // (with a capacity of 0) never references segments.
+    //
+    return _owned && _capacity > 0 ? BufferPool::getSegments(_buf) : 0;
+}
+
+void
+IceInternal::Buffer::Container::setSegments(BufferSegments* segments)
+{
+    assert(_owned && _capacity > 0);
+    delete BufferPool::getSegments(_buf);
+    BufferPool::setSegments(_buf, segments);
+}
+
 void
 IceInternal::Buffer::Container::reserve(size_type n)
 {
-    size_type c = _capacity;
+    size_type capacity;
     if(n > _capacity)
     {
-        _capacity = std::max<size_type>(n, 2 * _capacity);
-        _capacity = std::max<size_type>(static_cast<size_type>(240), _capacity);
+        capacity = std::max<size_type>(n, 2 * _capacity);
+        capacity = std::max<size_type>(static_cast<size_type>(240), capacity);
     }
     else if(n < _capacity)
     {
-        _capacity = n;
+        capacity = n;
     }
     else
     {
         return;
     }
 
+    BufferPool* pool = _owned && _buf ? BufferPool::getPool(_buf) : 0;
+    if(pool)
+    {
+        //
+        // Round up the capacity to the size of the pool blocks, the
+        // buffer is only reallocated if it moves to another size class.
+        //
+        capacity = BufferPool::capacity(capacity);
+        if(capacity == _capacity)
+        {
+            return;
+        }
+    }
+
     pointer p;
-    if(_owned)
+    if(_owned && _capacity > 0 && (!pool || (_capacity > BufferPool::maxBlockSize &&
+                                             capacity > BufferPool::maxBlockSize)))
     {
-        p = reinterpret_cast<pointer>(::realloc(_buf, _capacity));
+        p = BufferPool::reallocate(_buf, capacity);
+        if(!p)
+        {
+            throw std::bad_alloc();
+        }
     }
     else
     {
-        p = reinterpret_cast<pointer>(::malloc(_capacity));
-        if(p)
+        p = BufferPool::allocate(pool, capacity);
+        if(!p)
         {
-            ::memcpy(p, _buf, _size);
-            _owned = true;
+            throw std::bad_alloc();
+        }
+        if(_buf)
+        {
+            ::memcpy(p, _buf, std::min(_size, capacity));
         }
-    }
 
-    if(!p)
-    {
-        _capacity = c; // Restore the previous capacity.
-        throw std::bad_alloc();
+        //
+        // The segments, if any, move to the new memory block.
+        //
+        BufferSegments* s = segments();
+        if(s)
+        {
+            BufferPool::setSegments(_buf, 0);
+            BufferPool::setSegments(p, s);
+        }
+        release();
+        _owned = true;
     }
 
     _buf = p;
+    _capacity = capacity;
+}
+
+void
+IceInternal::Buffer::Container::release()
+{
+    if(_buf && _owned)
+    {
+        BufferPool::deallocate(_buf, _capacity);
+    }
 }
@@ -0,0 +1,250 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/BufferPool.h>
+#include <Ice/InstrumentationI.h>
+
+using namespace std;
+using namespace Ice;
+using namespace Ice::Instrumentation;
+using namespace IceInternal;
+
+IceUtil::Shared* IceInternal::upCast(BufferPool* p) { return p; }
+
+namespace
+{
+
+//
+// The size of the header of the blocks, it preserves the alignment of the
+// memory returned by malloc.
+//
+const size_t headerSize = 2 * sizeof(IceUtil::Int64);
+
+struct BlockHeader
+{
+    BufferPool* pool;
+    BufferSegments* segments;
+};
+
+inline BlockHeader*
+getHeader(Byte* block)
+{
+    return reinterpret_cast<BlockHeader*>(block - headerSize);
+}
+
+size_t
+getSizeClass(size_t sz)
+{
+    assert(sz <= BufferPool::maxBlockSize);
+    size_t index = 0;
+    while((BufferPool::minBlockSize << index) < sz)
+    {
+        ++index;
+    }
+    return index;
+}
+
+}
+
+IceInternal::BufferPool::BufferPool(size_t maxCached)
+{
+    for(size_t i = 0; i < sizeClassCount; ++i)
+    {
+        _sizeClasses[i].blocks.reserve(maxCached);
+        _sizeClasses[i].maxBlocks = maxCached;
+    }
+    reinterpret_cast<BlockHeader*>(_emptyBlock)->pool = this;
+    reinterpret_cast<BlockHeader*>(_emptyBlock)->segments = 0;
+}
+
+size_t
+IceInternal::BufferPool::capacity(size_t sz)
+{
+    if(sz > maxBlockSize)
+    {
+        return sz;
+    }
+    return minBlockSize << getSizeClass(sz);
+}
+
+Byte*
+IceInternal::BufferPool::allocate(BufferPool* pool, size_t sz)
+{
+    Byte* block;
+    if(!pool)
+    {
+        if(sz == 0)
+        {
+            return 0;
+        }
+        block = reinterpret_cast<Byte*>(::malloc(headerSize + sz));
+    }
+    else if(sz == 0)
+    {
+        block = reinterpret_cast<Byte*>(pool->_emptyBlock);
+    }
+    else if(sz <= maxBlockSize)
+    {
+        block = pool->allocateBlock(sz);
+    }
+    else
+    {
+        block = reinterpret_cast<Byte*>(::malloc(headerSize + sz));
+    }
+
+    if(!block)
+    {
+        return 0;
+    }
+
+    if(pool)
+    {
+        pool->__incRef();
+    }
+    if(sz > 0)
+    {
+        reinterpret_cast<BlockHeader*>(block)->pool = pool;
+        reinterpret_cast<BlockHeader*>(block)->segments = 0;
+    }
+    return block + headerSize;
+}
+
+Byte*
+IceInternal::BufferPool::reallocate(Byte* p, size_t sz)
+{
+    assert(sz > maxBlockSize || !getPool(p));
+    Byte* block = reinterpret_cast<Byte*>(::realloc(p - headerSize, headerSize + sz));
+    return block ? block + headerSize : 0;
+}
+
+void
+IceInternal::BufferPool::deallocate(Byte* p, size_t sz)
+{
+    BlockHeader* header = getHeader(p);
+    delete header->segments;
+
+    BufferPool* pool = header->pool;
+    if(!pool)
+    {
+        ::free(p - headerSize);
+        return;
+    }
+
+    if(sz > maxBlockSize)
+    {
+        ::free(p - headerSize);
+    }
+    else if(sz > 0)
+    {
+        pool->deallocateBlock(p - headerSize, sz);
+    }
+    pool->__decRef();
+}
+
+BufferPool*
+IceInternal::BufferPool::getPool(const Byte* p)
+{
+    return getHeader(const_cast<Byte*>(p))->pool;
+}
+
+BufferSegments*
+IceInternal::BufferPool::getSegments(const Byte* p)
+{
+    return getHeader(const_cast<Byte*>(p))->segments;
+}
+
+void
+IceInternal::BufferPool::setSegments(Byte* p, BufferSegments* segments)
+{
+    getHeader(p)->segments = segments;
+}
+
+Byte*
+IceInternal::BufferPool::allocateBlock(size_t sz)
+{
+    SizeClass& sizeClass = _sizeClasses[getSizeClass(sz)];
+    assert((minBlockSize << getSizeClass(sz)) == sz);
+
+    Byte* block = 0;
+    ObserverPtr observer;
+    {
+        IceUtil::Mutex::Lock sync(sizeClass.mutex);
+        if(!sizeClass.blocks.empty())
+        {
+            block = sizeClass.blocks.back();
+            sizeClass.blocks.pop_back();
+        }
+        observer = sizeClass.observer.get();
+    }
+
+    if(observer)
+    {
+        BufferPoolObserverI* o = dynamic_cast<BufferPoolObserverI*>(observer.get());
+        if(o)
+        {
+            o->allocated(block != 0);
+        }
+    }
+
+    if(!block)
+    {
+        block = reinterpret_cast<Byte*>(::malloc(headerSize + sz));
+    }
+    return block;
+}
+
+void
+IceInternal::BufferPool::deallocateBlock(Byte* block, size_t sz)
+{
+    SizeClass& sizeClass = _sizeClasses[getSizeClass(sz)];
+    {
+        IceUtil::Mutex::Lock sync(sizeClass.mutex);
+        if(sizeClass.blocks.size() < sizeClass.maxBlocks)
+        {
+            sizeClass.blocks.push_back(block);
+            return;
+        }
+    }
+    ::free(block);
+}
+
+void
+IceInternal::BufferPool::updateObservers(const CommunicatorObserverPtr& obsv)
+{
+    CommunicatorObserverI* observer = dynamic_cast<CommunicatorObserverI*>(obsv.get());
+    for(size_t i = 0; i < sizeClassCount; ++i)
+    {
+        SizeClass& sizeClass = _sizeClasses[i];
+        IceUtil::Mutex::Lock sync(sizeClass.mutex);
+        if(observer)
+        {
+            sizeClass.observer.attach(observer->getBufferPoolObserver(minBlockSize << i, sizeClass.observer.get()));
+        }
+        else
+        {
+            sizeClass.observer.detach();
+        }
+    }
+}
+
+void
+IceInternal::BufferPool::destroy()
+{
+    //
+    // Release the cached blocks, the blocks of the buffers which are still
+    // in use are released when the buffers are destroyed.
+    //
+    for(size_t i = 0; i < sizeClassCount; ++i)
+    {
+        SizeClass& sizeClass = _sizeClasses[i];
+        IceUtil::Mutex::Lock sync(sizeClass.mutex);
+        for(vector<Byte*>::const_iterator p = sizeClass.blocks.begin(); p != sizeClass.blocks.end(); ++p)
+        {
+            ::free(*p);
+        }
+        sizeClass.blocks.clear();
+        sizeClass.maxBlocks = 0;
+        sizeClass.observer.detach();
+    }
+}
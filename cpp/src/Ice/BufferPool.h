@@ -0,0 +1,113 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_BUFFER_POOL_H
+#define ICE_BUFFER_POOL_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Mutex.h>
+#include <Ice/BufferPoolF.h>
+#include <Ice/Buffer.h>
+#include <Ice/ObserverHelper.h>
+
+namespace IceInternal
+{
+
+//
+// Data referenced by a stream buffer rather than copied into it. A segment
+// is logically inserted before the byte at the given offset of the buffer
+// and it's always followed by at least one byte of the buffer, so the buffer
+// is fully consumed once its position reaches the end of the buffer.
+//
+struct BufferSegment
+{
+    size_t offset;
+    const Ice::Byte* begin;
+    const Ice::Byte* end;
+};
+
+//
+// The segments of a stream buffer, see OutputStream::setZeroCopySize. They
+// are stored in the header of the memory block of the buffer rather than in
+// the buffer itself, so they follow the memory when buffers are swapped and
+// are deleted with the block.
+//
+class BufferSegments
+{
+public:
+
+    BufferSegments(size_t sz) : zeroCopySize(sz), segmentPos(0)
+    {
+    }
+
+    const size_t zeroCopySize; // Byte sequences of at least this size are referenced.
+    std::vector<BufferSegment> segments;
+    size_t segmentPos; // The number of bytes consumed of the segment at the buffer position.
+};
+
+//
+// The pool of the memory blocks of the stream buffers of a communicator.
+// The blocks are grouped in size classes, the powers of 2 from 256 bytes
+// to 64KB, and each class caches up to Ice.BufferPool.MaxCached free
+// blocks. Larger buffers are allocated with malloc.
+//
+class BufferPool : public IceUtil::Shared
+{
+public:
+
+    static const size_t minBlockSize = 256;
+    static const size_t maxBlockSize = 64 * 1024;
+
+    BufferPool(size_t);
+
+    //
+    // Returns the capacity of a buffer of the given size: the size of its
+    // size class, or the given size if it's larger than maxBlockSize.
+    //
+    static size_t capacity(size_t);
+
+    //
+    // The memory of the stream buffers is allocated in blocks which start
+    // with a header referencing the pool of the buffer, if any, so that the
+    // pool doesn't need to be stored with the buffer. A buffer without
+    // memory references the empty block of its pool, which has a capacity
+    // of 0. Blocks hold a reference on their pool. The header also holds
+    // the segments of the buffer, if any, which are deleted with the block.
+    //
+    // allocate() returns 0 if the memory can't be allocated, reallocate()
+    // can only be used with blocks which aren't allocated from a size
+    // class and for sizes which don't fit in a size class.
+    //
+    static Ice::Byte* allocate(BufferPool*, size_t);
+    static Ice::Byte* reallocate(Ice::Byte*, size_t);
+    static void deallocate(Ice::Byte*, size_t);
+    static BufferPool* getPool(const Ice::Byte*);
+    static BufferSegments* getSegments(const Ice::Byte*);
+    static void setSegments(Ice::Byte*, BufferSegments*);
+
+    void updateObservers(const Ice::Instrumentation::CommunicatorObserverPtr&);
+    void destroy();
+
+private:
+
+    Ice::Byte* allocateBlock(size_t);
+    void deallocateBlock(Ice::Byte*, size_t);
+
+    static const size_t sizeClassCount = 9;
+
+    struct SizeClass
+    {
+        IceUtil::Mutex mutex;
+        std::vector<Ice::Byte*> blocks;
+        size_t maxBlocks;
+        ObserverHelperT<> observer;
+    };
+
+    SizeClass _sizeClasses[sizeClassCount];
+    IceUtil::Int64 _emptyBlock[2];
+};
+
+}
+
+#endif
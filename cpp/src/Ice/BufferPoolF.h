@@ -0,0 +1,19 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_BUFFER_POOL_F_H
+#define ICE_BUFFER_POOL_F_H
+
+#include <Ice/Handle.h>
+
+namespace IceInternal
+{
+
+class BufferPool;
+IceUtil::Shared* upCast(BufferPool*);
+typedef Handle<BufferPool> BufferPoolPtr;
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 
 #include <Ice/CollocatedRequestHandler.h>
 #include <Ice/ObjectAdapterI.h>
+#include <Ice/ServantManager.h>
 #include <Ice/ThreadPool.h>
 #include <Ice/Reference.h>
 #include <Ice/Instance.h>
@@ -161,6 +162,12 @@ CollocatedRequestHandler::invokeAsyncRequest(OutgoingAsyncBase* outAsync, int ba
          throw;
     }
 
+    //
+    // The request is dispatched from a contiguous buffer, possibly after the
+    // invocation returned if it's canceled: copy the referenced bytes now.
+    //
+    outAsync->getOs()->copySegments();
+
     outAsync->attachCollocatedObserver(_adapter, requestId);
 
     if(!synchronous || !_response || _reference->getInvocationTimeout() > 0)
@@ -365,6 +372,56 @@ CollocatedRequestHandler::invokeAll(OutputStream* os, Int requestId, Int batchRe
     _adapter->decDirectCount();
 }
 
+#ifdef ICE_CPP11_MAPPING
+ObjectPtr
+CollocatedRequestHandler::startDirectDispatch(Current& current)
+{
+    //
+    // The direct dispatch bypasses the marshaling of the request: it's not used if the
+    // dispatch must be done by the dispatcher or if the request must be traced.
+    //
+    if(_dispatcher || _traceLevels->protocol >= 1 || !_response)
+    {
+        return nullptr;
+    }
+
+    //
+    // Increase the direct count for the duration of the dispatch. This will throw if the
+    // object adapter has been deactivated, in which case the invocation falls back to the
+    // regular collocated invocation which reports the exception.
+    //
+    try
+    {
+        _adapter->incDirectCount();
+    }
+    catch(const LocalException&)
+    {
+        return nullptr;
+    }
+
+    //
+    // Only servants registered with the servant manager are dispatched directly: the
+    // dispatch of a request to a servant locator requires the regular incoming request.
+    //
+    ObjectPtr servant = _adapter->getServantManager()->findServant(_reference->getIdentity(),
+                                                                   _reference->getFacet());
+    if(!servant)
+    {
+        _adapter->decDirectCount();
+        return nullptr;
+    }
+
+    current.adapter = _adapter;
+    current.id = _reference->getIdentity();
+    current.facet = _reference->getFacet();
+    {
+        Lock sync(*this);
+        current.requestId = ++_requestId;
+    }
+    return servant;
+}
+#endif
+
 void
 CollocatedRequestHandler::handleException(int requestId, const Exception& ex, bool amd)
 {
@@ -61,6 +61,8 @@ public:
     void invokeAll(Ice::OutputStream*, Ice::Int, Ice::Int);
 
 #ifdef ICE_CPP11_MAPPING
+    Ice::ObjectPtr startDirectDispatch(Ice::Current&);
+
     std::shared_ptr<CollocatedRequestHandler> shared_from_this()
     {
         return std::static_pointer_cast<CollocatedRequestHandler>(ResponseHandler::shared_from_this());
@@ -0,0 +1,367 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/CompressionCodec.h>
+#include <Ice/LocalException.h>
+#include <IceUtil/StringUtil.h>
+
+#ifdef ICE_HAS_BZIP2
+#  include <bzlib.h>
+#endif
+
+#ifdef ICE_HAS_ZLIB
+#  include <zlib.h>
+#endif
+
+#ifdef ICE_HAS_LZ4
+#  include <lz4.h>
+#endif
+
+#ifdef ICE_HAS_ZSTD
+#  include <zstd.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IceInternal;
+
+namespace
+{
+
+#ifdef ICE_HAS_BZIP2
+string
+getBZ2Error(int bzError)
+{
+    if(bzError == BZ_RUN_OK)
+    {
+        return ": BZ_RUN_OK";
+    }
+    else if(bzError == BZ_FLUSH_OK)
+    {
+        return ": BZ_FLUSH_OK";
+    }
+    else if(bzError == BZ_FINISH_OK)
+    {
+        return ": BZ_FINISH_OK";
+    }
+    else if(bzError == BZ_STREAM_END)
+    {
+        return ": BZ_STREAM_END";
+    }
+    else if(bzError == BZ_CONFIG_ERROR)
+    {
+        return ": BZ_CONFIG_ERROR";
+    }
+    else if(bzError == BZ_SEQUENCE_ERROR)
+    {
+        return ": BZ_SEQUENCE_ERROR";
+    }
+    else if(bzError == BZ_PARAM_ERROR)
+    {
+        return ": BZ_PARAM_ERROR";
+    }
+    else if(bzError == BZ_MEM_ERROR)
+    {
+        return ": BZ_MEM_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR)
+    {
+        return ": BZ_DATA_ERROR";
+    }
+    else if(bzError == BZ_DATA_ERROR_MAGIC)
+    {
+        return ": BZ_DATA_ERROR_MAGIC";
+    }
+    else if(bzError == BZ_IO_ERROR)
+    {
+        return ": BZ_IO_ERROR";
+    }
+    else if(bzError == BZ_UNEXPECTED_EOF)
+    {
+        return ": BZ_UNEXPECTED_EOF";
+    }
+    else if(bzError == BZ_OUTBUFF_FULL)
+    {
+        return ": BZ_OUTBUFF_FULL";
+    }
+    else
+    {
+        return "";
+    }
+}
+
+class BZip2Codec : public CompressionCodec
+{
+public:
+
+    virtual Byte
+    id() const
+    {
+        return compressionBZip2;
+    }
+
+    virtual string
+    name() const
+    {
+        return "bzip2";
+    }
+
+    virtual size_t
+    maxCompressedSize(size_t sz) const
+    {
+        return static_cast<size_t>(sz * 1.01 + 600);
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen, int level) const
+    {
+        unsigned int compressedLen = static_cast<unsigned int>(dstLen);
+        int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(dst), &compressedLen,
+                                               reinterpret_cast<char*>(const_cast<Byte*>(src)),
+                                               static_cast<unsigned int>(srcLen), level, 0, 0);
+        if(bzError != BZ_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError));
+        }
+        return compressedLen;
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen) const
+    {
+        unsigned int uncompressedLen = static_cast<unsigned int>(dstLen);
+        int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(dst), &uncompressedLen,
+                                                 reinterpret_cast<char*>(const_cast<Byte*>(src)),
+                                                 static_cast<unsigned int>(srcLen), 0, 0);
+        if(bzError != BZ_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffDecompress failed" + getBZ2Error(bzError));
+        }
+    }
+};
+#endif
+
+#ifdef ICE_HAS_ZLIB
+class ZlibCodec : public CompressionCodec
+{
+public:
+
+    virtual Byte
+    id() const
+    {
+        return compressionZlib;
+    }
+
+    virtual string
+    name() const
+    {
+        return "zlib";
+    }
+
+    virtual size_t
+    maxCompressedSize(size_t sz) const
+    {
+        return static_cast<size_t>(compressBound(static_cast<uLong>(sz)));
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen, int level) const
+    {
+        uLongf compressedLen = static_cast<uLongf>(dstLen);
+        int err = compress2(dst, &compressedLen, src, static_cast<uLong>(srcLen), level);
+        if(err != Z_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, string("compress2 failed: ") + zError(err));
+        }
+        return compressedLen;
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen) const
+    {
+        uLongf uncompressedLen = static_cast<uLongf>(dstLen);
+        int err = ::uncompress(dst, &uncompressedLen, src, static_cast<uLong>(srcLen));
+        if(err != Z_OK)
+        {
+            throw CompressionException(__FILE__, __LINE__, string("uncompress failed: ") + zError(err));
+        }
+        if(uncompressedLen != dstLen)
+        {
+            throw CompressionException(__FILE__, __LINE__, "uncompress failed: unexpected uncompressed size");
+        }
+    }
+};
+#endif
+
+#ifdef ICE_HAS_LZ4
+class LZ4Codec : public CompressionCodec
+{
+public:
+
+    virtual Byte
+    id() const
+    {
+        return compressionLZ4;
+    }
+
+    virtual string
+    name() const
+    {
+        return "lz4";
+    }
+
+    virtual size_t
+    maxCompressedSize(size_t sz) const
+    {
+        return static_cast<size_t>(LZ4_compressBound(static_cast<int>(sz)));
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen, int) const
+    {
+        //
+        // The compression level is ignored, LZ4 is used with its default acceleration.
+        //
+        int compressedLen = LZ4_compress_default(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                                 static_cast<int>(srcLen), static_cast<int>(dstLen));
+        if(compressedLen <= 0)
+        {
+            throw CompressionException(__FILE__, __LINE__, "LZ4_compress_default failed");
+        }
+        return static_cast<size_t>(compressedLen);
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen) const
+    {
+        int uncompressedLen = LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+                                                  static_cast<int>(srcLen), static_cast<int>(dstLen));
+        if(uncompressedLen < 0 || static_cast<size_t>(uncompressedLen) != dstLen)
+        {
+            throw CompressionException(__FILE__, __LINE__, "LZ4_decompress_safe failed");
+        }
+    }
+};
+#endif
+
+#ifdef ICE_HAS_ZSTD
+class ZstdCodec : public CompressionCodec
+{
+public:
+
+    virtual Byte
+    id() const
+    {
+        return compressionZstd;
+    }
+
+    virtual string
+    name() const
+    {
+        return "zstd";
+    }
+
+    virtual size_t
+    maxCompressedSize(size_t sz) const
+    {
+        return ZSTD_compressBound(sz);
+    }
+
+    virtual size_t
+    compress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen, int level) const
+    {
+        size_t compressedLen = ZSTD_compress(dst, dstLen, src, srcLen, level);
+        if(ZSTD_isError(compressedLen))
+        {
+            throw CompressionException(__FILE__, __LINE__,
+                                       string("ZSTD_compress failed: ") + ZSTD_getErrorName(compressedLen));
+        }
+        return compressedLen;
+    }
+
+    virtual void
+    uncompress(const Byte* src, size_t srcLen, Byte* dst, size_t dstLen) const
+    {
+        size_t uncompressedLen = ZSTD_decompress(dst, dstLen, src, srcLen);
+        if(ZSTD_isError(uncompressedLen))
+        {
+            throw CompressionException(__FILE__, __LINE__,
+                                       string("ZSTD_decompress failed: ") + ZSTD_getErrorName(uncompressedLen));
+        }
+        if(uncompressedLen != dstLen)
+        {
+            throw CompressionException(__FILE__, __LINE__, "ZSTD_decompress failed: unexpected uncompressed size");
+        }
+    }
+};
+#endif
+
+//
+// The codecs are stateless, a single instance of each codec supported
+// by this build is shared by all the connections.
+//
+class CodecTable
+{
+public:
+
+    CodecTable() : supported(0)
+    {
+#ifdef ICE_HAS_BZIP2
+        add(new BZip2Codec);
+#endif
+#ifdef ICE_HAS_ZLIB
+        add(new ZlibCodec);
+#endif
+#ifdef ICE_HAS_LZ4
+        add(new LZ4Codec);
+#endif
+#ifdef ICE_HAS_ZSTD
+        add(new ZstdCodec);
+#endif
+    }
+
+    CompressionCodecPtr codecs[compressionZstd + 1];
+    Byte supported;
+
+private:
+
+    void
+    add(const CompressionCodecPtr& codec)
+    {
+        codecs[codec->id()] = codec;
+        supported = static_cast<Byte>(supported | compressionCodecMask(codec->id()));
+    }
+};
+const CodecTable codecTable;
+
+}
+
+CompressionCodecPtr
+IceInternal::getCompressionCodec(Byte id)
+{
+    if(id < compressionBZip2 || id > compressionZstd)
+    {
+        return 0;
+    }
+    return codecTable.codecs[id];
+}
+
+CompressionCodecPtr
+IceInternal::getCompressionCodec(const string& name)
+{
+    for(Byte id = compressionBZip2; id <= compressionZstd; ++id)
+    {
+        if(codecTable.codecs[id] && IceUtilInternal::toLower(name) == codecTable.codecs[id]->name())
+        {
+            return codecTable.codecs[id];
+        }
+    }
+    return 0;
+}
+
+Byte
+IceInternal::getSupportedCompressionCodecs()
+{
+    return codecTable.supported;
+}
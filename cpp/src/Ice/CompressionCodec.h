@@ -0,0 +1,88 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_COMPRESSION_CODEC_H
+#define ICE_COMPRESSION_CODEC_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <Ice/Config.h>
+#include <string>
+
+#if !defined(ICE_OS_UWP)
+#    ifndef ICE_HAS_BZIP2
+#        define ICE_HAS_BZIP2
+#    endif
+#endif
+
+namespace IceInternal
+{
+
+//
+// Compression status values, written in the message header. Status 2 is
+// the bzip2 compression defined by the Ice protocol, the other codecs
+// are only used with peers that advertise support for them during
+// connection validation.
+//
+const Ice::Byte compressionBZip2 = 2;
+const Ice::Byte compressionZlib = 3;
+const Ice::Byte compressionLZ4 = 4;
+const Ice::Byte compressionZstd = 5;
+
+class CompressionCodec : public IceUtil::Shared
+{
+public:
+
+    //
+    // The compression status written in the header of messages
+    // compressed with this codec.
+    //
+    virtual Ice::Byte id() const = 0;
+
+    virtual std::string name() const = 0;
+
+    //
+    // Returns the size of the largest buffer produced by compress() for
+    // an input of the given size.
+    //
+    virtual size_t maxCompressedSize(size_t) const = 0;
+
+    //
+    // Compress the given input into the output buffer and return the
+    // number of bytes written. The level is in the range 1-9, it's used
+    // as is by the bzip2, zlib and Zstandard codecs and ignored by LZ4.
+    //
+    virtual size_t compress(const Ice::Byte*, size_t, Ice::Byte*, size_t, int) const = 0;
+
+    //
+    // Uncompress the given input into the output buffer, which must be
+    // filled entirely.
+    //
+    virtual void uncompress(const Ice::Byte*, size_t, Ice::Byte*, size_t) const = 0;
+};
+typedef IceUtil::Handle<CompressionCodec> CompressionCodecPtr;
+
+//
+// Returns the codec for the given compression status or name, or a
+// null handle if the codec isn't supported by this build.
+//
+CompressionCodecPtr getCompressionCodec(Ice::Byte);
+CompressionCodecPtr getCompressionCodec(const std::string&);
+
+//
+// Returns the mask of the codecs supported by this build, as advertised
+// in the compression status of the validate connection message: bit N
+// is set if the codec with compression status N + 2 is supported.
+//
+Ice::Byte getSupportedCompressionCodecs();
+
+inline Ice::Byte
+compressionCodecMask(Ice::Byte id)
+{
+    return static_cast<Ice::Byte>(1 << (id - compressionBZip2));
+}
+
+}
+
+#endif
@@ -114,6 +114,49 @@ find(const multimap<K,::IceInternal::Handle<V> >& m,
 }
 #endif
 
+//
+// Find the least loaded active connection of a connection pool. Null is
+// returned if all the active connections are busy and the pool isn't full
+// yet, to get the caller to establish a new connection. Connections that
+// are transferring a large message are considered busier than connections
+// with queued requests since a large message delays all the messages
+// queued after it.
+//
+template<typename Map> typename Map::mapped_type
+findLeastLoaded(const Map& m, const typename Map::key_type& k, int poolSize, size_t largeMessageSize)
+{
+    typename Map::mapped_type best;
+    size_t bestRequests = 0;
+    bool bestLarge = false;
+    int active = 0;
+    pair<typename Map::const_iterator, typename Map::const_iterator> pr = m.equal_range(k);
+    for(typename Map::const_iterator q = pr.first; q != pr.second; ++q)
+    {
+        if(!q->second->isActiveOrHolding())
+        {
+            continue;
+        }
+        ++active;
+
+        size_t requests;
+        size_t transferSize;
+        q->second->getPoolLoad(requests, transferSize);
+        bool large = largeMessageSize > 0 && transferSize >= largeMessageSize;
+        if(!best || (bestLarge && !large) || (bestLarge == large && requests < bestRequests))
+        {
+            best = q->second;
+            bestRequests = requests;
+            bestLarge = large;
+        }
+    }
+
+    if(best && (bestRequests > 0 || bestLarge) && active < poolSize)
+    {
+        return typename Map::mapped_type();
+    }
+    return best;
+}
+
 class StartAcceptor : public IceUtil::TimerTask
 #ifdef ICE_CPP11_MAPPING
                     , public std::enable_shared_from_this<StartAcceptor>
@@ -273,6 +316,7 @@ void
 IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpts,
                                                bool hasMore,
                                                Ice::EndpointSelectionType selType,
+                                               int poolSize,
                                                const CreateConnectionCallbackPtr& callback)
 {
     assert(!endpts.empty());
@@ -288,7 +332,7 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     try
     {
         bool compress;
-        Ice::ConnectionIPtr connection = findConnection(endpoints, compress);
+        Ice::ConnectionIPtr connection = findConnection(endpoints, poolSize, compress);
         if(connection)
         {
             callback->setConnection(connection, compress);
@@ -302,13 +346,66 @@ IceInternal::OutgoingConnectionFactory::create(const vector<EndpointIPtr>& endpt
     }
 
 #ifdef ICE_CPP11_MAPPING
-    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, hasMore, callback, selType);
+    auto cb = make_shared<ConnectCallback>(_instance, this, endpoints, hasMore, callback, selType, poolSize);
 #else
-    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, hasMore, callback, selType);
+    ConnectCallbackPtr cb = new ConnectCallback(_instance, this, endpoints, hasMore, callback, selType, poolSize);
 #endif
     cb->getConnectors();
 }
 
+Ice::Long
+IceInternal::OutgoingConnectionFactory::getCost(const EndpointIPtr& endpt, Ice::EndpointSelectionType selType)
+{
+    EndpointIPtr endpoint = endpt;
+    DefaultsAndOverridesPtr defaultsAndOverrides = _instance->defaultsAndOverrides();
+    if(defaultsAndOverrides->overrideTimeout)
+    {
+        endpoint = endpoint->timeout(defaultsAndOverrides->overrideTimeoutValue);
+    }
+
+    ConnectionIPtr connection;
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+        if(_destroyed)
+        {
+            throw CommunicatorDestroyedException(__FILE__, __LINE__);
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        connection = find(_connectionsByEndpoint, endpoint,
+                          [](const ConnectionIPtr& conn)
+                          {
+                              return conn->isActiveOrHolding();
+                          });
+#else
+        connection = find(_connectionsByEndpoint, endpoint, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+#endif
+    }
+
+    if(!connection)
+    {
+        return 0;
+    }
+
+    Ice::Long latency;
+    size_t outstanding;
+    connection->getLoad(latency, outstanding);
+    if(selType == ICE_ENUM(EndpointSelectionType, LeastOutstanding))
+    {
+        return static_cast<Ice::Long>(outstanding);
+    }
+    else
+    {
+        //
+        // Weight the latency with the outstanding requests so that a
+        // replica with queued requests is penalized before the smoothed
+        // round-trip time catches up.
+        //
+        assert(selType == ICE_ENUM(EndpointSelectionType, LeastLatency));
+        return latency * static_cast<Ice::Long>(outstanding + 1);
+    }
+}
+
 void
 IceInternal::OutgoingConnectionFactory::setRouterInfo(const RouterInfoPtr& routerInfo)
 {
@@ -451,7 +548,8 @@ IceInternal::OutgoingConnectionFactory::applyOverrides(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr>& endpoints, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr>& endpoints, int poolSize,
+                                                       bool& compress)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
     if(_destroyed)
@@ -463,15 +561,24 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
     assert(!endpoints.empty());
     for(vector<EndpointIPtr>::const_iterator p = endpoints.begin(); p != endpoints.end(); ++p)
     {
+        ConnectionIPtr connection;
+        if(poolSize > 1)
+        {
+            connection = findLeastLoaded(_connectionsByEndpoint, *p, poolSize,
+                                         _instance->connectionPoolLargeMessageSize());
+        }
+        else
+        {
 #ifdef ICE_CPP11_MAPPING
-        auto connection = find(_connectionsByEndpoint, *p,
-                               [](const ConnectionIPtr& conn)
-                               {
-                                   return conn->isActiveOrHolding();
-                               });
+            connection = find(_connectionsByEndpoint, *p,
+                              [](const ConnectionIPtr& conn)
+                              {
+                                  return conn->isActiveOrHolding();
+                              });
 #else
-        ConnectionIPtr connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+            connection = find(_connectionsByEndpoint, *p, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
 #endif
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -489,7 +596,8 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<EndpointIPtr
 }
 
 ConnectionIPtr
-IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, bool& compress)
+IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInfo>& connectors, int poolSize,
+                                                       bool& compress)
 {
     // This must be called with the mutex locked.
 
@@ -501,15 +609,24 @@ IceInternal::OutgoingConnectionFactory::findConnection(const vector<ConnectorInf
             continue;
         }
 
+        ConnectionIPtr connection;
+        if(poolSize > 1)
+        {
+            connection = findLeastLoaded(_connections, p->connector, poolSize,
+                                         _instance->connectionPoolLargeMessageSize());
+        }
+        else
+        {
 #ifdef ICE_CPP11_MAPPING
-        auto connection = find(_connections, p->connector,
-                               [](const ConnectionIPtr& conn)
-                               {
-                                   return conn->isActiveOrHolding();
-                               });
+            connection = find(_connections, p->connector,
+                              [](const ConnectionIPtr& conn)
+                              {
+                                  return conn->isActiveOrHolding();
+                              });
 #else
-        ConnectionIPtr connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
+            connection = find(_connections, p->connector, Ice::constMemFun(&ConnectionI::isActiveOrHolding));
 #endif
+        }
         if(connection)
         {
             if(defaultsAndOverrides->overrideCompress)
@@ -560,6 +677,7 @@ IceInternal::OutgoingConnectionFactory::decPendingConnectCount()
 
 ConnectionIPtr
 IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo>& connectors,
+                                                      int poolSize,
                                                       const ConnectCallbackPtr& cb,
                                                       bool& compress)
 {
@@ -597,7 +715,7 @@ IceInternal::OutgoingConnectionFactory::getConnection(const vector<ConnectorInfo
             //
             // Search for a matching connection. If we find one, we're done.
             //
-            Ice::ConnectionIPtr connection = findConnection(connectors, compress);
+            Ice::ConnectionIPtr connection = findConnection(connectors, poolSize, compress);
             if(connection)
             {
                 return connection;
@@ -928,13 +1046,15 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::ConnectCallback(const I
                                                                          const vector<EndpointIPtr>& endpoints,
                                                                          bool hasMore,
                                                                          const CreateConnectionCallbackPtr& cb,
-                                                                         Ice::EndpointSelectionType selType) :
+                                                                         Ice::EndpointSelectionType selType,
+                                                                         int poolSize) :
     _instance(instance),
     _factory(factory),
     _endpoints(endpoints),
     _hasMore(hasMore),
     _callback(cb),
-    _selType(selType)
+    _selType(selType),
+    _poolSize(poolSize)
 {
     _endpointsIter = _endpoints.begin();
 }
@@ -1063,7 +1183,7 @@ IceInternal::OutgoingConnectionFactory::ConnectCallback::getConnection()
         // connection.
         //
         bool compress;
-        Ice::ConnectionIPtr connection = _factory->getConnection(_connectors, ICE_SHARED_FROM_THIS, compress);
+        Ice::ConnectionIPtr connection = _factory->getConnection(_connectors, _poolSize, ICE_SHARED_FROM_THIS, compress);
         if(!connection)
         {
             //
@@ -58,7 +58,15 @@ public:
 
     void waitUntilFinished();
 
-    void create(const std::vector<EndpointIPtr>&, bool, Ice::EndpointSelectionType, const CreateConnectionCallbackPtr&);
+    void create(const std::vector<EndpointIPtr>&, bool, Ice::EndpointSelectionType, int,
+                const CreateConnectionCallbackPtr&);
+
+    //
+    // Get the cost of sending a request to the given endpoint with the
+    // given latency-aware endpoint selection, 0 if there's no connection
+    // to the endpoint.
+    //
+    Ice::Long getCost(const EndpointIPtr&, Ice::EndpointSelectionType);
     void setRouterInfo(const RouterInfoPtr&);
     void removeAdapter(const Ice::ObjectAdapterPtr&);
     void flushAsyncBatchRequests(const CommunicatorFlushBatchAsyncPtr&, Ice::CompressBatch);
@@ -91,7 +99,7 @@ private:
     public:
 
         ConnectCallback(const InstancePtr&, const OutgoingConnectionFactoryPtr&, const std::vector<EndpointIPtr>&, bool,
-                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType);
+                        const CreateConnectionCallbackPtr&, Ice::EndpointSelectionType, int);
 
         virtual void connectionStartCompleted(const Ice::ConnectionIPtr&);
         virtual void connectionStartFailed(const Ice::ConnectionIPtr&, const Ice::LocalException&);
@@ -124,6 +132,7 @@ private:
         const bool _hasMore;
         const CreateConnectionCallbackPtr _callback;
         const Ice::EndpointSelectionType _selType;
+        const int _poolSize;
         Ice::Instrumentation::ObserverPtr _observer;
         std::vector<EndpointIPtr>::const_iterator _endpointsIter;
         std::vector<ConnectorInfo> _connectors;
@@ -133,10 +142,10 @@ private:
     friend class ConnectCallback;
 
     std::vector<EndpointIPtr> applyOverrides(const std::vector<EndpointIPtr>&);
-    Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<EndpointIPtr>&, int, bool&);
     void incPendingConnectCount();
     void decPendingConnectCount();
-    Ice::ConnectionIPtr getConnection(const std::vector<ConnectorInfo>&, const ConnectCallbackPtr&, bool&);
+    Ice::ConnectionIPtr getConnection(const std::vector<ConnectorInfo>&, int, const ConnectCallbackPtr&, bool&);
     void finishGetConnection(const std::vector<ConnectorInfo>&, const ConnectorInfo&, const Ice::ConnectionIPtr&,
                              const ConnectCallbackPtr&);
     void finishGetConnection(const std::vector<ConnectorInfo>&, const Ice::LocalException&, const ConnectCallbackPtr&);
@@ -144,7 +153,7 @@ private:
     bool addToPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
     void removeFromPending(const ConnectCallbackPtr&, const std::vector<ConnectorInfo>&);
 
-    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, bool&);
+    Ice::ConnectionIPtr findConnection(const std::vector<ConnectorInfo>&, int, bool&);
     Ice::ConnectionIPtr createConnection(const TransceiverPtr&, const ConnectorInfo&);
 
     void handleException(const Ice::LocalException&, bool);
@@ -22,10 +22,8 @@
 #include <Ice/ReferenceFactory.h> // For createProxy().
 #include <Ice/ProxyFactory.h> // For createProxy().
 #include <Ice/BatchRequestQueue.h>
-
-#ifdef ICE_HAS_BZIP2
-#  include <bzlib.h>
-#endif
+#include <Ice/BufferPool.h> // For BufferSegments.
+#include <Ice/InstrumentationI.h> // For ConnectionObserverI.
 
 using namespace std;
 using namespace Ice;
@@ -226,7 +224,7 @@ ConnectionFlushBatchAsync::invoke(const string& operation, Ice::CompressBatch co
     }
 }
 
-Ice::ConnectionI::Observer::Observer() : _readStreamPos(0), _writeStreamPos(0)
+Ice::ConnectionI::Observer::Observer() : _readStreamPos(0), _writing(false), _writeStreamPos(0)
 {
 }
 
@@ -256,34 +254,56 @@ Ice::ConnectionI::Observer::finishRead(const Buffer& buf)
 void
 Ice::ConnectionI::Observer::startWrite(const Buffer& buf)
 {
-    if(_writeStreamPos)
+    //
+    // The positions include the bytes of the segments referenced by the
+    // buffer, see Buffer::position().
+    //
+    if(_writing)
     {
         assert(!buf.b.empty());
-        _observer->sentBytes(static_cast<int>(buf.i - _writeStreamPos));
+        _observer->sentBytes(static_cast<int>(buf.position() - _writeStreamPos));
     }
-    _writeStreamPos = buf.b.empty() ? 0 : buf.i;
+    _writing = !buf.b.empty();
+    _writeStreamPos = _writing ? buf.position() : 0;
 }
 
 void
 Ice::ConnectionI::Observer::finishWrite(const Buffer& buf)
 {
-    if(_writeStreamPos == 0)
+    if(!_writing)
     {
         return;
     }
-    if(buf.i > _writeStreamPos)
+    size_t pos = buf.position();
+    if(pos > _writeStreamPos)
     {
-        _observer->sentBytes(static_cast<int>(buf.i - _writeStreamPos));
+        _observer->sentBytes(static_cast<int>(pos - _writeStreamPos));
     }
+    _writing = false;
     _writeStreamPos = 0;
 }
 
+void
+Ice::ConnectionI::Observer::compressed(Int compressedSize, Int uncompressedSize, const IceUtil::Time& duration)
+{
+    //
+    // Compression metrics are only provided by the metrics observer, they
+    // aren't part of the ConnectionObserver interface.
+    //
+    ConnectionObserverI* observer = dynamic_cast<ConnectionObserverI*>(_observer.get());
+    if(observer)
+    {
+        observer->compressed(compressedSize, uncompressedSize, duration.toMicroSeconds());
+    }
+}
+
 void
 Ice::ConnectionI::Observer::attach(const Ice::Instrumentation::ConnectionObserverPtr& observer)
 {
     ObserverHelperT<Ice::Instrumentation::ConnectionObserver>::attach(observer);
     if(!observer)
     {
+        _writing = false;
         _writeStreamPos = 0;
         _readStreamPos = 0;
     }
@@ -321,6 +341,12 @@ Ice::ConnectionI::OutgoingMessage::adopt(OutputStream* str)
     assert(str);
     stream = new OutputStream(str->instance(), currentProtocolEncoding);
     stream->swap(*str);
+
+    //
+    // The adopted stream outlives the invocation, it can't reference the
+    // memory of the caller.
+    //
+    stream->copySegments();
     adopted = true;
 }
 
@@ -684,7 +710,7 @@ Ice::ConnectionI::monitor(const IceUtil::Time& now, const ACMConfig& acm)
 }
 
 AsyncStatus
-Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compress, bool response, int batchRequestNum)
+Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, Byte compress, bool response, int batchRequestNum)
 {
     OutputStream* os = out->getOs();
 
@@ -765,8 +791,11 @@ Ice::ConnectionI::sendAsyncRequest(const OutgoingAsyncBasePtr& out, bool compres
         //
         // Add to the async requests map.
         //
+        AsyncRequest request;
+        request.outAsync = out;
+        request.time = IceUtil::Time::now(IceUtil::Time::Monotonic);
         _asyncRequestsHint = _asyncRequests.insert(_asyncRequests.end(),
-                                                   pair<const Int, OutgoingAsyncBasePtr>(requestId, out));
+                                                   pair<const Int, AsyncRequest>(requestId, request));
     }
     return status;
 }
@@ -1207,7 +1236,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
             if(o->requestId)
             {
                 if(_asyncRequestsHint != _asyncRequests.end() &&
-                   _asyncRequestsHint->second == ICE_DYNAMIC_CAST(OutgoingAsync, outAsync))
+                   _asyncRequestsHint->second.outAsync == ICE_DYNAMIC_CAST(OutgoingAsync, outAsync))
                 {
                     _asyncRequests.erase(_asyncRequestsHint);
                     _asyncRequestsHint = _asyncRequests.end();
@@ -1226,10 +1255,20 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
             {
                 //
                 // If the request is being sent, don't remove it from the send streams,
-                // it will be removed once the sending is finished.
+                // it will be removed once the sending is finished. This is also the case
+                // for requests sent in fragments, the peer expects all the fragments.
                 //
-                if(o == _sendStreams.begin())
+                if(o == _sendStreams.begin() || o->fragmentId)
                 {
+                    //
+                    // The caller might release the memory referenced by the
+                    // request once it's notified of the cancellation. The
+                    // stream being sent is copied first, a fragment references
+                    // the memory of its message which is released when the
+                    // message adopts its stream.
+                    //
+                    _writeStream.copySegments();
+
                     o->canceled(true); // true = adopt the stream
                 }
                 else
@@ -1250,7 +1289,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
     {
         if(_asyncRequestsHint != _asyncRequests.end())
         {
-            if(_asyncRequestsHint->second == outAsync)
+            if(_asyncRequestsHint->second.outAsync == outAsync)
             {
                 if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
                 {
@@ -1258,6 +1297,11 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 }
                 else
                 {
+                    //
+                    // The time elapsed since the request was queued is a lower
+                    // bound of its round-trip time.
+                    //
+                    updateLatency(_asyncRequestsHint->second.time);
                     _asyncRequests.erase(_asyncRequestsHint);
                     _asyncRequestsHint = _asyncRequests.end();
                     if(outAsync->exception(ex))
@@ -1269,9 +1313,9 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
             }
         }
 
-        for(map<Int, OutgoingAsyncBasePtr>::iterator p = _asyncRequests.begin(); p != _asyncRequests.end(); ++p)
+        for(map<Int, AsyncRequest>::iterator p = _asyncRequests.begin(); p != _asyncRequests.end(); ++p)
         {
-            if(p->second.get() == outAsync.get())
+            if(p->second.outAsync.get() == outAsync.get())
             {
                 if(dynamic_cast<const Ice::ConnectionTimeoutException*>(&ex))
                 {
@@ -1280,6 +1324,7 @@ Ice::ConnectionI::asyncRequestCanceled(const OutgoingAsyncBasePtr& outAsync, con
                 else
                 {
                     assert(p != _asyncRequestsHint);
+                    updateLatency(p->second.time);
                     _asyncRequests.erase(p);
                     if(outAsync->exception(ex))
                     {
@@ -1315,7 +1360,7 @@ Ice::ConnectionI::sendResponse(Int, OutputStream* os, Byte compressFlag, bool /*
             _exception->ice_throw();
         }
 
-        OutgoingMessage message(os, compressFlag > 0);
+        OutgoingMessage message(os, compressFlag);
         sendMessage(message);
 
         if(_state == StateClosing && _dispatchCount == 0)
@@ -1409,6 +1454,32 @@ Ice::ConnectionI::connector() const
     return _connector; // No mutex protection necessary, _connector is immutable.
 }
 
+void
+Ice::ConnectionI::getLoad(Long& latency, size_t& outstanding) const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    latency = _latency;
+    outstanding = _asyncRequests.size();
+}
+
+void
+Ice::ConnectionI::getPoolLoad(size_t& requests, size_t& transferSize) const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    requests = _asyncRequests.size() + _sendStreams.size();
+    transferSize = 0;
+    if(!_sendStreams.empty())
+    {
+        const OutgoingMessage& message = _sendStreams.front();
+        transferSize = message.fragmentId ? message.stream->b.size() + message.stream->segmentsSize() :
+            _writeStream.b.size() + _writeStream.segmentsSize();
+    }
+    if(_state == StateActive && !_readHeader)
+    {
+        transferSize = max(transferSize, _readStream.b.size());
+    }
+}
+
 void
 Ice::ConnectionI::setAdapter(const ObjectAdapterPtr& adapter)
 {
@@ -1494,8 +1565,16 @@ Ice::ConnectionI::startAsync(SocketOperation operation)
 
             if(_transceiver->startWrite(_writeStream) && !_sendStreams.empty())
             {
+                //
                 // The whole message is written, assume it's sent now for at-most-once semantics.
-                _sendStreams.front().isSent = true;
+                // A message sent in fragments is only sent once its last fragment is written.
+                //
+                OutgoingMessage& message = _sendStreams.front();
+                if(!message.fragmentId ||
+                   message.fragmentOffset == message.stream->b.size() + message.stream->segmentsSize())
+                {
+                    message.isSent = true;
+                }
             }
         }
         else if(operation & SocketOperationRead)
@@ -1835,17 +1914,19 @@ Ice::ConnectionI::message(ThreadPoolCurrent& current)
         }
     }
 
-    if(!_dispatcher) // Optimization, call dispatch() directly if there's no dispatcher.
+    //
+    // Optimization, call dispatch() directly if there's no dispatcher. If the thread pool
+    // is configured with Mode=WorkStealing, the dispatch is queued with its executor.
+    //
+    if(!_dispatcher && !_threadPool->workStealing())
     {
         dispatch(startCB, sentCBs, compress, requestId, invokeNum, servantManager, adapter, outAsync, heartbeatCallback,
                  current.stream);
     }
     else
     {
-        _threadPool->dispatchFromThisThread(new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId,
-                                                             invokeNum, servantManager, adapter, outAsync,
-                                                             heartbeatCallback, current.stream));
-
+        current.dispatch(new DispatchCall(ICE_SHARED_FROM_THIS, startCB, sentCBs, compress, requestId, invokeNum,
+                                          servantManager, adapter, outAsync, heartbeatCallback, current.stream));
     }
 }
 
@@ -2070,7 +2151,7 @@ Ice::ConnectionI::finish(bool close)
             // retriable AMI calls which are not marshalled again.
             //
             OutgoingMessage* message = &_sendStreams.front();
-            _writeStream.swap(*message->stream);
+            _writeStream.swap(writeStream(*message));
 
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             //
@@ -2109,21 +2190,30 @@ Ice::ConnectionI::finish(bool close)
         _sendStreams.clear();
     }
 
-    for(map<Int, OutgoingAsyncBasePtr>::const_iterator q = _asyncRequests.begin(); q != _asyncRequests.end(); ++q)
+    for(map<Int, AsyncRequest>::const_iterator q = _asyncRequests.begin(); q != _asyncRequests.end(); ++q)
     {
-        if(q->second->exception(*_exception))
+        if(q->second.outAsync->exception(*_exception))
         {
-            q->second->invokeException();
+            q->second.outAsync->invokeException();
         }
     }
 
     _asyncRequests.clear();
 
+    for(map<Int, Buffer*>::const_iterator p = _fragments.begin(); p != _fragments.end(); ++p)
+    {
+        delete p->second;
+    }
+    _fragments.clear();
+    _fragmentsSize = 0;
+
     //
     // Don't wait to be reaped to reclaim memory allocated by read/write streams.
     //
     _writeStream.clear();
     _writeStream.b.clear();
+    _fragmentStream.clear();
+    _fragmentStream.b.clear();
     _readStream.clear();
     _readStream.b.clear();
 
@@ -2249,10 +2339,19 @@ Ice::ConnectionI::ConnectionI(const CommunicatorPtr& communicator,
     _warn(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Connections") > 0),
     _warnUdp(_instance->initializationData().properties->getPropertyAsInt("Ice.Warn.Datagrams") > 0),
     _compressionLevel(1),
+    _compressionCodec(getCompressionCodec(compressionBZip2)),
+    _peerCompressionCodecs(0),
     _nextRequestId(1),
     _asyncRequestsHint(_asyncRequests.end()),
+    _latency(0),
     _messageSizeMax(adapter ? adapter->messageSizeMax() : _instance->messageSizeMax()),
-    _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram())),
+    _batchRequestQueue(new BatchRequestQueue(instance, endpoint->datagram(), instance->batchAutoFlushDelay())),
+    _messageFragmentSize(_instance->messageFragmentSize()),
+    _peerFragments(false),
+    _advertiseFragments(false),
+    _nextFragmentId(1),
+    _fragmentStream(_instance.get(), Ice::currentProtocolEncoding),
+    _fragmentsSize(0),
     _readStream(_instance.get(), Ice::currentProtocolEncoding),
     _readHeader(false),
     _writeStream(_instance.get(), Ice::currentProtocolEncoding),
@@ -2543,6 +2642,12 @@ Ice::ConnectionI::setState(State state)
 
     notifyAll();
 
+    if(_state == StateActive && _advertiseFragments)
+    {
+        _advertiseFragments = false;
+        sendHeartbeatNow();
+    }
+
     if(_state == StateClosing && _dispatchCount == 0)
     {
         try
@@ -2616,7 +2721,11 @@ Ice::ConnectionI::sendHeartbeatNow()
         os.write(currentProtocol);
         os.write(currentProtocolEncoding);
         os.write(validateConnectionMsg);
-        os.write(static_cast<Byte>(0)); // Compression status (always zero for validate connection).
+        //
+        // The compression status advertises that we accept fragmented messages to
+        // peers that support them, it's zero otherwise.
+        //
+        os.write(static_cast<Byte>(_peerFragments ? fragmentsSupported : 0));
         os.write(headerSize); // Message size.
         os.i = os.b.begin();
         try
@@ -2668,7 +2777,12 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 _writeStream.write(currentProtocol);
                 _writeStream.write(currentProtocolEncoding);
                 _writeStream.write(validateConnectionMsg);
-                _writeStream.write(static_cast<Byte>(0)); // Compression status (always zero for validate connection).
+                //
+                // The compression status of the validate connection message advertises the
+                // compression codecs supported by the server and whether or not it accepts
+                // fragmented messages. It's ignored by older clients.
+                //
+                _writeStream.write(static_cast<Byte>(getSupportedCompressionCodecs() | fragmentsSupported));
                 _writeStream.write(headerSize); // Message size.
                 _writeStream.i = _writeStream.b.begin();
                 traceSend(_writeStream, _logger, _traceLevels);
@@ -2748,7 +2862,7 @@ Ice::ConnectionI::validate(SocketOperation operation)
                 throw ConnectionNotValidatedException(__FILE__, __LINE__);
             }
             Byte compress;
-            _readStream.read(compress); // Ignore compression status for validate connection.
+            _readStream.read(compress); // Compression codecs supported by the server, zero for older servers.
             Int size;
             _readStream.read(size);
             if(size != headerSize)
@@ -2757,6 +2871,36 @@ Ice::ConnectionI::validate(SocketOperation operation)
             }
             traceRecv(_readStream, _logger, _traceLevels);
 
+            //
+            // If the server accepts fragmented messages, we advertise that we accept
+            // them too once the connection is activated.
+            //
+            if(compress & fragmentsSupported)
+            {
+                _peerFragments = true;
+                _advertiseFragments = true;
+                compress = static_cast<Byte>(compress & ~fragmentsSupported);
+            }
+
+            if(compress != 0)
+            {
+                _peerCompressionCodecs = compress;
+
+                //
+                // Use the configured compression codec if the server supports it. Otherwise,
+                // use bzip2 if supported by the server or disable compression.
+                //
+                const CompressionCodecPtr& codec = _instance->compressionCodec();
+                if(codec && (compress & compressionCodecMask(codec->id())))
+                {
+                    _compressionCodec = codec;
+                }
+                else if(!(compress & compressionCodecMask(compressionBZip2)))
+                {
+                    _compressionCodec = 0;
+                }
+            }
+
             _validated = true;
         }
     }
@@ -2797,7 +2941,7 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     {
         // Message wasn't sent, empty the _writeStream, we're not going to send more data.
         OutgoingMessage* message = &_sendStreams.front();
-        _writeStream.swap(*message->stream);
+        _writeStream.swap(writeStream(*message));
         return SocketOperationNone;
     }
 
@@ -2806,26 +2950,43 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
     {
         while(true)
         {
-            //
-            // Notify the message that it was sent.
-            //
             OutgoingMessage* message = &_sendStreams.front();
-            if(message->stream)
+            if(message->fragmentId &&
+               message->fragmentOffset < message->stream->b.size() + message->stream->segmentsSize())
             {
-                _writeStream.swap(*message->stream);
-                if(message->sent())
+                //
+                // A fragment was sent, the next fragment is sent after the next queued
+                // message unless it's the close connection message.
+                //
+                _writeStream.swap(_fragmentStream);
+                if(_sendStreams.size() > 1 && _sendStreams[1].stream &&
+                   _sendStreams[1].stream->b[8] != closeConnectionMsg)
                 {
-                    callbacks.push_back(*message);
+                    std::swap(_sendStreams[0], _sendStreams[1]);
                 }
             }
-            _sendStreams.pop_front();
-
-            //
-            // If there's nothing left to send, we're done.
-            //
-            if(_sendStreams.empty())
+            else
             {
-                break;
+                //
+                // Notify the message that it was sent.
+                //
+                if(message->stream)
+                {
+                    _writeStream.swap(writeStream(*message));
+                    if(message->sent())
+                    {
+                        callbacks.push_back(*message);
+                    }
+                }
+                _sendStreams.pop_front();
+
+                //
+                // If there's nothing left to send, we're done.
+                //
+                if(_sendStreams.empty())
+                {
+                    break;
+                }
             }
 
             //
@@ -2844,54 +3005,75 @@ Ice::ConnectionI::sendNextMessage(vector<OutgoingMessage>& callbacks)
             // Otherwise, prepare the next message stream for writing.
             //
             message = &_sendStreams.front();
-            assert(!message->stream->i);
-#ifdef ICE_HAS_BZIP2
-            if(message->compress && message->stream->b.size() >= 100) // Only compress messages > 100 bytes.
+            if(!message->fragmentId)
             {
-                //
-                // Message compressed. Request compressed response, if any.
-                //
-                message->stream->b[9] = 2;
+                assert(!message->stream->i);
+                // Only compress messages > 100 bytes.
+                size_t messageSize = message->stream->b.size() + message->stream->segmentsSize();
+                CompressionCodecPtr codec = getMessageCompressionCodec(message->compress);
+                if(codec && messageSize >= 100)
+                {
+                    message->stream->copySegments();
 
-                //
-                // Do compression.
-                //
-                OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-                doCompress(*message->stream, stream);
+                    //
+                    // Message compressed. Request compressed response, if any.
+                    //
+                    message->stream->b[9] = codec->id();
 
-                traceSend(*message->stream, _logger, _traceLevels);
+                    //
+                    // Do compression.
+                    //
+                    OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
+                    doCompress(codec, *message->stream, stream);
 
-                message->adopt(&stream); // Adopt the compressed stream.
-                message->stream->i = message->stream->b.begin();
-            }
-            else
-            {
-#endif
-                if(message->compress)
+                    traceSend(*message->stream, _logger, _traceLevels);
+
+                    message->adopt(&stream); // Adopt the compressed stream.
+                    message->stream->i = message->stream->b.begin();
+                }
+                else
                 {
+                    if(message->compress)
+                    {
+                        //
+                        // Message not compressed. Request compressed response, if any.
+                        //
+                        message->stream->b[9] = 1;
+                    }
+
                     //
-                    // Message not compressed. Request compressed response, if any.
+                    // The fragments reference the message, they are copied
+                    // one at a time if the transceiver doesn't support
+                    // segments.
                     //
-                    message->stream->b[9] = 1;
-                }
+                    if(!_transceiver->supportsSegments() && !shouldFragment(*message->stream))
+                    {
+                        message->stream->copySegments();
+                    }
 
-                //
-                // No compression, just fill in the message size.
-                //
-                Int sz = static_cast<Int>(message->stream->b.size());
-                const Byte* p = reinterpret_cast<const Byte*>(&sz);
+                    //
+                    // No compression, just fill in the message size.
+                    //
+                    Int sz = static_cast<Int>(message->stream->b.size() + message->stream->segmentsSize());
+                    const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
-                reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
+                    reverse_copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
 #else
-                copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
+                    copy(p, p + sizeof(Int), message->stream->b.begin() + 10);
 #endif
-                message->stream->i = message->stream->b.begin();
-                traceSend(*message->stream, _logger, _traceLevels);
-
-#ifdef ICE_HAS_BZIP2
+                    message->stream->i = message->stream->b.begin();
+                    traceSend(*message->stream, _logger, _traceLevels);
+                }
+            }
+            if(message->fragmentId || shouldFragment(*message->stream))
+            {
+                prepareFragment(*message);
+                _writeStream.swap(_fragmentStream);
+            }
+            else
+            {
+                _writeStream.swap(*message->stream);
             }
-#endif
-            _writeStream.swap(*message->stream);
 
             //
             // Send the message.
@@ -2956,49 +3138,58 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     //
 
     message.stream->i = message.stream->b.begin();
-    SocketOperation op;
-#ifdef ICE_HAS_BZIP2
-    if(message.compress && message.stream->b.size() >= 100) // Only compress messages larger than 100 bytes.
+    SocketOperation op = SocketOperationWrite;
+    bool fragmented;
+    // Only compress messages larger than 100 bytes.
+    CompressionCodecPtr codec = getMessageCompressionCodec(message.compress);
+    if(codec && message.stream->b.size() + message.stream->segmentsSize() >= 100)
     {
+        message.stream->copySegments();
+
         //
         // Message compressed. Request compressed response, if any.
         //
-        message.stream->b[9] = 2;
+        message.stream->b[9] = codec->id();
 
         //
         // Do compression.
         //
         OutputStream stream(_instance.get(), Ice::currentProtocolEncoding);
-        doCompress(*message.stream, stream);
+        doCompress(codec, *message.stream, stream);
         stream.i = stream.b.begin();
 
         traceSend(*message.stream, _logger, _traceLevels);
 
         //
-        // Send the message without blocking.
+        // Send the message without blocking, the fragments of large messages are
+        // sent by the thread pool.
         //
-        if(_observer)
-        {
-            _observer.startWrite(stream);
-        }
-        op = write(stream);
-        if(!op)
+        fragmented = shouldFragment(stream);
+        if(!fragmented)
         {
             if(_observer)
             {
-                _observer.finishWrite(stream);
+                _observer.startWrite(stream);
             }
-
-            AsyncStatus status = AsyncStatusSent;
-            if(message.sent())
+            op = write(stream);
+            if(!op)
             {
-                status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
-            }
-            if(_acmLastActivity != IceUtil::Time())
-            {
-                _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(_observer)
+                {
+                    _observer.finishWrite(stream);
+                }
+
+                AsyncStatus status = AsyncStatusSent;
+                if(message.sent())
+                {
+                    status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
+                }
+                if(_acmLastActivity != IceUtil::Time())
+                {
+                    _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                }
+                return status;
             }
-            return status;
         }
 
         _sendStreams.push_back(message);
@@ -3006,7 +3197,6 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
     }
     else
     {
-#endif
         if(message.compress)
         {
             //
@@ -3015,10 +3205,15 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
             message.stream->b[9] = 1;
         }
 
+        if(!_transceiver->supportsSegments() && !shouldFragment(*message.stream))
+        {
+            message.stream->copySegments();
+        }
+
         //
         // No compression, just fill in the message size.
         //
-        Int sz = static_cast<Int>(message.stream->b.size());
+        Int sz = static_cast<Int>(message.stream->b.size() + message.stream->segmentsSize());
         const Byte* p = reinterpret_cast<const Byte*>(&sz);
 #ifdef ICE_BIG_ENDIAN
         reverse_copy(p, p + sizeof(Int), message.stream->b.begin() + 10);
@@ -3030,125 +3225,338 @@ Ice::ConnectionI::sendMessage(OutgoingMessage& message)
         traceSend(*message.stream, _logger, _traceLevels);
 
         //
-        // Send the message without blocking.
+        // Send the message without blocking, the fragments of large messages are
+        // sent by the thread pool.
         //
-        if(_observer)
-        {
-            _observer.startWrite(*message.stream);
-        }
-        op = write(*message.stream);
-        if(!op)
+        fragmented = shouldFragment(*message.stream);
+        if(!fragmented)
         {
             if(_observer)
             {
-                _observer.finishWrite(*message.stream);
-            }
-            AsyncStatus status = AsyncStatusSent;
-            if(message.sent())
-            {
-                status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
+                _observer.startWrite(*message.stream);
             }
-            if(_acmLastActivity != IceUtil::Time())
+            op = write(*message.stream);
+            if(!op)
             {
-                _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(_observer)
+                {
+                    _observer.finishWrite(*message.stream);
+                }
+                AsyncStatus status = AsyncStatusSent;
+                if(message.sent())
+                {
+                    status = static_cast<AsyncStatus>(status | AsyncStatusInvokeSentCallback);
+                }
+                if(_acmLastActivity != IceUtil::Time())
+                {
+                    _acmLastActivity = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                }
+                return status;
             }
-            return status;
         }
 
         _sendStreams.push_back(message);
         _sendStreams.back().adopt(0); // Adopt the stream.
-#ifdef ICE_HAS_BZIP2
     }
-#endif
 
-    _writeStream.swap(*_sendStreams.back().stream);
+    if(fragmented)
+    {
+        prepareFragment(_sendStreams.back());
+        _writeStream.swap(_fragmentStream);
+    }
+    else
+    {
+        _writeStream.swap(*_sendStreams.back().stream);
+    }
     scheduleTimeout(op);
     _threadPool->_register(ICE_SHARED_FROM_THIS, op);
     return AsyncStatusQueued;
 }
 
-#ifdef ICE_HAS_BZIP2
-static string
-getBZ2Error(int bzError)
+bool
+Ice::ConnectionI::shouldFragment(const OutputStream& stream) const
+{
+    //
+    // Messages larger than the fragment size are sent in fragments to peers
+    // that accept fragmented messages.
+    //
+    return _peerFragments && _messageFragmentSize > 0 &&
+        stream.b.size() + stream.segmentsSize() > _messageFragmentSize;
+}
+
+void
+Ice::ConnectionI::prepareFragment(OutgoingMessage& message)
 {
-    if(bzError == BZ_RUN_OK)
+    //
+    // Write the next fragment of the message to the fragment stream, the
+    // message stream isn't swapped with the write stream while the message
+    // is sent in fragments.
+    //
+    if(!message.fragmentId)
     {
-        return ": BZ_RUN_OK";
+        message.fragmentId = _nextFragmentId++;
+        if(_nextFragmentId <= 0)
+        {
+            _nextFragmentId = 1;
+        }
     }
-    else if(bzError == BZ_FLUSH_OK)
+
+    const Buffer::Container& b = message.stream->b;
+    const size_t messageSize = b.size() + message.stream->segmentsSize();
+    assert(message.fragmentOffset < messageSize);
+    const size_t start = message.fragmentOffset;
+    const size_t end = start + min(_messageFragmentSize, messageSize - start);
+
+    _fragmentStream.b.reset();
+    _fragmentStream.write(magic[0]);
+    _fragmentStream.write(magic[1]);
+    _fragmentStream.write(magic[2]);
+    _fragmentStream.write(magic[3]);
+    _fragmentStream.write(currentProtocol);
+    _fragmentStream.write(currentProtocolEncoding);
+    _fragmentStream.write(fragmentMsg);
+    _fragmentStream.write(static_cast<Byte>(0)); // Fragments are never compressed.
+    _fragmentStream.write(static_cast<Int>(headerSize + 2 * sizeof(Int) + end - start)); // Message size.
+    _fragmentStream.write(message.fragmentId);
+    _fragmentStream.write(static_cast<Int>(messageSize));
+
+    //
+    // The fragment references the data of the message rather than copying
+    // it, only the small parts of the message buffer are copied. The bytes
+    // are copied if the transceiver doesn't support segments.
+    //
+    const bool reference = _transceiver->supportsSegments();
+    if(BufferSegments* segments = _fragmentStream.b.segments())
     {
-        return ": BZ_FLUSH_OK";
+        segments->segments.clear();
+        segments->segmentPos = 0;
     }
-    else if(bzError == BZ_FINISH_OK)
+    else if(reference)
     {
-        return ": BZ_FINISH_OK";
+        _fragmentStream.setZeroCopySize(1);
     }
-    else if(bzError == BZ_STREAM_END)
+
+    //
+    // The message is the bytes of its buffer with its segments inserted at
+    // their offset, add the parts of these bytes in the fragment range.
+    //
+    const BufferSegments* messageSegments = b.segments();
+    vector<BufferSegment>::const_iterator p;
+    if(messageSegments)
     {
-        return ": BZ_STREAM_END";
+        p = messageSegments->segments.begin();
     }
-    else if(bzError == BZ_CONFIG_ERROR)
+    size_t offset = 0; // The offset in the message of the current part.
+    size_t pos = 0; // The position in b of the current part.
+    while(offset < end)
     {
-        return ": BZ_CONFIG_ERROR";
+        const Byte* partBegin;
+        const Byte* partEnd;
+        if(messageSegments && p != messageSegments->segments.end() && p->offset == pos)
+        {
+            partBegin = p->begin;
+            partEnd = p->end;
+            ++p;
+        }
+        else
+        {
+            size_t next = messageSegments && p != messageSegments->segments.end() ? p->offset : b.size();
+            partBegin = b.begin() + pos;
+            partEnd = b.begin() + next;
+            pos = next;
+        }
+
+        size_t partSize = static_cast<size_t>(partEnd - partBegin);
+        if(offset + partSize > start)
+        {
+            if(offset < start)
+            {
+                partBegin += start - offset;
+            }
+            if(offset + partSize > end)
+            {
+                partEnd -= offset + partSize - end;
+            }
+
+            if(reference && partEnd - partBegin >= 256)
+            {
+                //
+                // The segment is followed by its last byte, segments must be
+                // followed by a byte of the buffer.
+                //
+                BufferSegment segment;
+                segment.offset = _fragmentStream.b.size();
+                segment.begin = partBegin;
+                segment.end = partEnd - 1;
+                _fragmentStream.b.push_back(*(partEnd - 1));
+                _fragmentStream.b.segments()->segments.push_back(segment);
+            }
+            else
+            {
+                _fragmentStream.writeBlob(partBegin, static_cast<Buffer::Container::size_type>(partEnd - partBegin));
+            }
+        }
+        offset += partSize;
     }
-    else if(bzError == BZ_SEQUENCE_ERROR)
+    _fragmentStream.i = _fragmentStream.b.begin();
+    message.fragmentOffset = end;
+}
+
+OutputStream&
+Ice::ConnectionI::writeStream(OutgoingMessage& message)
+{
+    //
+    // The stream swapped with the write stream to send the message.
+    //
+    return message.fragmentId ? _fragmentStream : *message.stream;
+}
+
+bool
+Ice::ConnectionI::addFragment(InputStream& stream)
+{
+    //
+    // Append the fragment to its message, the message replaces the fragment
+    // in the given stream once all its fragments are received. Fragments
+    // only interleave the sending of large messages, the message is
+    // dispatched once it's reassembled.
+    //
+    stream.i = stream.b.begin() + headerSize;
+    Int id;
+    stream.read(id);
+    Int size;
+    stream.read(size);
+    if(size < headerSize)
     {
-        return ": BZ_SEQUENCE_ERROR";
+        throw IllegalMessageSizeException(__FILE__, __LINE__);
     }
-    else if(bzError == BZ_PARAM_ERROR)
+    if(size > static_cast<Int>(_messageSizeMax))
     {
-        return ": BZ_PARAM_ERROR";
+        Ex::throwMemoryLimitException(__FILE__, __LINE__, size, _messageSizeMax);
     }
-    else if(bzError == BZ_MEM_ERROR)
+
+    map<Int, Buffer*>::iterator p = _fragments.find(id);
+    if(p == _fragments.end())
     {
-        return ": BZ_MEM_ERROR";
+        //
+        // The peer interleaves the fragments of at most two messages, limit
+        // the number of partially received messages to bound the memory used
+        // by a misbehaving peer.
+        //
+        if(_fragments.size() >= 4)
+        {
+            throw ProtocolException(__FILE__, __LINE__, "too many partially received fragmented messages");
+        }
+        p = _fragments.insert(make_pair(id, static_cast<Buffer*>(0))).first;
+        p->second = new Buffer();
     }
-    else if(bzError == BZ_DATA_ERROR)
+
+    Buffer::Container& b = p->second->b;
+    size_t length = static_cast<size_t>(stream.b.end() - stream.i);
+    if(b.size() + length > static_cast<size_t>(size))
     {
-        return ": BZ_DATA_ERROR";
+        throw IllegalMessageSizeException(__FILE__, __LINE__);
     }
-    else if(bzError == BZ_DATA_ERROR_MAGIC)
+
+    //
+    // The partially received messages can't use more than twice the maximum
+    // message size.
+    //
+    if(_fragmentsSize + length > 2 * _messageSizeMax)
     {
-        return ": BZ_DATA_ERROR_MAGIC";
+        Ex::throwMemoryLimitException(__FILE__, __LINE__, _fragmentsSize + length, 2 * _messageSizeMax);
     }
-    else if(bzError == BZ_IO_ERROR)
+    _fragmentsSize += length;
+    if(length > 0)
     {
-        return ": BZ_IO_ERROR";
+        size_t pos = b.size();
+        b.resize(pos + length);
+        copy(stream.i, stream.b.end(), b.begin() + pos);
     }
-    else if(bzError == BZ_UNEXPECTED_EOF)
+    if(b.size() < static_cast<size_t>(size))
     {
-        return ": BZ_UNEXPECTED_EOF";
+        return false;
     }
-    else if(bzError == BZ_OUTBUFF_FULL)
+
+    stream.b.swap(b);
+    delete p->second;
+    _fragments.erase(p);
+    _fragmentsSize -= stream.b.size();
+
+    //
+    // Check the header of the fragmented message, it's not checked by the
+    // thread pool like the header of the fragment.
+    //
+    stream.i = stream.b.begin();
+    const Byte* m;
+    stream.readBlob(m, static_cast<Int>(sizeof(magic)));
+    if(m[0] != magic[0] || m[1] != magic[1] || m[2] != magic[2] || m[3] != magic[3])
+    {
+        throw BadMagicException(__FILE__, __LINE__, "", Ice::ByteSeq(&m[0], &m[0] + sizeof(magic)));
+    }
+    ProtocolVersion pv;
+    stream.read(pv);
+    checkSupportedProtocol(pv);
+    EncodingVersion ev;
+    stream.read(ev);
+    checkSupportedProtocolEncoding(ev);
+    Byte messageType;
+    stream.read(messageType);
+    if(messageType != requestMsg && messageType != requestBatchMsg && messageType != replyMsg)
+    {
+        throw UnknownMessageException(__FILE__, __LINE__);
+    }
+    Byte compress;
+    stream.read(compress);
+    Int messageSize;
+    stream.read(messageSize);
+    if(messageSize != size)
     {
-        return ": BZ_OUTBUFF_FULL";
+        throw IllegalMessageSizeException(__FILE__, __LINE__);
+    }
+    stream.i = stream.b.end();
+    return true;
+}
+
+CompressionCodecPtr
+Ice::ConnectionI::getMessageCompressionCodec(Byte compress) const
+{
+    //
+    // Use the codec requested for the message if the peer supports it,
+    // otherwise the codec of the connection.
+    //
+    if(compress == 0)
+    {
+        return 0;
+    }
+    else if(compress >= compressionBZip2 && (_peerCompressionCodecs & compressionCodecMask(compress)))
+    {
+        return getCompressionCodec(compress);
     }
     else
     {
-        return "";
+        return _compressionCodec;
     }
 }
 
 void
-Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compressed)
+Ice::ConnectionI::doCompress(const CompressionCodecPtr& codec, OutputStream& uncompressed, OutputStream& compressed)
 {
     const Byte* p;
 
+    IceUtil::Time start;
+    if(_observer)
+    {
+        start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+
     //
     // Compress the message body, but not the header.
     //
-    unsigned int uncompressedLen = static_cast<unsigned int>(uncompressed.b.size() - headerSize);
-    unsigned int compressedLen = static_cast<unsigned int>(uncompressedLen * 1.01 + 600);
-    compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
-    int bzError = BZ2_bzBuffToBuffCompress(reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                           &compressedLen,
-                                           reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                           uncompressedLen,
-                                           _compressionLevel, 0, 0);
-    if(bzError != BZ_OK)
-    {
-        throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError));
-    }
+    size_t uncompressedLen = uncompressed.b.size() - headerSize;
+    compressed.b.resize(headerSize + sizeof(Int) + codec->maxCompressedSize(uncompressedLen));
+    size_t compressedLen = codec->compress(&uncompressed.b[0] + headerSize, uncompressedLen,
+                                           &compressed.b[0] + headerSize + sizeof(Int),
+                                           compressed.b.size() - headerSize - sizeof(Int), _compressionLevel);
     compressed.b.resize(headerSize + sizeof(Int) + compressedLen);
 
     //
@@ -3180,11 +3588,23 @@ Ice::ConnectionI::doCompress(OutputStream& uncompressed, OutputStream& compresse
     // Copy the header from the uncompressed stream to the compressed one.
     //
     copy(uncompressed.b.begin(), uncompressed.b.begin() + headerSize, compressed.b.begin());
+
+    if(_observer)
+    {
+        _observer.compressed(compressedSize, uncompressedSize,
+                             IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+    }
 }
 
 void
-Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompressed)
+Ice::ConnectionI::doUncompress(const CompressionCodecPtr& codec, InputStream& compressed, InputStream& uncompressed)
 {
+    IceUtil::Time start;
+    if(_observer)
+    {
+        start = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    }
+
     Int uncompressedSize;
     compressed.i = compressed.b.begin() + headerSize;
     compressed.read(uncompressedSize);
@@ -3199,21 +3619,17 @@ Ice::ConnectionI::doUncompress(InputStream& compressed, InputStream& uncompresse
     }
     uncompressed.resize(uncompressedSize);
 
-    unsigned int uncompressedLen = uncompressedSize - headerSize;
-    unsigned int compressedLen = static_cast<unsigned int>(compressed.b.size() - headerSize - sizeof(Int));
-    int bzError = BZ2_bzBuffToBuffDecompress(reinterpret_cast<char*>(&uncompressed.b[0]) + headerSize,
-                                             &uncompressedLen,
-                                             reinterpret_cast<char*>(&compressed.b[0]) + headerSize + sizeof(Int),
-                                             compressedLen,
-                                             0, 0);
-    if(bzError != BZ_OK)
-    {
-        throw CompressionException(__FILE__, __LINE__, "BZ2_bzBuffToBuffCompress failed" + getBZ2Error(bzError));
-    }
+    codec->uncompress(&compressed.b[0] + headerSize + sizeof(Int), compressed.b.size() - headerSize - sizeof(Int),
+                      &uncompressed.b[0] + headerSize, uncompressedSize - headerSize);
 
     copy(compressed.b.begin(), compressed.b.begin() + headerSize, uncompressed.b.begin());
+
+    if(_observer)
+    {
+        _observer.compressed(static_cast<Int>(compressed.b.size()), uncompressedSize,
+                             IceUtil::Time::now(IceUtil::Time::Monotonic) - start);
+    }
 }
-#endif
 
 SocketOperation
 Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& requestId, Byte& compress,
@@ -3251,15 +3667,46 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
         stream.read(messageType);
         stream.read(compress);
 
-        if(compress == 2)
+        if(messageType == fragmentMsg)
+        {
+            //
+            // The message is parsed once all its fragments are received.
+            //
+            if(!addFragment(stream))
+            {
+                return _state == StateHolding ? SocketOperationNone : SocketOperationRead;
+            }
+            stream.i = stream.b.begin() + 8;
+            stream.read(messageType);
+            stream.read(compress);
+        }
+
+        //
+        // The compression status of validate connection messages advertises
+        // whether or not the peer accepts fragmented messages.
+        //
+        if(compress >= compressionBZip2 && messageType != validateConnectionMsg)
         {
-#ifdef ICE_HAS_BZIP2
+            CompressionCodecPtr codec = getCompressionCodec(compress);
+            if(!codec)
+            {
+                throw FeatureNotSupportedException(__FILE__, __LINE__, "Cannot uncompress compressed message");
+            }
+
+            //
+            // A peer only uses a codec other than bzip2 if we advertised it, use the
+            // same codec for the messages sent over this connection. The replies are
+            // compressed with the codec of the request.
+            //
+            if(compress != compressionBZip2)
+            {
+                _compressionCodec = codec;
+            }
+            _peerCompressionCodecs = static_cast<Byte>(_peerCompressionCodecs | compressionCodecMask(compress));
+
             InputStream ustream(_instance.get(), Ice::currentProtocolEncoding);
-            doUncompress(stream, ustream);
+            doUncompress(codec, stream, ustream);
             stream.b.swap(ustream.b);
-#else
-            throw FeatureNotSupportedException(__FILE__, __LINE__, "Cannot uncompress compressed message");
-#endif
         }
         stream.i = stream.b.begin() + headerSize;
 
@@ -3341,7 +3788,7 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
 
                 stream.read(requestId);
 
-                map<Int, OutgoingAsyncBasePtr>::iterator q = _asyncRequests.end();
+                map<Int, AsyncRequest>::iterator q = _asyncRequests.end();
 
                 if(_asyncRequestsHint != _asyncRequests.end())
                 {
@@ -3358,7 +3805,8 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
 
                 if(q != _asyncRequests.end())
                 {
-                    outAsync = q->second;
+                    outAsync = q->second.outAsync;
+                    updateLatency(q->second.time);
 
                     if(q == _asyncRequestsHint)
                     {
@@ -3411,6 +3859,11 @@ Ice::ConnectionI::parseMessage(InputStream& stream, Int& invokeNum, Int& request
             case validateConnectionMsg:
             {
                 traceRecv(stream, _logger, _traceLevels);
+                if(compress & fragmentsSupported)
+                {
+                    _peerFragments = true;
+                }
+                compress = 0;
                 if(_heartbeatCallback)
                 {
                     heartbeatCallback = _heartbeatCallback;
@@ -3567,6 +4020,26 @@ Ice::ConnectionI::unscheduleTimeout(SocketOperation status)
     }
 }
 
+void
+Ice::ConnectionI::updateLatency(const IceUtil::Time& time)
+{
+    //
+    // Smooth the round-trip time with the same gain as the TCP smoothed
+    // round-trip time (RFC 6298). The latency is at least 1 microsecond
+    // once known.
+    //
+    Long sample = max(static_cast<Long>((IceUtil::Time::now(IceUtil::Time::Monotonic) - time).toMicroSeconds()),
+                      Long(1));
+    if(_latency == 0)
+    {
+        _latency = sample;
+    }
+    else
+    {
+        _latency += (sample - _latency) / 8;
+    }
+}
+
 Ice::ConnectionInfoPtr
 Ice::ConnectionI::initConnectionInfo() const
 {
@@ -3626,15 +4099,19 @@ ConnectionI::read(Buffer& buf)
 SocketOperation
 ConnectionI::write(Buffer& buf)
 {
-    Buffer::Container::iterator start = buf.i;
+    //
+    // The positions include the bytes of the segments referenced by the
+    // buffer, see Buffer::position().
+    //
+    size_t start = buf.position();
     SocketOperation op = _transceiver->write(buf);
-    if(_instance->traceLevels()->network >= 3 && buf.i != start)
+    if(_instance->traceLevels()->network >= 3 && buf.position() != start)
     {
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->networkCat);
-        out << "sent " << (buf.i - start);
+        out << "sent " << (buf.position() - start);
         if(!_endpoint->datagram())
         {
-            out << " of " << (buf.b.end() - start);
+            out << " of " << (buf.b.size() + buf.segmentsSize() - start);
         }
         out << " bytes via " << _endpoint->protocol() << "\n" << toString();
     }
@@ -35,15 +35,10 @@
 #include <Ice/ACM.h>
 #include <Ice/OutputStream.h>
 #include <Ice/InputStream.h>
+#include <Ice/CompressionCodec.h>
 
 #include <deque>
 
-#if !defined(ICE_OS_UWP)
-#    ifndef ICE_HAS_BZIP2
-#        define ICE_HAS_BZIP2
-#    endif
-#endif
-
 namespace Ice
 {
 
@@ -67,13 +62,15 @@ class ConnectionI : public Connection,
         void finishRead(const IceInternal::Buffer&);
         void startWrite(const IceInternal::Buffer&);
         void finishWrite(const IceInternal::Buffer&);
+        void compressed(Ice::Int, Ice::Int, const IceUtil::Time&);
 
         void attach(const Ice::Instrumentation::ConnectionObserverPtr&);
 
     private:
 
         Ice::Byte* _readStreamPos;
-        Ice::Byte* _writeStreamPos;
+        bool _writing;
+        size_t _writeStreamPos;
     };
 
 public:
@@ -87,8 +84,8 @@ public:
 
     struct OutgoingMessage
     {
-        OutgoingMessage(Ice::OutputStream* str, bool comp) :
-            stream(str), compress(comp), requestId(0), adopted(false)
+        OutgoingMessage(Ice::OutputStream* str, Ice::Byte comp) :
+            stream(str), compress(comp), requestId(0), adopted(false), fragmentId(0), fragmentOffset(0)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -96,8 +93,9 @@ public:
         }
 
         OutgoingMessage(const IceInternal::OutgoingAsyncBasePtr& o, Ice::OutputStream* str,
-                        bool comp, int rid) :
-            stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false)
+                        Ice::Byte comp, int rid) :
+            stream(str), outAsync(o), compress(comp), requestId(rid), adopted(false), fragmentId(0),
+            fragmentOffset(0)
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
             , isSent(false), invokeSent(false), receivedReply(false)
 #endif
@@ -111,9 +109,16 @@ public:
 
         Ice::OutputStream* stream;
         IceInternal::OutgoingAsyncBasePtr outAsync;
-        bool compress;
+        //
+        // 0 if the message isn't compressed, 1 to compress it with the codec of the
+        // connection, otherwise the compression status of the codec to compress it
+        // with if the peer supports this codec.
+        //
+        Ice::Byte compress;
         int requestId;
         bool adopted;
+        Int fragmentId; // Non-zero once the message is sent in fragments.
+        size_t fragmentOffset; // The offset of the next fragment.
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
         bool isSent;
         bool invokeSent;
@@ -165,7 +170,7 @@ public:
 
     void monitor(const IceUtil::Time&, const IceInternal::ACMConfig&);
 
-    IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, bool, bool, int);
+    IceInternal::AsyncStatus sendAsyncRequest(const IceInternal::OutgoingAsyncBasePtr&, Ice::Byte, bool, int);
 
     IceInternal::BatchRequestQueuePtr getBatchRequestQueue() const;
 
@@ -216,6 +221,19 @@ public:
     IceInternal::EndpointIPtr endpoint() const;
     IceInternal::ConnectorPtr connector() const;
 
+    //
+    // Get the smoothed round-trip time of the requests in microseconds
+    // (0 if unknown) and the number of requests waiting for a response.
+    //
+    void getLoad(Long&, size_t&) const;
+
+    //
+    // Get the number of requests queued for sending or waiting for a
+    // response and the size of the message being transferred over the
+    // connection (0 if none), used to balance the connection pool.
+    //
+    void getPoolLoad(size_t&, size_t&) const;
+
     virtual void setAdapter(const ObjectAdapterPtr&); // From Connection.
     virtual ObjectAdapterPtr getAdapter() const ICE_NOEXCEPT; // From Connection.
     virtual EndpointPtr getEndpoint() const ICE_NOEXCEPT; // From Connection.
@@ -293,10 +311,14 @@ private:
     IceInternal::SocketOperation sendNextMessage(std::vector<OutgoingMessage>&);
     IceInternal::AsyncStatus sendMessage(OutgoingMessage&);
 
-#ifdef ICE_HAS_BZIP2
-    void doCompress(Ice::OutputStream&, Ice::OutputStream&);
-    void doUncompress(Ice::InputStream&, Ice::InputStream&);
-#endif
+    bool shouldFragment(const Ice::OutputStream&) const;
+    void prepareFragment(OutgoingMessage&);
+    Ice::OutputStream& writeStream(OutgoingMessage&);
+    bool addFragment(Ice::InputStream&);
+
+    IceInternal::CompressionCodecPtr getMessageCompressionCodec(Ice::Byte) const;
+    void doCompress(const IceInternal::CompressionCodecPtr&, Ice::OutputStream&, Ice::OutputStream&);
+    void doUncompress(const IceInternal::CompressionCodecPtr&, Ice::InputStream&, Ice::InputStream&);
 
     IceInternal::SocketOperation parseMessage(Ice::InputStream&, Int&, Int&, Byte&,
                                               IceInternal::ServantManagerPtr&, ObjectAdapterPtr&,
@@ -308,6 +330,8 @@ private:
     void scheduleTimeout(IceInternal::SocketOperation status);
     void unscheduleTimeout(IceInternal::SocketOperation status);
 
+    void updateLatency(const IceUtil::Time&);
+
     Ice::ConnectionInfoPtr initConnectionInfo() const;
     Ice::Instrumentation::ConnectionState toConnectionState(State) const;
 
@@ -356,17 +380,34 @@ private:
     IceUtil::Time _acmLastActivity;
 
     const int _compressionLevel;
+    IceInternal::CompressionCodecPtr _compressionCodec;
+    Byte _peerCompressionCodecs; // The mask of the codecs known to be supported by the peer.
 
     Int _nextRequestId;
 
-    std::map<Int, IceInternal::OutgoingAsyncBasePtr> _asyncRequests;
-    std::map<Int, IceInternal::OutgoingAsyncBasePtr>::iterator _asyncRequestsHint;
+    struct AsyncRequest
+    {
+        IceInternal::OutgoingAsyncBasePtr outAsync;
+        IceUtil::Time time; // The time the request was queued, for the round-trip time.
+    };
+
+    std::map<Int, AsyncRequest> _asyncRequests;
+    std::map<Int, AsyncRequest>::iterator _asyncRequestsHint;
+    Long _latency;
 
     IceInternal::UniquePtr<LocalException> _exception;
 
     const size_t _messageSizeMax;
     IceInternal::BatchRequestQueuePtr _batchRequestQueue;
 
+    const size_t _messageFragmentSize;
+    bool _peerFragments; // True if the peer accepts fragmented messages.
+    bool _advertiseFragments;
+    Int _nextFragmentId;
+    Ice::OutputStream _fragmentStream;
+    std::map<Int, IceInternal::Buffer*> _fragments;
+    size_t _fragmentsSize; // The total size of the partially received messages.
+
     std::deque<OutgoingMessage> _sendStreams;
 
     Ice::InputStream _readStream;
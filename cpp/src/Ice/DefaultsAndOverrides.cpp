@@ -112,10 +112,19 @@ IceInternal::DefaultsAndOverrides::DefaultsAndOverrides(const PropertiesPtr& pro
     {
         defaultEndpointSelection = ICE_ENUM(EndpointSelectionType, Ordered);
     }
+    else if(value == "LeastLatency")
+    {
+        defaultEndpointSelection = ICE_ENUM(EndpointSelectionType, LeastLatency);
+    }
+    else if(value == "LeastOutstanding")
+    {
+        defaultEndpointSelection = ICE_ENUM(EndpointSelectionType, LeastOutstanding);
+    }
     else
     {
         throw EndpointSelectionTypeParseException(__FILE__, __LINE__, "illegal value `" + value +
-                                                  "'; expected `Random' or `Ordered'");
+                                                  "'; expected `Random', `Ordered', `LeastLatency' or"
+                                                  " `LeastOutstanding'");
     }
 
     const_cast<int&>(defaultTimeout) =
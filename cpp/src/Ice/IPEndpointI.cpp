@@ -10,6 +10,8 @@
 #include <Ice/LoggerUtil.h>
 #include <Ice/HashUtil.h>
 #include <Ice/NetworkProxy.h>
+#include <Ice/InstrumentationI.h>
+#include <Ice/UniquePtr.h>
 #include <IceUtil/MutexPtrLock.h>
 
 using namespace std;
@@ -527,12 +529,67 @@ IceInternal::IPEndpointI::IPEndpointI(const ProtocolInstancePtr& instance, Input
 #ifndef ICE_OS_UWP
 
 IceInternal::EndpointHostResolver::EndpointHostResolver(const InstancePtr& instance) :
-    IceUtil::Thread("Ice.HostResolver"),
     _instance(instance),
     _protocol(instance->protocolSupport()),
     _preferIPv6(instance->preferIPv6()),
-    _destroyed(false)
+    _cacheTTL(IceUtil::Time::seconds(
+                  instance->initializationData().properties->getPropertyAsInt("Ice.HostResolver.CacheTTL"))),
+    _negativeCacheTTL(IceUtil::Time::seconds(
+                          instance->initializationData().properties->getPropertyAsInt(
+                              "Ice.HostResolver.NegativeCacheTTL"))),
+    _destroyed(false),
+    _cachePurgeSize(64)
 {
+    const PropertiesPtr properties = instance->initializationData().properties;
+
+    int size = properties->getPropertyAsIntWithDefault("Ice.HostResolver.Size", 1);
+    if(size < 1)
+    {
+        Warning out(instance->initializationData().logger);
+        out << "Ice.HostResolver.Size < 1; Size adjusted to 1";
+        size = 1;
+    }
+
+    const bool hasPriority = properties->getProperty("Ice.ThreadPriority") != "";
+    const int priority = properties->getPropertyAsInt("Ice.ThreadPriority");
+    __setNoDelete(true);
+    try
+    {
+        for(int i = 0; i < size; ++i)
+        {
+            ostringstream name;
+            name << "Ice.HostResolver";
+            if(size > 1)
+            {
+                name << "-" << i;
+            }
+
+            HostResolverThreadPtr thread = new HostResolverThread(this, name.str());
+            if(hasPriority)
+            {
+                thread->start(0, priority);
+            }
+            else
+            {
+                thread->start();
+            }
+            _threads.push_back(thread);
+        }
+    }
+    catch(const IceUtil::Exception&)
+    {
+        destroy();
+        joinWithAllThreads();
+        __setNoDelete(false);
+        throw;
+    }
+    catch(...)
+    {
+        __setNoDelete(false);
+        throw;
+    }
+    __setNoDelete(false);
+
     updateObserver();
 }
 
@@ -563,9 +620,6 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
         }
     }
 
-    Lock sync(*this);
-    assert(!_destroyed);
-
     ResolveEntry entry;
     entry.host = host;
     entry.port = port;
@@ -581,10 +635,88 @@ IceInternal::EndpointHostResolver::resolve(const string& host, int port, Ice::En
         {
             entry.observer->attach();
         }
+
+        CommunicatorObserverI* metricsObsv = dynamic_cast<CommunicatorObserverI*>(obsv.get());
+        if(metricsObsv)
+        {
+            entry.resolverObserver = metricsObsv->getHostResolverObserver(host);
+            if(entry.resolverObserver)
+            {
+                entry.resolverObserver->attach();
+            }
+        }
     }
 
-    _queue.push_back(entry);
-    notify();
+    CacheEntry cached;
+    {
+        Lock sync(*this);
+        assert(!_destroyed);
+
+        //
+        // The host names resolved through a network proxy are neither cached
+        // nor shared, the proxy might resolve them differently.
+        //
+        if(networkProxy)
+        {
+            _queue.push_back(entry);
+            notify();
+            return;
+        }
+
+        map<string, CacheEntry>::iterator p = _cache.find(host);
+        if(p == _cache.end() || p->second.expiration <= IceUtil::Time::now(IceUtil::Time::Monotonic))
+        {
+            if(p != _cache.end())
+            {
+                _cache.erase(p);
+            }
+
+            map<string, deque<ResolveEntry> >::iterator q = _pending.find(host);
+            if(q != _pending.end())
+            {
+                //
+                // A lookup of this host is already in progress, wait for its result.
+                //
+                HostResolverObserverI* resolverObserver =
+                    dynamic_cast<HostResolverObserverI*>(entry.resolverObserver.get());
+                if(resolverObserver)
+                {
+                    resolverObserver->coalesced();
+                }
+                q->second.push_back(entry);
+            }
+            else
+            {
+                _pending.insert(make_pair(host, deque<ResolveEntry>()));
+                _queue.push_back(entry);
+                notify();
+            }
+            return;
+        }
+        cached = p->second;
+    }
+
+    //
+    // The host name was found in the cache.
+    //
+    HostResolverObserverI* resolverObserver = dynamic_cast<HostResolverObserverI*>(entry.resolverObserver.get());
+    if(resolverObserver)
+    {
+        resolverObserver->hit();
+    }
+
+    try
+    {
+        if(cached.addresses.empty())
+        {
+            throw Ice::DNSException(__FILE__, __LINE__, cached.error, host);
+        }
+        finished(entry, addresses(cached.addresses, port, selType), 0);
+    }
+    catch(const Ice::LocalException& ex)
+    {
+        failed(entry, ex);
+    }
 }
 
 void
@@ -593,11 +725,69 @@ IceInternal::EndpointHostResolver::destroy()
     Lock sync(*this);
     assert(!_destroyed);
     _destroyed = true;
-    notify();
+    notifyAll();
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithAllThreads()
+{
+    //
+    // The threads are no longer added or removed once the resolver is
+    // destroyed, it's safe to join them without holding the lock.
+    //
+    vector<HostResolverThreadPtr> threads;
+    {
+        Lock sync(*this);
+        assert(_destroyed);
+        threads = _threads;
+    }
+
+    for(vector<HostResolverThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+
+    //
+    // Fail the resolutions which didn't complete before the destruction.
+    //
+    deque<ResolveEntry> entries;
+    {
+        Lock sync(*this);
+        _threads.clear(); // Break the cyclic reference with the threads.
+        entries.swap(_queue);
+        for(map<string, deque<ResolveEntry> >::const_iterator p = _pending.begin(); p != _pending.end(); ++p)
+        {
+            entries.insert(entries.end(), p->second.begin(), p->second.end());
+        }
+        _pending.clear();
+        _cache.clear();
+    }
+
+    for(deque<ResolveEntry>::iterator p = entries.begin(); p != entries.end(); ++p)
+    {
+        failed(*p, Ice::CommunicatorDestroyedException(__FILE__, __LINE__));
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::updateObserver()
+{
+    Lock sync(*this);
+    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
+    if(obsv)
+    {
+        for(vector<HostResolverThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+        {
+            (*p)->_observer.attach(obsv->getThreadObserver("Communicator",
+                                                           (*p)->name(),
+                                                           ICE_ENUM(ThreadState, ThreadStateIdle),
+                                                           (*p)->_observer.get()));
+        }
+    }
+}
+
+void
+IceInternal::EndpointHostResolver::run(const HostResolverThreadPtr& thread)
 {
     while(true)
     {
@@ -617,7 +807,7 @@ IceInternal::EndpointHostResolver::run()
 
             r = _queue.front();
             _queue.pop_front();
-            threadObserver = _observer.get();
+            threadObserver = thread->_observer.get();
         }
 
         if(threadObserver)
@@ -625,81 +815,189 @@ IceInternal::EndpointHostResolver::run()
             threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateIdle), ICE_ENUM(ThreadState, ThreadStateInUseForOther));
         }
 
-        try
+        NetworkProxyPtr networkProxy = _instance->networkProxy();
+        if(networkProxy)
         {
-            NetworkProxyPtr networkProxy = _instance->networkProxy();
-            ProtocolSupport protocol = _protocol;
-            if(networkProxy)
+            try
             {
                 networkProxy = networkProxy->resolveHost(_protocol);
-                if(networkProxy)
-                {
-                    protocol = networkProxy->getProtocolSupport();
-                }
+                ProtocolSupport protocol = networkProxy ? networkProxy->getProtocolSupport() : _protocol;
+                finished(r, getAddresses(r.host, r.port, protocol, r.selType, _preferIPv6, true), networkProxy);
             }
-
-            vector<Address> addresses = getAddresses(r.host, r.port, protocol, r.selType, _preferIPv6, true);
-            if(r.observer)
+            catch(const Ice::LocalException& ex)
             {
-                r.observer->detach();
-                r.observer = 0;
+                failed(r, ex);
             }
-
-            r.callback->connectors(r.endpoint->connectors(addresses, networkProxy));
-
-            if(threadObserver)
+        }
+        else
+        {
+            //
+            // Lookup the host addresses without the port and the selection type,
+            // they are set for each of the entries waiting for this lookup.
+            //
+            vector<Address> addrs;
+            IceInternal::UniquePtr<Ice::LocalException> exception;
+            try
+            {
+                addrs = getAddresses(r.host, 0, _protocol, Ice::ICE_ENUM(EndpointSelectionType, Ordered), _preferIPv6,
+                                     true);
+            }
+            catch(const Ice::LocalException& ex)
             {
-                threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther),
-                                             ICE_ENUM(ThreadState, ThreadStateIdle));
+                ICE_SET_EXCEPTION_FROM_CLONE(exception, ex.ice_clone());
             }
 
-        }
-        catch(const Ice::LocalException& ex)
-        {
-            if(threadObserver)
+            deque<ResolveEntry> entries;
             {
-                threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther),
-                                             ICE_ENUM(ThreadState, ThreadStateIdle));
+                Lock sync(*this);
+                map<string, deque<ResolveEntry> >::iterator p = _pending.find(r.host);
+                if(p != _pending.end())
+                {
+                    entries.swap(p->second);
+                    _pending.erase(p);
+                }
+
+                if(!exception.get())
+                {
+                    cache(r.host, addrs, 0);
+                }
+                else
+                {
+                    const Ice::DNSException* dnsException = dynamic_cast<const Ice::DNSException*>(exception.get());
+                    if(dnsException)
+                    {
+                        cache(r.host, addrs, dnsException->error);
+                    }
+                }
             }
-            if(r.observer)
+            entries.push_front(r);
+
+            for(deque<ResolveEntry>::iterator p = entries.begin(); p != entries.end(); ++p)
             {
-                r.observer->failed(ex.ice_id());
-                r.observer->detach();
+                try
+                {
+                    if(exception.get())
+                    {
+                        exception->ice_throw();
+                    }
+                    finished(*p, addresses(addrs, p->port, p->selType), 0);
+                }
+                catch(const Ice::LocalException& ex)
+                {
+                    failed(*p, ex);
+                }
             }
-            r.callback->exception(ex);
         }
-    }
 
-    for(deque<ResolveEntry>::const_iterator p = _queue.begin(); p != _queue.end(); ++p)
-    {
-        Ice::CommunicatorDestroyedException ex(__FILE__, __LINE__);
-        if(p->observer)
+        if(threadObserver)
         {
-            p->observer->failed(ex.ice_id());
-            p->observer->detach();
+            threadObserver->stateChanged(ICE_ENUM(ThreadState, ThreadStateInUseForOther),
+                                         ICE_ENUM(ThreadState, ThreadStateIdle));
         }
-        p->callback->exception(ex);
     }
-    _queue.clear();
 
-    if(_observer)
+    Lock sync(*this);
+    if(thread->_observer)
     {
-        _observer.detach();
+        thread->_observer.detach();
     }
 }
 
 void
-IceInternal::EndpointHostResolver::updateObserver()
+IceInternal::EndpointHostResolver::finished(ResolveEntry& r, const vector<Address>& addrs,
+                                            const NetworkProxyPtr& networkProxy)
 {
-    Lock sync(*this);
-    const CommunicatorObserverPtr& obsv = _instance->initializationData().observer;
-    if(obsv)
+    if(r.observer)
+    {
+        r.observer->detach();
+        r.observer = 0;
+    }
+    if(r.resolverObserver)
+    {
+        r.resolverObserver->detach();
+        r.resolverObserver = 0;
+    }
+    r.callback->connectors(r.endpoint->connectors(addrs, networkProxy));
+}
+
+void
+IceInternal::EndpointHostResolver::failed(ResolveEntry& r, const Ice::LocalException& ex)
+{
+    if(r.observer)
+    {
+        r.observer->failed(ex.ice_id());
+        r.observer->detach();
+        r.observer = 0;
+    }
+    if(r.resolverObserver)
     {
-        _observer.attach(obsv->getThreadObserver("Communicator",
-                                                 name(),
-                                                 ICE_ENUM(ThreadState, ThreadStateIdle),
-                                                 _observer.get()));
+        r.resolverObserver->failed(ex.ice_id());
+        r.resolverObserver->detach();
+        r.resolverObserver = 0;
     }
+    r.callback->exception(ex);
+}
+
+vector<Address>
+IceInternal::EndpointHostResolver::addresses(const vector<Address>& addrs, int port,
+                                             Ice::EndpointSelectionType selType) const
+{
+    vector<Address> result(addrs);
+    for(vector<Address>::iterator p = result.begin(); p != result.end(); ++p)
+    {
+        setPort(*p, port);
+    }
+    sortAddresses(result, _protocol, selType, _preferIPv6);
+    return result;
+}
+
+void
+IceInternal::EndpointHostResolver::cache(const string& host, const vector<Address>& addrs, int error)
+{
+    //
+    // Must be called with the lock held.
+    //
+    const IceUtil::Time ttl = addrs.empty() ? _negativeCacheTTL : _cacheTTL;
+    if(ttl <= IceUtil::Time())
+    {
+        return;
+    }
+
+    const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(_cache.size() >= _cachePurgeSize)
+    {
+        map<string, CacheEntry>::iterator p = _cache.begin();
+        while(p != _cache.end())
+        {
+            if(p->second.expiration <= now)
+            {
+                _cache.erase(p++);
+            }
+            else
+            {
+                ++p;
+            }
+        }
+        _cachePurgeSize = max(static_cast<size_t>(64), _cache.size() * 2);
+    }
+
+    CacheEntry& entry = _cache[host];
+    entry.addresses = addrs;
+    entry.error = error;
+    entry.expiration = now + ttl;
+}
+
+IceInternal::EndpointHostResolver::HostResolverThread::HostResolverThread(const EndpointHostResolverPtr& resolver,
+                                                                          const string& name) :
+    IceUtil::Thread(name),
+    _resolver(resolver)
+{
+}
+
+void
+IceInternal::EndpointHostResolver::HostResolverThread::run()
+{
+    _resolver->run(this);
 }
 
 #else
@@ -733,7 +1031,7 @@ IceInternal::EndpointHostResolver::destroy()
 }
 
 void
-IceInternal::EndpointHostResolver::run()
+IceInternal::EndpointHostResolver::joinWithAllThreads()
 {
 }
 
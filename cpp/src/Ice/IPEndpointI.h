@@ -17,6 +17,7 @@
 
 #ifndef ICE_OS_UWP
 #   include <deque>
+#   include <map>
 #endif
 
 namespace IceInternal
@@ -105,7 +106,13 @@ private:
 };
 
 #ifndef ICE_OS_UWP
-class ICE_API EndpointHostResolver : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+//
+// Resolves the host names of the endpoints with a pool of Ice.HostResolver.Size
+// threads. Concurrent resolutions of the same host share the same lookup and
+// the results are cached for Ice.HostResolver.CacheTTL seconds (lookup
+// failures for Ice.HostResolver.NegativeCacheTTL seconds).
+//
+class ICE_API EndpointHostResolver : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 #else
 class ICE_API EndpointHostResolver : public IceUtil::Shared
 #endif
@@ -117,13 +124,29 @@ public:
     void resolve(const std::string&, int, Ice::EndpointSelectionType, const IPEndpointIPtr&,
                  const EndpointI_connectorsPtr&);
     void destroy();
+    void joinWithAllThreads();
 
-    virtual void run();
     void updateObserver();
 
 private:
 
 #ifndef ICE_OS_UWP
+    class HostResolverThread : public IceUtil::Thread
+    {
+    public:
+
+        HostResolverThread(const EndpointHostResolverPtr&, const std::string&);
+        virtual void run();
+
+    private:
+
+        friend class EndpointHostResolver;
+
+        const EndpointHostResolverPtr _resolver;
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    };
+    typedef IceUtil::Handle<HostResolverThread> HostResolverThreadPtr;
+
     struct ResolveEntry
     {
         std::string host;
@@ -132,14 +155,33 @@ private:
         IPEndpointIPtr endpoint;
         EndpointI_connectorsPtr callback;
         Ice::Instrumentation::ObserverPtr observer;
+        Ice::Instrumentation::ObserverPtr resolverObserver;
+    };
+
+    struct CacheEntry
+    {
+        std::vector<Address> addresses; // Empty if the lookup failed.
+        int error;
+        IceUtil::Time expiration;
     };
 
+    void run(const HostResolverThreadPtr&);
+    void finished(ResolveEntry&, const std::vector<Address>&, const NetworkProxyPtr&);
+    void failed(ResolveEntry&, const Ice::LocalException&);
+    std::vector<Address> addresses(const std::vector<Address>&, int, Ice::EndpointSelectionType) const;
+    void cache(const std::string&, const std::vector<Address>&, int);
+
     const InstancePtr _instance;
     const IceInternal::ProtocolSupport _protocol;
     const bool _preferIPv6;
+    const IceUtil::Time _cacheTTL;
+    const IceUtil::Time _negativeCacheTTL;
     bool _destroyed;
     std::deque<ResolveEntry> _queue;
-    ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+    std::map<std::string, std::deque<ResolveEntry> > _pending; // The entries waiting for a lookup in progress.
+    std::map<std::string, CacheEntry> _cache;
+    size_t _cachePurgeSize;
+    std::vector<HostResolverThreadPtr> _threads;
 #else
     const InstancePtr _instance;
 #endif
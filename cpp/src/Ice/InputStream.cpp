@@ -162,6 +162,8 @@ Ice::InputStream::initialize(Instance* instance, const EncodingVersion& encoding
 #endif
     _traceSlicing = _instance->traceLevels()->slicing > 0;
     _classGraphDepthMax = _instance->classGraphDepthMax();
+
+    b.setPool(_instance->bufferPool().get());
 }
 
 void
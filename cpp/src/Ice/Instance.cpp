@@ -27,6 +27,7 @@
 #include <Ice/RequestHandlerFactory.h>
 #include <Ice/RetryQueue.h>
 #include <Ice/DynamicLibrary.h>
+#include <Ice/BufferPool.h>
 #include <Ice/PluginManagerI.h>
 #include <Ice/Initialize.h>
 #include <Ice/LoggerUtil.h>
@@ -942,9 +943,16 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
     _state(StateActive),
     _initData(initData),
     _messageSizeMax(0),
+    _messageFragmentSize(0),
     _batchAutoFlushSize(0),
+    _batchAutoFlushDelay(0),
+    _batchAutoFlushAdaptive(false),
+    _connectionPoolSize(1),
+    _connectionPoolLargeMessageSize(0),
     _classGraphDepthMax(0),
+    _zeroCopySize(0),
     _collectObjects(false),
+    _collocationDirectDispatch(false),
     _toStringMode(ICE_ENUM(ToStringMode, Unicode)),
     _implicitContext(0),
     _stringConverter(Ice::getProcessStringConverter()),
@@ -1152,6 +1160,23 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             }
         }
 
+        {
+            // Property is in kilobytes, 0 (the default) doesn't fragment messages.
+            Int num = _initData.properties->getPropertyAsInt("Ice.MessageFragmentSize");
+            if(num < 1)
+            {
+                const_cast<size_t&>(_messageFragmentSize) = 0;
+            }
+            else if(static_cast<size_t>(num) > static_cast<size_t>(0x7fffffff / 1024))
+            {
+                const_cast<size_t&>(_messageFragmentSize) = static_cast<size_t>(0x7fffffff);
+            }
+            else
+            {
+                const_cast<size_t&>(_messageFragmentSize) = static_cast<size_t>(num) * 1024;
+            }
+        }
+
         if(_initData.properties->getProperty("Ice.BatchAutoFlushSize").empty() &&
            !_initData.properties->getProperty("Ice.BatchAutoFlush").empty())
         {
@@ -1178,6 +1203,37 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             }
         }
 
+        {
+            // Property is in milliseconds, 0 (the default) disables the time-based flush.
+            Int num = _initData.properties->getPropertyAsInt("Ice.BatchAutoFlushDelay");
+            const_cast<int&>(_batchAutoFlushDelay) = num < 1 ? 0 : num;
+        }
+
+        const_cast<bool&>(_batchAutoFlushAdaptive) =
+            _initData.properties->getPropertyAsInt("Ice.BatchAutoFlushAdaptive") > 0;
+
+        {
+            Int num = _initData.properties->getPropertyAsIntWithDefault("Ice.ConnectionPool.Size", 1);
+            const_cast<int&>(_connectionPoolSize) = num < 1 ? 1 : num;
+        }
+
+        {
+            // Property is in kilobytes, 0 (the default) doesn't separate large and small messages.
+            Int num = _initData.properties->getPropertyAsInt("Ice.ConnectionPool.LargeMessageSize");
+            if(num < 1)
+            {
+                const_cast<size_t&>(_connectionPoolLargeMessageSize) = 0;
+            }
+            else if(static_cast<size_t>(num) > static_cast<size_t>(0x7fffffff / 1024))
+            {
+                const_cast<size_t&>(_connectionPoolLargeMessageSize) = static_cast<size_t>(0x7fffffff);
+            }
+            else
+            {
+                const_cast<size_t&>(_connectionPoolLargeMessageSize) = static_cast<size_t>(num) * 1024;
+            }
+        }
+
         {
             static const int defaultValue = 100;
             Int num = _initData.properties->getPropertyAsIntWithDefault("Ice.ClassGraphDepthMax", defaultValue);
@@ -1191,8 +1247,28 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             }
         }
 
+        {
+            Int num = _initData.properties->getPropertyAsIntWithDefault("Ice.ZeroCopySize", 1024); // 1MB default
+            if(num < 1)
+            {
+                const_cast<size_t&>(_zeroCopySize) = 0; // Disabled
+            }
+            else if(static_cast<size_t>(num) > static_cast<size_t>(0x7fffffff / 1024))
+            {
+                const_cast<size_t&>(_zeroCopySize) = static_cast<size_t>(0x7fffffff);
+            }
+            else
+            {
+                // Property is in kilobytes, convert in bytes.
+                const_cast<size_t&>(_zeroCopySize) = static_cast<size_t>(num) * 1024;
+            }
+        }
+
         const_cast<bool&>(_collectObjects) = _initData.properties->getPropertyAsInt("Ice.CollectObjects") > 0;
 
+        const_cast<bool&>(_collocationDirectDispatch) =
+            _initData.properties->getPropertyAsInt("Ice.CollocationDirectDispatch") > 0;
+
         string toStringModeStr = _initData.properties->getPropertyWithDefault("Ice.ToStringMode", "Unicode");
         if(toStringModeStr == "ASCII")
         {
@@ -1207,6 +1283,29 @@ IceInternal::Instance::Instance(const CommunicatorPtr& communicator, const Initi
             throw InitializationException(__FILE__, __LINE__, "The value for Ice.ToStringMode must be Unicode, ASCII or Compat");
         }
 
+        string compressionCodec = _initData.properties->getProperty("Ice.Compression.Codec");
+        if(!compressionCodec.empty())
+        {
+            const_cast<CompressionCodecPtr&>(_compressionCodec) = getCompressionCodec(compressionCodec);
+            if(!_compressionCodec)
+            {
+                throw InitializationException(__FILE__, __LINE__, "The compression codec `" + compressionCodec +
+                                              "' set with Ice.Compression.Codec is not supported");
+            }
+        }
+        else
+        {
+            const_cast<CompressionCodecPtr&>(_compressionCodec) = getCompressionCodec(compressionBZip2);
+        }
+
+        {
+            Int num = _initData.properties->getPropertyAsIntWithDefault("Ice.BufferPool.MaxCached", 32);
+            if(num > 0)
+            {
+                const_cast<BufferPoolPtr&>(_bufferPool) = new BufferPool(static_cast<size_t>(num));
+            }
+        }
+
         const_cast<ImplicitContextIPtr&>(_implicitContext) =
             ImplicitContextI::create(_initData.properties->getProperty("Ice.ImplicitContext"));
 
@@ -1428,6 +1527,10 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
     if(_initData.observer)
     {
         _initData.observer->setObserverUpdater(ICE_MAKE_SHARED(ObserverUpdaterI, this));
+        if(_bufferPool)
+        {
+            _bufferPool->updateObservers(_initData.observer);
+        }
     }
 
     //
@@ -1456,18 +1559,6 @@ IceInternal::Instance::finishSetup(int& argc, const char* argv[], const Ice::Com
     try
     {
         _endpointHostResolver = new EndpointHostResolver(this);
-#ifndef ICE_OS_UWP
-        bool hasPriority = _initData.properties->getProperty("Ice.ThreadPriority") != "";
-        int priority = _initData.properties->getPropertyAsInt("Ice.ThreadPriority");
-        if(hasPriority)
-        {
-            _endpointHostResolver->start(0, priority);
-        }
-        else
-        {
-            _endpointHostResolver->start();
-        }
-#endif
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -1660,12 +1751,10 @@ IceInternal::Instance::destroy()
     {
         _serverThreadPool->joinWithAllThreads();
     }
-#ifndef ICE_OS_UWP
     if(_endpointHostResolver)
     {
-        _endpointHostResolver->getThreadControl().join();
+        _endpointHostResolver->joinWithAllThreads();
     }
-#endif
 
 #ifdef ICE_CPP11_COMPILER
     for(const auto& p : _objectFactoryMap)
@@ -1739,6 +1828,11 @@ IceInternal::Instance::destroy()
         _adminAdapter = 0;
         _adminFacets.clear();
 
+        if(_bufferPool)
+        {
+            _bufferPool->destroy();
+        }
+
         _state = StateDestroyed;
         notifyAll();
     }
@@ -1782,6 +1876,10 @@ IceInternal::Instance::updateThreadObservers()
         {
             _timer->updateObserver(_initData.observer);
         }
+        if(_bufferPool)
+        {
+            _bufferPool->updateObservers(_initData.observer);
+        }
     }
     catch(const Ice::CommunicatorDestroyedException&)
     {
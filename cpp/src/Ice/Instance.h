@@ -34,6 +34,8 @@
 #include <Ice/NetworkProxyF.h>
 #include <Ice/Initialize.h>
 #include <Ice/ImplicitContextI.h>
+#include <Ice/CompressionCodec.h>
+#include <Ice/BufferPoolF.h>
 #include <Ice/FacetMap.h>
 #include <Ice/Process.h>
 #include <list>
@@ -102,10 +104,19 @@ public:
     DynamicLibraryListPtr dynamicLibraryList() const;
     Ice::PluginManagerPtr pluginManager() const;
     size_t messageSizeMax() const { return _messageSizeMax; }
+    size_t messageFragmentSize() const { return _messageFragmentSize; }
     size_t batchAutoFlushSize() const { return _batchAutoFlushSize; }
+    int batchAutoFlushDelay() const { return _batchAutoFlushDelay; }
+    bool batchAutoFlushAdaptive() const { return _batchAutoFlushAdaptive; }
+    int connectionPoolSize() const { return _connectionPoolSize; }
+    size_t connectionPoolLargeMessageSize() const { return _connectionPoolLargeMessageSize; }
     size_t classGraphDepthMax() const { return _classGraphDepthMax; }
+    size_t zeroCopySize() const { return _zeroCopySize; }
     bool collectObjects() const { return _collectObjects; }
+    bool collocationDirectDispatch() const { return _collocationDirectDispatch; }
     Ice::ToStringMode toStringMode() const { return _toStringMode; }
+    const CompressionCodecPtr& compressionCodec() const { return _compressionCodec; }
+    const BufferPoolPtr& bufferPool() const { return _bufferPool; }
     const ACMConfig& clientACM() const;
     const ACMConfig& serverACM() const;
 
@@ -171,10 +182,19 @@ private:
     const TraceLevelsPtr _traceLevels; // Immutable, not reset by destroy().
     const DefaultsAndOverridesPtr _defaultsAndOverrides; // Immutable, not reset by destroy().
     const size_t _messageSizeMax; // Immutable, not reset by destroy().
+    const size_t _messageFragmentSize; // Immutable, not reset by destroy().
     const size_t _batchAutoFlushSize; // Immutable, not reset by destroy().
+    const int _batchAutoFlushDelay; // Immutable, not reset by destroy().
+    const bool _batchAutoFlushAdaptive; // Immutable, not reset by destroy().
+    const int _connectionPoolSize; // Immutable, not reset by destroy().
+    const size_t _connectionPoolLargeMessageSize; // Immutable, not reset by destroy().
     const size_t _classGraphDepthMax; // Immutable, not reset by destroy().
+    const size_t _zeroCopySize; // Immutable, not reset by destroy().
     const bool _collectObjects; // Immutable, not reset by destroy().
+    const bool _collocationDirectDispatch; // Immutable, not reset by destroy().
     const Ice::ToStringMode _toStringMode; // Immutable, not reset by destroy()
+    const CompressionCodecPtr _compressionCodec; // Immutable, not reset by destroy()
+    const BufferPoolPtr _bufferPool; // Immutable, not reset by destroy()
     ACMConfig _clientACM;
     ACMConfig _serverACM;
     RouterManagerPtr _routerManager;
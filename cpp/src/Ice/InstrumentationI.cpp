@@ -67,6 +67,47 @@ struct ThreadStateChanged
     ThreadState newState;
 };
 
+struct Compressed
+{
+    Compressed(Int compressedSizeP, Int uncompressedSizeP, Long durationP) :
+        compressedSize(compressedSizeP), uncompressedSize(uncompressedSizeP), duration(durationP)
+    {
+    }
+
+    void operator()(const ConnectionMetricsPtr& v)
+    {
+        //
+        // The compression metrics are optional to remain compatible with
+        // older versions, they are only set once a message is compressed.
+        //
+        v->compressedBytes = v->compressedBytes ? *v->compressedBytes + compressedSize : compressedSize;
+        v->uncompressedBytes = v->uncompressedBytes ? *v->uncompressedBytes + uncompressedSize : uncompressedSize;
+        v->compressionTime = v->compressionTime ? *v->compressionTime + duration : duration;
+    }
+
+    Long compressedSize;
+    Long uncompressedSize;
+    Long duration;
+};
+
+struct BufferAllocated
+{
+    BufferAllocated(bool hitP) : hit(hitP)
+    {
+    }
+
+    void operator()(const BufferPoolMetricsPtr& v)
+    {
+        ++v->allocations;
+        if(hit)
+        {
+            ++v->hits;
+        }
+    }
+
+    bool hit;
+};
+
 IPConnectionInfo*
 getIPConnectionInfo(const ConnectionInfoPtr& info)
 {
@@ -695,6 +736,76 @@ private:
 
 ThreadHelper::Attributes ThreadHelper::attributes;
 
+class BufferPoolHelper : public MetricsHelperT<BufferPoolMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<BufferPoolHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &BufferPoolHelper::_parent);
+            add("id", &BufferPoolHelper::_id);
+        }
+    };
+    static Attributes attributes;
+
+    BufferPoolHelper(size_t size) : _parent("Communicator")
+    {
+        ostringstream os;
+        os << size;
+        _id = os.str();
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+private:
+
+    const string _parent;
+    string _id;
+};
+
+BufferPoolHelper::Attributes BufferPoolHelper::attributes;
+
+class HostResolverHelper : public MetricsHelperT<HostResolverMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<HostResolverHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &HostResolverHelper::_parent);
+            add("id", &HostResolverHelper::_host);
+            add("host", &HostResolverHelper::_host);
+        }
+    };
+    static Attributes attributes;
+
+    HostResolverHelper(const string& host) : _parent("Communicator"), _host(host)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+private:
+
+    const string _parent;
+    const string _host;
+};
+
+HostResolverHelper::Attributes HostResolverHelper::attributes;
+
 class EndpointHelper : public MetricsHelperT<Metrics>
 {
 public:
@@ -788,6 +899,12 @@ ConnectionObserverI::receivedBytes(Int num)
     }
 }
 
+void
+ConnectionObserverI::compressed(Int compressedSize, Int uncompressedSize, Long duration)
+{
+    forEach(Compressed(compressedSize, uncompressedSize, duration));
+}
+
 void
 ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 {
@@ -799,6 +916,24 @@ ThreadObserverI::stateChanged(ThreadState oldState, ThreadState newState)
 
 }
 
+void
+BufferPoolObserverI::allocated(bool hit)
+{
+    forEach(BufferAllocated(hit));
+}
+
+void
+HostResolverObserverI::hit()
+{
+    forEach(inc(&HostResolverMetrics::hits));
+}
+
+void
+HostResolverObserverI::coalesced()
+{
+    forEach(inc(&HostResolverMetrics::coalesced));
+}
+
 void
 DispatchObserverI::userException()
 {
@@ -910,7 +1045,9 @@ CommunicatorObserverI::CommunicatorObserverI(const InitializationData& initData)
     _invocations(_metrics, "Invocation"),
     _threads(_metrics, "Thread"),
     _connects(_metrics, "ConnectionEstablishment"),
-    _endpointLookups(_metrics, "EndpointLookup")
+    _endpointLookups(_metrics, "EndpointLookup"),
+    _bufferPools(_metrics, "BufferPool"),
+    _hostResolvers(_metrics, "HostResolver")
 {
     _invocations.registerSubMap<RemoteMetrics>("Remote", &InvocationMetrics::remotes);
     _invocations.registerSubMap<CollocatedMetrics>("Collocated", &InvocationMetrics::collocated);
@@ -921,6 +1058,12 @@ CommunicatorObserverI::setObserverUpdater(const ObserverUpdaterPtr& updater)
 {
     _connections.setUpdater(newUpdater(updater, &ObserverUpdater::updateConnectionObservers));
     _threads.setUpdater(newUpdater(updater, &ObserverUpdater::updateThreadObservers));
+
+    //
+    // The ObserverUpdater interface has no operation for the buffer pool
+    // observers, they are updated with the thread observers.
+    //
+    _bufferPools.setUpdater(newUpdater(updater, &ObserverUpdater::updateThreadObservers));
     if(_delegate)
     {
         _delegate->setObserverUpdater(updater);
@@ -1073,6 +1216,42 @@ CommunicatorObserverI::getDispatchObserver(const Current& current, int size)
     return ICE_NULLPTR;
 }
 
+ObserverPtr
+CommunicatorObserverI::getBufferPoolObserver(size_t size, const ObserverPtr& observer)
+{
+    if(_bufferPools.isEnabled())
+    {
+        try
+        {
+            return _bufferPools.getObserverWithDelegate(BufferPoolHelper(size), ObserverPtr(), observer);
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
+ObserverPtr
+CommunicatorObserverI::getHostResolverObserver(const string& host)
+{
+    if(_hostResolvers.isEnabled())
+    {
+        try
+        {
+            return _hostResolvers.getObserver(HostResolverHelper(host));
+        }
+        catch(const exception& ex)
+        {
+            Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return ICE_NULLPTR;
+}
+
 const IceInternal::MetricsAdminIPtr&
 CommunicatorObserverI::getFacet() const
 {
@@ -1089,6 +1268,8 @@ CommunicatorObserverI::destroy()
     _threads.destroy();
     _connects.destroy();
     _endpointLookups.destroy();
+    _bufferPools.destroy();
+    _hostResolvers.destroy();
 
     _metrics->destroy();
 }
@@ -153,6 +153,12 @@ public:
 
     virtual void sentBytes(Ice::Int);
     virtual void receivedBytes(Ice::Int);
+
+    //
+    // Not part of the Instrumentation::ConnectionObserver interface, called
+    // by the connection when a message is compressed or uncompressed.
+    //
+    void compressed(Ice::Int, Ice::Int, Ice::Long);
 };
 
 class ThreadObserverI : public ObserverWithDelegateT<IceMX::ThreadMetrics, Ice::Instrumentation::ThreadObserver>
@@ -204,6 +210,29 @@ public:
 
 typedef ObserverWithDelegateT<IceMX::Metrics, Ice::Instrumentation::Observer> ObserverI;
 
+class BufferPoolObserverI : public ObserverWithDelegateT<IceMX::BufferPoolMetrics, Ice::Instrumentation::Observer>
+{
+public:
+
+    //
+    // Called by the buffer pool when a buffer of the observed size class
+    // is allocated, the argument is true if it's a cached buffer.
+    //
+    void allocated(bool);
+};
+
+class HostResolverObserverI : public ObserverWithDelegateT<IceMX::HostResolverMetrics, Ice::Instrumentation::Observer>
+{
+public:
+
+    //
+    // Called by the host resolver when the resolution is served by its
+    // cache or waits for a lookup of the same host already in progress.
+    //
+    void hit();
+    void coalesced();
+};
+
 class ICE_API CommunicatorObserverI : public Ice::Instrumentation::CommunicatorObserver
 {
 public:
@@ -233,6 +262,14 @@ public:
 
     virtual Ice::Instrumentation::DispatchObserverPtr getDispatchObserver(const Ice::Current&, Ice::Int);
 
+    //
+    // Not part of the Instrumentation::CommunicatorObserver interface, the
+    // buffer pool and host resolver observers are only provided by the
+    // metrics facet.
+    //
+    Ice::Instrumentation::ObserverPtr getBufferPoolObserver(size_t, const Ice::Instrumentation::ObserverPtr&);
+    Ice::Instrumentation::ObserverPtr getHostResolverObserver(const std::string&);
+
     const IceInternal::MetricsAdminIPtr& getFacet() const;
 
     void destroy();
@@ -248,6 +285,8 @@ private:
     ObserverFactoryWithDelegateT<ThreadObserverI> _threads;
     ObserverFactoryWithDelegateT<ObserverI> _connects;
     ObserverFactoryWithDelegateT<ObserverI> _endpointLookups;
+    ObserverFactoryWithDelegateT<BufferPoolObserverI> _bufferPools;
+    ObserverFactoryWithDelegateT<HostResolverObserverI> _hostResolvers;
 };
 ICE_DEFINE_PTR(CommunicatorObserverIPtr, CommunicatorObserverI);
 
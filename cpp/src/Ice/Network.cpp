@@ -135,46 +135,6 @@ public:
 };
 #   endif
 
-void
-sortAddresses(vector<Address>& addrs, ProtocolSupport protocol, Ice::EndpointSelectionType selType, bool preferIPv6)
-{
-    if(selType == Ice::ICE_ENUM(EndpointSelectionType, Random))
-    {
-        IceUtilInternal::shuffle(addrs.begin(), addrs.end());
-    }
-
-    if(protocol == EnableBoth)
-    {
-#ifdef ICE_CPP11_COMPILER
-        if(preferIPv6)
-        {
-            stable_partition(addrs.begin(), addrs.end(),
-                             [](const Address& ss)
-                             {
-                                 return ss.saStorage.ss_family == AF_INET6;
-                             });
-        }
-        else
-        {
-            stable_partition(addrs.begin(), addrs.end(),
-                             [](const Address& ss)
-                             {
-                                 return ss.saStorage.ss_family != AF_INET6;
-                             });
-        }
-#else
-        if(preferIPv6)
-        {
-            stable_partition(addrs.begin(), addrs.end(), AddressIsIPv6());
-        }
-        else
-        {
-            stable_partition(addrs.begin(), addrs.end(), not1(AddressIsIPv6()));
-        }
-#endif
-    }
-}
-
 void
 setTcpNoDelay(SOCKET fd)
 {
@@ -1136,6 +1096,52 @@ IceInternal::getAddresses(const string& host, int port, ProtocolSupport, Ice::En
 
 }
 #else
+void
+IceInternal::sortAddresses(vector<Address>& addrs, ProtocolSupport protocol, Ice::EndpointSelectionType selType,
+                            bool preferIPv6)
+{
+    //
+    // Only the ordered endpoint selection preserves the order of the
+    // addresses, the latency-aware selections pick among the endpoints
+    // and not among the addresses of an endpoint.
+    //
+    if(selType != Ice::ICE_ENUM(EndpointSelectionType, Ordered))
+    {
+        IceUtilInternal::shuffle(addrs.begin(), addrs.end());
+    }
+
+    if(protocol == EnableBoth)
+    {
+#ifdef ICE_CPP11_COMPILER
+        if(preferIPv6)
+        {
+            stable_partition(addrs.begin(), addrs.end(),
+                             [](const Address& ss)
+                             {
+                                 return ss.saStorage.ss_family == AF_INET6;
+                             });
+        }
+        else
+        {
+            stable_partition(addrs.begin(), addrs.end(),
+                             [](const Address& ss)
+                             {
+                                 return ss.saStorage.ss_family != AF_INET6;
+                             });
+        }
+#else
+        if(preferIPv6)
+        {
+            stable_partition(addrs.begin(), addrs.end(), AddressIsIPv6());
+        }
+        else
+        {
+            stable_partition(addrs.begin(), addrs.end(), not1(AddressIsIPv6()));
+        }
+#endif
+    }
+}
+
 vector<Address>
 IceInternal::getAddresses(const string& host, int port, ProtocolSupport protocol, Ice::EndpointSelectionType selType,
                           bool preferIPv6, bool canBlock)
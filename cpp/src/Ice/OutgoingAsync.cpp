@@ -14,12 +14,39 @@
 #include <Ice/RetryQueue.h>
 #include <Ice/ConnectionFactory.h>
 #include <Ice/ObjectAdapterFactory.h>
+#include <Ice/ObjectAdapterI.h>
 #include <Ice/LoggerUtil.h>
+#include <Ice/StringUtil.h>
 
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
 
+#ifdef ICE_CPP11_MAPPING
+namespace IceUtilInternal
+{
+
+extern bool printStackTraces;
+
+}
+
+namespace
+{
+
+template<typename T> void
+warnCollocatedDispatch(const InstancePtr& instance, const Current& current, const T& ex)
+{
+    Warning out(instance->initializationData().logger);
+    ToStringMode toStringMode = instance->toStringMode();
+    out << "dispatch exception: " << ex;
+    out << "\nidentity: " << identityToString(current.id, toStringMode);
+    out << "\nfacet: " << escapeString(current.facet, "", toStringMode);
+    out << "\noperation: " << current.operation;
+}
+
+}
+#endif
+
 #ifndef ICE_CPP11_MAPPING
 IceUtil::Shared* IceInternal::upCast(OutgoingAsyncBase* p) { return p; }
 IceUtil::Shared* IceInternal::upCast(ProxyOutgoingAsyncBase* p) { return p; }
@@ -865,6 +892,21 @@ OutgoingAsync::prepare(const string& operation, OperationMode mode, const Contex
     {
         case Reference::ModeTwoway:
         case Reference::ModeOneway:
+        {
+            _os.writeBlob(requestHdr, sizeof(requestHdr));
+
+            //
+            // Synchronous invocations can reference large byte sequences instead of
+            // copying them: the caller waits for the invocation to complete, so the
+            // sequences remain valid while the request is sent or retried.
+            //
+            if(_synchronous)
+            {
+                _os.setZeroCopySize(_instance->zeroCopySize());
+            }
+            break;
+        }
+
         case Reference::ModeDatagram:
         {
             _os.writeBlob(requestHdr, sizeof(requestHdr));
@@ -1092,7 +1134,21 @@ AsyncStatus
 OutgoingAsync::invokeRemote(const ConnectionIPtr& connection, bool compress, bool response)
 {
     _cachedConnection = connection;
-    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, compress, response, 0);
+
+    //
+    // Compress the request with the codec of the proxy, if any, otherwise with
+    // the codec of the connection.
+    //
+    Byte codec = 0;
+    if(compress)
+    {
+        codec = _proxy->_getReference()->getCompressionCodec();
+        if(codec == 0)
+        {
+            codec = 1;
+        }
+    }
+    return connection->sendAsyncRequest(ICE_SHARED_FROM_THIS, codec, response, 0);
 }
 
 AsyncStatus
@@ -1186,6 +1242,182 @@ OutgoingAsync::throwUserException()
     }
 }
 
+ObjectPtr
+OutgoingAsync::startCollocatedDispatch(const string& operation, OperationMode mode, const Context& context,
+                                       Current& current)
+{
+    //
+    // Only synchronous two-way invocations are dispatched directly, the caller thread is
+    // used for the dispatch. The invocation is also sent with the regular collocated
+    // invocation if it must be observed or if it's subject to an invocation timeout.
+    //
+    if(!_synchronous || !_instance->collocationDirectDispatch() || _instance->initializationData().observer)
+    {
+        return nullptr;
+    }
+
+    Reference* ref = _proxy->_getReference().get();
+    if(ref->getMode() != Reference::ModeTwoway || ref->getInvocationTimeout() > 0)
+    {
+        return nullptr;
+    }
+
+    CollocatedRequestHandlerPtr handler;
+    try
+    {
+        handler = dynamic_pointer_cast<CollocatedRequestHandler>(_proxy->_getRequestHandler());
+    }
+    catch(const LocalException&)
+    {
+        return nullptr; // The regular invocation will report the failure.
+    }
+
+    if(!handler)
+    {
+        return nullptr;
+    }
+
+    ObjectPtr servant = handler->startDirectDispatch(current);
+    if(!servant)
+    {
+        return nullptr;
+    }
+
+    current.operation = operation;
+    current.mode = mode;
+    current.encoding = _encoding;
+    if(&context != &Ice::noExplicitContext)
+    {
+        current.ctx = context;
+    }
+    else
+    {
+        const ImplicitContextIPtr& implicitContext = ref->getInstance()->getImplicitContext();
+        const Context& prxContext = ref->getContext()->getValue();
+        if(implicitContext == 0)
+        {
+            current.ctx = prxContext;
+        }
+        else
+        {
+            implicitContext->combine(prxContext, current.ctx);
+        }
+    }
+    return servant;
+}
+
+void
+OutgoingAsync::finishCollocatedDispatch(Current& current)
+{
+    if(current.adapter)
+    {
+        dynamic_cast<ObjectAdapterI*>(current.adapter.get())->decDirectCount();
+        current.adapter = nullptr;
+    }
+}
+
+void
+OutgoingAsync::throwCollocatedException(const Current& current)
+{
+    //
+    // Must be called from a catch block. The exception raised by the servant is translated
+    // to the exception the invocation would raise if the reply was marshaled.
+    //
+    const int warnDispatch =
+        _instance->initializationData().properties->getPropertyAsIntWithDefault("Ice.Warn.Dispatch", 1);
+    try
+    {
+        throw;
+    }
+    catch(const UserException& ex)
+    {
+        if(_userException)
+        {
+            _userException(ex);
+        }
+        throw UnknownUserException(__FILE__, __LINE__, ex.ice_id());
+    }
+    catch(RequestFailedException& ex)
+    {
+        if(ex.id.name.empty())
+        {
+            ex.id = current.id;
+        }
+
+        if(ex.facet.empty() && !current.facet.empty())
+        {
+            ex.facet = current.facet;
+        }
+
+        if(ex.operation.empty() && !current.operation.empty())
+        {
+            ex.operation = current.operation;
+        }
+
+        if(warnDispatch > 1)
+        {
+            warnCollocatedDispatch(_instance, current, ex);
+        }
+        throw;
+    }
+    catch(const SystemException&)
+    {
+        throw;
+    }
+    catch(const UnknownException& ex)
+    {
+        if(warnDispatch > 0)
+        {
+            warnCollocatedDispatch(_instance, current, ex);
+        }
+        throw;
+    }
+    catch(const LocalException& ex)
+    {
+        if(warnDispatch > 0)
+        {
+            warnCollocatedDispatch(_instance, current, ex);
+        }
+        ostringstream str;
+        str << ex;
+        if(IceUtilInternal::printStackTraces)
+        {
+            str << '\n' << ex.ice_stackTrace();
+        }
+        throw UnknownLocalException(__FILE__, __LINE__, str.str());
+    }
+    catch(const Ice::Exception& ex)
+    {
+        if(warnDispatch > 0)
+        {
+            warnCollocatedDispatch(_instance, current, ex);
+        }
+        ostringstream str;
+        str << ex;
+        if(IceUtilInternal::printStackTraces)
+        {
+            str << '\n' << ex.ice_stackTrace();
+        }
+        throw UnknownException(__FILE__, __LINE__, str.str());
+    }
+    catch(const std::exception& ex)
+    {
+        if(warnDispatch > 0)
+        {
+            warnCollocatedDispatch(_instance, current, string("std::exception: ") + ex.what());
+        }
+        throw UnknownException(__FILE__, __LINE__, string("std::exception: ") + ex.what());
+    }
+    catch(...)
+    {
+        if(warnDispatch > 0)
+        {
+            warnCollocatedDispatch(_instance, current, "unknown c++ exception");
+        }
+        throw UnknownException(__FILE__, __LINE__, "unknown c++ exception");
+    }
+}
+
 #endif
 
 #ifdef ICE_CPP11_MAPPING
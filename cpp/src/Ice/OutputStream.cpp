@@ -3,6 +3,7 @@
 //
 
 #include <Ice/OutputStream.h>
+#include <Ice/BufferPool.h>
 #include <Ice/DefaultsAndOverrides.h>
 #include <Ice/Instance.h>
 #include <Ice/Object.h>
@@ -130,6 +131,8 @@ Ice::OutputStream::initialize(Instance* instance, const EncodingVersion& encodin
     _encoding = encoding;
 
     _format = _instance->defaultsAndOverrides()->defaultFormat;
+
+    b.setPool(_instance->bufferPool().get());
 }
 
 void
@@ -252,7 +255,21 @@ Ice::OutputStream::write(const Byte* begin, const Byte* end)
 {
     Int sz = static_cast<Int>(end - begin);
     writeSize(sz);
-    if(sz > 0)
+    BufferSegments* segments = b.segments();
+    if(segments && static_cast<size_t>(sz) >= segments->zeroCopySize)
+    {
+        //
+        // Reference the sequence instead of copying it. The last byte is
+        // copied to ensure the segment is followed by a byte of the buffer.
+        //
+        BufferSegment segment;
+        segment.offset = b.size();
+        segment.begin = begin;
+        segment.end = end - 1;
+        segments->segments.push_back(segment);
+        b.push_back(*(end - 1));
+    }
+    else if(sz > 0)
     {
         Container::size_type pos = b.size();
         resize(pos + sz);
@@ -831,15 +848,28 @@ Ice::OutputStream::writeOptImpl(Int tag, OptionalFormat type)
     return true;
 }
 
+void
+Ice::OutputStream::setZeroCopySize(size_t sz)
+{
+    //
+    // The segments are stored with the memory of the buffer, which already
+    // holds the message header.
+    //
+    assert(!b.empty());
+    b.setSegments(sz > 0 ? new BufferSegments(sz) : 0);
+}
+
 void
 Ice::OutputStream::finished(vector<Byte>& bytes)
 {
+    copySegments();
     vector<Byte>(b.begin(), b.end()).swap(bytes);
 }
 
 pair<const Byte*, const Byte*>
 Ice::OutputStream::finished()
 {
+    copySegments();
     if(b.empty())
     {
         return pair<const Byte*, const Byte*>(reinterpret_cast<Ice::Byte*>(0), reinterpret_cast<Ice::Byte*>(0));
@@ -999,7 +1029,7 @@ Ice::OutputStream::EncapsEncoder10::endSlice()
     //
     // Write the slice length.
     //
-    Int sz = static_cast<Int>(_stream->b.size() - _writeSlice + sizeof(Int));
+    Int sz = static_cast<Int>(_stream->b.size() - _writeSlice + sizeof(Int) + _stream->segmentsSize(_writeSlice));
     Byte* dest = &(*(_stream->b.begin() + _writeSlice - sizeof(Int)));
     _stream->write(sz, dest);
 }
@@ -1233,7 +1263,8 @@ Ice::OutputStream::EncapsEncoder11::endSlice()
     //
     if(_current->sliceFlags & FLAG_HAS_SLICE_SIZE)
     {
-        Int sz = static_cast<Int>(_stream->b.size() - _current->writeSlice + sizeof(Int));
+        Int sz = static_cast<Int>(_stream->b.size() - _current->writeSlice + sizeof(Int) +
+                                  _stream->segmentsSize(_current->writeSlice));
         Byte* dest = &(*(_stream->b.begin() + _current->writeSlice - sizeof(Int)));
         _stream->write(sz, dest);
     }
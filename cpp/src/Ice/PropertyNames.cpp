@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Thu Oct 25 22:10:11 2018
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 09:28:45 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -34,6 +34,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.Locator.PreferSecure", false, 0),
     IceInternal::Property("Ice.Admin.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Admin.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Admin.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Ice.Admin.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Ice.Admin.Locator.CompressionCodec", false, 0),
     IceInternal::Property("Ice.Admin.Locator.Locator", false, 0),
     IceInternal::Property("Ice.Admin.Locator.Router", false, 0),
     IceInternal::Property("Ice.Admin.Locator.CollocationOptimized", false, 0),
@@ -46,6 +49,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.Router.PreferSecure", false, 0),
     IceInternal::Property("Ice.Admin.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Admin.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Admin.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Ice.Admin.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Ice.Admin.Router.CompressionCodec", false, 0),
     IceInternal::Property("Ice.Admin.Router.Locator", false, 0),
     IceInternal::Property("Ice.Admin.Router.Router", false, 0),
     IceInternal::Property("Ice.Admin.Router.CollocationOptimized", false, 0),
@@ -57,6 +63,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Ice.Admin.ThreadPool.Mode", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.Admin.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Ice.Admin.MessageSizeMax", false, 0),
@@ -70,13 +77,20 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Admin.ServerId", false, 0),
     IceInternal::Property("Ice.BackgroundLocatorCacheUpdates", false, 0),
     IceInternal::Property("Ice.BatchAutoFlush", true, 0),
+    IceInternal::Property("Ice.BatchAutoFlushAdaptive", false, 0),
+    IceInternal::Property("Ice.BatchAutoFlushDelay", false, 0),
     IceInternal::Property("Ice.BatchAutoFlushSize", false, 0),
+    IceInternal::Property("Ice.BufferPool.MaxCached", false, 0),
     IceInternal::Property("Ice.ChangeUser", false, 0),
     IceInternal::Property("Ice.ClassGraphDepthMax", false, 0),
     IceInternal::Property("Ice.ClientAccessPolicyProtocol", false, 0),
+    IceInternal::Property("Ice.Compression.Codec", false, 0),
     IceInternal::Property("Ice.Compression.Level", false, 0),
     IceInternal::Property("Ice.CollectObjects", false, 0),
+    IceInternal::Property("Ice.CollocationDirectDispatch", false, 0),
     IceInternal::Property("Ice.Config", false, 0),
+    IceInternal::Property("Ice.ConnectionPool.LargeMessageSize", false, 0),
+    IceInternal::Property("Ice.ConnectionPool.Size", false, 0),
     IceInternal::Property("Ice.ConsoleListener", false, 0),
     IceInternal::Property("Ice.Default.CollocationOptimized", false, 0),
     IceInternal::Property("Ice.Default.EncodingVersion", false, 0),
@@ -87,6 +101,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Locator.PreferSecure", false, 0),
     IceInternal::Property("Ice.Default.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Default.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Default.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Ice.Default.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Ice.Default.Locator.CompressionCodec", false, 0),
     IceInternal::Property("Ice.Default.Locator.Locator", false, 0),
     IceInternal::Property("Ice.Default.Locator.Router", false, 0),
     IceInternal::Property("Ice.Default.Locator.CollocationOptimized", false, 0),
@@ -102,6 +119,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.Default.Router.PreferSecure", false, 0),
     IceInternal::Property("Ice.Default.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Ice.Default.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Ice.Default.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Ice.Default.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Ice.Default.Router.CompressionCodec", false, 0),
     IceInternal::Property("Ice.Default.Router.Locator", false, 0),
     IceInternal::Property("Ice.Default.Router.Router", false, 0),
     IceInternal::Property("Ice.Default.Router.CollocationOptimized", false, 0),
@@ -114,6 +134,9 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.FactoryAssemblies", false, 0),
     IceInternal::Property("Ice.HTTPProxyHost", false, 0),
     IceInternal::Property("Ice.HTTPProxyPort", false, 0),
+    IceInternal::Property("Ice.HostResolver.CacheTTL", false, 0),
+    IceInternal::Property("Ice.HostResolver.NegativeCacheTTL", false, 0),
+    IceInternal::Property("Ice.HostResolver.Size", false, 0),
     IceInternal::Property("Ice.ImplicitContext", false, 0),
     IceInternal::Property("Ice.InitPlugins", false, 0),
     IceInternal::Property("Ice.IPv4", false, 0),
@@ -121,6 +144,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.LogFile", false, 0),
     IceInternal::Property("Ice.LogFile.SizeMax", false, 0),
     IceInternal::Property("Ice.LogStdErr.Convert", false, 0),
+    IceInternal::Property("Ice.MessageFragmentSize", false, 0),
     IceInternal::Property("Ice.MessageSizeMax", false, 0),
     IceInternal::Property("Ice.Nohup", false, 0),
     IceInternal::Property("Ice.NullHandleAbort", false, 0),
@@ -150,6 +174,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Client.SizeWarn", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.StackSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.Serialize", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Client.Mode", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Client.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Size", false, 0),
@@ -157,6 +182,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.ThreadPool.Server.SizeWarn", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.StackSize", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.Serialize", false, 0),
+    IceInternal::Property("Ice.ThreadPool.Server.Mode", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadIdleTime", false, 0),
     IceInternal::Property("Ice.ThreadPool.Server.ThreadPriority", false, 0),
     IceInternal::Property("Ice.ThreadPriority", false, 0),
@@ -187,6 +213,7 @@ const IceInternal::Property IcePropsData[] =
     IceInternal::Property("Ice.CacheMessageBuffers", false, 0),
     IceInternal::Property("Ice.ThreadInterruptSafe", false, 0),
     IceInternal::Property("Ice.Voip", true, 0),
+    IceInternal::Property("Ice.ZeroCopySize", false, 0),
 };
 
 const IceInternal::PropertyArray
@@ -220,6 +247,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Locator.CollocationOptimized", false, 0),
@@ -232,6 +262,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.Router.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.Router.CollocationOptimized", false, 0),
@@ -243,6 +276,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Multicast.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Multicast.MessageSizeMax", false, 0),
@@ -257,6 +291,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Locator.CollocationOptimized", false, 0),
@@ -269,6 +306,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.Router.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Reply.Router.CollocationOptimized", false, 0),
@@ -280,6 +320,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Reply.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Reply.MessageSizeMax", false, 0),
@@ -294,6 +335,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Locator.CollocationOptimized", false, 0),
@@ -306,6 +350,9 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.Router.PreferSecure", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.Locator", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceDiscovery.Locator.Router.CollocationOptimized", false, 0),
@@ -317,6 +364,7 @@ const IceInternal::Property IceDiscoveryPropsData[] =
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceDiscovery.Locator.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceDiscovery.Locator.MessageSizeMax", false, 0),
@@ -347,6 +395,9 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Locator.CollocationOptimized", false, 0),
@@ -359,6 +410,9 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.Router.CollocationOptimized", false, 0),
@@ -370,6 +424,7 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Reply.MessageSizeMax", false, 0),
@@ -384,6 +439,9 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Locator.CollocationOptimized", false, 0),
@@ -396,6 +454,9 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.PreferSecure", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.Locator", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.Router.CollocationOptimized", false, 0),
@@ -407,6 +468,7 @@ const IceInternal::Property IceLocatorDiscoveryPropsData[] =
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceLocatorDiscovery.Locator.MessageSizeMax", false, 0),
@@ -457,6 +519,9 @@ const IceInternal::Property IceBoxAdminPropsData[] =
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.PreferSecure", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.InvocationTimeout", false, 0),
+    IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.CompressionCodec", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.Locator", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.Router", false, 0),
     IceInternal::Property("IceBoxAdmin.ServiceManager.Proxy.CollocationOptimized", false, 0),
@@ -481,6 +546,9 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceBridge.Source.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceBridge.Source.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceBridge.Source.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceBridge.Source.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceBridge.Source.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceBridge.Source.Locator.Locator", false, 0),
     IceInternal::Property("IceBridge.Source.Locator.Router", false, 0),
     IceInternal::Property("IceBridge.Source.Locator.CollocationOptimized", false, 0),
@@ -493,6 +561,9 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.Router.PreferSecure", false, 0),
     IceInternal::Property("IceBridge.Source.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceBridge.Source.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceBridge.Source.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceBridge.Source.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceBridge.Source.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceBridge.Source.Router.Locator", false, 0),
     IceInternal::Property("IceBridge.Source.Router.Router", false, 0),
     IceInternal::Property("IceBridge.Source.Router.CollocationOptimized", false, 0),
@@ -504,6 +575,7 @@ const IceInternal::Property IceBridgePropsData[] =
     IceInternal::Property("IceBridge.Source.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceBridge.Source.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceBridge.Source.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceBridge.Source.MessageSizeMax", false, 0),
@@ -536,6 +608,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Locator.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Locator.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Locator.CollocationOptimized", false, 0),
@@ -548,6 +623,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Router.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Server.Router.CollocationOptimized", false, 0),
@@ -559,6 +637,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Server.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Server.MessageSizeMax", false, 0),
@@ -576,6 +655,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Locator.CollocationOptimized", false, 0),
@@ -588,6 +670,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.Router.CollocationOptimized", false, 0),
@@ -599,6 +684,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Reply.MessageSizeMax", false, 0),
@@ -613,6 +699,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Locator.CollocationOptimized", false, 0),
@@ -625,6 +714,9 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.Locator", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.Router", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.Router.CollocationOptimized", false, 0),
@@ -636,6 +728,7 @@ const IceInternal::Property IceGridAdminPropsData[] =
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGridAdmin.Discovery.Locator.MessageSizeMax", false, 0),
@@ -660,6 +753,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Locator.CollocationOptimized", false, 0),
@@ -672,6 +768,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.Router", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.Router.CollocationOptimized", false, 0),
@@ -683,6 +782,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.AdminRouter.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.AdminRouter.MessageSizeMax", false, 0),
@@ -698,6 +798,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Node.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Node.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Node.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Node.Locator.CollocationOptimized", false, 0),
@@ -710,6 +813,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Node.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Node.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Node.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Node.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Node.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Node.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Node.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Node.Router.CollocationOptimized", false, 0),
@@ -721,6 +827,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Node.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Node.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Node.MessageSizeMax", false, 0),
@@ -747,6 +854,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Node.UserAccountMapper.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Node.UserAccountMapper.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Node.UserAccountMapper.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Node.UserAccountMapper.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.Locator", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.Router", false, 0),
     IceInternal::Property("IceGrid.Node.UserAccountMapper.CollocationOptimized", false, 0),
@@ -759,6 +869,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminPermissionsVerifier.CollocationOptimized", false, 0),
@@ -776,6 +889,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Locator.CollocationOptimized", false, 0),
@@ -788,6 +904,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.Router.CollocationOptimized", false, 0),
@@ -799,6 +918,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSessionManager.MessageSizeMax", false, 0),
@@ -807,6 +927,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.AdminSSLPermissionsVerifier.CollocationOptimized", false, 0),
@@ -823,6 +946,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Locator.CollocationOptimized", false, 0),
@@ -835,6 +961,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.Router.CollocationOptimized", false, 0),
@@ -846,6 +975,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Client.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Client.MessageSizeMax", false, 0),
@@ -862,6 +992,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Locator.CollocationOptimized", false, 0),
@@ -874,6 +1007,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.Router.CollocationOptimized", false, 0),
@@ -885,6 +1021,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Discovery.MessageSizeMax", false, 0),
@@ -904,6 +1041,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Locator.CollocationOptimized", false, 0),
@@ -916,6 +1056,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.Router.CollocationOptimized", false, 0),
@@ -927,10 +1070,14 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Internal.MessageSizeMax", false, 0),
+    IceInternal::Property("IceGrid.Registry.LMDB.GroupCommitWindow", false, 0),
+    IceInternal::Property("IceGrid.Registry.LMDB.MapGrowthThreshold", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.MapSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.LMDB.MaxMapSize", false, 0),
     IceInternal::Property("IceGrid.Registry.LMDB.Path", false, 0),
     IceInternal::Property("IceGrid.Registry.NodeSessionTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.EndpointSelection", false, 0),
@@ -938,6 +1085,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.PermissionsVerifier.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.PermissionsVerifier.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.PermissionsVerifier.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.PermissionsVerifier.CollocationOptimized", false, 0),
@@ -958,6 +1108,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Locator.CollocationOptimized", false, 0),
@@ -970,6 +1123,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.Router.CollocationOptimized", false, 0),
@@ -981,6 +1137,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.Server.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.Server.MessageSizeMax", false, 0),
@@ -996,6 +1153,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Locator.CollocationOptimized", false, 0),
@@ -1008,6 +1168,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.Router.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.Router.CollocationOptimized", false, 0),
@@ -1019,6 +1182,7 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.Mode", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IceGrid.Registry.SessionManager.MessageSizeMax", false, 0),
@@ -1028,6 +1192,9 @@ const IceInternal::Property IceGridPropsData[] =
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.CompressionCodec", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.Router", false, 0),
     IceInternal::Property("IceGrid.Registry.SSLPermissionsVerifier.CollocationOptimized", false, 0),
@@ -1067,6 +1234,9 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.Locator.PreferSecure", false, 0),
     IceInternal::Property("IcePatch2.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IcePatch2.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("IcePatch2.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IcePatch2.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IcePatch2.Locator.CompressionCodec", false, 0),
     IceInternal::Property("IcePatch2.Locator.Locator", false, 0),
     IceInternal::Property("IcePatch2.Locator.Router", false, 0),
     IceInternal::Property("IcePatch2.Locator.CollocationOptimized", false, 0),
@@ -1079,6 +1249,9 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.Router.PreferSecure", false, 0),
     IceInternal::Property("IcePatch2.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("IcePatch2.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("IcePatch2.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("IcePatch2.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("IcePatch2.Router.CompressionCodec", false, 0),
     IceInternal::Property("IcePatch2.Router.Locator", false, 0),
     IceInternal::Property("IcePatch2.Router.Router", false, 0),
     IceInternal::Property("IcePatch2.Router.CollocationOptimized", false, 0),
@@ -1090,11 +1263,14 @@ const IceInternal::Property IcePatch2PropsData[] =
     IceInternal::Property("IcePatch2.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.StackSize", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("IcePatch2.ThreadPool.Mode", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("IcePatch2.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("IcePatch2.MessageSizeMax", false, 0),
+    IceInternal::Property("IcePatch2.CacheSize", false, 0),
     IceInternal::Property("IcePatch2.Directory", false, 0),
     IceInternal::Property("IcePatch2.InstanceName", false, 0),
+    IceInternal::Property("IcePatch2.ReadAhead", false, 0),
 };
 
 const IceInternal::PropertyArray
@@ -1104,6 +1280,7 @@ const IceInternal::PropertyArray
 const IceInternal::Property IcePatch2ClientPropsData[] =
 {
     IceInternal::Property("IcePatch2Client.ChunkSize", false, 0),
+    IceInternal::Property("IcePatch2Client.Concurrency", false, 0),
     IceInternal::Property("IcePatch2Client.Directory", false, 0),
     IceInternal::Property("IcePatch2Client.Proxy", false, 0),
     IceInternal::Property("IcePatch2Client.Remove", false, 0),
@@ -1200,6 +1377,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.Locator.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Client.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.Client.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.Client.Locator.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.Locator", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.Router", false, 0),
     IceInternal::Property("Glacier2.Client.Locator.CollocationOptimized", false, 0),
@@ -1212,6 +1392,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.Router.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Client.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Client.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Client.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.Client.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.Client.Router.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.Client.Router.Locator", false, 0),
     IceInternal::Property("Glacier2.Client.Router.Router", false, 0),
     IceInternal::Property("Glacier2.Client.Router.CollocationOptimized", false, 0),
@@ -1223,6 +1406,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Client.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Glacier2.Client.ThreadPool.Mode", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Client.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Client.MessageSizeMax", false, 0),
@@ -1247,6 +1431,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.PermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.PermissionsVerifier.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.PermissionsVerifier.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.PermissionsVerifier.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.Locator", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.Router", false, 0),
     IceInternal::Property("Glacier2.PermissionsVerifier.CollocationOptimized", false, 0),
@@ -1258,6 +1445,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.SSLPermissionsVerifier.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.SSLPermissionsVerifier.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.SSLPermissionsVerifier.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.Locator", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.Router", false, 0),
     IceInternal::Property("Glacier2.SSLPermissionsVerifier.CollocationOptimized", false, 0),
@@ -1275,6 +1465,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Locator.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Server.Locator.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.Server.Locator.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.Server.Locator.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.Locator", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.Router", false, 0),
     IceInternal::Property("Glacier2.Server.Locator.CollocationOptimized", false, 0),
@@ -1287,6 +1480,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.Router.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.Server.Router.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.Server.Router.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.Server.Router.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.Server.Router.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.Server.Router.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.Server.Router.Locator", false, 0),
     IceInternal::Property("Glacier2.Server.Router.Router", false, 0),
     IceInternal::Property("Glacier2.Server.Router.CollocationOptimized", false, 0),
@@ -1298,6 +1494,7 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.Server.ThreadPool.SizeWarn", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.StackSize", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.Serialize", false, 0),
+    IceInternal::Property("Glacier2.Server.ThreadPool.Mode", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadIdleTime", false, 0),
     IceInternal::Property("Glacier2.Server.ThreadPool.ThreadPriority", false, 0),
     IceInternal::Property("Glacier2.Server.MessageSizeMax", false, 0),
@@ -1312,6 +1509,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.SessionManager.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.SessionManager.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.SessionManager.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.SessionManager.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.SessionManager.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.SessionManager.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.SessionManager.Locator", false, 0),
     IceInternal::Property("Glacier2.SessionManager.Router", false, 0),
     IceInternal::Property("Glacier2.SessionManager.CollocationOptimized", false, 0),
@@ -1322,6 +1522,9 @@ const IceInternal::Property Glacier2PropsData[] =
     IceInternal::Property("Glacier2.SSLSessionManager.PreferSecure", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.LocatorCacheTimeout", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.InvocationTimeout", false, 0),
+    IceInternal::Property("Glacier2.SSLSessionManager.BatchAutoFlushDelay", false, 0),
+    IceInternal::Property("Glacier2.SSLSessionManager.ConnectionPoolSize", false, 0),
+    IceInternal::Property("Glacier2.SSLSessionManager.CompressionCodec", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.Locator", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.Router", false, 0),
     IceInternal::Property("Glacier2.SSLSessionManager.CollocationOptimized", false, 0),
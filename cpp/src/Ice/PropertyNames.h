@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Thu Oct 25 22:10:11 2018
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 09:28:45 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -24,6 +24,7 @@
 #include <Ice/DefaultsAndOverrides.h>
 #include <Ice/Comparable.h>
 #include <Ice/StringUtil.h>
+#include <Ice/CompressionCodec.h>
 
 #include <IceUtil/Random.h>
 #include <IceUtil/MutexPtrLock.h>
@@ -905,6 +906,9 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
                                                   EndpointSelectionType endpointSelection,
                                                   int locatorCacheTimeout,
                                                   int invocationTimeout,
+                                                  int batchAutoFlushDelay,
+                                                  int connectionPoolSize,
+                                                  Ice::Byte compressionCodec,
                                                   const Ice::Context& ctx) :
     Reference(instance, communicator, id, facet, mode, secure, protocol, encoding, invocationTimeout, ctx),
     _endpoints(endpoints),
@@ -916,6 +920,9 @@ IceInternal::RoutableReference::RoutableReference(const InstancePtr& instance,
     _preferSecure(preferSecure),
     _endpointSelection(endpointSelection),
     _locatorCacheTimeout(locatorCacheTimeout),
+    _batchAutoFlushDelay(batchAutoFlushDelay),
+    _connectionPoolSize(connectionPoolSize),
+    _compressionCodec(compressionCodec),
     _overrideTimeout(false),
     _timeout(-1)
 {
@@ -988,6 +995,18 @@ IceInternal::RoutableReference::getTimeout() const
     return _overrideTimeout ? IceUtil::Optional<int>(_timeout) : IceUtil::None;
 }
 
+int
+IceInternal::RoutableReference::getConnectionPoolSize() const
+{
+    return _connectionPoolSize;
+}
+
+Byte
+IceInternal::RoutableReference::getCompressionCodec() const
+{
+    return _compressionCodec;
+}
+
 ReferencePtr
 IceInternal::RoutableReference::changeEncoding(const Ice::EncodingVersion& encoding) const
 {
@@ -1288,7 +1307,29 @@ IceInternal::RoutableReference::toProperty(const string& prefix) const
     properties[prefix + ".CollocationOptimized"] = _collocationOptimized ? "1" : "0";
     properties[prefix + ".ConnectionCached"] = _cacheConnection ? "1" : "0";
     properties[prefix + ".PreferSecure"] = _preferSecure ? "1" : "0";
-    properties[prefix + ".EndpointSelection"] = _endpointSelection == ICE_ENUM(EndpointSelectionType, Random) ? "Random" : "Ordered";
+    switch(_endpointSelection)
+    {
+        case ICE_ENUM(EndpointSelectionType, Random):
+        {
+            properties[prefix + ".EndpointSelection"] = "Random";
+            break;
+        }
+        case ICE_ENUM(EndpointSelectionType, Ordered):
+        {
+            properties[prefix + ".EndpointSelection"] = "Ordered";
+            break;
+        }
+        case ICE_ENUM(EndpointSelectionType, LeastLatency):
+        {
+            properties[prefix + ".EndpointSelection"] = "LeastLatency";
+            break;
+        }
+        case ICE_ENUM(EndpointSelectionType, LeastOutstanding):
+        {
+            properties[prefix + ".EndpointSelection"] = "LeastOutstanding";
+            break;
+        }
+    }
     {
         ostringstream s;
         s << _locatorCacheTimeout;
@@ -1299,6 +1340,22 @@ IceInternal::RoutableReference::toProperty(const string& prefix) const
         s << getInvocationTimeout();
         properties[prefix + ".InvocationTimeout"] = s.str();
     }
+    if(_batchAutoFlushDelay != getInstance()->batchAutoFlushDelay())
+    {
+        ostringstream s;
+        s << _batchAutoFlushDelay;
+        properties[prefix + ".BatchAutoFlushDelay"] = s.str();
+    }
+    if(_connectionPoolSize != getInstance()->connectionPoolSize())
+    {
+        ostringstream s;
+        s << _connectionPoolSize;
+        properties[prefix + ".ConnectionPoolSize"] = s.str();
+    }
+    if(_compressionCodec)
+    {
+        properties[prefix + ".CompressionCodec"] = IceInternal::getCompressionCodec(_compressionCodec)->name();
+    }
     if(_routerInfo)
     {
         PropertyDict routerProperties = _routerInfo->getRouter()->_getReference()->toProperty(prefix + ".Router");
@@ -1397,6 +1454,18 @@ IceInternal::RoutableReference::operator==(const Reference& r) const
     {
         return false;
     }
+    if(_batchAutoFlushDelay != rhs->_batchAutoFlushDelay)
+    {
+        return false;
+    }
+    if(_connectionPoolSize != rhs->_connectionPoolSize)
+    {
+        return false;
+    }
+    if(_compressionCodec != rhs->_compressionCodec)
+    {
+        return false;
+    }
     return true;
 }
 
@@ -1528,6 +1597,30 @@ IceInternal::RoutableReference::operator<(const Reference& r) const
     {
         return false;
     }
+    if(_batchAutoFlushDelay < rhs->_batchAutoFlushDelay)
+    {
+        return true;
+    }
+    else if(rhs->_batchAutoFlushDelay < _batchAutoFlushDelay)
+    {
+        return false;
+    }
+    if(_connectionPoolSize < rhs->_connectionPoolSize)
+    {
+        return true;
+    }
+    else if(rhs->_connectionPoolSize < _connectionPoolSize)
+    {
+        return false;
+    }
+    if(_compressionCodec < rhs->_compressionCodec)
+    {
+        return true;
+    }
+    else if(rhs->_compressionCodec < _compressionCodec)
+    {
+        return false;
+    }
     return false;
 }
 
@@ -1546,7 +1639,7 @@ IceInternal::RoutableReference::getRequestHandler(const Ice::ObjectPrxPtr& proxy
 BatchRequestQueuePtr
 IceInternal::RoutableReference::getBatchRequestQueue() const
 {
-    return new BatchRequestQueue(getInstance(), getMode() == Reference::ModeBatchDatagram);
+    return new BatchRequestQueue(getInstance(), getMode() == Reference::ModeBatchDatagram, _batchAutoFlushDelay);
 }
 
 void
@@ -1766,7 +1859,7 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
         // Get an existing connection or create one if there's no
         // existing connection to one of the given endpoints.
         //
-        factory->create(endpoints, false, getEndpointSelection(), new CB1(_routerInfo, callback));
+        factory->create(endpoints, false, getEndpointSelection(), _connectionPoolSize, new CB1(_routerInfo, callback));
         return;
     }
     else
@@ -1809,7 +1902,8 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
                 endpoint.push_back(_endpoints[_i]);
 
                 OutgoingConnectionFactoryPtr factory = _reference->getInstance()->outgoingConnectionFactory();
-                factory->create(endpoint, more, _reference->getEndpointSelection(), this);
+                factory->create(endpoint, more, _reference->getEndpointSelection(),
+                                _reference->getConnectionPoolSize(), this);
             }
 
             CB2(const RoutableReferencePtr& reference, const vector<EndpointIPtr>& endpoints,
@@ -1841,7 +1935,7 @@ IceInternal::RoutableReference::createConnection(const vector<EndpointIPtr>& all
         vector<EndpointIPtr> endpt;
         endpt.push_back(endpoints[0]);
         RoutableReference* self = const_cast<RoutableReference*>(this);
-        factory->create(endpt, true, getEndpointSelection(), new CB2(self, endpoints, callback));
+        factory->create(endpt, true, getEndpointSelection(), _connectionPoolSize, new CB2(self, endpoints, callback));
         return;
     }
 }
@@ -1874,6 +1968,9 @@ IceInternal::RoutableReference::RoutableReference(const RoutableReference& r) :
     _preferSecure(r._preferSecure),
     _endpointSelection(r._endpointSelection),
     _locatorCacheTimeout(r._locatorCacheTimeout),
+    _batchAutoFlushDelay(r._batchAutoFlushDelay),
+    _connectionPoolSize(r._connectionPoolSize),
+    _compressionCodec(r._compressionCodec),
     _overrideTimeout(r._overrideTimeout),
     _timeout(r._timeout),
     _connectionId(r._connectionId)
@@ -1970,6 +2067,8 @@ IceInternal::RoutableReference::filterEndpoints(const vector<EndpointIPtr>& allE
     switch(getEndpointSelection())
     {
         case ICE_ENUM(EndpointSelectionType, Random):
+        case ICE_ENUM(EndpointSelectionType, LeastLatency):
+        case ICE_ENUM(EndpointSelectionType, LeastOutstanding):
         {
             IceUtilInternal::shuffle(endpoints.begin(), endpoints.end());
             break;
@@ -2042,5 +2141,22 @@ IceInternal::RoutableReference::filterEndpoints(const vector<EndpointIPtr>& allE
 #endif
     }
 
+    //
+    // With the latency-aware endpoint selections, use the "power of two
+    // choices": the first two endpoints are in a random order, prefer
+    // the one with the lowest cost if both are equally preferred.
+    //
+    EndpointSelectionType selType = getEndpointSelection();
+    if((selType == ICE_ENUM(EndpointSelectionType, LeastLatency) ||
+        selType == ICE_ENUM(EndpointSelectionType, LeastOutstanding)) &&
+       endpoints.size() > 1 && endpoints[0]->secure() == endpoints[1]->secure())
+    {
+        OutgoingConnectionFactoryPtr factory = getInstance()->outgoingConnectionFactory();
+        if(factory->getCost(endpoints[1], selType) < factory->getCost(endpoints[0], selType))
+        {
+            swap(endpoints[0], endpoints[1]);
+        }
+    }
+
     return endpoints;
 }
@@ -86,6 +86,12 @@ public:
     virtual std::string getConnectionId() const = 0;
     virtual IceUtil::Optional<int> getTimeout() const = 0;
 
+    //
+    // The compression status of the codec used to compress the requests,
+    // 0 to use the codec of the connection.
+    //
+    virtual Ice::Byte getCompressionCodec() const { return 0; }
+
     //
     // The change* methods (here and in derived classes) create
     // a new reference based on the existing one, with the
@@ -241,7 +247,7 @@ public:
     RoutableReference(const InstancePtr&, const Ice::CommunicatorPtr&, const Ice::Identity&, const std::string&, Mode,
                       bool, const Ice::ProtocolVersion&, const Ice::EncodingVersion&, const std::vector<EndpointIPtr>&,
                       const std::string&, const LocatorInfoPtr&, const RouterInfoPtr&, bool, bool, bool,
-                      Ice::EndpointSelectionType, int, int, const Ice::Context&);
+                      Ice::EndpointSelectionType, int, int, int, int, Ice::Byte, const Ice::Context&);
 
     virtual std::vector<EndpointIPtr> getEndpoints() const;
     virtual std::string getAdapterId() const;
@@ -254,6 +260,8 @@ public:
     virtual int getLocatorCacheTimeout() const;
     virtual std::string getConnectionId() const;
     virtual IceUtil::Optional<int> getTimeout() const;
+    int getConnectionPoolSize() const;
+    virtual Ice::Byte getCompressionCodec() const;
 
     virtual ReferencePtr changeEncoding(const Ice::EncodingVersion&) const;
     virtual ReferencePtr changeCompress(bool) const;
@@ -312,6 +320,9 @@ private:
     bool _preferSecure;
     Ice::EndpointSelectionType _endpointSelection;
     int _locatorCacheTimeout;
+    int _batchAutoFlushDelay;
+    int _connectionPoolSize;
+    Ice::Byte _compressionCodec;
 
     bool _overrideTimeout;
     int _timeout; // Only used if _overrideTimeout == true
@@ -20,6 +20,7 @@
 #include <Ice/DefaultsAndOverrides.h>
 #include <Ice/PropertyNames.h>
 #include <Ice/StringUtil.h>
+#include <Ice/CompressionCodec.h>
 
 using namespace std;
 using namespace Ice;
@@ -668,6 +669,9 @@ IceInternal::ReferenceFactory::checkForUnknownProperties(const string& prefix)
         "PreferSecure",
         "LocatorCacheTimeout",
         "InvocationTimeout",
+        "BatchAutoFlushDelay",
+        "ConnectionPoolSize",
+        "CompressionCodec",
         "Locator",
         "Router",
         "CollocationOptimized",
@@ -752,6 +756,9 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
     Ice::EndpointSelectionType endpointSelection = defaultsAndOverrides->defaultEndpointSelection;
     int locatorCacheTimeout = defaultsAndOverrides->defaultLocatorCacheTimeout;
     int invocationTimeout = defaultsAndOverrides->defaultInvocationTimeout;
+    int batchAutoFlushDelay = _instance->batchAutoFlushDelay();
+    int connectionPoolSize = _instance->connectionPoolSize();
+    Byte compressionCodec = 0;
     Ice::Context ctx;
 
     //
@@ -818,10 +825,19 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
             {
                 endpointSelection = ICE_ENUM(EndpointSelectionType, Ordered);
             }
+            else if(type == "LeastLatency")
+            {
+                endpointSelection = ICE_ENUM(EndpointSelectionType, LeastLatency);
+            }
+            else if(type == "LeastOutstanding")
+            {
+                endpointSelection = ICE_ENUM(EndpointSelectionType, LeastOutstanding);
+            }
             else
             {
                 throw EndpointSelectionTypeParseException(__FILE__, __LINE__, "illegal value `" + type +
-                                                          "'; expected `Random' or `Ordered'");
+                                                          "'; expected `Random', `Ordered', `LeastLatency' or"
+                                                          " `LeastOutstanding'");
             }
         }
 
@@ -855,6 +871,53 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
             }
         }
 
+        property = propertyPrefix + ".BatchAutoFlushDelay";
+        value = properties->getProperty(property);
+        if(!value.empty())
+        {
+            batchAutoFlushDelay = properties->getPropertyAsIntWithDefault(property, batchAutoFlushDelay);
+            if(batchAutoFlushDelay < 0)
+            {
+                batchAutoFlushDelay = 0;
+
+                Warning out(_instance->initializationData().logger);
+                out << "invalid value for " << property << "`" << properties->getProperty(property) << "'"
+                    << ": defaulting to 0";
+            }
+        }
+
+        property = propertyPrefix + ".ConnectionPoolSize";
+        value = properties->getProperty(property);
+        if(!value.empty())
+        {
+            connectionPoolSize = properties->getPropertyAsIntWithDefault(property, connectionPoolSize);
+            if(connectionPoolSize < 1)
+            {
+                connectionPoolSize = 1;
+
+                Warning out(_instance->initializationData().logger);
+                out << "invalid value for " << property << "`" << properties->getProperty(property) << "'"
+                    << ": defaulting to 1";
+            }
+        }
+
+        property = propertyPrefix + ".CompressionCodec";
+        value = properties->getProperty(property);
+        if(!value.empty())
+        {
+            CompressionCodecPtr codec = getCompressionCodec(value);
+            if(codec)
+            {
+                compressionCodec = codec->id();
+            }
+            else
+            {
+                Warning out(_instance->initializationData().logger);
+                out << "unsupported compression codec for " << property << "`" << value << "'"
+                    << ": defaulting to the codec of the connection";
+            }
+        }
+
         property = propertyPrefix + ".Context.";
         PropertyDict contexts = properties->getPropertiesForPrefix(property);
         for(PropertyDict::const_iterator p = contexts.begin(); p != contexts.end(); ++p)
@@ -884,5 +947,8 @@ IceInternal::ReferenceFactory::create(const Identity& ident,
                                  endpointSelection,
                                  locatorCacheTimeout,
                                  invocationTimeout,
+                                 batchAutoFlushDelay,
+                                 connectionPoolSize,
+                                 compressionCodec,
                                  ctx);
 }
@@ -15,42 +15,63 @@ using namespace IceInternal;
 
 ICE_API IceUtil::Shared* IceInternal::upCast(ServantManager* p) { return p; }
 
+namespace
+{
+
+//
+// The FNV-1a hash of the identity category and name, with a final mix so
+// that all the bits depend on every character. The shard is selected with
+// the high bits of the hash and the bucket with the low bits.
+//
+unsigned int
+identityHash(const Identity& ident)
+{
+    unsigned int h = 2166136261u;
+    for(string::const_iterator p = ident.category.begin(); p != ident.category.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619u;
+    }
+    h = (h ^ static_cast<unsigned char>('/')) * 16777619u;
+    for(string::const_iterator p = ident.name.begin(); p != ident.name.end(); ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 16777619u;
+    }
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    return h;
+}
+
+}
+
 void
 IceInternal::ServantManager::addServant(const ObjectPtr& object, const Identity& ident, const string& facet)
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
+    unsigned int hash = identityHash(ident);
+    ServantShard& s = shard(hash);
 
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
+    IceUtil::Mutex::Lock sync(s);
 
-    if(p == _servantMapMap.end())
+    ServantEntry* entry = s.find(hash, ident);
+    if(!entry)
     {
-        p = _servantMapMap.insert(_servantMapMapHint, pair<const Identity, FacetMap>(ident, FacetMap()));
+        entry = s.insert(hash, ident);
     }
-    else
+    else if(entry->facets.find(facet) != entry->facets.end())
     {
-        if(p->second.find(facet) != p->second.end())
+        ToStringMode toStringMode = _instance->toStringMode();
+        ostringstream os;
+        os << Ice::identityToString(ident, toStringMode);
+        if(!facet.empty())
         {
-            ToStringMode toStringMode = _instance->toStringMode();
-            ostringstream os;
-            os << Ice::identityToString(ident, toStringMode);
-            if(!facet.empty())
-            {
-                os << " -f " << escapeString(facet, "", toStringMode);
-            }
-            throw AlreadyRegisteredException(__FILE__, __LINE__, "servant", os.str());
+            os << " -f " << escapeString(facet, "", toStringMode);
         }
+        throw AlreadyRegisteredException(__FILE__, __LINE__, "servant", os.str());
     }
 
-    _servantMapMapHint = p;
-
-    p->second.insert(pair<const string, ObjectPtr>(facet, object));
+    entry->facets.insert(pair<const string, ObjectPtr>(facet, object));
 }
 
 void
@@ -79,19 +100,16 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
     //
     ObjectPtr servant = 0;
 
-    IceUtil::Mutex::Lock sync(*this);
-
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    FacetMap::iterator q;
+    unsigned int hash = identityHash(ident);
+    ServantShard& s = shard(hash);
 
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
+    IceUtil::Mutex::Lock sync(s);
 
-    if(p == _servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    ServantEntry* entry = s.find(hash, ident);
+    FacetMap::iterator q;
+    if(!entry || (q = entry->facets.find(facet)) == entry->facets.end())
     {
         ToStringMode toStringMode = _instance->toStringMode();
         ostringstream os;
@@ -104,19 +122,11 @@ IceInternal::ServantManager::removeServant(const Identity& ident, const string&
     }
 
     servant = q->second;
-    p->second.erase(q);
+    entry->facets.erase(q);
 
-    if(p->second.empty())
+    if(entry->facets.empty())
     {
-        if(p == _servantMapMapHint)
-        {
-            _servantMapMap.erase(p++);
-            _servantMapMapHint = p;
-        }
-        else
-        {
-            _servantMapMap.erase(p);
-        }
+        s.erase(entry);
     }
     return servant;
 }
@@ -150,43 +160,29 @@ IceInternal::ServantManager::removeDefaultServant(const string& category)
 FacetMap
 IceInternal::ServantManager::removeAllFacets(const Identity& ident)
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
+    unsigned int hash = identityHash(ident);
+    ServantShard& s = shard(hash);
 
-    if(p == _servantMapMap.end() || p->first != ident)
-    {
-        p = _servantMapMap.find(ident);
-    }
+    IceUtil::Mutex::Lock sync(s);
 
-    if(p == _servantMapMap.end())
+    ServantEntry* entry = s.find(hash, ident);
+    if(!entry)
     {
         throw NotRegisteredException(__FILE__, __LINE__, "servant",
                                      Ice::identityToString(ident, _instance->toStringMode()));
     }
 
-    FacetMap result = p->second;
-
-    if(p == _servantMapMapHint)
-    {
-        _servantMapMap.erase(p++);
-        _servantMapMapHint = p;
-    }
-    else
-    {
-        _servantMapMap.erase(p);
-    }
-
+    FacetMap result;
+    result.swap(entry->facets);
+    s.erase(entry);
     return result;
 }
 
 ObjectPtr
 IceInternal::ServantManager::findServant(const Identity& ident, const string& facet) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
     // This assert is not valid if the adapter dispatch incoming
     // requests from bidir connections. This method might be called if
@@ -195,30 +191,32 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
     //
     //assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    FacetMap::iterator q;
+    unsigned int hash = identityHash(ident);
+    {
+        ServantShard& s = shard(hash);
 
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
+        IceUtil::Mutex::Lock sync(s);
 
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
+        ServantEntry* entry = s.find(hash, ident);
+        if(entry)
+        {
+            FacetMap::const_iterator q = entry->facets.find(facet);
+            if(q != entry->facets.end())
+            {
+                return q->second;
+            }
+        }
     }
 
-    if(p == servantMapMap.end() || (q = p->second.find(facet)) == p->second.end())
+    IceUtil::Mutex::Lock sync(*this);
+
+    DefaultServantMap::const_iterator d = _defaultServantMap.find(ident.category);
+    if(d == _defaultServantMap.end())
     {
-        DefaultServantMap::const_iterator d = _defaultServantMap.find(ident.category);
+        d = _defaultServantMap.find("");
         if(d == _defaultServantMap.end())
         {
-            d = _defaultServantMap.find("");
-            if(d == _defaultServantMap.end())
-            {
-                return 0;
-            }
-            else
-            {
-                return d->second;
-            }
+            return 0;
         }
         else
         {
@@ -227,8 +225,7 @@ IceInternal::ServantManager::findServant(const Identity& ident, const string& fa
     }
     else
     {
-        _servantMapMapHint = p;
-        return q->second;
+        return d->second;
     }
 }
 
@@ -251,35 +248,27 @@ IceInternal::ServantManager::findDefaultServant(const string& category) const
 FacetMap
 IceInternal::ServantManager::findAllFacets(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
+    unsigned int hash = identityHash(ident);
+    ServantShard& s = shard(hash);
 
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
+    IceUtil::Mutex::Lock sync(s);
 
-    if(p == servantMapMap.end())
+    ServantEntry* entry = s.find(hash, ident);
+    if(!entry)
     {
         return FacetMap();
     }
     else
     {
-        _servantMapMapHint = p;
-        return p->second;
+        return entry->facets;
     }
 }
 
 bool
 IceInternal::ServantManager::hasServant(const Identity& ident) const
 {
-    IceUtil::Mutex::Lock sync(*this);
-
     //
     // This assert is not valid if the adapter dispatch incoming
     // requests from bidir connections. This method might be called if
@@ -288,24 +277,14 @@ IceInternal::ServantManager::hasServant(const Identity& ident) const
     //
     //assert(_instance); // Must not be called after destruction.
 
-    ServantMapMap::iterator p = _servantMapMapHint;
-    ServantMapMap& servantMapMap = const_cast<ServantMapMap&>(_servantMapMap);
+    unsigned int hash = identityHash(ident);
+    ServantShard& s = shard(hash);
 
-    if(p == servantMapMap.end() || p->first != ident)
-    {
-        p = servantMapMap.find(ident);
-    }
+    IceUtil::Mutex::Lock sync(s);
 
-    if(p == servantMapMap.end())
-    {
-        return false;
-    }
-    else
-    {
-        _servantMapMapHint = p;
-        assert(!p->second.empty());
-        return true;
-    }
+    ServantEntry* entry = s.find(hash, ident);
+    assert(!entry || !entry->facets.empty());
+    return entry != 0;
 }
 
 void
@@ -400,7 +379,6 @@ IceInternal::ServantManager::findServantLocator(const string& category) const
 IceInternal::ServantManager::ServantManager(const InstancePtr& instance, const string& adapterName)
     : _instance(instance),
       _adapterName(adapterName),
-      _servantMapMapHint(_servantMapMap.end()),
       _locatorMapHint(_locatorMap.end())
 {
 }
@@ -418,7 +396,7 @@ IceInternal::ServantManager::~ServantManager()
 void
 IceInternal::ServantManager::destroy()
 {
-    ServantMapMap servantMapMap;
+    ServantEntry* entries[ShardCount];
     DefaultServantMap defaultServantMap;
     map<string, ServantLocatorPtr> locatorMap;
     Ice::LoggerPtr logger;
@@ -435,8 +413,11 @@ IceInternal::ServantManager::destroy()
 
         logger = _instance->initializationData().logger;
 
-        servantMapMap.swap(_servantMapMap);
-        _servantMapMapHint = _servantMapMap.end();
+        for(int i = 0; i < ShardCount; ++i)
+        {
+            IceUtil::Mutex::Lock shardSync(_shards[i]);
+            entries[i] = _shards[i].clear();
+        }
 
         defaultServantMap.swap(_defaultServantMap);
 
@@ -474,7 +455,123 @@ IceInternal::ServantManager::destroy()
     // hold any internal Ice mutex while running user code (such as servant
     // or servant locator destructors).
     //
-    servantMapMap.clear();
+    for(int i = 0; i < ShardCount; ++i)
+    {
+        ServantShard::deleteEntries(entries[i]);
+    }
     locatorMap.clear();
     defaultServantMap.clear();
 }
+
+IceInternal::ServantManager::ServantShard&
+IceInternal::ServantManager::shard(unsigned int hash) const
+{
+    return _shards[hash >> (32 - ShardBits)];
+}
+
+IceInternal::ServantManager::ServantShard::ServantShard() :
+    _buckets(16),
+    _size(0)
+{
+}
+
+IceInternal::ServantManager::ServantShard::~ServantShard()
+{
+    deleteEntries(clear());
+}
+
+IceInternal::ServantManager::ServantEntry*
+IceInternal::ServantManager::ServantShard::find(unsigned int hash, const Identity& ident) const
+{
+    ServantEntry* entry = _buckets[hash & (_buckets.size() - 1)];
+    while(entry && (entry->hash != hash || entry->id.name != ident.name || entry->id.category != ident.category))
+    {
+        entry = entry->next;
+    }
+    return entry;
+}
+
+IceInternal::ServantManager::ServantEntry*
+IceInternal::ServantManager::ServantShard::insert(unsigned int hash, const Identity& ident)
+{
+    if(_size >= _buckets.size())
+    {
+        rehash(_buckets.size() * 2);
+    }
+
+    ServantEntry*& bucket = _buckets[hash & (_buckets.size() - 1)];
+    ServantEntry* entry = new ServantEntry(hash, ident);
+    entry->next = bucket;
+    bucket = entry;
+    ++_size;
+    return entry;
+}
+
+void
+IceInternal::ServantManager::ServantShard::erase(ServantEntry* entry)
+{
+    ServantEntry** p = &_buckets[entry->hash & (_buckets.size() - 1)];
+    while(*p != entry)
+    {
+        assert(*p);
+        p = &(*p)->next;
+    }
+    *p = entry->next;
+    delete entry;
+    --_size;
+
+    //
+    // Shrink the table if it's mostly empty after servants were removed.
+    //
+    if(_buckets.size() > 16 && _size < _buckets.size() / 8)
+    {
+        rehash(_buckets.size() / 2);
+    }
+}
+
+IceInternal::ServantManager::ServantEntry*
+IceInternal::ServantManager::ServantShard::clear()
+{
+    ServantEntry* head = 0;
+    for(vector<ServantEntry*>::iterator p = _buckets.begin(); p != _buckets.end(); ++p)
+    {
+        while(*p)
+        {
+            ServantEntry* entry = *p;
+            *p = entry->next;
+            entry->next = head;
+            head = entry;
+        }
+    }
+    _size = 0;
+    return head;
+}
+
+void
+IceInternal::ServantManager::ServantShard::deleteEntries(ServantEntry* entry)
+{
+    while(entry)
+    {
+        ServantEntry* next = entry->next;
+        delete entry;
+        entry = next;
+    }
+}
+
+void
+IceInternal::ServantManager::ServantShard::rehash(size_t size)
+{
+    vector<ServantEntry*> buckets(size);
+    for(vector<ServantEntry*>::iterator p = _buckets.begin(); p != _buckets.end(); ++p)
+    {
+        while(*p)
+        {
+            ServantEntry* entry = *p;
+            *p = entry->next;
+            ServantEntry*& bucket = buckets[entry->hash & (size - 1)];
+            entry->next = bucket;
+            bucket = entry;
+        }
+    }
+    _buckets.swap(buckets);
+}
@@ -13,6 +13,8 @@
 #include <Ice/Identity.h>
 #include <Ice/FacetMap.h>
 
+#include <vector>
+
 namespace Ice
 {
 
@@ -52,11 +54,59 @@ private:
 
     const std::string _adapterName;
 
-    typedef std::map<Ice::Identity, Ice::FacetMap> ServantMapMap;
-    typedef std::map<std::string, Ice::ObjectPtr> DefaultServantMap;
+    //
+    // The servants are kept in a hash table keyed on the identity hash and
+    // split in shards, each protected by its own mutex. Dispatch threads
+    // looking up servants with different identities rarely contend for the
+    // same shard, and the lookups compare the hashes before comparing the
+    // identity strings.
+    //
+    struct ServantEntry
+    {
+        ServantEntry(unsigned int h, const Ice::Identity& i) :
+            hash(h), id(i), next(0)
+        {
+        }
+
+        const unsigned int hash;
+        const Ice::Identity id;
+        Ice::FacetMap facets;
+        ServantEntry* next;
+    };
+
+    class ServantShard : public IceUtil::Mutex
+    {
+    public:
+
+        ServantShard();
+        ~ServantShard();
+
+        ServantEntry* find(unsigned int, const Ice::Identity&) const;
+        ServantEntry* insert(unsigned int, const Ice::Identity&);
+        void erase(ServantEntry*);
+
+        //
+        // Removes all the entries from the shard and returns them to be
+        // deleted by the caller outside the synchronization.
+        //
+        ServantEntry* clear();
+        static void deleteEntries(ServantEntry*);
 
-    ServantMapMap _servantMapMap;
-    mutable ServantMapMap::iterator _servantMapMapHint;
+    private:
+
+        void rehash(size_t);
+
+        std::vector<ServantEntry*> _buckets;
+        size_t _size;
+    };
+
+    enum { ShardBits = 6, ShardCount = 1 << ShardBits };
+
+    ServantShard& shard(unsigned int) const;
+
+    mutable ServantShard _shards[ShardCount];
+
+    typedef std::map<std::string, Ice::ObjectPtr> DefaultServantMap;
 
     DefaultServantMap _defaultServantMap;
 
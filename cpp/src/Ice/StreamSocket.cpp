@@ -5,6 +5,11 @@
 #include <Ice/StreamSocket.h>
 #include <Ice/NetworkProxy.h>
 #include <Ice/ProtocolInstance.h>
+#include <Ice/BufferPool.h>
+
+#if !defined(_WIN32)
+#   include <sys/uio.h>
+#endif
 
 using namespace IceInternal;
 
@@ -217,6 +222,13 @@ StreamSocket::write(Buffer& buf)
             }
         }
     }
+#if !defined(_WIN32)
+    if(buf.b.segments())
+    {
+        buf.advance(static_cast<size_t>(writeSegments(buf)));
+        return buf.i != buf.b.end() ? SocketOperationWrite : SocketOperationNone;
+    }
+#endif
     buf.i += write(reinterpret_cast<const char*>(&*buf.i), buf.b.end() - buf.i);
 #endif
     return buf.i != buf.b.end() ? SocketOperationWrite : SocketOperationNone;
@@ -350,6 +362,83 @@ StreamSocket::write(const char* buf, size_t length)
 }
 #endif
 
+#if !defined(_WIN32)
+ssize_t
+StreamSocket::writeSegments(const Buffer& buf)
+{
+    assert(_fd != INVALID_SOCKET);
+
+    //
+    // Gather the remaining bytes of the buffer, the referenced segments are
+    // sent directly from the memory provided by the application. If more
+    // vectors are needed than the limit below, the remainder is sent by the
+    // next call.
+    //
+    const int maxVectors = 64;
+    struct iovec iov[maxVectors];
+    int count = 0;
+
+    const BufferSegments* segments = buf.b.segments();
+    size_t offset = static_cast<size_t>(buf.i - buf.b.begin());
+    size_t segmentPos = segments->segmentPos;
+    std::vector<BufferSegment>::const_iterator p = segments->segments.begin();
+    while(p != segments->segments.end() && p->offset < offset)
+    {
+        ++p;
+    }
+
+    while(count < maxVectors && offset < buf.b.size())
+    {
+        if(p != segments->segments.end() && p->offset == offset)
+        {
+            iov[count].iov_base = const_cast<Ice::Byte*>(p->begin + segmentPos);
+            iov[count].iov_len = static_cast<size_t>(p->end - p->begin) - segmentPos;
+            segmentPos = 0;
+            ++p;
+        }
+        else
+        {
+            size_t next = p != segments->segments.end() ? p->offset : buf.b.size();
+            iov[count].iov_base = const_cast<Ice::Byte*>(buf.b.begin() + offset);
+            iov[count].iov_len = next - offset;
+            offset = next;
+        }
+        ++count;
+    }
+
+    while(true)
+    {
+        ssize_t ret = ::writev(_fd, iov, count);
+        if(ret == 0)
+        {
+            throw Ice::ConnectionLostException(__FILE__, __LINE__, 0);
+        }
+        else if(ret == SOCKET_ERROR)
+        {
+            if(interrupted())
+            {
+                continue;
+            }
+
+            if(wouldBlock())
+            {
+                return 0;
+            }
+
+            if(connectionLost())
+            {
+                throw Ice::ConnectionLostException(__FILE__, __LINE__, getSocketErrno());
+            }
+            else
+            {
+                throw Ice::SocketException(__FILE__, __LINE__, getSocketErrno());
+            }
+        }
+        return ret;
+    }
+}
+#endif
+
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
 AsyncInfo*
 StreamSocket::getAsyncInfo(SocketOperation op)
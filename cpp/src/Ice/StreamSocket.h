@@ -53,6 +53,9 @@ public:
 private:
 
     void init();
+#if !defined(_WIN32)
+    ssize_t writeSegments(const Buffer&);
+#endif
 
     enum State
     {
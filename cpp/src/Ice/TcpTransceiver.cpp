@@ -119,6 +119,16 @@ IceInternal::TcpTransceiver::setBufferSize(int rcvSize, int sndSize)
     _stream->setBufferSize(rcvSize, sndSize);
 }
 
+bool
+IceInternal::TcpTransceiver::supportsSegments() const
+{
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+    return false;
+#else
+    return true;
+#endif
+}
+
 IceInternal::TcpTransceiver::TcpTransceiver(const ProtocolInstancePtr& instance, const StreamSocketPtr& stream) :
     _instance(instance),
     _stream(stream)
@@ -110,6 +110,66 @@ class ThreadPoolDestroyedException
 {
 };
 
+void
+startThreadHook(const InstancePtr& instance, const string& prefix)
+{
+#ifdef ICE_CPP11_MAPPING
+    if(instance->initializationData().threadStart)
+#else
+    if(instance->initializationData().threadHook)
+#endif
+    {
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            instance->initializationData().threadStart();
+#else
+            instance->initializationData().threadHook->start();
+#endif
+        }
+        catch(const exception& ex)
+        {
+            Error out(instance->initializationData().logger);
+            out << "thread hook start() method raised an unexpected exception in `" << prefix << "':\n" << ex;
+        }
+        catch(...)
+        {
+            Error out(instance->initializationData().logger);
+            out << "thread hook start() method raised an unexpected exception in `" << prefix << "'";
+        }
+    }
+}
+
+void
+stopThreadHook(const InstancePtr& instance, const string& prefix)
+{
+#ifdef ICE_CPP11_MAPPING
+    if(instance->initializationData().threadStop)
+#else
+    if(instance->initializationData().threadHook)
+#endif
+    {
+        try
+        {
+#ifdef ICE_CPP11_MAPPING
+            instance->initializationData().threadStop();
+#else
+            instance->initializationData().threadHook->stop();
+#endif
+        }
+        catch(const exception& ex)
+        {
+            Error out(instance->initializationData().logger);
+            out << "thread hook stop() method raised an unexpected exception in `" << prefix << "':\n" << ex;
+        }
+        catch(...)
+        {
+            Error out(instance->initializationData().logger);
+            out << "thread hook stop() method raised an unexpected exception in `" << prefix << "'";
+        }
+    }
+}
+
 }
 
 Ice::DispatcherCall::~DispatcherCall()
@@ -337,6 +397,23 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
 #endif
     const_cast<int&>(_threadIdleTime) = threadIdleTime;
 
+    bool workStealing = false;
+    string mode = properties->getPropertyWithDefault(_prefix + ".Mode", "LeaderFollower");
+    if(mode == "WorkStealing")
+    {
+#if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
+        Warning out(_instance->initializationData().logger);
+        out << _prefix << ".Mode=WorkStealing is not supported on this platform; Mode adjusted to LeaderFollower";
+#else
+        workStealing = true;
+#endif
+    }
+    else if(mode != "LeaderFollower")
+    {
+        Warning out(_instance->initializationData().logger);
+        out << "invalid value for " << _prefix << ".Mode: `" << mode << "'; Mode adjusted to LeaderFollower";
+    }
+
 #ifdef ICE_USE_IOCP
     _selector.setup(_sizeIO);
 #endif
@@ -375,6 +452,10 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
         Trace out(_instance->initializationData().logger, _instance->traceLevels()->threadPoolCat);
         out << "creating " << _prefix << ": Size = " << _size << ", SizeMax = " << _sizeMax << ", SizeWarn = "
             << _sizeWarn;
+        if(workStealing)
+        {
+            out << ", Mode = WorkStealing";
+        }
     }
 
     __setNoDelete(true);
@@ -393,6 +474,15 @@ IceInternal::ThreadPool::ThreadPool(const InstancePtr& instance, const string& p
             }
             _threads.insert(thread);
         }
+
+        if(workStealing)
+        {
+            //
+            // The executor has SizeMax threads, the pool threads only perform
+            // IO and hand off the dispatch work items to the executor.
+            //
+            _executor = new ThreadPoolExecutor(*this, _sizeMax);
+        }
     }
     catch(const IceUtil::Exception& ex)
     {
@@ -429,6 +519,10 @@ IceInternal::ThreadPool::destroy()
     }
     _destroyed = true;
     _workQueue->destroy();
+    if(_executor)
+    {
+        _executor->destroy();
+    }
 }
 
 void
@@ -439,6 +533,10 @@ IceInternal::ThreadPool::updateObservers()
     {
         (*p)->updateObserver();
     }
+    if(_executor)
+    {
+        _executor->updateObservers();
+    }
 }
 
 void
@@ -571,6 +669,18 @@ IceInternal::ThreadPool::dispatchFromThisThread(const DispatchWorkItemPtr& workI
 void
 IceInternal::ThreadPool::dispatch(const DispatchWorkItemPtr& workItem)
 {
+    if(_executor)
+    {
+        //
+        // The executor is immutable, no need to lock the thread pool.
+        //
+        if(!_executor->execute(workItem, 0, SocketOperationNone))
+        {
+            throw CommunicatorDestroyedException(__FILE__, __LINE__);
+        }
+        return;
+    }
+
     Lock sync(*this);
     if(_destroyed)
     {
@@ -579,6 +689,45 @@ IceInternal::ThreadPool::dispatch(const DispatchWorkItemPtr& workItem)
     _workQueue->queue(workItem);
 }
 
+void
+IceInternal::ThreadPool::dispatch(ThreadPoolCurrent& current, const DispatchWorkItemPtr& workItem)
+{
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    if(_executor)
+    {
+        //
+        // If the requests are serialized, the handler was disabled by
+        // ioCompleted() and it's enabled again once the executor is done
+        // with the work item instead of when message() returns. This
+        // ensures a single dispatch at a time for the handler.
+        //
+        EventHandlerPtr handler;
+        if(_sizeMax > 1 && _serialize && current._ioCompleted && current._handler.get() != _workQueue.get())
+        {
+            handler = current._handler;
+        }
+
+        if(_executor->execute(workItem, handler, current.operation))
+        {
+            current._deferEnable = handler != 0;
+            return;
+        }
+
+        //
+        // The executor is destroyed, dispatch the work item from this thread.
+        //
+    }
+#endif
+    dispatchFromThisThread(workItem);
+}
+
+void
+IceInternal::ThreadPool::enable(const EventHandlerPtr& handler, SocketOperation operation)
+{
+    Lock sync(*this);
+    _selector.enable(handler.get(), operation);
+}
+
 void
 IceInternal::ThreadPool::joinWithAllThreads()
 {
@@ -594,6 +743,10 @@ IceInternal::ThreadPool::joinWithAllThreads()
     {
         (*p)->getThreadControl().join();
     }
+    if(_executor)
+    {
+        _executor->joinWithAllThreads();
+    }
     _selector.destroy();
 }
 
@@ -681,7 +834,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
                     // If the handler called ioCompleted(), we re-enable the handler in
                     // case it was disabled and we decrease the number of thread in use.
                     //
-                    if(_serialize && current._handler.get() != _workQueue.get())
+                    if(_serialize && current._handler.get() != _workQueue.get() && !current._deferEnable)
                     {
                         _selector.enable(current._handler.get(), current.operation);
                     }
@@ -706,6 +859,7 @@ IceInternal::ThreadPool::run(const EventHandlerThreadPtr& thread)
             if(_nextHandler != _handlers.end())
             {
                 current._ioCompleted = false;
+                current._deferEnable = false;
                 current._handler = ICE_GET_SHARED_FROM_THIS(_nextHandler->first);
                 current.operation = _nextHandler->second;
                 ++_nextHandler;
@@ -1174,31 +1328,7 @@ IceInternal::ThreadPool::EventHandlerThread::setState(Ice::Instrumentation::Thre
 void
 IceInternal::ThreadPool::EventHandlerThread::run()
 {
-#ifdef ICE_CPP11_MAPPING
-    if(_pool->_instance->initializationData().threadStart)
-#else
-    if(_pool->_instance->initializationData().threadHook)
-#endif
-    {
-        try
-        {
-#ifdef ICE_CPP11_MAPPING
-            _pool->_instance->initializationData().threadStart();
-#else
-            _pool->_instance->initializationData().threadHook->start();
-#endif
-        }
-        catch(const exception& ex)
-        {
-            Error out(_pool->_instance->initializationData().logger);
-            out << "thread hook start() method raised an unexpected exception in `" << _pool->_prefix << "':\n" << ex;
-        }
-        catch(...)
-        {
-            Error out(_pool->_instance->initializationData().logger);
-            out << "thread hook start() method raised an unexpected exception in `" << _pool->_prefix << "'";
-        }
-    }
+    startThreadHook(_pool->_instance, _pool->_prefix);
 
     try
     {
@@ -1217,45 +1347,358 @@ IceInternal::ThreadPool::EventHandlerThread::run()
 
     _observer.detach();
 
-#ifdef ICE_CPP11_MAPPING
-    if(_pool->_instance->initializationData().threadStop)
-#else
-    if(_pool->_instance->initializationData().threadHook)
+    stopThreadHook(_pool->_instance, _pool->_prefix);
+
+    _pool = 0; // Break cyclic dependency.
+}
+
+ThreadPoolCurrent::ThreadPoolCurrent(const InstancePtr& instance,
+                                     const ThreadPoolPtr& threadPool,
+                                     const ThreadPool::EventHandlerThreadPtr& thread) :
+    operation(SocketOperationNone),
+    stream(instance.get(), Ice::currentProtocolEncoding),
+    _threadPool(threadPool.get()),
+    _thread(thread),
+    _ioCompleted(false)
+#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
+    , _leader(false),
+    _deferEnable(false)
 #endif
+{
+}
+
+IceInternal::ThreadPoolExecutor::ThreadPoolExecutor(ThreadPool& threadPool, int size) :
+    _threadPool(threadPool),
+    _next(0),
+    _queued(0),
+    _idleCount(0)
+{
+    //
+    // Create all the threads before starting them, the threads access
+    // the run queues of the other threads to steal work items.
+    //
+    for(int i = 0; i < size; ++i)
+    {
+        ostringstream os;
+        os << _threadPool._prefix << "-executor-" << i;
+        _threads.push_back(new ExecutorThread(*this, os.str(), static_cast<size_t>(i)));
+    }
+    _idle.reserve(_threads.size());
+
+    size_t started = 0;
+    try
+    {
+        for(; started < _threads.size(); ++started)
+        {
+            if(_threadPool._hasPriority)
+            {
+                _threads[started]->start(_threadPool._stackSize, _threadPool._priority);
+            }
+            else
+            {
+                _threads[started]->start(_threadPool._stackSize);
+            }
+        }
+    }
+    catch(...)
+    {
+        destroy();
+        for(size_t i = 0; i < started; ++i)
+        {
+            _threads[i]->getThreadControl().join();
+        }
+        throw;
+    }
+}
+
+void
+IceInternal::ThreadPoolExecutor::destroy()
+{
+    for(vector<ExecutorThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
     {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(**p);
+        (*p)->_destroyed = true;
+        (*p)->notify();
+    }
+}
+
+void
+IceInternal::ThreadPoolExecutor::updateObservers()
+{
+    for(vector<ExecutorThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(**p);
+        (*p)->updateObserver();
+    }
+}
+
+bool
+IceInternal::ThreadPoolExecutor::execute(const DispatchWorkItemPtr& item,
+                                         const EventHandlerPtr& handler,
+                                         SocketOperation operation)
+{
+    ExecutorThread* thread = _threads[static_cast<unsigned int>(_next++) % _threads.size()].get();
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*thread);
+        if(thread->_destroyed)
+        {
+            return false;
+        }
+
+        WorkItem workItem;
+        workItem.item = item;
+        workItem.handler = handler;
+        workItem.operation = operation;
+        thread->_workItems.push_back(workItem);
+        ++_queued;
+
+        if(thread->_waiting)
+        {
+            thread->notify();
+            return true;
+        }
+    }
+
+    //
+    // The thread is busy, wake up an idle thread to steal the work item.
+    //
+    if(_idleCount.load() > 0)
+    {
+        notifyIdle();
+    }
+    return true;
+}
+
+void
+IceInternal::ThreadPoolExecutor::joinWithAllThreads()
+{
+    for(vector<ExecutorThreadPtr>::const_iterator p = _threads.begin(); p != _threads.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+}
+
+void
+IceInternal::ThreadPoolExecutor::run(ExecutorThread* thread)
+{
+    while(true)
+    {
+        WorkItem workItem;
+        bool found = false;
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*thread);
+            if(!thread->_workItems.empty())
+            {
+                workItem = thread->_workItems.front();
+                thread->_workItems.pop_front();
+                found = true;
+            }
+        }
+
+        if(!found && !steal(thread, workItem))
+        {
+            if(!wait(thread))
+            {
+                return; // Destroyed and the run queue of this thread is empty.
+            }
+            continue;
+        }
+        --_queued;
+
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*thread);
+            thread->setState(ICE_ENUM(ThreadState, ThreadStateInUseForUser));
+        }
+
         try
         {
-#ifdef ICE_CPP11_MAPPING
-            _pool->_instance->initializationData().threadStop();
-#else
-            _pool->_instance->initializationData().threadHook->stop();
-#endif
+            _threadPool.dispatchFromThisThread(workItem.item);
         }
         catch(const exception& ex)
         {
-            Error out(_pool->_instance->initializationData().logger);
-            out << "thread hook stop() method raised an unexpected exception in `" << _pool->_prefix << "':\n" << ex;
+            Error out(_threadPool._instance->initializationData().logger);
+            out << "exception in `" << _threadPool._prefix << "':\n" << ex;
         }
         catch(...)
         {
-            Error out(_pool->_instance->initializationData().logger);
-            out << "thread hook stop() method raised an unexpected exception in `" << _pool->_prefix << "'";
+            Error out(_threadPool._instance->initializationData().logger);
+            out << "unknown exception in `" << _threadPool._prefix << "'";
+        }
+
+        if(workItem.handler)
+        {
+            _threadPool.enable(workItem.handler, workItem.operation);
+        }
+
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*thread);
+            thread->setState(ICE_ENUM(ThreadState, ThreadStateIdle));
         }
     }
+}
 
-    _pool = 0; // Break cyclic dependency.
+bool
+IceInternal::ThreadPoolExecutor::steal(ExecutorThread* thread, WorkItem& workItem)
+{
+    //
+    // Take the oldest work item of the first busy thread found, starting
+    // with the thread following this thread. Threads which are locked are
+    // skipped, if all the work items are missed this way, wait() checks
+    // the count of queued work items and retries.
+    //
+    for(size_t i = 1; i < _threads.size() && _queued.load() > 0; ++i)
+    {
+        ExecutorThread* other = _threads[(thread->_index + i) % _threads.size()].get();
+        IceUtil::Monitor<IceUtil::Mutex>::TryLock sync(*other);
+        if(sync.acquired() && !other->_workItems.empty())
+        {
+            workItem = other->_workItems.front();
+            other->_workItems.pop_front();
+            return true;
+        }
+    }
+    return false;
 }
 
-ThreadPoolCurrent::ThreadPoolCurrent(const InstancePtr& instance,
-                                     const ThreadPoolPtr& threadPool,
-                                     const ThreadPool::EventHandlerThreadPtr& thread) :
-    operation(SocketOperationNone),
-    stream(instance.get(), Ice::currentProtocolEncoding),
-    _threadPool(threadPool.get()),
-    _thread(thread),
-    _ioCompleted(false)
-#if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
-    , _leader(false)
-#endif
+bool
+IceInternal::ThreadPoolExecutor::wait(ExecutorThread* thread)
+{
+    {
+        IceUtil::Mutex::Lock sync(_idleMutex);
+        _idle.push_back(thread);
+        ++_idleCount;
+    }
+
+    //
+    // Check again for work items queued before this thread was added to the
+    // idle threads, execute() might not have seen this thread as idle.
+    //
+    if(_queued.load() > 0 && removeIdle(thread))
+    {
+        return true;
+    }
+
+    bool notified;
+    bool destroyed;
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*thread);
+        while(!thread->_notified && thread->_workItems.empty() && !thread->_destroyed)
+        {
+            thread->_waiting = true;
+            thread->wait();
+        }
+        thread->_waiting = false;
+        notified = thread->_notified;
+        thread->_notified = false;
+        destroyed = thread->_destroyed && thread->_workItems.empty();
+    }
+
+    if(!notified)
+    {
+        //
+        // Woken up by a work item queued for this thread or by destroy(),
+        // the thread is still registered as idle.
+        //
+        removeIdle(thread);
+    }
+    return !destroyed;
+}
+
+void
+IceInternal::ThreadPoolExecutor::notifyIdle()
+{
+    ExecutorThread* thread = 0;
+    {
+        IceUtil::Mutex::Lock sync(_idleMutex);
+        if(_idle.empty())
+        {
+            return;
+        }
+        thread = _idle.back();
+        _idle.pop_back();
+        --_idleCount;
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*thread);
+    thread->_notified = true;
+    thread->notify();
+}
+
+bool
+IceInternal::ThreadPoolExecutor::removeIdle(ExecutorThread* thread)
+{
+    IceUtil::Mutex::Lock sync(_idleMutex);
+    vector<ExecutorThread*>::iterator p = find(_idle.begin(), _idle.end(), thread);
+    if(p == _idle.end())
+    {
+        return false; // Already removed by notifyIdle().
+    }
+    _idle.erase(p);
+    --_idleCount;
+    return true;
+}
+
+IceInternal::ThreadPoolExecutor::ExecutorThread::ExecutorThread(ThreadPoolExecutor& executor,
+                                                                const string& name,
+                                                                size_t index) :
+    IceUtil::Thread(name),
+    _executor(executor),
+    _index(index),
+    _destroyed(false),
+    _waiting(false),
+    _notified(false),
+    _state(ICE_ENUM(ThreadState, ThreadStateIdle))
+{
+    updateObserver();
+}
+
+void
+IceInternal::ThreadPoolExecutor::ExecutorThread::run()
+{
+    const ThreadPool& threadPool = _executor._threadPool;
+    startThreadHook(threadPool._instance, threadPool._prefix);
+
+    try
+    {
+        _executor.run(this);
+    }
+    catch(const exception& ex)
+    {
+        Error out(threadPool._instance->initializationData().logger);
+        out << "exception in `" << threadPool._prefix << "':\n" << ex;
+    }
+    catch(...)
+    {
+        Error out(threadPool._instance->initializationData().logger);
+        out << "unknown exception in `" << threadPool._prefix << "'";
+    }
+
+    _observer.detach();
+
+    stopThreadHook(threadPool._instance, threadPool._prefix);
+}
+
+void
+IceInternal::ThreadPoolExecutor::ExecutorThread::updateObserver()
+{
+    // Must be called with the thread locked
+    const CommunicatorObserverPtr& obsv = _executor._threadPool._instance->initializationData().observer;
+    if(obsv)
+    {
+        _observer.attach(obsv->getThreadObserver(_executor._threadPool._prefix, name(), _state, _observer.get()));
+    }
+}
+
+void
+IceInternal::ThreadPoolExecutor::ExecutorThread::setState(Ice::Instrumentation::ThreadState s)
 {
+    // Must be called with the thread locked
+    if(_observer)
+    {
+        if(_state != s)
+        {
+            _observer->stateChanged(_state, s);
+        }
+    }
+    _state = s;
 }
@@ -21,8 +21,11 @@
 #include <Ice/InputStream.h>
 #include <Ice/ObserverHelper.h>
 
+#include <IceUtil/Atomic.h>
+
 #include <set>
 #include <list>
+#include <deque>
 
 namespace IceInternal
 {
@@ -32,6 +35,9 @@ class ThreadPoolCurrent;
 class ThreadPoolWorkQueue;
 ICE_DEFINE_PTR(ThreadPoolWorkQueuePtr, ThreadPoolWorkQueue);
 
+class ThreadPoolExecutor;
+typedef IceUtil::Handle<ThreadPoolExecutor> ThreadPoolExecutorPtr;
+
 class ThreadPoolWorkItem : public virtual IceUtil::Shared
 {
 public:
@@ -110,10 +116,23 @@ public:
 
     std::string prefix() const;
 
+    //
+    // Returns true if the thread pool is configured with Mode=WorkStealing,
+    // the pool threads only perform IO and the dispatch work items are
+    // executed by the threads of the executor.
+    //
+    bool workStealing() const
+    {
+        return _executor.get() != 0;
+    }
+
 private:
 
     void run(const EventHandlerThreadPtr&);
 
+    void dispatch(ThreadPoolCurrent&, const DispatchWorkItemPtr&);
+    void enable(const EventHandlerPtr&, SocketOperation);
+
     bool ioCompleted(ThreadPoolCurrent&);
 
 #if defined(ICE_USE_IOCP) || defined(ICE_OS_UWP)
@@ -141,6 +160,7 @@ private:
     friend class EventHandlerThread;
     friend class ThreadPoolCurrent;
     friend class ThreadPoolWorkQueue;
+    friend class ThreadPoolExecutor;
 
     const int _size; // Number of threads that are pre-created.
     const int _sizeIO; // Maximum number of threads that can concurrently perform IO.
@@ -154,6 +174,7 @@ private:
     const size_t _stackSize;
 
     std::set<EventHandlerThreadPtr> _threads; // All threads, running or not.
+    ThreadPoolExecutorPtr _executor; // Only set with Mode=WorkStealing, immutable after construction.
     int _inUse; // Number of threads that are currently in use.
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     int _inUseIO; // Number of threads that are currently performing IO.
@@ -200,6 +221,15 @@ public:
         _threadPool->dispatchFromThisThread(workItem);
     }
 
+    //
+    // Dispatch the work item from this thread or, if the thread pool is
+    // configured with Mode=WorkStealing, queue it with the executor.
+    //
+    void dispatch(const DispatchWorkItemPtr& workItem)
+    {
+        _threadPool->dispatch(*this, workItem);
+    }
+
 private:
 
     ThreadPool* _threadPool;
@@ -208,6 +238,7 @@ private:
     bool _ioCompleted;
 #if !defined(ICE_USE_IOCP) && !defined(ICE_OS_UWP)
     bool _leader;
+    bool _deferEnable; // True if the handler is enabled by the executor once the dispatch is done.
 #else
     DWORD _count;
     int _error;
@@ -241,6 +272,80 @@ private:
     std::list<ThreadPoolWorkItemPtr> _workItems;
 };
 
+//
+// The executor of a thread pool configured with Mode=WorkStealing. Each
+// executor thread has its own run queue protected by its own mutex, work
+// items are queued in round-robin and idle threads steal work items from
+// the queues of the other threads. The thread pool mutex is only locked to
+// enable again the event handler of a serialized dispatch.
+//
+class ThreadPoolExecutor : public IceUtil::Shared
+{
+public:
+
+    ThreadPoolExecutor(ThreadPool&, int);
+
+    void destroy();
+    void updateObservers();
+
+    //
+    // Queue the work item, the event handler is enabled for the given
+    // operation once the work item is executed. Returns false if the
+    // executor is destroyed.
+    //
+    bool execute(const DispatchWorkItemPtr&, const EventHandlerPtr&, SocketOperation);
+
+    void joinWithAllThreads();
+
+private:
+
+    struct WorkItem
+    {
+        DispatchWorkItemPtr item;
+        EventHandlerPtr handler;
+        SocketOperation operation;
+    };
+
+    class ExecutorThread : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+    {
+    public:
+
+        ExecutorThread(ThreadPoolExecutor&, const std::string&, size_t);
+        virtual void run();
+
+        void updateObserver();
+        void setState(Ice::Instrumentation::ThreadState);
+
+    private:
+
+        friend class ThreadPoolExecutor;
+
+        ThreadPoolExecutor& _executor;
+        const size_t _index;
+        std::deque<WorkItem> _workItems;
+        bool _destroyed;
+        bool _waiting;
+        bool _notified;
+        ObserverHelperT<Ice::Instrumentation::ThreadObserver> _observer;
+        Ice::Instrumentation::ThreadState _state;
+    };
+    typedef IceUtil::Handle<ExecutorThread> ExecutorThreadPtr;
+
+    void run(ExecutorThread*);
+    bool steal(ExecutorThread*, WorkItem&);
+    bool wait(ExecutorThread*);
+    void notifyIdle();
+    bool removeIdle(ExecutorThread*);
+
+    ThreadPool& _threadPool;
+    std::vector<ExecutorThreadPtr> _threads; // Immutable after construction.
+    IceUtilInternal::Atomic _next;
+    IceUtilInternal::Atomic _queued;
+    IceUtilInternal::Atomic _idleCount;
+    IceUtil::Mutex _idleMutex;
+    std::vector<ExecutorThread*> _idle;
+};
+
 //
 // The ThreadPoolMessage class below hides the IOCP implementation details from
 // the event handler implementations. Only event handler implementation that
@@ -62,6 +62,8 @@ getMessageTypeAsString(Byte type)
             return "close connection";
         case validateConnectionMsg:
             return "validate connection";
+        case fragmentMsg:
+            return "fragment";
         default:
             return "unknown";
     }
@@ -154,30 +156,60 @@ printHeader(ostream& s, InputStream& stream)
     stream.read(compress);
     s << "\ncompression status = "  << static_cast<int>(compress) << ' ';
 
-    switch(compress)
-    {
-        case 0:
-        {
-            s << "(not compressed; do not compress response, if any)";
-            break;
-        }
+    static const char* const codecs[] = { "bzip2", "zlib", "lz4", "zstd" };
+    const Byte codecCount = static_cast<Byte>(sizeof(codecs) / sizeof(codecs[0]));
 
-        case 1:
+    if(type == validateConnectionMsg)
+    {
+        //
+        // The compression status of the validate connection message is
+        // the mask of the compression codecs supported by the server and
+        // whether or not the peer accepts fragmented messages.
+        //
+        s << "(supported compression codecs:";
+        bool none = true;
+        for(Byte i = 0; i < codecCount; ++i)
         {
-            s << "(not compressed; compress response, if any)";
-            break;
+            if(compress & (1 << i))
+            {
+                s << ' ' << codecs[i];
+                none = false;
+            }
         }
-
-        case 2:
+        s << (none ? " unknown)" : ")");
+        if(compress & fragmentsSupported)
         {
-            s << "(compressed; compress response, if any)";
-            break;
+            s << " (accepts fragmented messages)";
         }
-
-        default:
+    }
+    else
+    {
+        switch(compress)
         {
-            s << "(unknown)";
-            break;
+            case 0:
+            {
+                s << "(not compressed; do not compress response, if any)";
+                break;
+            }
+
+            case 1:
+            {
+                s << "(not compressed; compress response, if any)";
+                break;
+            }
+
+            default:
+            {
+                if(compress - 2 < codecCount)
+                {
+                    s << "(compressed with " << codecs[compress - 2] << "; compress response, if any)";
+                }
+                else
+                {
+                    s << "(unknown)";
+                }
+                break;
+            }
         }
     }
 
@@ -415,6 +447,13 @@ IceInternal::traceSend(const OutputStream& str, const LoggerPtr& logger, const T
     if(tl->protocol >= 1)
     {
         OutputStream& stream = const_cast<OutputStream&>(str);
+
+        //
+        // The message is printed from a contiguous buffer, the referenced
+        // segments are copied.
+        //
+        stream.copySegments();
+
         InputStream is(stream.instance(), stream.getEncoding(), stream);
         is.i = is.b.begin();
 
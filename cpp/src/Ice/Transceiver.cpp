@@ -16,3 +16,9 @@ IceInternal::Transceiver::bind()
     assert(false);
     return 0;
 }
+
+bool
+IceInternal::Transceiver::supportsSegments() const
+{
+    return false;
+}
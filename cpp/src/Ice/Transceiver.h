@@ -42,6 +42,12 @@ public:
     virtual Ice::ConnectionInfoPtr getInfo() const = 0;
     virtual void checkSendSize(const Buffer&) = 0;
     virtual void setBufferSize(int, int) = 0;
+
+    //
+    // Returns true if write() supports buffers with referenced segments,
+    // see BufferSegments.
+    //
+    virtual bool supportsSegments() const;
 };
 
 }
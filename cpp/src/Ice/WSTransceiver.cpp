@@ -14,6 +14,7 @@
 #include <Ice/Base64.h>
 #include <IceUtil/Random.h>
 #include <Ice/SHA1.h>
+#include <Ice/WSUtil.h>
 #include <IceUtil/StringUtil.h>
 
 // Python 2.7 under Windows.
@@ -1288,33 +1289,8 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                     Trace out(_instance->logger(), _instance->traceCategory());
                     out << "received " << protocol() << " connection close frame\n" << toString();
                 }
-
-                State s = _nextState == StateOpened ? _state : _nextState;
-                if(s == StateClosingRequestPending)
-                {
-                    //
-                    // If we receive a close frame while we were actually
-                    // waiting to send one, change the role and send a
-                    // close frame response.
-                    //
-                    if(!_closingInitiator)
-                    {
-                        _closingInitiator = true;
-                    }
-                    if(_state == StateClosingRequestPending)
-                    {
-                        _state = StateClosingResponsePending;
-                    }
-                    else
-                    {
-                        _nextState = StateClosingResponsePending;
-                    }
-                    return false; // No longer interested in reading
-                }
-                else
-                {
-                    throw ConnectionLostException(__FILE__, __LINE__, 0);
-                }
+                _readState = ReadStateControlFrame;
+                break;
             }
             case OP_PING:
             {
@@ -1352,16 +1328,63 @@ IceInternal::WSTransceiver::preRead(Buffer& buf)
                 return true;
             }
 
+            if(_readPayloadLength > 0 && _incoming)
+            {
+                wsMask(_readI, _readI, _readPayloadLength, _readMask, 0);
+            }
+
             if(_readPayloadLength > 0 && _readOpCode == OP_PING)
             {
                 _pingPayload.clear();
                 _pingPayload.resize(_readPayloadLength);
                 memcpy(&_pingPayload[0], _readI, _pingPayload.size());
             }
+            else if(_readOpCode == OP_CLOSE)
+            {
+                //
+                // The payload of a close frame is either empty or a 2-byte
+                // status code followed by an UTF-8 reason.
+                //
+                if(_readPayloadLength == 1 ||
+                   (_readPayloadLength > 2 && !wsIsValidUTF8(_readI + 2, _readPayloadLength - 2)))
+                {
+                    throw ProtocolException(__FILE__, __LINE__, "invalid close frame payload");
+                }
+            }
 
             _readI += _readPayloadLength;
             _readPayloadLength = 0;
 
+            if(_readOpCode == OP_CLOSE)
+            {
+                State s = _nextState == StateOpened ? _state : _nextState;
+                if(s == StateClosingRequestPending)
+                {
+                    //
+                    // If we receive a close frame while we were actually
+                    // waiting to send one, change the role and send a
+                    // close frame response.
+                    //
+                    if(!_closingInitiator)
+                    {
+                        _closingInitiator = true;
+                    }
+                    if(_state == StateClosingRequestPending)
+                    {
+                        _state = StateClosingResponsePending;
+                    }
+                    else
+                    {
+                        _nextState = StateClosingResponsePending;
+                    }
+                    return false; // No longer interested in reading
+                }
+                else
+                {
+                    throw ConnectionLostException(__FILE__, __LINE__, 0);
+                }
+            }
+
             if(_readOpCode == OP_PING)
             {
                 if(_state == StateOpened)
@@ -1434,11 +1457,8 @@ IceInternal::WSTransceiver::postRead(Buffer& buf)
         //
         // Unmask the data we just read.
         //
-        IceInternal::Buffer::Container::iterator p = _readStart;
-        for(size_t n = _readStart - _readFrameStart; p < buf.i; ++p, ++n)
-        {
-            *p ^= _readMask[n % 4];
-        }
+        wsMask(_readStart, _readStart, static_cast<size_t>(buf.i - _readStart), _readMask,
+               static_cast<size_t>(_readStart - _readFrameStart));
     }
 
     _readPayloadLength -= buf.i - _readStart;
@@ -1544,11 +1564,10 @@ IceInternal::WSTransceiver::preWrite(Buffer& buf)
             }
 
             size_t n = buf.i - buf.b.begin();
-            for(; n < buf.b.size() && _writeBuffer.i < _writeBuffer.b.end(); ++_writeBuffer.i, ++n)
-            {
-                *_writeBuffer.i = buf.b[n] ^ _writeMask[n % 4];
-            }
-            _writePayloadLength = n;
+            size_t sz = min(buf.b.size() - n, static_cast<size_t>(_writeBuffer.b.end() - _writeBuffer.i));
+            wsMask(_writeBuffer.i, &buf.b[0] + n, sz, _writeMask, n);
+            _writeBuffer.i += sz;
+            _writePayloadLength = n + sz;
             if(_writeBuffer.i < _writeBuffer.b.end())
             {
                 _writeBuffer.b.resize(_writeBuffer.i - _writeBuffer.b.begin());
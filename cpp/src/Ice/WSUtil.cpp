@@ -0,0 +1,261 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/WSUtil.h>
+
+#include <string.h>
+#include <stdint.h>
+
+//
+// SSE2 is always available on x86_64 and NEON on AArch64. AVX2 code is
+// compiled with the GCC/clang target attribute and only used if the CPU
+// supports it.
+//
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define ICE_WS_SSE2
+#   include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#   define ICE_WS_NEON
+#   include <arm_neon.h>
+#endif
+
+#if defined(ICE_WS_SSE2) && defined(__GNUC__) && \
+    (defined(__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#   define ICE_WS_AVX2
+#   include <immintrin.h>
+#endif
+
+using namespace Ice;
+using namespace IceInternal;
+
+namespace
+{
+
+#ifdef ICE_WS_AVX2
+bool
+hasAVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+const bool avx2 = hasAVX2();
+
+__attribute__((target("avx2"))) size_t
+maskAVX2(Byte* dst, const Byte* src, size_t n, uint32_t key)
+{
+    const __m256i k = _mm256_set1_epi32(static_cast<int>(key));
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_xor_si256(v, k));
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) size_t
+skipASCIIAVX2(const Byte* p, size_t n)
+{
+    size_t i = 0;
+    for(; i + 32 <= n; i += 32)
+    {
+        if(_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i))) != 0)
+        {
+            break;
+        }
+    }
+    return i;
+}
+#endif
+
+//
+// Masks the bytes of src with the given key, 16 or 32 bytes at a time, and
+// returns the number of bytes masked (a multiple of 4 so the next byte is
+// masked with the first byte of the key).
+//
+size_t
+maskVector(Byte* dst, const Byte* src, size_t n, uint32_t key)
+{
+    size_t i = 0;
+#ifdef ICE_WS_AVX2
+    if(avx2)
+    {
+        i = maskAVX2(dst, src, n, key);
+    }
+#endif
+#if defined(ICE_WS_SSE2)
+    const __m128i k = _mm_set1_epi32(static_cast<int>(key));
+    for(; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, k));
+    }
+#elif defined(ICE_WS_NEON)
+    const uint8x16_t k = vreinterpretq_u8_u32(vdupq_n_u32(key));
+    for(; i + 16 <= n; i += 16)
+    {
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), k));
+    }
+#endif
+    const uint64_t key64 = static_cast<uint64_t>(key) * 0x100000001ULL;
+    for(; i + 8 <= n; i += 8)
+    {
+        uint64_t v;
+        memcpy(&v, src + i, 8);
+        v ^= key64;
+        memcpy(dst + i, &v, 8);
+    }
+    return i;
+}
+
+//
+// Returns the number of leading ASCII bytes, checked 16 or 32 bytes at a
+// time. The remaining bytes (less than a vector or starting with a non-ASCII
+// byte within the next vector) are checked by the caller.
+//
+size_t
+skipASCII(const Byte* p, size_t n)
+{
+    size_t i = 0;
+#ifdef ICE_WS_AVX2
+    if(avx2)
+    {
+        i = skipASCIIAVX2(p, n);
+    }
+#endif
+#if defined(ICE_WS_SSE2)
+    for(; i + 16 <= n; i += 16)
+    {
+        if(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))) != 0)
+        {
+            return i;
+        }
+    }
+#elif defined(ICE_WS_NEON)
+    for(; i + 16 <= n; i += 16)
+    {
+        if(vmaxvq_u8(vld1q_u8(p + i)) >= 0x80)
+        {
+            return i;
+        }
+    }
+#endif
+    for(; i + 8 <= n; i += 8)
+    {
+        uint64_t v;
+        memcpy(&v, p + i, 8);
+        if((v & 0x8080808080808080ULL) != 0)
+        {
+            return i;
+        }
+    }
+    return i;
+}
+
+}
+
+void
+IceInternal::wsMask(Byte* dst, const Byte* src, size_t n, const Byte* mask, size_t offset)
+{
+    //
+    // Rotate the key so that its first byte applies to src[0].
+    //
+    Byte rotated[4];
+    for(size_t i = 0; i < 4; ++i)
+    {
+        rotated[i] = mask[(offset + i) % 4];
+    }
+    uint32_t key;
+    memcpy(&key, rotated, 4);
+
+    size_t i = maskVector(dst, src, n, key);
+    for(; i < n; ++i)
+    {
+        dst[i] = src[i] ^ rotated[i % 4];
+    }
+}
+
+bool
+IceInternal::wsIsValidUTF8(const Byte* p, size_t n)
+{
+    size_t i = 0;
+    while(i < n)
+    {
+        i += skipASCII(p + i, n - i);
+        if(i == n)
+        {
+            break;
+        }
+
+        //
+        // Skip the ASCII bytes preceding the next multi-byte sequence in the
+        // vector that skipASCII stopped at.
+        //
+        Byte c = p[i];
+        if(c < 0x80)
+        {
+            ++i;
+            while(i < n && p[i] < 0x80)
+            {
+                ++i;
+            }
+            continue;
+        }
+
+        //
+        // Check the number of continuation bytes and the allowed range for
+        // the second byte, which excludes overlong encodings, surrogates
+        // and code points above U+10FFFF.
+        //
+        size_t length;
+        Byte min = 0x80;
+        Byte max = 0xBF;
+        if(c >= 0xC2 && c <= 0xDF)
+        {
+            length = 2;
+        }
+        else if(c >= 0xE0 && c <= 0xEF)
+        {
+            length = 3;
+            if(c == 0xE0)
+            {
+                min = 0xA0;
+            }
+            else if(c == 0xED)
+            {
+                max = 0x9F;
+            }
+        }
+        else if(c >= 0xF0 && c <= 0xF4)
+        {
+            length = 4;
+            if(c == 0xF0)
+            {
+                min = 0x90;
+            }
+            else if(c == 0xF4)
+            {
+                max = 0x8F;
+            }
+        }
+        else
+        {
+            return false;
+        }
+
+        if(n - i < length || p[i + 1] < min || p[i + 1] > max)
+        {
+            return false;
+        }
+        for(size_t j = 2; j < length; ++j)
+        {
+            if((p[i + j] & 0xC0) != 0x80)
+            {
+                return false;
+            }
+        }
+        i += length;
+    }
+    return true;
+}
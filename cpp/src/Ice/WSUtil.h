@@ -0,0 +1,30 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_WS_UTIL_H
+#define ICE_WS_UTIL_H
+
+#include <Ice/Config.h>
+
+namespace IceInternal
+{
+
+//
+// Apply the 4-byte WebSocket masking key to n bytes of the src buffer and
+// store the result in dst, dst can be equal to src for in-place masking.
+// The offset is the position of src[0] in the frame payload, it selects
+// the key byte applied to src[0]. Masking and unmasking are the same
+// operation.
+//
+ICE_API void wsMask(Ice::Byte*, const Ice::Byte*, size_t, const Ice::Byte*, size_t);
+
+//
+// Returns true if the given bytes are a complete and well-formed UTF-8
+// sequence (RFC 3629, without overlong encodings or surrogates).
+//
+ICE_API bool wsIsValidUTF8(const Ice::Byte*, size_t);
+
+}
+
+#endif
@@ -139,7 +139,36 @@ BadEnvException::ice_throw() const
     throw *this;
 }
 
-Env::Env(const string& path, MDB_dbi maxDbs, size_t mapSize, unsigned int maxReaders)
+namespace
+{
+
+//
+// How long a resize waits for the active transactions to complete, and
+// how long to wait before trying again when the map can't be resized.
+//
+const IceUtil::Time resizeTimeout = IceUtil::Time::seconds(1);
+const IceUtil::Time resizeRetryDelay = IceUtil::Time::seconds(10);
+
+size_t
+getPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return si.dwPageSize;
+#else
+    return sysconf(_SC_PAGESIZE);
+#endif
+}
+
+}
+
+Env::Env(const string& path, MDB_dbi maxDbs, size_t mapSize, unsigned int maxReaders) :
+    _txns(0),
+    _resizing(false),
+    _full(false),
+    _threshold(0),
+    _maxMapSize(0)
 {
     int rc = mdb_env_create(&_menv);
     if(rc != MDB_SUCCESS)
@@ -147,6 +176,12 @@ Env::Env(const string& path, MDB_dbi maxDbs, size_t mapSize, unsigned int maxRea
         throw LMDBException(__FILE__, __LINE__, rc);
     }
 
+    rc = mdb_env_set_userctx(_menv, this);
+    if(rc != MDB_SUCCESS)
+    {
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+
     if(maxDbs != 0)
     {
         rc = mdb_env_set_maxdbs(_menv, maxDbs);
@@ -159,14 +194,7 @@ Env::Env(const string& path, MDB_dbi maxDbs, size_t mapSize, unsigned int maxRea
     if(mapSize != 0)
     {
         // Make sure the map size is a multiple of the page size
-        size_t pageSize;
-#ifdef _WIN32
-        SYSTEM_INFO si;
-        GetSystemInfo(&si);
-        pageSize = si.dwPageSize;
-#else
-        pageSize = sysconf(_SC_PAGESIZE);
-#endif
+        const size_t pageSize = getPageSize();
         size_t remainder = mapSize % pageSize;
         if(remainder != 0)
         {
@@ -222,13 +250,239 @@ Env::menv() const
     return _menv;
 }
 
-Txn::Txn(const Env& env, unsigned int flags)
+void
+Env::setMapGrowth(int threshold, size_t maxMapSize)
 {
-    const int rc = mdb_txn_begin(env.menv(), 0, flags, &_mtxn);
+    _threshold = max(0, min(threshold, 100));
+    _maxMapSize = maxMapSize;
+}
+
+EnvStat
+Env::stat() const
+{
+    MDB_envinfo info;
+    int rc = mdb_env_info(_menv, &info);
+    if(rc != MDB_SUCCESS)
+    {
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+
+    MDB_stat stat;
+    rc = mdb_env_stat(_menv, &stat);
     if(rc != MDB_SUCCESS)
     {
         throw LMDBException(__FILE__, __LINE__, rc);
     }
+
+    EnvStat envStat;
+    envStat.mapSize = info.me_mapsize;
+    envStat.maxMapSize = _maxMapSize;
+    envStat.pageSize = stat.ms_psize;
+    envStat.usedPages = info.me_last_pgno + 1;
+    return envStat;
+}
+
+void
+Env::copy(const string& path, bool compact) const
+{
+    //
+    // The copy reads the environment with its own read-only transaction,
+    // the map must not be resized meanwhile.
+    //
+    beginTxn(false);
+    const int rc = mdb_env_copy2(_menv, path.c_str(), compact ? MDB_CP_COMPACT : 0);
+    endTxn();
+    if(rc != MDB_SUCCESS)
+    {
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+}
+
+void
+Env::beginTxn(bool readWrite) const
+{
+    if(readWrite && _threshold > 0)
+    {
+        bool grow;
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+            grow = _full;
+        }
+
+        if(!grow)
+        {
+            //
+            // The map is grown once the last used page crosses the
+            // threshold, the pages freed by LMDB are only reused below it.
+            //
+            MDB_envinfo info;
+            MDB_stat stat;
+            if(mdb_env_info(_menv, &info) == MDB_SUCCESS && mdb_env_stat(_menv, &stat) == MDB_SUCCESS)
+            {
+                grow = (info.me_last_pgno + 1) * stat.ms_psize > info.me_mapsize / 100 * _threshold;
+            }
+        }
+
+        if(grow)
+        {
+            resize(true);
+        }
+    }
+
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    while(_resizing)
+    {
+        _monitor.wait();
+    }
+    ++_txns;
+}
+
+void
+Env::endTxn() const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    assert(_txns > 0);
+    if(--_txns == 0 && _resizing)
+    {
+        _monitor.notifyAll();
+    }
+}
+
+bool
+Env::resize(bool grow) const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    if(_resizing)
+    {
+        //
+        // Another thread is resizing the map.
+        //
+        while(_resizing)
+        {
+            _monitor.wait();
+        }
+        return true;
+    }
+
+    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    if(grow && now < _nextResize)
+    {
+        return false;
+    }
+
+    //
+    // LMDB requires the map to be resized while this process has no active
+    // transactions. If the transactions don't complete in time, for example
+    // because the calling thread has a transaction of its own, the resize
+    // is given up and tried again later.
+    //
+    _resizing = true;
+    const IceUtil::Time deadline = now + resizeTimeout;
+    while(_txns > 0)
+    {
+        now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(now >= deadline)
+        {
+            _resizing = false;
+            _nextResize = now + resizeRetryDelay;
+            _monitor.notifyAll();
+            return false;
+        }
+        _monitor.timedWait(deadline - now);
+    }
+
+    int rc = MDB_SUCCESS;
+    if(grow)
+    {
+        MDB_envinfo info;
+        rc = mdb_env_info(_menv, &info);
+        if(rc == MDB_SUCCESS)
+        {
+            size_t mapSize = info.me_mapsize * 2;
+            if(_maxMapSize > 0 && mapSize > _maxMapSize)
+            {
+                mapSize = _maxMapSize - _maxMapSize % getPageSize();
+            }
+
+            if(mapSize > info.me_mapsize)
+            {
+                rc = mdb_env_set_mapsize(_menv, mapSize);
+            }
+            else
+            {
+                _nextResize = now + resizeRetryDelay; // The map reached its maximum size.
+            }
+        }
+    }
+    else
+    {
+        //
+        // Adopt the map size set by another process.
+        //
+        rc = mdb_env_set_mapsize(_menv, 0);
+    }
+
+    _full = false;
+    _resizing = false;
+    _monitor.notifyAll();
+
+    if(rc != MDB_SUCCESS)
+    {
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+    return true;
+}
+
+void
+Env::mapFull() const
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(_monitor);
+    _full = true;
+}
+
+void
+Env::mapFull(MDB_txn* txn)
+{
+    const Env* env = static_cast<const Env*>(mdb_env_get_userctx(mdb_txn_env(txn)));
+    if(env != 0)
+    {
+        env->mapFull();
+    }
+}
+
+Txn::Txn(const Env& env, unsigned int flags) :
+    _env(&env)
+{
+    env.beginTxn((flags & MDB_RDONLY) == 0);
+    int rc = mdb_txn_begin(env.menv(), 0, flags, &_mtxn);
+    if(rc == MDB_MAP_RESIZED)
+    {
+        //
+        // Another process grew the map.
+        //
+        env.endTxn();
+        if(!env.resize(false))
+        {
+            _env = 0;
+            throw LMDBException(__FILE__, __LINE__, rc);
+        }
+        env.beginTxn(false);
+        rc = mdb_txn_begin(env.menv(), 0, flags, &_mtxn);
+    }
+
+    if(rc != MDB_SUCCESS)
+    {
+        _mtxn = 0;
+        _env = 0;
+        env.endTxn();
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+}
+
+Txn::Txn() :
+    _mtxn(0),
+    _env(0)
+{
 }
 
 Txn::~Txn()
@@ -241,8 +495,19 @@ Txn::commit()
 {
     const int rc = mdb_txn_commit(_mtxn);
     _mtxn = 0;
+    const Env* env = _env;
+    if(_env != 0)
+    {
+        _env->endTxn();
+        _env = 0;
+    }
+
     if(rc != MDB_SUCCESS)
     {
+        if(rc == MDB_MAP_FULL && env != 0)
+        {
+            env->mapFull();
+        }
         throw LMDBException(__FILE__, __LINE__, rc);
     }
 }
@@ -254,6 +519,11 @@ Txn::rollback()
     {
         mdb_txn_abort(_mtxn);
         _mtxn = 0;
+        if(_env != 0)
+        {
+            _env->endTxn();
+            _env = 0;
+        }
     }
 }
 
@@ -299,6 +569,322 @@ ReadWriteTxn::ReadWriteTxn(const Env& env) :
 {
 }
 
+ReadWriteTxn::ReadWriteTxn()
+{
+}
+
+namespace IceDB
+{
+
+class GroupCommitThread : public IceUtil::Thread
+{
+public:
+
+    GroupCommitThread(GroupCommit& groupCommit) :
+        IceUtil::Thread("IceDB.GroupCommit"),
+        _groupCommit(groupCommit)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _groupCommit.run();
+    }
+
+private:
+
+    GroupCommit& _groupCommit;
+};
+
+}
+
+GroupCommit::GroupCommit(const Env& env, const IceUtil::Time& window) :
+    _env(env),
+    _window(window),
+    _mtxn(0),
+    _group(0),
+    _committed(0),
+    _beginFailures(0),
+    _beginError(MDB_SUCCESS),
+    _waiting(0),
+    _active(false),
+    _destroyed(false)
+{
+    if(_window > IceUtil::Time())
+    {
+        _thread = new GroupCommitThread(*this);
+        _thread->start();
+    }
+}
+
+GroupCommit::~GroupCommit()
+{
+    destroy();
+}
+
+void
+GroupCommit::destroy()
+{
+    {
+        Lock sync(*this);
+        _destroyed = true;
+        notifyAll();
+    }
+
+    if(_thread)
+    {
+        _thread->getThreadControl().join();
+        _thread = 0;
+    }
+}
+
+void
+GroupCommit::wait(Ice::Long group)
+{
+    if(group == 0)
+    {
+        return; // Group commit is disabled.
+    }
+
+    Lock sync(*this);
+    while(_committed < group)
+    {
+        IceUtil::Monitor<IceUtil::Mutex>::wait();
+    }
+
+    map<Ice::Long, int>::const_iterator p = _errors.find(group);
+    if(p != _errors.end())
+    {
+        throw LMDBException(__FILE__, __LINE__, p->second);
+    }
+}
+
+MDB_txn*
+GroupCommit::begin(Ice::Long& group)
+{
+    group = 0;
+    if(!_thread)
+    {
+        return 0; // Group commit is disabled, start a regular transaction.
+    }
+
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        return 0; // Start a regular transaction once destroyed.
+    }
+
+    const Ice::Long beginFailures = _beginFailures;
+    ++_waiting;
+    notifyAll();
+    while(_mtxn == 0 || _active)
+    {
+        if(_beginFailures != beginFailures)
+        {
+            --_waiting;
+            throw LMDBException(__FILE__, __LINE__, _beginError);
+        }
+        IceUtil::Monitor<IceUtil::Mutex>::wait();
+    }
+    --_waiting;
+
+    _active = true;
+    group = _group;
+    return _mtxn;
+}
+
+void
+GroupCommit::end()
+{
+    Lock sync(*this);
+    assert(_active);
+    _active = false;
+    notifyAll();
+}
+
+void
+GroupCommit::run()
+{
+    Lock sync(*this);
+    while(true)
+    {
+        while(_waiting == 0 && !_destroyed)
+        {
+            IceUtil::Monitor<IceUtil::Mutex>::wait();
+        }
+
+        if(_waiting == 0)
+        {
+            return; // Destroyed and no writer is waiting for a group.
+        }
+
+        //
+        // Start the group transaction without holding the lock: this waits
+        // for the regular read-write transactions to complete.
+        //
+        MDB_txn* mtxn = 0;
+        unlock();
+        int rc;
+        try
+        {
+            _env.beginTxn(true);
+            rc = mdb_txn_begin(_env.menv(), 0, 0, &mtxn);
+            if(rc != MDB_SUCCESS)
+            {
+                _env.endTxn();
+            }
+        }
+        catch(const LMDBException& ex)
+        {
+            rc = ex.error();
+        }
+        lock();
+        if(rc != MDB_SUCCESS)
+        {
+            ++_beginFailures;
+            _beginError = rc;
+            notifyAll();
+            continue;
+        }
+
+        _mtxn = mtxn;
+        const Ice::Long group = ++_group;
+        notifyAll();
+
+        //
+        // The writers join the group until the window elapses. The group
+        // is closed once the active nested transaction completes.
+        //
+        const IceUtil::Time deadline = IceUtil::Time::now(IceUtil::Time::Monotonic) + _window;
+        while(true)
+        {
+            if(_active)
+            {
+                IceUtil::Monitor<IceUtil::Mutex>::wait();
+                continue;
+            }
+
+            const IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+            if(_destroyed || now >= deadline)
+            {
+                break;
+            }
+            timedWait(deadline - now);
+        }
+        _mtxn = 0;
+
+        unlock();
+        rc = mdb_txn_commit(mtxn);
+        _env.endTxn();
+        lock();
+
+        if(rc != MDB_SUCCESS)
+        {
+            if(rc == MDB_MAP_FULL)
+            {
+                _env.mapFull();
+            }
+            _errors[group] = rc;
+        }
+
+        //
+        // Only remember the recent failures, the writers wait for their
+        // group as soon as they release their locks.
+        //
+        while(!_errors.empty() && _errors.begin()->first < group - 1000)
+        {
+            _errors.erase(_errors.begin());
+        }
+
+        _committed = group;
+        notifyAll();
+    }
+}
+
+GroupTxn::GroupTxn(GroupCommit& groupCommit) :
+    _groupCommit(groupCommit),
+    _group(0)
+{
+    MDB_txn* parent = _groupCommit.begin(_group);
+    if(!parent)
+    {
+        _env = &_groupCommit._env;
+        _env->beginTxn(true);
+    }
+
+    const int rc = mdb_txn_begin(_groupCommit._env.menv(), parent, 0, &_mtxn);
+    if(rc != MDB_SUCCESS)
+    {
+        _mtxn = 0;
+        if(parent)
+        {
+            _groupCommit.end();
+        }
+        else
+        {
+            _env->endTxn();
+            _env = 0;
+        }
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+}
+
+GroupTxn::~GroupTxn()
+{
+    rollback();
+}
+
+void
+GroupTxn::commit()
+{
+    const int rc = mdb_txn_commit(_mtxn);
+    _mtxn = 0;
+    if(_group != 0)
+    {
+        _groupCommit.end();
+    }
+    else if(_env != 0)
+    {
+        _env->endTxn();
+        _env = 0;
+    }
+
+    if(rc != MDB_SUCCESS)
+    {
+        if(rc == MDB_MAP_FULL)
+        {
+            _groupCommit._env.mapFull();
+        }
+        throw LMDBException(__FILE__, __LINE__, rc);
+    }
+}
+
+void
+GroupTxn::rollback()
+{
+    if(_mtxn != 0)
+    {
+        mdb_txn_abort(_mtxn);
+        _mtxn = 0;
+        if(_group != 0)
+        {
+            _groupCommit.end();
+        }
+        else if(_env != 0)
+        {
+            _env->endTxn();
+            _env = 0;
+        }
+    }
+}
+
+Ice::Long
+GroupTxn::group() const
+{
+    return _group;
+}
+
 DbiBase::DbiBase(const Txn& txn, const std::string& name, unsigned int flags, MDB_cmp_func* cmp)
 {
     int rc = mdb_dbi_open(txn.mtxn(), name.c_str(), flags, &_mdbi);
@@ -362,6 +948,10 @@ DbiBase::put(const ReadWriteTxn& txn, MDB_val* key, MDB_val* data, unsigned int
     const int rc = mdb_put(txn.mtxn(), _mdbi, key, data, flags);
     if(rc != MDB_SUCCESS)
     {
+        if(rc == MDB_MAP_FULL)
+        {
+            Env::mapFull(txn.mtxn());
+        }
         throw LMDBException(__FILE__, __LINE__, rc);
     }
 }
@@ -440,6 +1030,10 @@ CursorBase::put(MDB_val* key, MDB_val* data, unsigned int flags)
     const int rc = mdb_cursor_put(_mcursor, key, data, flags);
     if (rc != MDB_SUCCESS)
     {
+        if(rc == MDB_MAP_FULL)
+        {
+            Env::mapFull(mdb_cursor_txn(_mcursor));
+        }
         throw LMDBException(__FILE__, __LINE__, rc);
     }
 }
@@ -7,12 +7,17 @@
 
 #include <IceUtil/Exception.h>
 #include <IceUtil/FileUtil.h>
+#include <IceUtil/Monitor.h>
+#include <IceUtil/Mutex.h>
+#include <IceUtil/Thread.h>
 #include <Ice/Initialize.h>
 #include <Ice/OutputStream.h>
 #include <Ice/InputStream.h>
 
 #include <lmdb.h>
 
+#include <map>
+
 #ifndef ICE_DB_API
 #   if defined(ICE_STATIC_LIBS)
 #       define ICE_DB_API /**/
@@ -142,6 +147,17 @@ private:
 template<typename T, typename C, typename H>
 struct Codec;
 
+//
+// The usage of the map of an environment, sizes are in bytes.
+//
+struct EnvStat
+{
+    size_t mapSize;
+    size_t maxMapSize;
+    size_t pageSize;
+    size_t usedPages;
+};
+
 class ICE_DB_API Env
 {
 public:
@@ -153,13 +169,53 @@ public:
 
     MDB_env* menv() const;
 
+    //
+    // Enables the growth of the map: when a read-write transaction starts
+    // and more than threshold percent of the map is used, or once a
+    // transaction failed with MDB_MAP_FULL, the map size is doubled up to
+    // maxMapSize bytes (0 for no limit). The map is resized once all the
+    // transactions of this process completed, the new transactions wait
+    // for the resize. A threshold of 0 disables the growth.
+    //
+    void setMapGrowth(int, size_t = 0);
+
+    EnvStat stat() const;
+
+    //
+    // Copies the environment into the given directory, which must exist,
+    // while it can still be updated. With compact, the free pages are
+    // omitted and the pages are renumbered sequentially.
+    //
+    void copy(const std::string&, bool) const;
+
 private:
 
     // Not implemented: class is not copyable
     Env(const Env&);
     void operator=(const Env&);
 
+    friend class Txn;
+    friend class GroupCommit;
+    friend class GroupTxn;
+    friend class DbiBase;
+    friend class CursorBase;
+
+    void beginTxn(bool) const;
+    void endTxn() const;
+    bool resize(bool) const;
+    void mapFull() const;
+
+    static void mapFull(MDB_txn*);
+
     MDB_env* _menv;
+
+    mutable IceUtil::Monitor<IceUtil::Mutex> _monitor;
+    mutable int _txns; // The active transactions.
+    mutable bool _resizing;
+    mutable bool _full;
+    mutable IceUtil::Time _nextResize;
+    int _threshold;
+    size_t _maxMapSize;
 };
 
 class ICE_DB_API Txn
@@ -176,8 +232,10 @@ public:
 protected:
 
     explicit Txn(const Env&, unsigned int);
+    Txn();
 
     MDB_txn* _mtxn;
+    const Env* _env; // Set if the transaction is counted by the environment.
 
 private:
 
@@ -205,6 +263,106 @@ public:
     virtual ~ReadWriteTxn();
 
     explicit ReadWriteTxn(const Env&);
+
+protected:
+
+    ReadWriteTxn();
+};
+
+//
+// GroupCommit coalesces the updates of concurrent writers into a single
+// LMDB transaction, so that these writers share the cost of committing
+// and flushing this transaction to disk.
+//
+// The group transaction is started by the group commit thread when a
+// writer is waiting for it and committed once the group commit window
+// has elapsed. Each writer updates the database in a GroupTxn nested in
+// the group transaction, one writer at a time, and waits for the commit
+// of its group with wait(), preferably after releasing its own locks so
+// that other writers can join the group.
+//
+// The nested transactions are used by other threads than the group
+// commit thread which owns the group transaction. This is safe with
+// LMDB: only the top-level transaction acquires and releases the write
+// lock of the environment, which the group commit thread does, and the
+// group transaction is never used by two threads at once, the monitor
+// hands it over from one thread to the next.
+//
+// If the window is zero or once the GroupCommit is destroyed, each
+// GroupTxn is a regular transaction committed and flushed to disk by
+// GroupTxn::commit.
+//
+class ICE_DB_API GroupCommit : private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    GroupCommit(const Env&, const IceUtil::Time&);
+    ~GroupCommit();
+
+    void destroy();
+
+    //
+    // Waits for the commit of the given group, throws LMDBException if
+    // the group transaction couldn't be committed.
+    //
+    void wait(Ice::Long);
+
+private:
+
+    // Not implemented: class is not copyable
+    GroupCommit(const GroupCommit&);
+    void operator=(const GroupCommit&);
+
+    friend class GroupTxn;
+    friend class GroupCommitThread;
+
+    MDB_txn* begin(Ice::Long&);
+    void end();
+    void run();
+
+    const Env& _env;
+    const IceUtil::Time _window;
+    IceUtil::ThreadPtr _thread;
+
+    MDB_txn* _mtxn; // The transaction of the open group, null if no group is open.
+    Ice::Long _group; // The last open group.
+    Ice::Long _committed; // The last committed group.
+    std::map<Ice::Long, int> _errors; // The groups which couldn't be committed.
+    Ice::Long _beginFailures;
+    int _beginError;
+    int _waiting;
+    bool _active;
+    bool _destroyed;
+};
+
+//
+// A transaction nested in the transaction of the current group. Only one
+// GroupTxn can be active at a time, a thread must not start another
+// read-write transaction or wait for a group while its GroupTxn is active.
+//
+class ICE_DB_API GroupTxn : public ReadWriteTxn
+{
+public:
+
+    explicit GroupTxn(GroupCommit&);
+    virtual ~GroupTxn();
+
+    //
+    // Commits the updates to the group transaction, they are durable once
+    // GroupCommit::wait returns for this group.
+    //
+    void commit();
+    void rollback();
+
+    //
+    // The group of this transaction, 0 for a regular transaction.
+    //
+    Ice::Long group() const;
+
+private:
+
+    GroupCommit& _groupCommit;
+    Ice::Long _group;
 };
 
 class ICE_DB_API DbiBase
@@ -404,6 +562,20 @@ public:
         return false;
     }
 
+    //
+    // Reads only the key, the data isn't decoded.
+    //
+    bool get(K& key, MDB_cursor_op op)
+    {
+        MDB_val mkey, mdata;
+        if(CursorBase::get(&mkey, &mdata, op))
+        {
+            Codec<K, C, H>::read(key, mkey, _marshalingContext);
+            return true;
+        }
+        return false;
+    }
+
     bool find(const K& key)
     {
         unsigned char kbuf[maxKeySize];
@@ -500,6 +672,10 @@ struct IceContext
 template<typename T>
 struct Codec<T, IceContext, Ice::OutputStream>
 {
+    //
+    // The value is decoded in place from the memory map, without copying
+    // the encoded bytes.
+    //
     static void read(T& t, const MDB_val& val, const IceContext& ctx)
     {
         std::pair<const Ice::Byte*, const Ice::Byte*> p(static_cast<const Ice::Byte*>(val.mv_data),
@@ -954,6 +954,18 @@ AdminI::getAllRegistryNames(const Current&) const
     return replicas;
 }
 
+DatabaseInfo
+AdminI::getDatabaseInfo(const Current&) const
+{
+    return _database->getDatabaseInfo();
+}
+
+void
+AdminI::copyDatabase(const string& path, bool compact, const Current&) const
+{
+    _database->copyDatabase(path, compact);
+}
+
 void
 AdminI::shutdown(const Current&)
 {
@@ -83,6 +83,9 @@ public:
     virtual void shutdownRegistry(const std::string&, const Ice::Current&);
     virtual Ice::StringSeq getAllRegistryNames(const ::Ice::Current&) const;
 
+    virtual DatabaseInfo getDatabaseInfo(const Ice::Current&) const;
+    virtual void copyDatabase(const std::string&, bool, const Ice::Current&) const;
+
     virtual void shutdown(const Ice::Current&);
 
     virtual Ice::SliceChecksumDict getSliceChecksums(const Ice::Current&) const;
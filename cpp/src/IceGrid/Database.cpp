@@ -5,6 +5,7 @@
 #include <IceUtil/StringUtil.h>
 #include <IceUtil/Random.h>
 #include <IceUtil/Functional.h>
+#include <IceUtil/FileUtil.h>
 #include <Ice/LoggerUtil.h>
 #include <Ice/Communicator.h>
 #include <Ice/ObjectAdapter.h>
@@ -26,6 +27,7 @@ using namespace std;
 using namespace IceGrid;
 
 typedef IceDB::ReadWriteCursor<string, ApplicationInfo, IceDB::IceContext, Ice::OutputStream> ApplicationMapRWCursor;
+typedef IceDB::ReadOnlyCursor<string, ApplicationInfo, IceDB::IceContext, Ice::OutputStream> ApplicationMapROCursor;
 typedef IceDB::ReadOnlyCursor<string, AdapterInfo, IceDB::IceContext, Ice::OutputStream> AdapterMapROCursor;
 typedef IceDB::Cursor<string, string, IceDB::IceContext, Ice::OutputStream> AdaptersByGroupMapCursor;
 typedef IceDB::ReadOnlyCursor<string, Ice::Identity, IceDB::IceContext, Ice::OutputStream> ObjectsByTypeMapROCursor;
@@ -209,9 +211,16 @@ Database::Database(const Ice::ObjectAdapterPtr& registryAdapter,
     _dbLock(_communicator->getProperties()->getProperty("IceGrid.Registry.LMDB.Path") + "/icedb.lock"),
     _env(_communicator->getProperties()->getProperty("IceGrid.Registry.LMDB.Path"), 8,
          IceDB::getMapSize(_communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.LMDB.MapSize"))),
+    _groupCommit(_env, IceUtil::Time::milliSeconds(
+                     _communicator->getProperties()->getPropertyAsInt("IceGrid.Registry.LMDB.GroupCommitWindow"))),
     _pluginFacade(RegistryPluginFacadeIPtr::dynamicCast(getRegistryPluginFacade())),
     _lock(0)
 {
+    const Ice::PropertiesPtr properties = _communicator->getProperties();
+    const int maxMapSize = properties->getPropertyAsInt("IceGrid.Registry.LMDB.MaxMapSize");
+    _env.setMapGrowth(properties->getPropertyAsIntWithDefault("IceGrid.Registry.LMDB.MapGrowthThreshold", 90),
+                      static_cast<size_t>(max(maxMapSize, 0)) * 1024 * 1024);
+
     IceDB::ReadWriteTxn txn(_env);
 
     IceDB::IceContext context;
@@ -584,6 +593,40 @@ Database::getSerials() const
     return toMap(txn, _serials);
 }
 
+DatabaseInfo
+Database::getDatabaseInfo() const
+{
+    const IceDB::EnvStat stat = _env.stat();
+
+    DatabaseInfo info;
+    info.mapSize = static_cast<Ice::Long>(stat.mapSize);
+    info.maxMapSize = static_cast<Ice::Long>(stat.maxMapSize);
+    info.pageSize = static_cast<Ice::Long>(stat.pageSize);
+    info.usedPages = static_cast<Ice::Long>(stat.usedPages);
+    return info;
+}
+
+void
+Database::copyDatabase(const string& path, bool compact) const
+{
+    if(!IceUtilInternal::directoryExists(path) && IceUtilInternal::mkdir(path, 0777) != 0)
+    {
+        throw FileNotAvailableException("cannot create directory `" + path + "':\n" +
+                                        IceUtilInternal::lastErrorToString());
+    }
+
+    try
+    {
+        _env.copy(path, compact);
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        ostringstream os;
+        os << "cannot copy the database to `" << path << "':\n" << ex;
+        throw FileNotAvailableException(os.str());
+    }
+}
+
 void
 Database::addApplication(const ApplicationInfo& info, AdminSessionI* session, Ice::Long dbSerial)
 {
@@ -913,7 +956,18 @@ Ice::StringSeq
 Database::getAllApplications(const string& expression)
 {
     IceDB::ReadOnlyTxn txn(_env);
-    return getMatchingKeys<map<string, ApplicationInfo> >(toMap(txn, _applications), expression);
+
+    Ice::StringSeq names;
+    string name;
+    ApplicationMapROCursor cursor(_applications, txn);
+    while(cursor.get(name, MDB_NEXT))
+    {
+        if(expression.empty() || IceUtilInternal::match(name, expression, true))
+        {
+            names.push_back(name);
+        }
+    }
+    return names;
 }
 
 void
@@ -989,6 +1043,7 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
     assert(dbSerial != 0 || _master);
 
     int serial = 0; // Initialize to prevent warning.
+    Ice::Long group = 0;
     {
         Lock sync(*this);
         if(_adapterCache.has(adapterId))
@@ -1011,7 +1066,7 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
         bool updated = false;
         try
         {
-            IceDB::ReadWriteTxn txn(_env);
+            IceDB::GroupTxn txn(_groupCommit);
 
             AdapterInfo oldInfo;
             bool found = _adapters.get(txn, adapterId, oldInfo);
@@ -1036,6 +1091,7 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
             dbSerial = updateSerial(txn, adaptersDbName, dbSerial);
 
             txn.commit();
+            group = txn.group();
         }
         catch(const IceDB::KeyTooLongException&)
         {
@@ -1074,6 +1130,7 @@ Database::setAdapterDirectProxy(const string& adapterId, const string& replicaGr
             serial = _adapterObserverTopic->adapterRemoved(dbSerial, adapterId);
         }
     }
+    waitForGroupCommit(group);
     _adapterObserverTopic->waitForSyncedSubscribers(serial);
 }
 
@@ -1118,6 +1175,7 @@ Database::removeAdapter(const string& adapterId)
     assert(_master);
 
     int serial = 0; // Initialize to prevent warning.
+    Ice::Long group = 0;
     {
         Lock sync(*this);
         if(_adapterCache.has(adapterId))
@@ -1132,7 +1190,7 @@ Database::removeAdapter(const string& adapterId)
         Ice::Long dbSerial = 0;
         try
         {
-            IceDB::ReadWriteTxn txn(_env);
+            IceDB::GroupTxn txn(_groupCommit);
 
             AdapterInfo info;
             if(_adapters.get(txn, adapterId, info))
@@ -1156,6 +1214,7 @@ Database::removeAdapter(const string& adapterId)
             dbSerial = updateSerial(txn, adaptersDbName);
 
             txn.commit();
+            group = txn.group();
         }
         catch(const IceDB::KeyTooLongException&)
         {
@@ -1185,6 +1244,7 @@ Database::removeAdapter(const string& adapterId)
             }
         }
     }
+    waitForGroupCommit(group);
     _adapterObserverTopic->waitForSyncedSubscribers(serial);
 }
 
@@ -1450,6 +1510,7 @@ Database::addObject(const ObjectInfo& info)
     assert(_master);
 
     int serial = 0;
+    Ice::Long group = 0;
     {
         Lock sync(*this);
         const Ice::Identity id = info.proxy->ice_getIdentity();
@@ -1462,7 +1523,7 @@ Database::addObject(const ObjectInfo& info)
         Ice::Long dbSerial = 0;
         try
         {
-            IceDB::ReadWriteTxn txn(_env);
+            IceDB::GroupTxn txn(_groupCommit);
 
             if(_objects.find(txn, id))
             {
@@ -1472,6 +1533,7 @@ Database::addObject(const ObjectInfo& info)
             dbSerial = updateSerial(txn, objectsDbName);
 
             txn.commit();
+            group = txn.group();
         }
         catch(const IceDB::LMDBException& ex)
         {
@@ -1487,6 +1549,7 @@ Database::addObject(const ObjectInfo& info)
             out << "added object `" << _communicator->identityToString(id) << "' (serial = `" << dbSerial << "')";
         }
     }
+    waitForGroupCommit(group);
     _objectObserverTopic->waitForSyncedSubscribers(serial);
 }
 
@@ -1496,6 +1559,7 @@ Database::addOrUpdateObject(const ObjectInfo& info, Ice::Long dbSerial)
     assert(dbSerial != 0 || _master);
 
     int serial = 0; // Initialize to prevent warning.
+    Ice::Long group = 0;
     {
         Lock sync(*this);
         const Ice::Identity id = info.proxy->ice_getIdentity();
@@ -1508,7 +1572,7 @@ Database::addOrUpdateObject(const ObjectInfo& info, Ice::Long dbSerial)
         bool update = false;
         try
         {
-            IceDB::ReadWriteTxn txn(_env);
+            IceDB::GroupTxn txn(_groupCommit);
 
             Ice::Identity k;
             ObjectInfo v;
@@ -1521,6 +1585,7 @@ Database::addOrUpdateObject(const ObjectInfo& info, Ice::Long dbSerial)
             dbSerial = updateSerial(txn, objectsDbName, dbSerial);
 
             txn.commit();
+            group = txn.group();
         }
         catch(const IceDB::LMDBException& ex)
         {
@@ -1543,6 +1608,7 @@ Database::addOrUpdateObject(const ObjectInfo& info, Ice::Long dbSerial)
             out << (!update ? "added" : "updated") << " object `" << _communicator->identityToString(id) << "' (serial = `" << dbSerial << "')";
         }
     }
+    waitForGroupCommit(group);
     _objectObserverTopic->waitForSyncedSubscribers(serial);
 }
 
@@ -1552,6 +1618,7 @@ Database::removeObject(const Ice::Identity& id, Ice::Long dbSerial)
     assert(dbSerial != 0 || _master);
 
     int serial = 0; // Initialize to prevent warning.
+    Ice::Long group = 0;
     {
         Lock sync(*this);
         if(_objectCache.has(id))
@@ -1563,7 +1630,7 @@ Database::removeObject(const Ice::Identity& id, Ice::Long dbSerial)
 
         try
         {
-            IceDB::ReadWriteTxn txn(_env);
+            IceDB::GroupTxn txn(_groupCommit);
 
             ObjectInfo info;
             if(!_objects.get(txn, id, info))
@@ -1574,6 +1641,7 @@ Database::removeObject(const Ice::Identity& id, Ice::Long dbSerial)
             dbSerial = updateSerial(txn, objectsDbName, dbSerial);
 
             txn.commit();
+            group = txn.group();
         }
         catch(const IceDB::LMDBException& ex)
         {
@@ -1589,6 +1657,7 @@ Database::removeObject(const Ice::Identity& id, Ice::Long dbSerial)
             out << "removed object `" << _communicator->identityToString(id) << "' (serial = `" << dbSerial << "')";
         }
     }
+    waitForGroupCommit(group);
     _objectObserverTopic->waitForSyncedSubscribers(serial);
 }
 
@@ -1598,6 +1667,7 @@ Database::updateObject(const Ice::ObjectPrx& proxy)
     assert(_master);
 
     int serial = 0;
+    Ice::Long group = 0;
     {
         Lock sync(*this);
 
@@ -1613,7 +1683,7 @@ Database::updateObject(const Ice::ObjectPrx& proxy)
         Ice::Long dbSerial = 0;
         try
         {
-            IceDB::ReadWriteTxn txn(_env);
+            IceDB::GroupTxn txn(_groupCommit);
 
             if(!_objects.get(txn, id, info))
             {
@@ -1624,6 +1694,7 @@ Database::updateObject(const Ice::ObjectPrx& proxy)
             dbSerial = updateSerial(txn, objectsDbName);
 
             txn.commit();
+            group = txn.group();
         }
         catch(const IceDB::LMDBException& ex)
         {
@@ -1638,6 +1709,7 @@ Database::updateObject(const Ice::ObjectPrx& proxy)
             out << "updated object `" << _communicator->identityToString(id) << "' (serial = `" << dbSerial << "')";
         }
     }
+    waitForGroupCommit(group);
     _objectObserverTopic->waitForSyncedSubscribers(serial);
 }
 
@@ -1824,13 +1896,17 @@ Database::getAllObjectInfos(const string& expression)
 
     IceDB::ReadOnlyTxn txn(_env);
 
+    //
+    // Only decode the object infos which match the expression.
+    //
     Ice::Identity id;
     ObjectInfo info;
     ObjectsMapROCursor cursor(_objects, txn);
-    while(cursor.get(id, info, MDB_NEXT))
+    while(cursor.get(id, MDB_NEXT))
     {
         if(expression.empty() || IceUtilInternal::match(_communicator->identityToString(id), expression, true))
         {
+            cursor.get(id, info, MDB_GET_CURRENT);
             infos.push_back(info);
         }
     }
@@ -2678,6 +2754,25 @@ Database::finishUpdating(const string& name)
     notifyAll();
 }
 
+void
+Database::waitForGroupCommit(Ice::Long group)
+{
+    //
+    // Wait for the group of the update to be committed, this is called
+    // once the database lock is released so that other updates can join
+    // the group.
+    //
+    try
+    {
+        _groupCommit.wait(group);
+    }
+    catch(const IceDB::LMDBException& ex)
+    {
+        logError(_communicator, ex);
+        throw;
+    }
+}
+
 Ice::Long
 Database::getSerial(const IceDB::Txn& txn, const string& dbName)
 {
@@ -87,6 +87,9 @@ public:
 
     StringLongDict getSerials() const;
 
+    DatabaseInfo getDatabaseInfo() const;
+    void copyDatabase(const std::string&, bool) const;
+
     void addApplication(const ApplicationInfo&, AdminSessionI*, Ice::Long = 0);
     void updateApplication(const ApplicationUpdateInfo&, bool, AdminSessionI*, Ice::Long = 0);
     void syncApplicationDescriptor(const ApplicationDescriptor&, bool, AdminSessionI*);
@@ -184,6 +187,8 @@ private:
     void startUpdating(const std::string&, const std::string&, int);
     void finishUpdating(const std::string&);
 
+    void waitForGroupCommit(Ice::Long);
+
     Ice::Long getSerial(const IceDB::Txn&, const std::string&);
     Ice::Long updateSerial(const IceDB::ReadWriteTxn&, const std::string&, Ice::Long = 0);
 
@@ -224,6 +229,7 @@ private:
 
     IceUtilInternal::FileLock _dbLock;
     IceDB::Env _env;
+    IceDB::GroupCommit _groupCommit;
 
     StringApplicationInfoMap _applications;
 
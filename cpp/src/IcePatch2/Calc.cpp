@@ -9,6 +9,10 @@
 #include <IcePatch2Lib/Util.h>
 #include <iterator>
 
+#ifndef _WIN32
+#   include <unistd.h>
+#endif
+
 using namespace std;
 using namespace Ice;
 using namespace IceInternal;
@@ -104,6 +108,8 @@ usage(const string& appName)
         "-z, --compress          Always compress files.\n"
         "-Z, --no-compress       Never compress files.\n"
         "-i, --case-insensitive  Files must not differ in case only.\n"
+        "-f, --force             Compute the checksums of all the files.\n"
+        "-t, --threads N         Compute the checksums with N threads.\n"
         "-V, --verbose           Verbose mode.\n"
         ;
 }
@@ -128,6 +134,8 @@ main(int argc, char* argv[])
     int compress = 1;
     bool verbose;
     bool caseInsensitive;
+    bool force;
+    int threads;
 
     IceUtilInternal::Options opts;
     opts.addOpt("h", "help");
@@ -136,6 +144,8 @@ main(int argc, char* argv[])
     opts.addOpt("Z", "no-compress");
     opts.addOpt("V", "verbose");
     opts.addOpt("i", "case-insensitive");
+    opts.addOpt("f", "force");
+    opts.addOpt("t", "threads", IceUtilInternal::Options::NeedArg);
 
     vector<string> args;
     try
@@ -177,6 +187,29 @@ main(int argc, char* argv[])
     }
     verbose = opts.isSet("verbose");
     caseInsensitive = opts.isSet("case-insensitive");
+    force = opts.isSet("force");
+
+    if(opts.isSet("threads"))
+    {
+        istringstream is(opts.optArg("threads"));
+        if(!(is >> threads) || !is.eof() || threads < 1)
+        {
+            consoleErr << appName << ": invalid number of threads `" << opts.optArg("threads") << "'" << endl;
+            usage(appName);
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+#ifdef _WIN32
+        SYSTEM_INFO sysInfo;
+        GetSystemInfo(&sysInfo);
+        threads = static_cast<int>(sysInfo.dwNumberOfProcessors);
+#else
+        threads = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+        threads = max(threads, 1);
+    }
 
     if(args.empty())
     {
@@ -231,12 +264,22 @@ main(int argc, char* argv[])
             p->erase(0, absDataDirWithSlash.size());
         }
 
+        //
+        // The checksums of the files which didn't change since the last
+        // run are reused, unless all the checksums must be computed.
+        //
+        FileStatDict stats;
+        if(!force)
+        {
+            loadFileStatDict(absDataDir, stats);
+        }
+
         LargeFileInfoSeq infoSeq;
 
         if(fileSeq.empty())
         {
             CalcCB calcCB;
-            if(!getFileInfoSeq(absDataDir, compress, verbose ? &calcCB : 0, infoSeq))
+            if(!getFileInfoSeq(absDataDir, compress, verbose ? &calcCB : 0, infoSeq, threads, &stats))
             {
                 return EXIT_FAILURE;
             }
@@ -250,7 +293,8 @@ main(int argc, char* argv[])
                 LargeFileInfoSeq partialInfoSeq;
 
                 CalcCB calcCB;
-                if(!getFileInfoSeqSubDir(absDataDir, *p, compress, verbose ? &calcCB : 0, partialInfoSeq))
+                if(!getFileInfoSeqSubDir(absDataDir, *p, compress, verbose ? &calcCB : 0, partialInfoSeq, threads,
+                                         &stats))
                 {
                     return EXIT_FAILURE;
                 }
@@ -304,6 +348,67 @@ main(int argc, char* argv[])
         }
 
         saveFileInfoSeq(absDataDir, infoSeq);
+
+        //
+        // Only keep the stats of the files which are still published.
+        //
+        FileStatDict newStats;
+        for(LargeFileInfoSeq::const_iterator p = infoSeq.begin(); p != infoSeq.end(); ++p)
+        {
+            FileStatDict::const_iterator q = stats.find(p->path);
+            if(p->size >= 0 && q != stats.end() && q->second.checksum == p->checksum)
+            {
+                newStats.insert(*q);
+            }
+        }
+        saveFileStatDict(absDataDir, newStats);
+
+        //
+        // Compute the content-defined chunks of the large files, the
+        // chunks of the files which didn't change are reused.
+        //
+        FileChunksDict oldChunksDict;
+        loadFileChunksDict(absDataDir, oldChunksDict);
+
+        FileChunksDict chunksDict;
+        for(LargeFileInfoSeq::const_iterator p = infoSeq.begin(); p != infoSeq.end(); ++p)
+        {
+            if(p->size < 0) // Directory?
+            {
+                continue;
+            }
+
+            const string path = simplify(absDataDir + '/' + p->path);
+            IceUtilInternal::structstat buf;
+            if(IceUtilInternal::stat(path, &buf) == -1)
+            {
+                throw runtime_error("cannot stat `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+            }
+
+            if(buf.st_size < chunkedFileSizeMin)
+            {
+                continue;
+            }
+
+            FileChunksDict::const_iterator q = oldChunksDict.find(p->path);
+            if(q != oldChunksDict.end() && q->second.checksum == p->checksum)
+            {
+                chunksDict.insert(*q);
+            }
+            else
+            {
+                if(verbose)
+                {
+                    consoleOut << "chunks: " << p->path << endl;
+                }
+
+                FileChunks& fileChunks = chunksDict[p->path];
+                fileChunks.checksum = p->checksum;
+                getChunkInfoSeq(path, fileChunks.chunks);
+            }
+        }
+
+        saveFileChunksDict(absDataDir, chunksDict);
     }
     catch(const exception& ex)
     {
@@ -19,12 +19,13 @@
 using namespace std;
 using namespace IceInternal;
 
-class TextPatcherFeedback : public IcePatch2::PatcherFeedback
+class TextPatcherFeedback : public IcePatch2::PatcherFeedback, public IcePatch2::PatcherThroughputFeedback
 {
 public:
 
     TextPatcherFeedback() :
-        _pressAnyKeyMessage(false)
+        _pressAnyKeyMessage(false),
+        _throughput(0)
     {
 #ifndef _WIN32
         tcgetattr(0, &_savedTerm);
@@ -145,6 +146,10 @@ public:
         }
         ostringstream s;
         s << progress << '/' << size << " (" << totalProgress << '/' << totalSize << ')';
+        if(_throughput > 0)
+        {
+            s << ' ' << _throughput / 1024 << " KB/s";
+        }
         _lastProgress = s.str();
         consoleOut << _lastProgress << flush;
         return !keyPressed();
@@ -157,6 +162,13 @@ public:
         return !keyPressed();
     }
 
+    virtual bool
+    patchThroughput(Ice::Long throughput)
+    {
+        _throughput = throughput;
+        return !keyPressed();
+    }
+
 private:
 
 #ifdef _WIN32
@@ -245,6 +257,7 @@ private:
 
     string _lastProgress;
     bool _pressAnyKeyMessage;
+    Ice::Long _throughput;
 };
 
 int run(const Ice::StringSeq&);
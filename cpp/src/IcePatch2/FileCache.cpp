@@ -0,0 +1,287 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceUtil/DisableWarnings.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/StringUtil.h>
+#include <IcePatch2/FileCache.h>
+#include <IcePatch2/FileServer.h>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <unistd.h>
+#   include <sys/mman.h>
+#endif
+
+using namespace std;
+using namespace Ice;
+using namespace IcePatch2;
+
+IcePatch2::CachedFile::CachedFile(const string& path, const string& absolutePath, Long readAhead, bool mapFile) :
+    _path(path),
+    _absolutePath(absolutePath),
+    _readAhead(readAhead),
+    _fd(-1),
+    _size(0),
+    _mtime(0),
+    _ino(0),
+    _data(0),
+    _next(0),
+    _readAheadEnd(0)
+{
+    _fd = IceUtilInternal::open(absolutePath, O_RDONLY|O_BINARY);
+    if(_fd == -1)
+    {
+        throw FileAccessException(string("cannot open `") + path + "' for reading: " +
+                                  IceUtilInternal::errorToString(errno));
+    }
+
+    IceUtilInternal::structstat buf;
+    if(IceUtilInternal::stat(absolutePath, &buf) == -1)
+    {
+        IceUtilInternal::close(_fd);
+        throw FileAccessException(string("cannot stat `") + path + "':\n" + IceUtilInternal::lastErrorToString());
+    }
+    _size = static_cast<Long>(buf.st_size);
+    _mtime = static_cast<Long>(buf.st_mtime);
+    _ino = static_cast<Long>(buf.st_ino);
+
+#ifndef _WIN32
+    //
+    // Map the file if it fits in the address space, the descriptor is no
+    // longer needed once the file is mapped. If the mapping fails, the
+    // chunks are read with pread instead.
+    //
+    if(mapFile && _size > 0 && static_cast<Long>(static_cast<size_t>(_size)) == _size)
+    {
+        void* data = mmap(0, static_cast<size_t>(_size), PROT_READ, MAP_SHARED, _fd, 0);
+        if(data != MAP_FAILED)
+        {
+            _data = static_cast<Byte*>(data);
+            IceUtilInternal::close(_fd);
+            _fd = -1;
+        }
+    }
+#else
+    (void)mapFile;
+#endif
+}
+
+IcePatch2::CachedFile::~CachedFile()
+{
+#ifndef _WIN32
+    if(_data)
+    {
+        munmap(_data, static_cast<size_t>(_size));
+    }
+#endif
+    if(_fd != -1)
+    {
+        IceUtilInternal::close(_fd);
+    }
+}
+
+bool
+IcePatch2::CachedFile::modified() const
+{
+    IceUtilInternal::structstat buf;
+    if(IceUtilInternal::stat(_absolutePath, &buf) == -1)
+    {
+        return true;
+    }
+    return static_cast<Long>(buf.st_size) != _size || static_cast<Long>(buf.st_mtime) != _mtime ||
+        static_cast<Long>(buf.st_ino) != _ino;
+}
+
+pair<const Byte*, const Byte*>
+IcePatch2::CachedFile::read(Long pos, Int num, vector<Byte>& buffer)
+{
+    if(pos >= _size)
+    {
+        return make_pair<const Byte*, const Byte*>(0, 0);
+    }
+
+    if(static_cast<Long>(num) > _size - pos)
+    {
+        num = static_cast<Int>(_size - pos);
+    }
+
+    readAhead(pos, num);
+
+    if(_data)
+    {
+        return make_pair<const Byte*, const Byte*>(_data + pos, _data + pos + num);
+    }
+
+    buffer.resize(static_cast<size_t>(num));
+#ifdef _WIN32
+    int r;
+    {
+        //
+        // The file position is shared by all the requests on this file.
+        //
+        IceUtil::Mutex::Lock sync(_mutex);
+        if(_lseeki64(_fd, pos, SEEK_SET) != pos)
+        {
+            ostringstream posStr;
+            posStr << pos;
+            throw FileAccessException("cannot seek position " + posStr.str() + " in file `" + _path + "': " +
+                                      IceUtilInternal::errorToString(errno));
+        }
+        r = _read(_fd, &buffer[0], static_cast<unsigned int>(num));
+    }
+    if(r == -1)
+#else
+    ssize_t r = pread(_fd, &buffer[0], static_cast<size_t>(num), static_cast<off_t>(pos));
+    if(r == -1)
+#endif
+    {
+        throw FileAccessException("cannot read `" + _path + "': " + IceUtilInternal::errorToString(errno));
+    }
+    buffer.resize(static_cast<size_t>(r));
+
+    if(buffer.empty())
+    {
+        return make_pair<const Byte*, const Byte*>(0, 0);
+    }
+    return make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size());
+}
+
+void
+IcePatch2::CachedFile::readAhead(Long pos, Int num)
+{
+#ifndef _WIN32
+    if(_readAhead <= 0)
+    {
+        return;
+    }
+
+    //
+    // If the chunks of the file are requested sequentially, ask the kernel
+    // to read the next chunks ahead of the requests. The range is extended
+    // once half of the range read ahead has been requested.
+    //
+    Long start;
+    Long end;
+    {
+        IceUtil::Mutex::Lock sync(_mutex);
+        bool sequential = pos == _next;
+        _next = pos + num;
+        if(!sequential || _next >= _size || _readAheadEnd - _next > _readAhead / 2)
+        {
+            return;
+        }
+
+        start = max(_next, _readAheadEnd);
+        end = min(_next + _readAhead, _size);
+        if(start >= end)
+        {
+            return;
+        }
+        _readAheadEnd = end;
+    }
+
+    if(_data)
+    {
+        static const Long pageSize = static_cast<Long>(sysconf(_SC_PAGESIZE));
+        start -= start % pageSize;
+        madvise(_data + start, static_cast<size_t>(end - start), MADV_WILLNEED);
+    }
+#   if defined(POSIX_FADV_WILLNEED)
+    else
+    {
+        posix_fadvise(_fd, static_cast<off_t>(start), static_cast<off_t>(end - start), POSIX_FADV_WILLNEED);
+    }
+#   endif
+#else
+    //
+    // Windows already reads ahead the files accessed sequentially.
+    //
+    (void)pos;
+    (void)num;
+#endif
+}
+
+IcePatch2::FileCache::FileCache(const string& dataDir, const string& suffix, size_t size, Long readAhead,
+                                bool mapFile) :
+    _dataDir(dataDir),
+    _suffix(suffix),
+    _size(size),
+    _readAhead(readAhead),
+    _map(mapFile)
+{
+}
+
+CachedFilePtr
+IcePatch2::FileCache::get(const string& path, bool& hit)
+{
+    CachedFilePtr cached;
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        map<string, FileList::iterator>::iterator p = _index.find(path);
+        if(p != _index.end())
+        {
+            _files.splice(_files.begin(), _files, p->second);
+            cached = p->second->second;
+        }
+    }
+
+    if(cached)
+    {
+        //
+        // Check that the file wasn't replaced or modified since it was
+        // opened, the chunks of a truncated file can't be read from the
+        // mapping. A modified file is reopened.
+        //
+        if(!cached->modified())
+        {
+            hit = true;
+            return cached;
+        }
+
+        IceUtil::Mutex::Lock sync(*this);
+        map<string, FileList::iterator>::iterator p = _index.find(path);
+        if(p != _index.end() && p->second->second.get() == cached.get())
+        {
+            _files.erase(p->second);
+            _index.erase(p);
+        }
+    }
+
+    //
+    // Open the file without holding the lock, other requests are not
+    // blocked by the file system while the file is opened.
+    //
+    hit = false;
+    CachedFilePtr file = new CachedFile(path, _dataDir + '/' + path + _suffix, _readAhead, _map);
+    if(_size == 0)
+    {
+        return file; // Caching disabled, the file is closed once the request is served.
+    }
+
+    IceUtil::Mutex::Lock sync(*this);
+    map<string, FileList::iterator>::iterator p = _index.find(path);
+    if(p != _index.end())
+    {
+        //
+        // Another request opened the file concurrently, use the cached one.
+        //
+        _files.splice(_files.begin(), _files, p->second);
+        return p->second->second;
+    }
+
+    _files.push_front(make_pair(path, file));
+    _index.insert(make_pair(path, _files.begin()));
+    if(_files.size() > _size)
+    {
+        //
+        // Evict the least recently used file, it's closed once the requests
+        // which are still using it complete.
+        //
+        _index.erase(_files.back().first);
+        _files.pop_back();
+    }
+    return file;
+}
@@ -0,0 +1,107 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_PATCH2_FILE_CACHE_H
+#define ICE_PATCH2_FILE_CACHE_H
+
+#include <IceUtil/Shared.h>
+#include <IceUtil/Handle.h>
+#include <IceUtil/Mutex.h>
+#include <Ice/Config.h>
+#include <list>
+#include <map>
+#include <vector>
+
+namespace IcePatch2
+{
+
+//
+// A file of the data directory. If mapping is enabled, the file is mapped
+// in memory if possible and chunks are returned directly from the mapping,
+// otherwise the file descriptor is kept open and chunks are read with pread.
+//
+class CachedFile : public IceUtil::Shared
+{
+public:
+
+    CachedFile(const std::string&, const std::string&, Ice::Long, bool);
+    ~CachedFile();
+
+    //
+    // Returns true if the file of the data directory was replaced, or if
+    // its size or modification time changed since it was opened.
+    //
+    bool modified() const;
+
+    Ice::Long size() const
+    {
+        return _size;
+    }
+
+    //
+    // Returns the chunk of at most the given number of bytes at the given
+    // position. The chunk either references the mapping of the file or the
+    // given buffer, it's only valid as long as the file and the buffer are.
+    //
+    std::pair<const Ice::Byte*, const Ice::Byte*> read(Ice::Long, Ice::Int, std::vector<Ice::Byte>&);
+
+private:
+
+    void readAhead(Ice::Long, Ice::Int);
+
+    const std::string _path;
+    const std::string _absolutePath;
+    const Ice::Long _readAhead;
+    int _fd;
+    Ice::Long _size;
+    Ice::Long _mtime;
+    Ice::Long _ino;
+    Ice::Byte* _data;
+
+    IceUtil::Mutex _mutex;
+    Ice::Long _next; // The end of the last chunk read.
+    Ice::Long _readAheadEnd; // The end of the range already read ahead.
+};
+typedef IceUtil::Handle<CachedFile> CachedFilePtr;
+
+//
+// A least recently used cache of the files of the data directory with
+// the given suffix. This saves the open and close system calls for each
+// chunk request when many clients download the same files. A cached file
+// is reopened if it was modified since it was opened.
+//
+// Truncating a mapped file while it's read crashes the server with a bus
+// error, only files which are replaced instead of being modified in place
+// should be mapped (icepatch2calc replaces the compressed files).
+//
+class FileCache : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    FileCache(const std::string&, const std::string&, size_t, Ice::Long, bool);
+
+    //
+    // Returns the cached file for the given path, the boolean is set to
+    // true if the file was already open and wasn't modified since.
+    //
+    CachedFilePtr get(const std::string&, bool&);
+
+private:
+
+    typedef std::list<std::pair<std::string, CachedFilePtr> > FileList;
+
+    const std::string _dataDir;
+    const std::string _suffix;
+    const size_t _size;
+    const Ice::Long _readAhead;
+    const bool _map;
+
+    FileList _files; // Most recently used first.
+    std::map<std::string, FileList::iterator> _index;
+};
+typedef IceUtil::Handle<FileCache> FileCachePtr;
+
+}
+
+#endif
@@ -5,24 +5,99 @@
 #include <IceUtil/DisableWarnings.h>
 #include <IceUtil/FileUtil.h>
 #include <IceUtil/StringUtil.h>
+#include <Ice/Communicator.h>
+#include <Ice/Properties.h>
+#include <Ice/InstrumentationI.h>
 #include <IcePatch2/FileServerI.h>
 
-#ifdef _WIN32
-#   include <io.h>
-#else
-#   include <unistd.h>
-#endif
-
 using namespace std;
 using namespace Ice;
 using namespace IcePatch2;
 using namespace IcePatch2Internal;
 
-IcePatch2::FileServerI::FileServerI(const std::string& dataDir, const LargeFileInfoSeq& infoSeq) :
-    _dataDir(dataDir), _tree0(FileTree0())
+namespace
+{
+
+size_t
+getCacheSize(const CommunicatorPtr& communicator)
+{
+    return static_cast<size_t>(max(communicator->getProperties()->getPropertyAsIntWithDefault(
+                                       "IcePatch2.CacheSize", 100), 0));
+}
+
+Long
+getReadAhead(const CommunicatorPtr& communicator)
+{
+    return static_cast<Long>(max(communicator->getProperties()->getPropertyAsIntWithDefault(
+                                     "IcePatch2.ReadAhead", 1024), 0)) * 1024;
+}
+
+string
+checkPath(const string& pa)
+{
+    if(IceUtilInternal::isAbsolutePath(pa))
+    {
+        throw FileAccessException(string("illegal absolute path `") + pa + "'");
+    }
+
+    string path = simplify(pa);
+
+    if(path == ".." ||
+       path.find("/../") != string::npos ||
+       (path.size() >= 3 && (path.substr(0, 3) == "../" || path.substr(path.size() - 3, 3) == "/..")))
+    {
+        throw FileAccessException(string("illegal `..' component in path `") + path + "'");
+    }
+    return path;
+}
+
+}
+
+IcePatch2::FileServerI::FileServerI(const CommunicatorPtr& communicator, const std::string& dataDir,
+                                    const LargeFileInfoSeq& infoSeq, const FileChunksDict& chunksDict) :
+    _dataDir(dataDir),
+    _tree0(FileTree0()),
+    _cache(new FileCache(dataDir, ".bz2", getCacheSize(communicator), getReadAhead(communicator), true)),
+    //
+    // The chunks are read from the files of the data directory, which can
+    // be modified in place and therefore aren't mapped.
+    //
+    _chunksCache(new FileCache(dataDir, "", getCacheSize(communicator), getReadAhead(communicator), false))
 {
     FileTree0& tree0 = const_cast<FileTree0&>(_tree0);
     getFileTree0(infoSeq, tree0);
+
+    //
+    // The chunks computed for a previous version of a file are ignored.
+    //
+    map<string, Chunks>& chunks = const_cast<map<string, Chunks>&>(_chunks);
+    for(LargeFileInfoSeq::const_iterator p = infoSeq.begin(); p != infoSeq.end(); ++p)
+    {
+        FileChunksDict::const_iterator q = chunksDict.find(p->path);
+        if(q != chunksDict.end() && q->second.checksum == p->checksum)
+        {
+            Chunks& c = chunks[p->path];
+            c.chunks = q->second.chunks;
+            c.offsets.reserve(c.chunks.size());
+            Long offset = 0;
+            for(ChunkInfoSeq::const_iterator r = c.chunks.begin(); r != c.chunks.end(); ++r)
+            {
+                c.offsets.push_back(offset);
+                offset += r->size;
+            }
+        }
+    }
+
+    //
+    // If an Ice metrics observer is setup on the communicator, also
+    // enable metrics for the files served by IcePatch2.
+    //
+    IceInternal::CommunicatorObserverIPtr o =
+        IceInternal::CommunicatorObserverIPtr::dynamicCast(communicator->getObserver());
+    if(o)
+    {
+        _observer = new FileServerObserverI(o->getFacet());
+    }
 }
 
 FileInfoSeq
@@ -72,15 +147,9 @@ IcePatch2::FileServerI::getFileCompressed_async(const AMD_FileServer_getFileComp
     try
     {
         vector<Byte> buffer;
-        getFileCompressedInternal(pa, pos, num, buffer, false);
-        if(buffer.empty())
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
-        }
-        else
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size()));
-        }
+        pair<const Byte*, const Byte*> chunk(0, 0);
+        CachedFilePtr file = getFileCompressedInternal(pa, pos, num, buffer, chunk, false);
+        cb->ice_response(chunk); // The file holds the mapping the chunk might reference.
     }
     catch(const std::exception& ex)
     {
@@ -95,16 +164,9 @@ IcePatch2::FileServerI::getLargeFileCompressed_async(const AMD_FileServer_getLar
     try
     {
         vector<Byte> buffer;
-        getFileCompressedInternal(pa, pos, num, buffer, true);
-        if(buffer.empty())
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
-        }
-        else
-        {
-            cb->ice_response(make_pair<const Byte*, const Byte*>(&buffer[0], &buffer[0] + buffer.size()));
-        }
-
+        pair<const Byte*, const Byte*> chunk(0, 0);
+        CachedFilePtr file = getFileCompressedInternal(pa, pos, num, buffer, chunk, true);
+        cb->ice_response(chunk); // The file holds the mapping the chunk might reference.
     }
     catch(const std::exception& ex)
     {
@@ -112,82 +174,126 @@ IcePatch2::FileServerI::getLargeFileCompressed_async(const AMD_FileServer_getLar
     }
 }
 
-void
-IcePatch2::FileServerI::getFileCompressedInternal(const std::string& pa, Ice::Long pos, Ice::Int num,
-                                                  vector<Byte>& buffer, bool largeFile) const
+ChunkInfoSeq
+IcePatch2::FileServerI::getChunkInfoSeq(const string& pa, const Current&) const
 {
-    if(IceUtilInternal::isAbsolutePath(pa))
+    map<string, Chunks>::const_iterator p = _chunks.find(checkPath(pa));
+    if(p == _chunks.end())
     {
-        throw FileAccessException(string("illegal absolute path `") + pa + "'");
+        return ChunkInfoSeq();
     }
+    return p->second.chunks;
+}
 
-    string path = simplify(pa);
-
-    if(path == ".." ||
-       path.find("/../") != string::npos ||
-       (path.size() >= 3 && (path.substr(0, 3) == "../" || path.substr(path.size() - 3, 3) == "/..")))
+void
+IcePatch2::FileServerI::getChunks_async(const AMD_FileServer_getChunksPtr& cb, const string& pa,
+                                        const IntSeq& indexes, const Current&) const
+{
+    try
     {
-        throw FileAccessException(string("illegal `..' component in path `") + path + "'");
-    }
+        string path = checkPath(pa);
+        map<string, Chunks>::const_iterator p = _chunks.find(path);
+        if(p == _chunks.end())
+        {
+            throw FileAccessException("no chunks available for `" + path + "'");
+        }
+        const Chunks& chunks = p->second;
 
-    if(num <= 0 || pos < 0)
-    {
-        return;
-    }
+        //
+        // The indexes and the total size of the requested chunks are checked
+        // before reading anything, a client can't make the server read more
+        // than chunksRequestSizeMax bytes with a single call.
+        //
+        Long size = 0;
+        for(IntSeq::const_iterator q = indexes.begin(); q != indexes.end(); ++q)
+        {
+            if(*q < 0 || static_cast<size_t>(*q) >= chunks.chunks.size())
+            {
+                ostringstream os;
+                os << "invalid chunk `" << *q << "' for file `" << path << "'";
+                throw FileAccessException(os.str());
+            }
 
-    string absolutePath = _dataDir + '/' + path + ".bz2";
-    int fd = IceUtilInternal::open(absolutePath, O_RDONLY|O_BINARY);
-    if(fd == -1)
-    {
-        throw FileAccessException(string("cannot open `") + path + "' for reading: " +
-                                  IceUtilInternal::errorToString(errno));
-    }
+            size += chunks.chunks[*q].size;
+            if(size > chunksRequestSizeMax)
+            {
+                ostringstream os;
+                os << "cannot read the chunks of `" << path << "': more than " << chunksRequestSizeMax
+                   << " bytes requested";
+                throw FileAccessException(os.str());
+            }
+        }
 
-    if(!largeFile)
-    {
-        IceUtilInternal::structstat buf;
-        if(IceUtilInternal::stat(absolutePath, &buf) == -1)
+        bool hit;
+        CachedFilePtr file = _chunksCache->get(path, hit);
+
+        vector<Byte> bytes;
+        bytes.reserve(static_cast<size_t>(size));
+        vector<Byte> buffer;
+        for(IntSeq::const_iterator q = indexes.begin(); q != indexes.end(); ++q)
         {
-            throw FileAccessException(string("cannot stat `") + path + "':\n" + IceUtilInternal::lastErrorToString());
+            const ChunkInfo& info = chunks.chunks[*q];
+            pair<const Byte*, const Byte*> chunk = file->read(chunks.offsets[*q], info.size, buffer);
+            if(chunk.second - chunk.first != info.size)
+            {
+                throw FileAccessException("cannot read the chunks of `" + path + "': the file was modified");
+            }
+            bytes.insert(bytes.end(), chunk.first, chunk.second);
         }
 
-        if(buf.st_size > 0x7FFFFFFF)
+        FileObserverIPtr observer = _observer ? _observer->getFileObserver(_dataDir, path) : FileObserverIPtr();
+        if(observer)
         {
-            ostringstream os;
-            os << "cannot encode size `" << buf.st_size << "' for file `" << path << "' as Ice::Int" << endl;
-            throw FileAccessException(os.str());
+            observer->attach();
+            observer->served(hit, static_cast<Int>(bytes.size()));
+            observer->detach();
         }
-    }
 
-    if(
-#if defined(_MSC_VER)
-        _lseek(fd, static_cast<off_t>(pos), SEEK_SET)
-#else
-        lseek(fd, static_cast<off_t>(pos), SEEK_SET)
-#endif
-        != static_cast<off_t>(pos))
+        if(bytes.empty())
+        {
+            cb->ice_response(make_pair<const Byte*, const Byte*>(0, 0));
+        }
+        else
+        {
+            cb->ice_response(make_pair<const Byte*, const Byte*>(&bytes[0], &bytes[0] + bytes.size()));
+        }
+    }
+    catch(const std::exception& ex)
     {
-        IceUtilInternal::close(fd);
+        cb->ice_exception(ex);
+    }
+}
 
-        ostringstream posStr;
-        posStr << pos;
+CachedFilePtr
+IcePatch2::FileServerI::getFileCompressedInternal(const std::string& pa, Ice::Long pos, Ice::Int num,
+                                                  vector<Byte>& buffer, pair<const Byte*, const Byte*>& chunk,
+                                                  bool largeFile) const
+{
+    string path = checkPath(pa);
 
-        throw FileAccessException("cannot seek position " + posStr.str() + " in file `" + path + "': " +
-                                  IceUtilInternal::errorToString(errno));
+    if(num <= 0 || pos < 0)
+    {
+        return 0;
     }
 
-    buffer.resize(num);
-#ifdef _WIN32
-    int r;
-    if((r = _read(fd, &buffer[0], static_cast<unsigned int>(num))) == -1)
-#else
-    ssize_t r;
-    if((r = read(fd, &buffer[0], static_cast<size_t>(num))) == -1)
-#endif
+    bool hit;
+    CachedFilePtr file = _cache->get(path, hit);
+
+    if(!largeFile && file->size() > 0x7FFFFFFF)
     {
-        IceUtilInternal::close(fd);
-        throw FileAccessException("cannot read `" + path + "': " + IceUtilInternal::errorToString(errno));
+        ostringstream os;
+        os << "cannot encode size `" << file->size() << "' for file `" << path << "' as Ice::Int" << endl;
+        throw FileAccessException(os.str());
     }
 
-    IceUtilInternal::close(fd);
+    chunk = file->read(pos, num, buffer);
+
+    FileObserverIPtr observer = _observer ? _observer->getFileObserver(_dataDir, path) : FileObserverIPtr();
+    if(observer)
+    {
+        observer->attach();
+        observer->served(hit, static_cast<Int>(chunk.second - chunk.first));
+        observer->detach();
+    }
+    return file;
 }
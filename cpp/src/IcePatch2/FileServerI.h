@@ -7,6 +7,8 @@
 
 #include <IcePatch2Lib/Util.h>
 #include <IcePatch2/FileServer.h>
+#include <IcePatch2/FileCache.h>
+#include <IcePatch2/InstrumentationI.h>
 
 namespace IcePatch2
 {
@@ -15,7 +17,8 @@ class FileServerI : public FileServer
 {
 public:
 
-    FileServerI(const std::string&, const LargeFileInfoSeq&);
+    FileServerI(const Ice::CommunicatorPtr&, const std::string&, const LargeFileInfoSeq&,
+                const IcePatch2Internal::FileChunksDict&);
 
     FileInfoSeq getFileInfoSeq(Ice::Int, const Ice::Current&) const;
 
@@ -38,17 +41,35 @@ public:
                                       Ice::Int,
                                       const Ice::Current&) const;
 
+    ChunkInfoSeq getChunkInfoSeq(const std::string&, const Ice::Current&) const;
+
+    void getChunks_async(const AMD_FileServer_getChunksPtr&,
+                         const std::string&,
+                         const Ice::IntSeq&,
+                         const Ice::Current&) const;
+
 private:
 
-    void
+    CachedFilePtr
     getFileCompressedInternal(const std::string&,
                               Ice::Long,
                               Ice::Int,
                               std::vector<Ice::Byte>&,
+                              std::pair<const Ice::Byte*, const Ice::Byte*>&,
                               bool) const;
 
+    struct Chunks
+    {
+        ChunkInfoSeq chunks;
+        std::vector<Ice::Long> offsets;
+    };
+
     const std::string _dataDir;
     const IcePatch2Internal::FileTree0 _tree0;
+    const std::map<std::string, Chunks> _chunks;
+    const FileCachePtr _cache;
+    const FileCachePtr _chunksCache;
+    FileServerObserverIPtr _observer;
 };
 
 }
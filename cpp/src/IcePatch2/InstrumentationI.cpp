@@ -0,0 +1,112 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IcePatch2/InstrumentationI.h>
+
+#include <Ice/LocalException.h>
+#include <Ice/Communicator.h>
+#include <Ice/LoggerUtil.h>
+
+using namespace std;
+using namespace IcePatch2;
+using namespace IceMX;
+
+namespace
+{
+
+class FileHelper : public MetricsHelperT<FileMetrics>
+{
+public:
+
+    class Attributes : public AttributeResolverT<FileHelper>
+    {
+    public:
+
+        Attributes()
+        {
+            add("parent", &FileHelper::getDirectory);
+            add("id", &FileHelper::getPath);
+            add("directory", &FileHelper::getDirectory);
+            add("path", &FileHelper::getPath);
+        }
+    };
+    static Attributes attributes;
+
+    FileHelper(const string& directory, const string& path) : _directory(directory), _path(path)
+    {
+    }
+
+    virtual string operator()(const string& attribute) const
+    {
+        return attributes(this, attribute);
+    }
+
+    const string& getDirectory() const
+    {
+        return _directory;
+    }
+
+    const string& getPath() const
+    {
+        return _path;
+    }
+
+private:
+
+    const string& _directory;
+    const string& _path;
+};
+
+FileHelper::Attributes FileHelper::attributes;
+
+struct ServedUpdate
+{
+    ServedUpdate(bool hitP, Ice::Int bytesP) : hit(hitP), bytes(bytesP)
+    {
+    }
+
+    void operator()(const FileMetricsPtr& v)
+    {
+        if(hit)
+        {
+            ++v->hits;
+        }
+        v->bytes += bytes;
+    }
+
+    bool hit;
+    Ice::Int bytes;
+};
+
+}
+
+void
+FileObserverI::served(bool hit, Ice::Int bytes)
+{
+    forEach(ServedUpdate(hit, bytes));
+}
+
+FileServerObserverI::FileServerObserverI(const IceInternal::MetricsAdminIPtr& metrics) :
+    _metrics(metrics),
+    _files(metrics, "File")
+{
+}
+
+FileObserverIPtr
+FileServerObserverI::getFileObserver(const string& directory, const string& path)
+{
+    if(_files.isEnabled())
+    {
+        try
+        {
+            return _files.getObserver(FileHelper(directory, path));
+        }
+        catch(const exception& ex)
+        {
+            ::Ice::Error error(_metrics->getLogger());
+            error << "unexpected exception trying to obtain observer:\n" << ex;
+        }
+    }
+    return 0;
+}
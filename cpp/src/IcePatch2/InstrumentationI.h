@@ -0,0 +1,41 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICE_PATCH2_INSTRUMENTATION_I_H
+#define ICE_PATCH2_INSTRUMENTATION_I_H
+
+#include <Ice/MetricsObserverI.h>
+
+#include <IcePatch2/Metrics.h>
+
+namespace IcePatch2
+{
+
+class FileObserverI : public IceMX::ObserverT<IceMX::FileMetrics>
+{
+public:
+
+    void served(bool, Ice::Int);
+};
+typedef IceUtil::Handle<FileObserverI> FileObserverIPtr;
+
+class FileServerObserverI : public IceUtil::Shared
+{
+public:
+
+    FileServerObserverI(const IceInternal::MetricsAdminIPtr&);
+
+    FileObserverIPtr getFileObserver(const std::string&, const std::string&);
+
+private:
+
+    const IceInternal::MetricsAdminIPtr _metrics;
+
+    IceMX::ObserverFactoryT<FileObserverI> _files;
+};
+typedef IceUtil::Handle<FileServerObserverI> FileServerObserverIPtr;
+
+}
+
+#endif
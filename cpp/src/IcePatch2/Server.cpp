@@ -94,6 +94,7 @@ IcePatch2::PatcherService::start(int argc, char* argv[], int& status)
     }
 
     LargeFileInfoSeq infoSeq;
+    FileChunksDict chunksDict;
 
     try
     {
@@ -109,6 +110,7 @@ IcePatch2::PatcherService::start(int argc, char* argv[], int& status)
         }
 
         loadFileInfoSeq(dataDir, infoSeq);
+        loadFileChunksDict(dataDir, chunksDict);
     }
     catch(const exception& ex)
     {
@@ -131,7 +133,7 @@ IcePatch2::PatcherService::start(int argc, char* argv[], int& status)
     Identity id;
     id.category = instanceName;
     id.name = "server";
-    adapter->add(new FileServerI(dataDir, infoSeq), id);
+    adapter->add(new FileServerI(communicator(), dataDir, infoSeq, chunksDict), id);
 
     adapter->activate();
 
@@ -6,8 +6,18 @@
 #include <IceUtil/FileUtil.h>
 #include <IcePatch2/ClientUtil.h>
 #include <IcePatch2Lib/Util.h>
+#include <Ice/SHA1.h>
+#include <bzlib.h>
 #include <list>
+#include <set>
 #include <iterator>
+#include <string.h>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <unistd.h>
+#endif
 
 using namespace std;
 using namespace Ice;
@@ -25,32 +35,83 @@ IcePatch2::PatcherFeedback::~PatcherFeedback()
     // Out of line to avoid weak vtable
 }
 
+IcePatch2::PatcherThroughputFeedback::~PatcherThroughputFeedback()
+{
+    // Out of line to avoid weak vtable
+}
+
 namespace
 {
 
-class Decompressor : public IceUtil::Thread, public IceUtil::Monitor<IceUtil::Mutex>
+//
+// The queue of the files to download shared by the downloader threads.
+// The patcher thread waits on the queue for the downloads to progress
+// to report it to the patcher feedback.
+//
+class DownloadQueue : public IceUtil::Shared, public IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
 
-    Decompressor(const string&);
-    virtual ~Decompressor();
+    DownloadQueue(const LargeFileInfoSeq&);
+
+    const LargeFileInfo& file(size_t index) const
+    {
+        return _files[index];
+    }
 
+    bool next(size_t&);
+    bool progress(size_t, Ice::Long);
+    void reset(size_t);
+    void finished(size_t);
+    void exception(const string&);
+
+    bool wait(size_t, Ice::Long&, Ice::Long&, const IceUtil::Time&);
     void destroy();
-    void add(const LargeFileInfo&);
-    void exception() const;
     void log(FILE* fp);
-    virtual void run();
 
 private:
 
-    const string _dataDir;
+    const LargeFileInfoSeq _files;
 
-    string _exception;
-    list<LargeFileInfo> _files;
+    size_t _next;
+    vector<Ice::Long> _pos;
+    vector<bool> _done;
+    Ice::Long _updated;
+    bool _changed;
     LargeFileInfoSeq _filesDone;
+    string _exception;
     bool _destroy;
 };
-typedef IceUtil::Handle<Decompressor> DecompressorPtr;
+typedef IceUtil::Handle<DownloadQueue> DownloadQueuePtr;
+
+//
+// A downloader thread downloads the files from the queue over its own
+// connection. The chunks are decompressed, checksummed and written to
+// the file while the next chunk is being downloaded.
+//
+class Downloader : public IceUtil::Thread
+{
+public:
+
+    Downloader(const DownloadQueuePtr&, const FileServerPrx&, const string&, Ice::Int, bool);
+
+    virtual void run();
+
+private:
+
+    bool download(size_t);
+    bool patchChunks(size_t, const string&, bool&);
+    AsyncResultPtr beginGetChunk(const LargeFileInfo&, Ice::Long);
+    ByteSeq endGetChunk(const LargeFileInfo&, const AsyncResultPtr&);
+
+    const DownloadQueuePtr _queue;
+    const FileServerPrx _server;
+    const FileServerPrx _serverCompress;
+    const string _dataDir;
+    const Ice::Int _chunkSize;
+    const bool _useSmallFileAPI;
+};
+typedef IceUtil::Handle<Downloader> DownloaderPtr;
 
 class PatcherI : public Patcher
 {
@@ -69,7 +130,7 @@ private:
     void init(const FileServerPrx&);
     bool removeFiles(const LargeFileInfoSeq&);
     bool updateFiles(const LargeFileInfoSeq&);
-    bool updateFilesInternal(const LargeFileInfoSeq&, const DecompressorPtr&);
+    bool updateFilesInternal(const LargeFileInfoSeq&, const DownloadQueuePtr&, Ice::Long);
     bool updateFlags(const LargeFileInfoSeq&);
 
     const PatcherFeedbackPtr _feedback;
@@ -77,6 +138,7 @@ private:
     const bool _thorough;
     const Ice::Int _chunkSize;
     const Ice::Int _remove;
+    const Ice::Int _concurrency;
     const FileServerPrx _serverCompress;
     const FileServerPrx _serverNoCompress;
 
@@ -89,49 +151,102 @@ private:
     bool _useSmallFileAPI;
 };
 
-Decompressor::Decompressor(const string& dataDir) :
-    _dataDir(dataDir),
+DownloadQueue::DownloadQueue(const LargeFileInfoSeq& files) :
+    _files(files),
+    _next(0),
+    _pos(files.size(), 0),
+    _done(files.size(), false),
+    _updated(0),
+    _changed(false),
     _destroy(false)
 {
 }
 
-Decompressor::~Decompressor()
+bool
+DownloadQueue::next(size_t& index)
 {
-    assert(_destroy);
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_destroy || _next == _files.size())
+    {
+        return false;
+    }
+    index = _next++;
+    return true;
+}
+
+bool
+DownloadQueue::progress(size_t index, Ice::Long size)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    _pos[index] += size;
+    _updated += size;
+    _changed = true;
+    notifyAll();
+    return !_destroy;
 }
 
 void
-Decompressor::destroy()
+DownloadQueue::reset(size_t index)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    _destroy = true;
-    notify();
+    _updated -= _pos[index];
+    _pos[index] = 0;
+    _changed = true;
+    notifyAll();
 }
 
 void
-Decompressor::add(const LargeFileInfo& info)
+DownloadQueue::finished(size_t index)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-    if(!_exception.empty())
+    _done[index] = true;
+    _filesDone.push_back(_files[index]);
+    _changed = true;
+    notifyAll();
+}
+
+void
+DownloadQueue::exception(const string& reason)
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(_exception.empty())
     {
-        throw runtime_error(_exception);
+        _exception = reason;
     }
-    _files.push_back(info);
-    notify();
+    _destroy = true;
+    notifyAll();
 }
 
-void
-Decompressor::exception() const
+bool
+DownloadQueue::wait(size_t index, Ice::Long& pos, Ice::Long& updated, const IceUtil::Time& timeout)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    if(!_changed && _exception.empty())
+    {
+        timedWait(timeout);
+    }
+
     if(!_exception.empty())
     {
         throw runtime_error(_exception);
     }
+
+    _changed = false;
+    pos = _pos[index];
+    updated = _updated;
+    return _done[index];
 }
 
 void
-Decompressor::log(FILE* fp)
+DownloadQueue::destroy()
+{
+    IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+    _destroy = true;
+    notifyAll();
+}
+
+void
+DownloadQueue::log(FILE* fp)
 {
     IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
 
@@ -146,50 +261,425 @@ Decompressor::log(FILE* fp)
     _filesDone.clear();
 }
 
+Downloader::Downloader(const DownloadQueuePtr& queue, const FileServerPrx& server, const string& dataDir,
+                       Ice::Int chunkSize, bool useSmallFileAPI) :
+    IceUtil::Thread("IcePatch2 downloader"),
+    _queue(queue),
+    _server(server),
+    _serverCompress(FileServerPrx::uncheckedCast(server->ice_compress(true))),
+    _dataDir(dataDir),
+    _chunkSize(chunkSize),
+    _useSmallFileAPI(useSmallFileAPI)
+{
+}
+
 void
-Decompressor::run()
+Downloader::run()
+{
+    try
+    {
+        size_t index;
+        while(_queue->next(index))
+        {
+            if(!download(index))
+            {
+                return;
+            }
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        _queue->exception(ex.what());
+    }
+    catch(const string& ex)
+    {
+        _queue->exception(ex);
+    }
+}
+
+bool
+Downloader::download(size_t index)
 {
-    LargeFileInfo info;
+    const LargeFileInfo& info = _queue->file(index);
+    const string path = simplify(_dataDir + '/' + info.path);
+
+    string dir = getDirname(path);
+    if(!dir.empty())
+    {
+        createDirectoryRecursive(dir);
+    }
+
+    //
+    // If a previous version of a large file is present, only the chunks
+    // it doesn't have are downloaded.
+    //
+    bool aborted = false;
+    if(patchChunks(index, path, aborted))
+    {
+        return true;
+    }
+    else if(aborted)
+    {
+        return false;
+    }
 
-    while(true)
+    try
+    {
+        removeRecursive(path + ".bz2"); // Left over by a previous patch.
+    }
+    catch(...)
     {
+    }
+
+    FILE* fp = IceUtilInternal::fopen(path, "wb");
+    if(fp == 0)
+    {
+        throw runtime_error("cannot open `" + path + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    bz_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if(BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK)
+    {
+        fclose(fp);
+        throw runtime_error("BZ2_bzDecompressInit failed");
+    }
+
+    try
+    {
+        //
+        // The checksum of a file is computed over its path and its
+        // uncompressed contents.
+        //
+        IceInternal::SHA1 hasher;
+        hasher.update(reinterpret_cast<const unsigned char*>(info.path.c_str()), info.path.size());
+
+        vector<char> out(64 * 1024);
+        int bzError = BZ_OK;
+        Ice::Long pos = 0;
+        AsyncResultPtr curCB = beginGetChunk(info, pos);
+        while(pos < info.size)
         {
-            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
+            AsyncResultPtr nxtCB;
+            if(pos + _chunkSize < info.size)
+            {
+                nxtCB = beginGetChunk(info, pos + _chunkSize);
+            }
 
-            if(!info.path.empty())
+            ByteSeq bytes = endGetChunk(info, curCB);
+            if(bytes.empty())
             {
-                _filesDone.push_back(info);
+                throw runtime_error("size mismatch for `" + info.path + "'");
             }
 
-            while(!_destroy && _files.empty())
+            //
+            // Older servers always return chunks of '_chunkSize' bytes, the
+            // bytes past the end of the file are ignored.
+            //
+            size_t size = (pos + bytes.size()) > static_cast<size_t>(info.size) ?
+                static_cast<size_t>(info.size - pos) : bytes.size();
+
+            stream.next_in = reinterpret_cast<char*>(&bytes[0]);
+            stream.avail_in = static_cast<unsigned int>(size);
+            while(bzError != BZ_STREAM_END && (stream.avail_in > 0 || stream.avail_out == 0))
             {
-                wait();
+                stream.next_out = &out[0];
+                stream.avail_out = static_cast<unsigned int>(out.size());
+                bzError = BZ2_bzDecompress(&stream);
+                if(bzError != BZ_OK && bzError != BZ_STREAM_END)
+                {
+                    throw runtime_error("cannot decompress `" + info.path + "': BZ2_bzDecompress failed");
+                }
+
+                size_t sz = out.size() - stream.avail_out;
+                if(sz > 0)
+                {
+                    if(fwrite(&out[0], sz, 1, fp) != 1)
+                    {
+                        throw runtime_error("cannot write to `" + path + "':\n" +
+                                            IceUtilInternal::lastErrorToString());
+                    }
+                    hasher.update(reinterpret_cast<const unsigned char*>(&out[0]), sz);
+                }
             }
 
-            if(!_files.empty())
+            pos += size;
+            if(!_queue->progress(index, static_cast<Ice::Long>(size)))
             {
-                info = _files.front();
-                _files.pop_front();
+                aborted = true;
+                break;
             }
-            else
+            curCB = nxtCB;
+        }
+
+        if(!aborted)
+        {
+            if(bzError != BZ_STREAM_END)
             {
-                return;
+                throw runtime_error("cannot decompress `" + info.path + "': unexpected end of compressed data");
+            }
+
+            ByteSeq checksum;
+            hasher.finalize(checksum);
+            if(checksum != info.checksum)
+            {
+                throw runtime_error("checksum mismatch for `" + info.path + "'");
             }
         }
+    }
+    catch(...)
+    {
+        BZ2_bzDecompressEnd(&stream);
+        fclose(fp);
+        throw;
+    }
 
-        try
+    BZ2_bzDecompressEnd(&stream);
+    if(fclose(fp) != 0)
+    {
+        throw runtime_error("cannot write to `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    if(aborted)
+    {
+        return false;
+    }
+
+    setFileFlags(path, info);
+    _queue->finished(index);
+    return true;
+}
+
+bool
+Downloader::patchChunks(size_t index, const string& path, bool& aborted)
+{
+    const LargeFileInfo& info = _queue->file(index);
+
+    IceUtilInternal::structstat buf;
+    if(IceUtilInternal::stat(path, &buf) == -1 || !S_ISREG(buf.st_mode) || buf.st_size < chunkedFileSizeMin)
+    {
+        return false;
+    }
+
+    ChunkInfoSeq chunks;
+    try
+    {
+        chunks = _serverCompress->getChunkInfoSeq(info.path);
+    }
+    catch(const Ice::OperationNotExistException&)
+    {
+        return false; // Server without chunks support.
+    }
+
+    Ice::Long size = 0;
+    for(ChunkInfoSeq::const_iterator p = chunks.begin(); p != chunks.end(); ++p)
+    {
+        size += p->size;
+    }
+    if(size == 0)
+    {
+        return false;
+    }
+
+    //
+    // The offsets in the local file of the chunks it has.
+    //
+    map<ByteSeq, Ice::Long> localChunks;
+    {
+        ChunkInfoSeq seq;
+        getChunkInfoSeq(path, seq);
+        Ice::Long offset = 0;
+        for(ChunkInfoSeq::const_iterator p = seq.begin(); p != seq.end(); ++p)
         {
-            decompressFile(_dataDir + '/' + info.path);
-            setFileFlags(_dataDir + '/' + info.path, info);
-            remove(_dataDir + '/' + info.path + ".bz2");
+            localChunks.insert(make_pair(p->checksum, offset));
+            offset += p->size;
         }
-        catch(const std::exception& ex)
+    }
+
+    const string pathTemp = path + ".chunktemp";
+    int fd = IceUtilInternal::open(path, O_RDONLY|O_BINARY);
+    if(fd == -1)
+    {
+        throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    FILE* fp = IceUtilInternal::fopen(pathTemp, "wb");
+    if(fp == 0)
+    {
+        IceUtilInternal::close(fd);
+        throw runtime_error("cannot open `" + pathTemp + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    //
+    // The file is rebuilt from the local chunks and the missing chunks,
+    // which are requested in batches of about '_chunkSize' bytes. A batch
+    // stays below the chunksRequestSizeMax bytes accepted by the server. If
+    // the data doesn't match the checksums, the whole file is downloaded.
+    //
+    const Ice::Long batchSize = min(static_cast<Ice::Long>(_chunkSize),
+                                    static_cast<Ice::Long>(chunksRequestSizeMax - chunkSizeMax));
+    bool patched = true;
+    try
+    {
+        IceInternal::SHA1 hasher;
+        hasher.update(reinterpret_cast<const unsigned char*>(info.path.c_str()), info.path.size());
+
+        Ice::Long written = 0;
+        Ice::Long reported = 0;
+        IntSeq missing;
+        Ice::Long missingSize = 0;
+        ByteSeq bytes;
+        for(size_t i = 0; i <= chunks.size() && patched && !aborted; ++i)
         {
-            IceUtil::Monitor<IceUtil::Mutex>::Lock sync(*this);
-            _destroy = true;
-            _exception = ex.what();
-            return;
+            map<ByteSeq, Ice::Long>::const_iterator local = localChunks.end();
+            if(i < chunks.size())
+            {
+                local = localChunks.find(chunks[i].checksum);
+                if(local == localChunks.end())
+                {
+                    missing.push_back(static_cast<Ice::Int>(i));
+                    missingSize += chunks[i].size;
+                }
+            }
+
+            if(!missing.empty() && (i == chunks.size() || local != localChunks.end() || missingSize >= batchSize))
+            {
+                try
+                {
+                    bytes = _serverCompress->getChunks(info.path, missing);
+                }
+                catch(const FileAccessException&)
+                {
+                    patched = false;
+                    break;
+                }
+
+                size_t pos = 0;
+                for(IntSeq::const_iterator p = missing.begin(); p != missing.end() && patched; ++p)
+                {
+                    const ChunkInfo& chunk = chunks[*p];
+                    ByteSeq checksum;
+                    if(bytes.size() - pos >= static_cast<size_t>(chunk.size))
+                    {
+                        IceInternal::sha1(reinterpret_cast<const unsigned char*>(&bytes[pos]), chunk.size, checksum);
+                    }
+
+                    if(checksum != chunk.checksum)
+                    {
+                        patched = false;
+                    }
+                    else if(fwrite(&bytes[pos], chunk.size, 1, fp) != 1)
+                    {
+                        throw runtime_error("cannot write to `" + pathTemp + "':\n" +
+                                            IceUtilInternal::lastErrorToString());
+                    }
+                    else
+                    {
+                        hasher.update(reinterpret_cast<const unsigned char*>(&bytes[pos]), chunk.size);
+                        pos += chunk.size;
+                    }
+                }
+                written += missingSize;
+                missing.clear();
+                missingSize = 0;
+            }
+
+            if(patched && local != localChunks.end())
+            {
+                bytes.resize(static_cast<size_t>(chunks[i].size));
+                if(
+#if defined(_MSC_VER)
+                    _lseeki64(fd, local->second, SEEK_SET)
+#else
+                    lseek(fd, static_cast<off_t>(local->second), SEEK_SET)
+#endif
+                    != local->second ||
+#if defined(_MSC_VER)
+                    _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#else
+                    read(fd, &bytes[0], bytes.size())
+#endif
+                    != static_cast<int>(bytes.size()))
+                {
+                    throw runtime_error("cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+                }
+
+                if(fwrite(&bytes[0], bytes.size(), 1, fp) != 1)
+                {
+                    throw runtime_error("cannot write to `" + pathTemp + "':\n" + IceUtilInternal::lastErrorToString());
+                }
+                hasher.update(reinterpret_cast<const unsigned char*>(&bytes[0]), bytes.size());
+                written += chunks[i].size;
+            }
+
+            //
+            // The progress is reported in compressed bytes, like for a
+            // regular download.
+            //
+            Ice::Long pos = written == size ? info.size :
+                static_cast<Ice::Long>(static_cast<double>(info.size) * written / size);
+            if(patched && pos > reported)
+            {
+                aborted = !_queue->progress(index, pos - reported);
+                reported = pos;
+            }
         }
+
+        if(patched && !aborted)
+        {
+            ByteSeq checksum;
+            hasher.finalize(checksum);
+            patched = checksum == info.checksum;
+        }
+    }
+    catch(...)
+    {
+        IceUtilInternal::close(fd);
+        fclose(fp);
+        throw;
+    }
+
+    IceUtilInternal::close(fd);
+    if(fclose(fp) != 0)
+    {
+        throw runtime_error("cannot write to `" + pathTemp + "':\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    if(!patched || aborted)
+    {
+        remove(pathTemp);
+        if(!aborted)
+        {
+            _queue->reset(index);
+        }
+        return false;
+    }
+
+    rename(pathTemp, path);
+    setFileFlags(path, info);
+    _queue->finished(index);
+    return true;
+}
+
+AsyncResultPtr
+Downloader::beginGetChunk(const LargeFileInfo& info, Ice::Long pos)
+{
+    return _useSmallFileAPI ?
+        _server->begin_getFileCompressed(info.path, static_cast<Ice::Int>(pos), _chunkSize) :
+        _server->begin_getLargeFileCompressed(info.path, pos, _chunkSize);
+}
+
+ByteSeq
+Downloader::endGetChunk(const LargeFileInfo& info, const AsyncResultPtr& result)
+{
+    try
+    {
+        return _useSmallFileAPI ? _server->end_getFileCompressed(result) :
+                                  _server->end_getLargeFileCompressed(result);
+    }
+    catch(const FileAccessException& ex)
+    {
+        throw runtime_error("error from IcePatch2 server for `" + info.path + "': " + ex.reason);
     }
 }
 
@@ -199,6 +689,7 @@ PatcherI::PatcherI(const CommunicatorPtr& communicator, const PatcherFeedbackPtr
     _thorough(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.Thorough", 0) > 0),
     _chunkSize(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.ChunkSize", 100)),
     _remove(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.Remove", 1)),
+    _concurrency(communicator->getProperties()->getPropertyAsIntWithDefault("IcePatch2Client.Concurrency", 4)),
     _log(0),
     _useSmallFileAPI(false)
 {
@@ -229,6 +720,9 @@ PatcherI::PatcherI(const FileServerPrx& server,
     _thorough(thorough),
     _chunkSize(chunkSize),
     _remove(remove),
+    _concurrency(server->ice_getCommunicator()->getProperties()->getPropertyAsIntWithDefault(
+                     "IcePatch2Client.Concurrency", 4)),
+    _log(0),
     _useSmallFileAPI(false)
 {
     init(server);
@@ -622,6 +1116,11 @@ PatcherI::init(const FileServerPrx& server)
         const_cast<Int&>(_chunkSize) *= 1024;
     }
 
+    if(_concurrency < 1)
+    {
+        const_cast<Int&>(_concurrency) = 1;
+    }
+
     if(!IceUtilInternal::isAbsolutePath(_dataDir))
     {
         string cwd;
@@ -644,11 +1143,27 @@ PatcherI::removeFiles(const LargeFileInfoSeq& files)
         return true;
     }
 
+    //
+    // The previous version of the regular files which are updated is kept,
+    // the chunks which didn't change are reused when they are patched.
+    //
+    set<string> updatedFiles;
+    for(LargeFileInfoSeq::const_iterator p = _updateFiles.begin(); p != _updateFiles.end(); ++p)
+    {
+        if(p->size >= 0)
+        {
+            updatedFiles.insert(p->path);
+        }
+    }
+
     for(LargeFileInfoSeq::const_reverse_iterator p = files.rbegin(); p != files.rend(); ++p)
     {
         try
         {
-            remove(_dataDir + '/' + p->path);
+            if(p->size < 0 || updatedFiles.find(p->path) == updatedFiles.end())
+            {
+                remove(_dataDir + '/' + p->path);
+            }
             if(fputc('-', _log) == EOF || ! writeFileInfo(_log, *p))
             {
                 throw runtime_error("error writing log file:\n" + IceUtilInternal::lastErrorToString());
@@ -692,202 +1207,147 @@ PatcherI::removeFiles(const LargeFileInfoSeq& files)
 bool
 PatcherI::updateFiles(const LargeFileInfoSeq& files)
 {
-    DecompressorPtr decompressor = new Decompressor(_dataDir);
-#if defined(__hppa)
     //
-    // The thread stack size is only 64KB only HP-UX and that's not
-    // enough for this thread.
+    // The directories are created first, the regular non-empty files are
+    // then downloaded and decompressed in parallel by the downloader
+    // threads, each downloader uses its own connection to the server.
     //
-    decompressor->start(256 * 1024); // 256KB
-#else
-    decompressor->start();
-#endif
+    LargeFileInfoSeq downloads;
+    Long total = 0;
+    for(LargeFileInfoSeq::const_iterator p = files.begin(); p != files.end(); ++p)
+    {
+        if(p->size < 0) // Directory?
+        {
+            createDirectoryRecursive(_dataDir + '/' + p->path);
+            if(fputc('+', _log) == EOF || !writeFileInfo(_log, *p))
+            {
+                throw runtime_error("error writing log file:\n" + IceUtilInternal::lastErrorToString());
+            }
+        }
+        else if(p->size > 0) // Regular, non-empty file?
+        {
+            downloads.push_back(*p);
+            total += p->size;
+        }
+    }
+
+    DownloadQueuePtr queue = new DownloadQueue(downloads);
+    vector<DownloaderPtr> downloaders;
     bool result;
 
     try
     {
-        result = updateFilesInternal(files, decompressor);
+        size_t count = min(downloads.size(), static_cast<size_t>(_concurrency));
+        for(size_t i = 0; i < count; ++i)
+        {
+            ostringstream os;
+            os << "IcePatch2-" << i;
+            FileServerPrx server = FileServerPrx::uncheckedCast(_serverNoCompress->ice_connectionId(os.str()));
+            DownloaderPtr downloader = new Downloader(queue, server, _dataDir, _chunkSize, _useSmallFileAPI);
+            downloader->start();
+            downloaders.push_back(downloader);
+        }
+
+        result = updateFilesInternal(files, queue, total);
     }
     catch(...)
     {
-        decompressor->destroy();
-        decompressor->getThreadControl().join();
-        decompressor->log(_log);
+        queue->destroy();
+        for(vector<DownloaderPtr>::const_iterator p = downloaders.begin(); p != downloaders.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+        }
+        queue->log(_log);
         throw;
     }
 
-    decompressor->destroy();
-    decompressor->getThreadControl().join();
-    decompressor->log(_log);
-    decompressor->exception();
+    queue->destroy();
+    for(vector<DownloaderPtr>::const_iterator p = downloaders.begin(); p != downloaders.end(); ++p)
+    {
+        (*p)->getThreadControl().join();
+    }
+    queue->log(_log);
 
     return result;
 }
 
 bool
-PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DecompressorPtr& decompressor)
+PatcherI::updateFilesInternal(const LargeFileInfoSeq& files, const DownloadQueuePtr& queue, Long total)
 {
-    Long total = 0;
+    //
+    // The feedback is called from this thread for each file in order: the
+    // progress of a file is reported while the next files are downloaded
+    // by the other downloaders, the total progress includes the bytes of
+    // all the files being downloaded.
+    //
+    PatcherThroughputFeedback* throughputFeedback = dynamic_cast<PatcherThroughputFeedback*>(_feedback.get());
+    const IceUtil::Time interval = IceUtil::Time::seconds(1);
+    IceUtil::Time lastTime = IceUtil::Time::now(IceUtil::Time::Monotonic);
+    Long lastUpdated = 0;
     Long updated = 0;
+    size_t index = 0;
 
     for(LargeFileInfoSeq::const_iterator p = files.begin(); p != files.end(); ++p)
     {
-        if(p->size > 0) // Regular, non-empty file?
+        if(p->size < 0) // Directory?
         {
-            total += p->size;
+            continue;
         }
-    }
 
-    AsyncResultPtr curCB;
-    AsyncResultPtr nxtCB;
+        if(!_feedback->patchStart(p->path, p->size, updated, total))
+        {
+            return false;
+        }
 
-    for(LargeFileInfoSeq::const_iterator p = files.begin(); p != files.end(); ++p)
-    {
-        if(p->size < 0) // Directory?
+        if(p->size == 0)
         {
-            createDirectoryRecursive(_dataDir + '/' + p->path);
-            if(fputc('+', _log) == EOF || !writeFileInfo(_log, *p))
+            string path = simplify(_dataDir + '/' + p->path);
+            FILE* fp = IceUtilInternal::fopen(path, "wb");
+            if(fp == 0)
             {
-                throw runtime_error("error writing log file:\n" + IceUtilInternal::lastErrorToString());
+                throw runtime_error("cannot open `" + path +"' for writing:\n" + IceUtilInternal::lastErrorToString());
             }
+            fclose(fp);
         }
-        else // Regular file.
+        else
         {
-            if(!_feedback->patchStart(p->path, p->size, updated, total))
+            Long pos = 0;
+            bool done = false;
+            while(!done)
             {
-                return false;
-            }
-
-            if(p->size == 0)
-            {
-                string path = simplify(_dataDir + '/' + p->path);
-                FILE* fp = IceUtilInternal::fopen(path, "wb");
-                if(fp == 0)
-                {
-                    throw runtime_error("cannot open `" + path +"' for writing:\n" + IceUtilInternal::lastErrorToString());
-                }
-                fclose(fp);
-            }
-            else
-            {
-                string pathBZ2 = simplify(_dataDir + '/' + p->path + ".bz2");
-
-                string dir = getDirname(pathBZ2);
-                if(!dir.empty())
-                {
-                    createDirectoryRecursive(dir);
-                }
-
-                try
-                {
-                    removeRecursive(pathBZ2);
-                }
-                catch(...)
+                Long newPos;
+                Long newUpdated;
+                done = queue->wait(index, newPos, newUpdated, interval);
+                if(newPos != pos || newUpdated != updated)
                 {
+                    pos = newPos;
+                    updated = newUpdated;
+                    if(!_feedback->patchProgress(pos, p->size, updated, total))
+                    {
+                        return false;
+                    }
                 }
 
-                FILE* fileBZ2 = IceUtilInternal::fopen(pathBZ2, "wb");
-                if(fileBZ2 == 0)
-                {
-                    throw runtime_error("cannot open `" + pathBZ2 + "' for writing:\n" + IceUtilInternal::lastErrorToString());
-                }
-
-                try
+                IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                if(throughputFeedback && now - lastTime >= interval)
                 {
-                    Ice::Long pos = 0;
-
-                    while(pos < p->size)
+                    Long throughput = static_cast<Long>((updated - lastUpdated) / (now - lastTime).toSecondsDouble());
+                    lastTime = now;
+                    lastUpdated = updated;
+                    if(!throughputFeedback->patchThroughput(throughput))
                     {
-                        if(!curCB)
-                        {
-                            assert(!nxtCB);
-                            curCB = _useSmallFileAPI ?
-                                _serverNoCompress->begin_getFileCompressed(p->path, static_cast<Ice::Int>(pos), _chunkSize) :
-                                _serverNoCompress->begin_getLargeFileCompressed(p->path, pos, _chunkSize);
-                        }
-                        else
-                        {
-                            assert(nxtCB);
-                            swap(nxtCB, curCB);
-                        }
-
-                        if(pos + _chunkSize < p->size)
-                        {
-                            nxtCB = _useSmallFileAPI ?
-                                _serverNoCompress->begin_getFileCompressed(p->path, static_cast<Ice::Int>(pos + _chunkSize), _chunkSize) :
-                                _serverNoCompress->begin_getLargeFileCompressed(p->path, pos + _chunkSize, _chunkSize);
-                        }
-                        else
-                        {
-                            LargeFileInfoSeq::const_iterator q = p + 1;
-
-                            while(q != files.end() && q->size <= 0)
-                            {
-                                ++q;
-                            }
-
-                            if(q != files.end())
-                            {
-                                nxtCB = _useSmallFileAPI ?
-                                    _serverNoCompress->begin_getFileCompressed(q->path, 0, _chunkSize) :
-                                    _serverNoCompress->begin_getLargeFileCompressed(q->path, 0, _chunkSize);
-                            }
-                        }
-
-                        ByteSeq bytes;
-
-                        try
-                        {
-                            bytes = _useSmallFileAPI ? _serverNoCompress->end_getFileCompressed(curCB) :
-                                                       _serverNoCompress->end_getLargeFileCompressed(curCB);
-                        }
-                        catch(const FileAccessException& ex)
-                        {
-                            throw runtime_error("error from IcePatch2 server for `" + p->path + "': " + ex.reason);
-                        }
-
-                        if(bytes.empty())
-                        {
-                            throw runtime_error("size mismatch for `" + p->path + "'");
-                        }
-
-                        if(fwrite(reinterpret_cast<char*>(&bytes[0]), bytes.size(), 1, fileBZ2) != 1)
-                        {
-                            throw runtime_error(": cannot write `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString());
-                        }
-
-                        // 'bytes' is always returned with size '_chunkSize'. When a file is smaller than '_chunkSize'
-                        // or we are reading the last chunk of a file, 'bytes' will be larger than necessary. In this
-                        // case we calculate the current position and updated size based on the known file size.
-                        size_t size = (pos + bytes.size()) > static_cast<size_t>(p->size) ?
-                            static_cast<size_t>(p->size - pos) : bytes.size();
-
-                        pos += size;
-                        updated += size;
-
-                        if(!_feedback->patchProgress(pos, p->size, updated, total))
-                        {
-                            fclose(fileBZ2);
-                            return false;
-                        }
+                        return false;
                     }
                 }
-                catch(...)
-                {
-                    fclose(fileBZ2);
-                    throw;
-                }
-
-                fclose(fileBZ2);
-
-                decompressor->log(_log);
-                decompressor->add(*p);
             }
+            ++index;
 
-            if(!_feedback->patchEnd())
-            {
-                return false;
-            }
+            queue->log(_log);
+        }
+
+        if(!_feedback->patchEnd())
+        {
+            return false;
         }
     }
 
@@ -36,6 +36,11 @@
 
 const char* IcePatch2Internal::checksumFile = "IcePatch2.sum";
 const char* IcePatch2Internal::logFile = "IcePatch2.log";
+const char* IcePatch2Internal::chunksFile = "IcePatch2.chunks";
+const char* IcePatch2Internal::statFile = "IcePatch2.stat";
+const Ice::Long IcePatch2Internal::chunkedFileSizeMin = 1024 * 1024;
+const Ice::Int IcePatch2Internal::chunkSizeMax = 256 * 1024;
+const Ice::Int IcePatch2Internal::chunksRequestSizeMax = 4 * IcePatch2Internal::chunkSizeMax;
 
 using namespace std;
 using namespace Ice;
@@ -325,7 +330,8 @@ IcePatch2Internal::ignoreSuffix(const string& path)
     return suffix == "md5" // For legacy IcePatch.
         || suffix == "tot" // For legacy IcePatch.
         || suffix == "bz2"
-        || suffix == "bz2temp";
+        || suffix == "bz2temp"
+        || suffix == "chunktemp";
 }
 
 string
@@ -741,11 +747,275 @@ IcePatch2Internal::setFileFlags(const string&, const LargeFileInfo&)
 namespace
 {
 
+//
+// A regular file whose checksum must be computed, and compressed if
+// compress is true.
+//
+struct ChecksumJob
+{
+    string path;
+    LargeFileInfo info;
+    Long size;
+    Long mtime;
+    bool compress;
+};
+
+void
+computeFileInfo(ChecksumJob& job)
+{
+    const string& path = job.path;
+    const string& relPath = job.info.path;
+    LargeFileInfo& info = job.info;
+
+    ByteSeq bytesSHA;
+
+    if(relPath.size() + job.size == 0)
+    {
+        bytesSHA.resize(20);
+        fill(bytesSHA.begin(), bytesSHA.end(), Byte(0));
+    }
+    else
+    {
+        IceInternal::SHA1 hasher;
+        if(relPath.size() != 0)
+        {
+            hasher.update(reinterpret_cast<const IceUtil::Byte*>(relPath.c_str()), relPath.size());
+        }
+
+        if(job.size != 0)
+        {
+            int fd = IceUtilInternal::open(path.c_str(), O_BINARY|O_RDONLY);
+            if(fd == -1)
+            {
+                throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
+            }
+
+            const string pathBZ2 = path + ".bz2";
+            const string pathBZ2Temp = path + ".bz2temp";
+            FILE* stdioFile = 0;
+            int bzError = 0;
+            BZFILE* bzFile = 0;
+            if(job.compress)
+            {
+                stdioFile = IceUtilInternal::fopen(simplify(pathBZ2Temp), "wb");
+                if(!stdioFile)
+                {
+                    IceUtilInternal::close(fd);
+                    throw runtime_error("cannot open `" + pathBZ2Temp + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+                }
+
+                bzFile = BZ2_bzWriteOpen(&bzError, stdioFile, 5, 0, 0);
+                if(bzError != BZ_OK)
+                {
+                    string reason = "BZ2_bzWriteOpen failed";
+                    if(bzError == BZ_IO_ERROR)
+                    {
+                        reason += ": " + IceUtilInternal::lastErrorToString();
+                    }
+                    fclose(stdioFile);
+                    IceUtilInternal::close(fd);
+                    throw runtime_error(reason);
+                }
+            }
+
+            Long bytesLeft = job.size;
+            ByteSeq bytes;
+            while(bytesLeft > 0)
+            {
+                bytes.resize(static_cast<size_t>(min(bytesLeft, static_cast<Long>(1024 * 1024))));
+                if(
+#if defined(_MSC_VER)
+                    _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#else
+                    read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
+#endif
+                    == -1)
+                {
+                    if(job.compress)
+                    {
+                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                        fclose(stdioFile);
+                    }
+
+                    IceUtilInternal::close(fd);
+                    throw runtime_error("cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+                }
+                bytesLeft -= static_cast<Long>(bytes.size());
+                if(job.compress)
+                {
+                    BZ2_bzWrite(&bzError, bzFile, const_cast<Byte*>(&bytes[0]), static_cast<int>(bytes.size()));
+                    if(bzError != BZ_OK)
+                    {
+                        string reason = "BZ2_bzWrite failed";
+                        if(bzError == BZ_IO_ERROR)
+                        {
+                            reason += ": " + IceUtilInternal::lastErrorToString();
+                        }
+                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                        fclose(stdioFile);
+                        IceUtilInternal::close(fd);
+                        throw runtime_error(reason);
+                    }
+                }
+
+                hasher.update(reinterpret_cast<IceUtil::Byte*>(&bytes[0]), bytes.size());
+            }
+
+            IceUtilInternal::close(fd);
+
+            if(job.compress)
+            {
+                BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
+                if(bzError != BZ_OK)
+                {
+                    string reason = "BZ2_bzWriteClose failed";
+                    if(bzError == BZ_IO_ERROR)
+                    {
+                        reason += ": " + IceUtilInternal::lastErrorToString();
+                    }
+                    fclose(stdioFile);
+                    throw runtime_error(reason);
+                }
+
+                fclose(stdioFile);
+
+                rename(pathBZ2Temp, pathBZ2);
+
+                IceUtilInternal::structstat bufBZ2;
+                if(IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1)
+                {
+                    throw runtime_error("cannot stat `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString());
+                }
+
+                info.size = bufBZ2.st_size;
+            }
+        }
+        hasher.finalize(bytesSHA);
+    }
+
+    info.checksum.swap(bytesSHA);
+}
+
+//
+// The checksum jobs are shared by the calling thread and the checksum
+// threads. The callback is only called by one thread at a time, and the
+// first failure aborts the remaining jobs.
+//
+class ChecksumQueue : public IceUtil::Shared, private IceUtil::Mutex
+{
+public:
+
+    ChecksumQueue(vector<ChecksumJob>& jobs, GetFileInfoSeqCB* cb) :
+        _jobs(jobs),
+        _cb(cb),
+        _next(0),
+        _aborted(false)
+    {
+    }
+
+    void
+    run()
+    {
+        try
+        {
+            while(true)
+            {
+                ChecksumJob* job;
+                {
+                    IceUtil::Mutex::Lock sync(*this);
+                    if(_aborted || _next == _jobs.size())
+                    {
+                        return;
+                    }
+
+                    job = &_jobs[_next++];
+                    if(_cb && ((job->compress && !_cb->compress(job->info.path)) || !_cb->checksum(job->info.path)))
+                    {
+                        _aborted = true;
+                        return;
+                    }
+                }
+
+                computeFileInfo(*job);
+            }
+        }
+        catch(const std::exception& ex)
+        {
+            exception(ex.what());
+        }
+        catch(const string& ex)
+        {
+            exception(ex);
+        }
+    }
+
+    //
+    // Returns false if the jobs were aborted by the callback and throws
+    // the first exception raised by a job.
+    //
+    bool
+    result()
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(!_exception.empty())
+        {
+            throw runtime_error(_exception);
+        }
+        return !_aborted;
+    }
+
+private:
+
+    void
+    exception(const string& reason)
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        if(_exception.empty())
+        {
+            _exception = reason;
+        }
+        _aborted = true;
+    }
+
+    vector<ChecksumJob>& _jobs;
+    GetFileInfoSeqCB* _cb;
+    size_t _next;
+    bool _aborted;
+    string _exception;
+};
+typedef IceUtil::Handle<ChecksumQueue> ChecksumQueuePtr;
+
+class ChecksumThread : public IceUtil::Thread
+{
+public:
+
+    ChecksumThread(const ChecksumQueuePtr& queue) :
+        _queue(queue)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        _queue->run();
+    }
+
+private:
+
+    const ChecksumQueuePtr _queue;
+};
+typedef IceUtil::Handle<ChecksumThread> ChecksumThreadPtr;
+
+//
+// Walks the tree and returns the infos of the directories and of the files
+// whose checksum is reused from the given stats. The files whose checksum
+// must be computed are added to the jobs.
+//
 static bool
 getFileInfoSeqInternal(const string& basePath, const string& relPath, int compress, GetFileInfoSeqCB* cb,
-                       LargeFileInfoSeq& infoSeq)
+                       const FileStatDict* stats, LargeFileInfoSeq& infoSeq, vector<ChecksumJob>& jobs)
 {
-    if(relPath == checksumFile || relPath == logFile)
+    if(relPath == checksumFile || relPath == logFile || relPath == chunksFile || relPath == statFile)
     {
         return true;
     }
@@ -830,7 +1100,8 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
             StringSeq content = readDirectory(path);
             for(StringSeq::const_iterator p = content.begin(); p != content.end() ; ++p)
             {
-                if(!getFileInfoSeqInternal(basePath, simplify(relPath + '/' + *p), compress, cb, infoSeq))
+                if(!getFileInfoSeqInternal(basePath, simplify(relPath + '/' + *p), compress, cb, stats, infoSeq,
+                                           jobs))
                 {
                     return false;
                 }
@@ -838,7 +1109,13 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
         }
         else if(S_ISREG(buf.st_mode))
         {
-            LargeFileInfo info;
+            ChecksumJob job;
+            job.path = path;
+            job.size = static_cast<Long>(buf.st_size);
+            job.mtime = static_cast<Long>(buf.st_mtime);
+            job.compress = false;
+
+            LargeFileInfo& info = job.info;
             info.path = relPath;
             info.size = 0;
 #ifdef _WIN32
@@ -849,7 +1126,6 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
 
             IceUtilInternal::structstat bufBZ2;
             const string pathBZ2 = path + ".bz2";
-            bool doCompress = false;
             if(buf.st_size != 0 && compress > 0)
             {
                 //
@@ -859,12 +1135,7 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
                 //
                 if(compress >= 2 || IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1 || buf.st_mtime >= bufBZ2.st_mtime)
                 {
-                    if(cb && !cb->compress(relPath))
-                    {
-                        return false;
-                    }
-
-                    doCompress = true;
+                    job.compress = true;
                 }
                 else
                 {
@@ -872,136 +1143,22 @@ getFileInfoSeqInternal(const string& basePath, const string& relPath, int compre
                 }
             }
 
-            if(cb && !cb->checksum(relPath))
-            {
-                return false;
-            }
-
-            ByteSeq bytesSHA;
-
-            if(relPath.size() + buf.st_size == 0)
-            {
-                bytesSHA.resize(20);
-                fill(bytesSHA.begin(), bytesSHA.end(), Byte(0));
-            }
-            else
+            //
+            // The checksum of a file which doesn't need to be compressed is
+            // reused if its size and modification time didn't change.
+            //
+            if(stats && !job.compress)
             {
-                IceInternal::SHA1 hasher;
-                if(relPath.size() != 0)
+                FileStatDict::const_iterator p = stats->find(relPath);
+                if(p != stats->end() && p->second.size == job.size && p->second.mtime == job.mtime)
                 {
-                    hasher.update(reinterpret_cast<const IceUtil::Byte*>(relPath.c_str()), relPath.size());
+                    info.checksum = p->second.checksum;
+                    infoSeq.push_back(info);
+                    return true;
                 }
-
-                if(buf.st_size != 0)
-                {
-                    int fd = IceUtilInternal::open(path.c_str(), O_BINARY|O_RDONLY);
-                    if(fd == -1)
-                    {
-                        throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
-                    }
-
-                    const string pathBZ2Temp = path + ".bz2temp";
-                    FILE* stdioFile = 0;
-                    int bzError = 0;
-                    BZFILE* bzFile = 0;
-                    if(doCompress)
-                    {
-                        stdioFile = IceUtilInternal::fopen(simplify(pathBZ2Temp), "wb");
-                        if(!stdioFile)
-                        {
-                            IceUtilInternal::close(fd);
-                            throw runtime_error("cannot open `" + pathBZ2Temp + "' for writing:\n" + IceUtilInternal::lastErrorToString());
-                        }
-
-                        bzFile = BZ2_bzWriteOpen(&bzError, stdioFile, 5, 0, 0);
-                        if(bzError != BZ_OK)
-                        {
-                            string reason = "BZ2_bzWriteOpen failed";
-                            if(bzError == BZ_IO_ERROR)
-                            {
-                                reason += ": " + IceUtilInternal::lastErrorToString();
-                            }
-                            fclose(stdioFile);
-                            IceUtilInternal::close(fd);
-                            throw runtime_error(reason);
-                        }
-                    }
-
-                    long bytesLeft = buf.st_size;
-                    while(bytesLeft > 0)
-                    {
-                        ByteSeq bytes(min(bytesLeft, 1024l*1024));
-                        if(
-#if defined(_MSC_VER)
-                            _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
-#else
-                            read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()))
-#endif
-                            == -1)
-                        {
-                            if(doCompress)
-                            {
-                                fclose(stdioFile);
-                            }
-
-                            IceUtilInternal::close(fd);
-                            throw runtime_error("cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString());
-                        }
-                        bytesLeft -= static_cast<unsigned int>(bytes.size());
-                        if(doCompress)
-                        {
-                            BZ2_bzWrite(&bzError, bzFile, const_cast<Byte*>(&bytes[0]), static_cast<int>(bytes.size()));
-                            if(bzError != BZ_OK)
-                            {
-                                string reason = "BZ2_bzWrite failed";
-                                if(bzError == BZ_IO_ERROR)
-                                {
-                                    reason += ": " + IceUtilInternal::lastErrorToString();
-                                }
-                                BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
-                                fclose(stdioFile);
-                                IceUtilInternal::close(fd);
-                                throw runtime_error(reason);
-                            }
-                        }
-
-                        hasher.update(reinterpret_cast<IceUtil::Byte*>(&bytes[0]), bytes.size());
-                    }
-
-                    IceUtilInternal::close(fd);
-
-                    if(doCompress)
-                    {
-                        BZ2_bzWriteClose(&bzError, bzFile, 0, 0, 0);
-                        if(bzError != BZ_OK)
-                        {
-                            string reason = "BZ2_bzWriteClose failed";
-                            if(bzError == BZ_IO_ERROR)
-                            {
-                                reason += ": " + IceUtilInternal::lastErrorToString();
-                            }
-                            fclose(stdioFile);
-                            throw runtime_error(reason);
-                        }
-
-                        fclose(stdioFile);
-
-                        rename(pathBZ2Temp, pathBZ2);
-
-                        if(IceUtilInternal::stat(pathBZ2, &bufBZ2) == -1)
-                        {
-                            throw runtime_error("cannot stat `" + pathBZ2 + "':\n" + IceUtilInternal::lastErrorToString());
-                        }
-
-                        info.size = bufBZ2.st_size;
-                    }
-                }
-                hasher.finalize(bytesSHA);
             }
 
-            info.checksum.swap(bytesSHA);
-
-            infoSeq.push_back(info);
+            jobs.push_back(job);
         }
     }
 
@@ -1017,23 +1174,81 @@ IcePatch2Internal::GetFileInfoSeqCB::~GetFileInfoSeqCB()
 
 bool
 IcePatch2Internal::getFileInfoSeq(const string& basePath, int compress, GetFileInfoSeqCB* cb,
-                                  LargeFileInfoSeq& infoSeq)
+                                  LargeFileInfoSeq& infoSeq, int threads, FileStatDict* stats)
 {
-    return getFileInfoSeqSubDir(basePath, ".", compress, cb, infoSeq);
+    return getFileInfoSeqSubDir(basePath, ".", compress, cb, infoSeq, threads, stats);
 }
 
 bool
 IcePatch2Internal::getFileInfoSeqSubDir(const string& basePa, const string& relPa, int compress, GetFileInfoSeqCB* cb,
-                                        LargeFileInfoSeq& infoSeq)
+                                        LargeFileInfoSeq& infoSeq, int threads, FileStatDict* stats)
 {
     const string basePath = simplify(basePa);
     const string relPath = simplify(relPa);
 
-    if(!getFileInfoSeqInternal(basePath, relPath, compress, cb, infoSeq))
+    //
+    // A file modified within the same second as its modification time is
+    // recorded could be modified again without its modification time
+    // changing, the stats of recently modified files are not recorded.
+    //
+    const Long now = static_cast<Long>(time(0));
+
+    vector<ChecksumJob> jobs;
+    if(!getFileInfoSeqInternal(basePath, relPath, compress, cb, stats, infoSeq, jobs))
     {
         return false;
     }
 
+    if(!jobs.empty())
+    {
+        ChecksumQueuePtr queue = new ChecksumQueue(jobs, cb);
+        vector<ChecksumThreadPtr> checksumThreads;
+        try
+        {
+            size_t count = min(jobs.size(), static_cast<size_t>(max(threads, 1)));
+            for(size_t i = 1; i < count; ++i)
+            {
+                ChecksumThreadPtr thread = new ChecksumThread(queue);
+                thread->start();
+                checksumThreads.push_back(thread);
+            }
+        }
+        catch(const IceUtil::ThreadSyscallException&)
+        {
+            // Compute the remaining checksums with the threads already started.
+        }
+
+        queue->run();
+        for(vector<ChecksumThreadPtr>::const_iterator p = checksumThreads.begin(); p != checksumThreads.end(); ++p)
+        {
+            (*p)->getThreadControl().join();
+        }
+
+        if(!queue->result())
+        {
+            return false;
+        }
+
+        for(vector<ChecksumJob>::const_iterator p = jobs.begin(); p != jobs.end(); ++p)
+        {
+            infoSeq.push_back(p->info);
+            if(stats)
+            {
+                if(p->mtime < now)
+                {
+                    FileStat& stat = (*stats)[p->info.path];
+                    stat.checksum = p->info.checksum;
+                    stat.size = p->size;
+                    stat.mtime = p->mtime;
+                }
+                else
+                {
+                    stats->erase(p->info.path);
+                }
+            }
+        }
+    }
+
     sort(infoSeq.begin(), infoSeq.end(), FileInfoLess());
     infoSeq.erase(unique(infoSeq.begin(), infoSeq.end(), FileInfoEqual()), infoSeq.end());
 
@@ -1236,3 +1451,303 @@ IcePatch2Internal::getFileTree0(const LargeFileInfoSeq& infoSeq, FileTree0& tree
         fill(tree0.checksum.begin(), tree0.checksum.end(), Byte(0));
     }
 }
+
+namespace
+{
+
+//
+// The chunk boundaries are found with a gear rolling hash: a boundary is
+// found when the high bits of the hash of the last 32 bytes are zero,
+// which gives chunks of about 80KB between the minimum and maximum sizes.
+//
+const size_t chunkSizeMin = 16 * 1024;
+const unsigned int chunkMask = 0xFFFF0000;
+
+//
+// The table of the rolling hash must be the same for all the clients and
+// servers, it's generated from a fixed seed.
+//
+class GearTable
+{
+public:
+
+    GearTable()
+    {
+        unsigned int x = 0x2545F491;
+        for(int i = 0; i < 256; ++i)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            _values[i] = x;
+        }
+    }
+
+    unsigned int operator[](Byte b) const
+    {
+        return _values[b];
+    }
+
+private:
+
+    unsigned int _values[256];
+};
+
+const GearTable gearTable;
+
+void
+addChunk(const ByteSeq& chunk, ChunkInfoSeq& chunks)
+{
+    ChunkInfo info;
+    info.size = static_cast<Int>(chunk.size());
+    IceInternal::sha1(reinterpret_cast<const unsigned char*>(&chunk[0]), chunk.size(), info.checksum);
+    chunks.push_back(info);
+}
+
+bool
+readLine(FILE* fp, string& data)
+{
+    data.clear();
+    char buf[BUFSIZ];
+    while(fgets(buf, static_cast<int>(sizeof(buf)), fp) != 0)
+    {
+        data += buf;
+
+        size_t len = strlen(buf);
+        if(buf[len - 1] == '\n')
+        {
+            break;
+        }
+    }
+    return !data.empty();
+}
+
+}
+
+void
+IcePatch2Internal::getChunkInfoSeq(const string& pa, ChunkInfoSeq& chunks)
+{
+    const string path = simplify(pa);
+
+    int fd = IceUtilInternal::open(path, O_BINARY|O_RDONLY);
+    if(fd == -1)
+    {
+        throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    ByteSeq chunk;
+    chunk.reserve(static_cast<size_t>(chunkSizeMax));
+    ByteSeq bytes(1024 * 1024);
+    unsigned int hash = 0;
+    while(true)
+    {
+#if defined(_MSC_VER)
+        int r = _read(fd, &bytes[0], static_cast<unsigned int>(bytes.size()));
+#else
+        ssize_t r = read(fd, &bytes[0], bytes.size());
+#endif
+        if(r == -1)
+        {
+            IceUtilInternal::close(fd);
+            throw runtime_error("cannot read from `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+        }
+        else if(r == 0)
+        {
+            break;
+        }
+
+        size_t start = 0;
+        for(size_t i = 0; i < static_cast<size_t>(r); ++i)
+        {
+            hash = (hash << 1) + gearTable[bytes[i]];
+            size_t size = chunk.size() + i + 1 - start;
+            if(size >= static_cast<size_t>(chunkSizeMax) || (size >= chunkSizeMin && (hash & chunkMask) == 0))
+            {
+                chunk.insert(chunk.end(), bytes.begin() + start, bytes.begin() + i + 1);
+                addChunk(chunk, chunks);
+                chunk.clear();
+                start = i + 1;
+                hash = 0;
+            }
+        }
+        chunk.insert(chunk.end(), bytes.begin() + start, bytes.begin() + r);
+    }
+
+    IceUtilInternal::close(fd);
+
+    if(!chunk.empty())
+    {
+        addChunk(chunk, chunks);
+    }
+}
+
+void
+IcePatch2Internal::saveFileChunksDict(const string& pa, const FileChunksDict& dict)
+{
+    const string path = simplify(pa + '/' + chunksFile);
+    FILE* fp = IceUtilInternal::fopen(path, "w");
+    if(!fp)
+    {
+        throw runtime_error("cannot open `" + path + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    for(FileChunksDict::const_iterator p = dict.begin(); p != dict.end(); ++p)
+    {
+        bool ok = fprintf(fp, "%s\t%s\t%d\n",
+                          escapeString(p->first, "", IceUtilInternal::Compat).c_str(),
+                          bytesToString(p->second.checksum).c_str(),
+                          static_cast<int>(p->second.chunks.size())) > 0;
+        for(ChunkInfoSeq::const_iterator q = p->second.chunks.begin(); ok && q != p->second.chunks.end(); ++q)
+        {
+            ok = fprintf(fp, "%s\t%d\n", bytesToString(q->checksum).c_str(), q->size) > 0;
+        }
+
+        if(!ok)
+        {
+            fclose(fp);
+            throw runtime_error("error writing `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+        }
+    }
+    fclose(fp);
+}
+
+bool
+IcePatch2Internal::loadFileChunksDict(const string& pa, FileChunksDict& dict)
+{
+    const string path = simplify(pa + '/' + chunksFile);
+    FILE* fp = IceUtilInternal::fopen(path, "r");
+    if(!fp)
+    {
+        if(errno == ENOENT)
+        {
+            return false;
+        }
+        throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    try
+    {
+        string data;
+        while(readLine(fp, data))
+        {
+            istringstream is(data);
+
+            string s;
+            getline(is, s, '\t');
+            string filePath;
+            try
+            {
+                filePath = IceUtilInternal::unescapeString(s, 0, s.size(), "");
+            }
+            catch(const IceUtil::IllegalArgumentException& ex)
+            {
+                throw invalid_argument(ex.reason());
+            }
+
+            FileChunks& fileChunks = dict[filePath];
+            getline(is, s, '\t');
+            fileChunks.checksum = stringToBytes(s);
+
+            int count = 0;
+            is >> count;
+            fileChunks.chunks.resize(count > 0 ? static_cast<size_t>(count) : 0);
+            for(ChunkInfoSeq::iterator p = fileChunks.chunks.begin(); p != fileChunks.chunks.end(); ++p)
+            {
+                if(!readLine(fp, data))
+                {
+                    throw runtime_error("unexpected end of file in `" + path + "'");
+                }
+
+                istringstream chunkIs(data);
+                getline(chunkIs, s, '\t');
+                p->checksum = stringToBytes(s);
+                chunkIs >> p->size;
+            }
+        }
+    }
+    catch(...)
+    {
+        fclose(fp);
+        throw;
+    }
+    fclose(fp);
+    return true;
+}
+
+void
+IcePatch2Internal::saveFileStatDict(const string& pa, const FileStatDict& dict)
+{
+    const string path = simplify(pa + '/' + statFile);
+    FILE* fp = IceUtilInternal::fopen(path, "w");
+    if(!fp)
+    {
+        throw runtime_error("cannot open `" + path + "' for writing:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    for(FileStatDict::const_iterator p = dict.begin(); p != dict.end(); ++p)
+    {
+        if(fprintf(fp, "%s\t%s\t" ICE_INT64_FORMAT "\t" ICE_INT64_FORMAT "\n",
+                   escapeString(p->first, "", IceUtilInternal::Compat).c_str(),
+                   bytesToString(p->second.checksum).c_str(),
+                   p->second.size,
+                   p->second.mtime) <= 0)
+        {
+            fclose(fp);
+            throw runtime_error("error writing `" + path + "':\n" + IceUtilInternal::lastErrorToString());
+        }
+    }
+    fclose(fp);
+}
+
+bool
+IcePatch2Internal::loadFileStatDict(const string& pa, FileStatDict& dict)
+{
+    const string path = simplify(pa + '/' + statFile);
+    FILE* fp = IceUtilInternal::fopen(path, "r");
+    if(!fp)
+    {
+        if(errno == ENOENT)
+        {
+            return false;
+        }
+        throw runtime_error("cannot open `" + path + "' for reading:\n" + IceUtilInternal::lastErrorToString());
+    }
+
+    try
+    {
+        string data;
+        while(readLine(fp, data))
+        {
+            istringstream is(data);
+
+            string s;
+            getline(is, s, '\t');
+            string filePath;
+            try
+            {
+                filePath = IceUtilInternal::unescapeString(s, 0, s.size(), "");
+            }
+            catch(const IceUtil::IllegalArgumentException& ex)
+            {
+                throw invalid_argument(ex.reason());
+            }
+
+            FileStat& stat = dict[filePath];
+            getline(is, s, '\t');
+            stat.checksum = stringToBytes(s);
+            is >> stat.size;
+            is >> stat.mtime;
+            if(!is)
+            {
+                dict.erase(filePath); // Recompute the checksum of this file.
+            }
+        }
+    }
+    catch(...)
+    {
+        fclose(fp);
+        throw;
+    }
+    fclose(fp);
+    return true;
+}
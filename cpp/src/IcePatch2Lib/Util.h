@@ -14,6 +14,20 @@ namespace IcePatch2Internal
 
 ICEPATCH2_API extern const char* checksumFile;
 ICEPATCH2_API extern const char* logFile;
+ICEPATCH2_API extern const char* chunksFile;
+ICEPATCH2_API extern const char* statFile;
+
+//
+// Only the chunks of the files at least this large are computed.
+//
+ICEPATCH2_API extern const Ice::Long chunkedFileSizeMin;
+
+//
+// The maximum size of a chunk, and the maximum number of bytes of the
+// chunks returned by a single getChunks call.
+//
+ICEPATCH2_API extern const Ice::Int chunkSizeMax;
+ICEPATCH2_API extern const Ice::Int chunksRequestSizeMax;
 
 ICEPATCH2_API std::string lastError();
 
@@ -158,9 +172,34 @@ public:
     virtual bool compress(const std::string&) = 0;
 };
 
-ICEPATCH2_API bool getFileInfoSeq(const std::string&, int, GetFileInfoSeqCB*, IcePatch2::LargeFileInfoSeq&);
+//
+// The size and modification time of a file, along with the checksum
+// computed for this size and modification time.
+//
+struct FileStat
+{
+    Ice::ByteSeq checksum;
+    Ice::Long size;
+    Ice::Long mtime;
+};
+
+typedef std::map<std::string, FileStat> FileStatDict;
 
-ICEPATCH2_API bool getFileInfoSeqSubDir(const std::string&, const std::string&, int, GetFileInfoSeqCB*, IcePatch2::LargeFileInfoSeq&);
+//
+// The checksums are computed and the files compressed with the given
+// number of threads. If stats are provided, the checksums of the files
+// whose size and modification time match their stat are reused, and the
+// stats of the files whose checksum is computed are updated.
+//
+ICEPATCH2_API bool getFileInfoSeq(const std::string&, int, GetFileInfoSeqCB*, IcePatch2::LargeFileInfoSeq&,
+                                  int = 1, FileStatDict* = 0);
+
+ICEPATCH2_API bool getFileInfoSeqSubDir(const std::string&, const std::string&, int, GetFileInfoSeqCB*,
+                                        IcePatch2::LargeFileInfoSeq&, int = 1, FileStatDict* = 0);
+
+ICEPATCH2_API void saveFileStatDict(const std::string&, const FileStatDict&);
+
+ICEPATCH2_API bool loadFileStatDict(const std::string&, FileStatDict&);
 
 ICEPATCH2_API void saveFileInfoSeq(const std::string&, const IcePatch2::LargeFileInfoSeq&);
 
@@ -189,6 +228,24 @@ struct FileTree0
 
 ICEPATCH2_API void getFileTree0(const IcePatch2::LargeFileInfoSeq&, FileTree0&);
 
+//
+// The content-defined chunks of a file, along with the checksum of the
+// file they were computed for.
+//
+struct FileChunks
+{
+    Ice::ByteSeq checksum;
+    IcePatch2::ChunkInfoSeq chunks;
+};
+
+typedef std::map<std::string, FileChunks> FileChunksDict;
+
+ICEPATCH2_API void getChunkInfoSeq(const std::string&, IcePatch2::ChunkInfoSeq&);
+
+ICEPATCH2_API void saveFileChunksDict(const std::string&, const FileChunksDict&);
+
+ICEPATCH2_API bool loadFileChunksDict(const std::string&, FileChunksDict&);
+
 }
 
 #endif
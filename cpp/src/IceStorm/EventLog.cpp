@@ -0,0 +1,730 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <IceUtil/DisableWarnings.h>
+#include <IceUtil/FileUtil.h>
+#include <IceUtil/OutputUtil.h>
+#include <IceUtil/StringConverter.h>
+#include <IceStorm/EventLog.h>
+#include <IceStorm/Instance.h>
+#include <IceStorm/TraceLevels.h>
+#include <Ice/LoggerUtil.h>
+#include <Ice/LocalException.h>
+#include <iomanip>
+
+#ifdef _WIN32
+#   include <io.h>
+#else
+#   include <unistd.h>
+#   include <dirent.h>
+#   include <sys/mman.h>
+#endif
+
+using namespace std;
+using namespace IceStorm;
+
+namespace
+{
+
+//
+// Each record of a segment is the size of the record followed by the
+// sequence number and the timestamp of the event and the event data.
+//
+const size_t recordHeaderSize = 4 + 8 + 8;
+
+const string sequenceContextKey = "IceStorm.Sequence";
+
+void
+readRecordHeader(const Ice::Byte* p, Ice::Int& size, Ice::Long& seq, Ice::Long& timestamp)
+{
+    Ice::InputStream in(Ice::currentEncoding, make_pair(p, p + recordHeaderSize));
+    in.read(size);
+    in.read(seq);
+    in.read(timestamp);
+}
+
+vector<string>
+readDirectory(const string& path)
+{
+    vector<string> result;
+
+#ifdef _WIN32
+
+    const wstring fs = IceUtil::stringToWstring(path + "/*");
+
+    struct _wfinddata_t data;
+    intptr_t h = _wfindfirst(fs.c_str(), &data);
+    if(h == -1)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, path);
+    }
+
+    do
+    {
+        result.push_back(IceUtil::wstringToString(data.name));
+    }
+    while(_wfindnext(h, &data) != -1);
+
+    _findclose(h);
+
+#else
+
+    DIR* dir = opendir(path.c_str());
+    if(!dir)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, path);
+    }
+
+    struct dirent* entry;
+    while((entry = readdir(dir)) != 0)
+    {
+        result.push_back(entry->d_name);
+    }
+
+    closedir(dir);
+
+#endif
+
+    return result;
+}
+
+void
+createDirectory(const string& path)
+{
+    if(IceUtilInternal::mkdir(path, 0777) == -1 && errno != EEXIST)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, path);
+    }
+}
+
+}
+
+EventLogSegmentView::EventLogSegmentView(const string& path, Ice::Long first, size_t size) :
+    _first(first),
+    _data(0),
+    _size(size),
+    _mapped(false)
+{
+    if(_size == 0)
+    {
+        return;
+    }
+
+    int fd = IceUtilInternal::open(path, O_RDONLY|O_BINARY);
+    if(fd == -1)
+    {
+        throw Ice::FileException(__FILE__, __LINE__, errno, path);
+    }
+
+#ifndef _WIN32
+    void* data = mmap(0, _size, PROT_READ, MAP_SHARED, fd, 0);
+    if(data != MAP_FAILED)
+    {
+        _data = static_cast<Ice::Byte*>(data);
+        _mapped = true;
+        IceUtilInternal::close(fd);
+        return;
+    }
+#endif
+
+    //
+    // Read the segment in memory if it can't be mapped.
+    //
+    _buffer.resize(_size);
+    size_t pos = 0;
+    while(pos < _size)
+    {
+#ifdef _WIN32
+        int r = _read(fd, &_buffer[pos], static_cast<unsigned int>(_size - pos));
+#else
+        ssize_t r = ::read(fd, &_buffer[pos], _size - pos);
+#endif
+        if(r <= 0)
+        {
+            int error = r == 0 ? EIO : errno;
+            IceUtilInternal::close(fd);
+            throw Ice::FileException(__FILE__, __LINE__, error, path);
+        }
+        pos += static_cast<size_t>(r);
+    }
+    IceUtilInternal::close(fd);
+    _data = &_buffer[0];
+}
+
+EventLogSegmentView::~EventLogSegmentView()
+{
+#ifndef _WIN32
+    if(_mapped)
+    {
+        munmap(_data, _size);
+    }
+#endif
+}
+
+EventLogReader::EventLogReader(const EventLogPtr& log, Ice::Long next) :
+    _log(log),
+    _next(next),
+    _offset(0)
+{
+}
+
+bool
+EventLogReader::read(size_t max, EventDataSeq& events)
+{
+    while(events.size() < max)
+    {
+        if(!_view || _offset == _view->size())
+        {
+            //
+            // Map the segment with the next event. If the next event isn't
+            // written yet, read the events from the log memory.
+            //
+            if(!_log->map(_next, _view, _offset))
+            {
+                _view = 0;
+                if(!_log->readPending(_next, max, events))
+                {
+                    return false;
+                }
+                continue;
+            }
+        }
+
+        Ice::InputStream in(Ice::currentEncoding, make_pair(_view->begin() + _offset, _view->end()));
+        while(events.size() < max && in.pos() < _view->size() - _offset)
+        {
+            Ice::Int size;
+            Ice::Long seq;
+            Ice::Long timestamp;
+            in.read(size);
+            in.read(seq);
+            in.read(timestamp);
+
+            EventDataPtr event = new EventData;
+            in.read(event);
+            events.push_back(event);
+            _next = seq + 1;
+        }
+        _offset += in.pos();
+    }
+    return true;
+}
+
+Ice::Long
+EventLogReader::next() const
+{
+    return _next;
+}
+
+EventLog::EventLog(const InstancePtr& instance, const string& name, const string& path) :
+    IceUtil::Thread("IceStorm event log writer"),
+    _instance(instance),
+    _name(name),
+    _path(path),
+    _segmentSize(static_cast<size_t>(max(instance->properties()->getPropertyAsIntWithDefault(
+                                             instance->serviceName() + ".EventLog.SegmentSize", 64), 1)) * 1024 * 1024),
+    _retentionSize(static_cast<Ice::Long>(instance->properties()->getPropertyAsIntWithDefault(
+                                              instance->serviceName() + ".EventLog.RetentionSize", 1024)) * 1024 * 1024),
+    _retentionTime(static_cast<Ice::Long>(instance->properties()->getPropertyAsInt(
+                                              instance->serviceName() + ".EventLog.RetentionTime")) * 1000),
+    _sync(instance->properties()->getPropertyAsInt(instance->serviceName() + ".EventLog.Sync") > 0),
+    _fd(-1),
+    _head(0),
+    _written(0),
+    _timestamp(0),
+    _destroyed(false)
+{
+    recover();
+}
+
+Ice::Long
+EventLog::append(const EventDataSeq& events)
+{
+    Lock sync(*this);
+    if(_destroyed)
+    {
+        return -1;
+    }
+
+    //
+    // The timestamps are never decreasing to allow finding the events
+    // appended at or after a given time.
+    //
+    _timestamp = max(IceUtil::Time::now().toMilliSeconds(), _timestamp);
+
+    const Ice::Long first = _head;
+    const bool notifyWriter = _pending.empty();
+    for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        (*p)->context[sequenceContextKey] = IceUtilInternal::int64ToString(_head++);
+
+        Event event;
+        event.timestamp = _timestamp;
+        event.data = *p;
+        _pending.push_back(event);
+    }
+
+    if(notifyWriter)
+    {
+        notify();
+    }
+    return first;
+}
+
+EventLogReaderPtr
+EventLog::createReader(Ice::Long seq)
+{
+    Lock sync(*this);
+    return new EventLogReader(this, min(seq, _head));
+}
+
+Ice::Long
+EventLog::find(Ice::Long timestamp)
+{
+    Ice::Long next = 0;
+    {
+        Lock sync(*this);
+
+        //
+        // Start with the last segment whose first event was appended
+        // before the given time.
+        //
+        for(vector<Segment>::const_iterator p = _segments.begin(); p != _segments.end() && p->timestamp < timestamp;
+            ++p)
+        {
+            next = p->first;
+        }
+    }
+
+    EventLogSegmentViewPtr view;
+    size_t offset = 0;
+    while(true)
+    {
+        if(!map(next, view, offset))
+        {
+            Lock sync(*this);
+            if(next < _written)
+            {
+                continue; // The events have been written in the meantime.
+            }
+
+            for(; next < _head; ++next)
+            {
+                size_t i = static_cast<size_t>(next - _written);
+                if((i < _writing.size() ? _writing[i] : _pending[i - _writing.size()]).timestamp >= timestamp)
+                {
+                    break;
+                }
+            }
+            return next;
+        }
+
+        while(offset < view->size())
+        {
+            Ice::Int size;
+            Ice::Long seq;
+            Ice::Long ts;
+            readRecordHeader(view->begin() + offset, size, seq, ts);
+            if(ts >= timestamp)
+            {
+                return seq;
+            }
+            offset += 4 + static_cast<size_t>(size);
+            next = seq + 1;
+        }
+    }
+}
+
+void
+EventLog::destroy(bool remove)
+{
+    bool join;
+    {
+        Lock sync(*this);
+        join = !_destroyed;
+        _destroyed = true;
+        notify();
+    }
+
+    if(join)
+    {
+        getThreadControl().join();
+        closeSegment();
+    }
+
+    if(remove)
+    {
+        Lock sync(*this);
+        for(vector<Segment>::const_iterator p = _segments.begin(); p != _segments.end(); ++p)
+        {
+            IceUtilInternal::remove(segmentPath(p->first));
+        }
+        _segments.clear();
+        IceUtilInternal::rmdir(_path);
+    }
+}
+
+void
+EventLog::run()
+{
+    while(true)
+    {
+        Ice::Long first;
+        {
+            Lock sync(*this);
+            while(_pending.empty() && !_destroyed)
+            {
+                wait();
+            }
+
+            if(_pending.empty())
+            {
+                return;
+            }
+
+            //
+            // Write all the pending events at once, the events appended
+            // while they are written are written with the next batch.
+            //
+            _writing.swap(_pending);
+            first = _written;
+        }
+
+        try
+        {
+            write(_writing, first);
+        }
+        catch(const Ice::Exception& ex)
+        {
+            //
+            // Start a new segment with the next batch, the events of this
+            // batch which couldn't be written are skipped by the readers.
+            //
+            closeSegment();
+
+            Ice::Error error(_instance->traceLevels()->logger);
+            error << "cannot write the event log of topic `" << _name << "':\n" << ex;
+        }
+
+        Lock sync(*this);
+        _written += static_cast<Ice::Long>(_writing.size());
+        _writing.clear();
+        removeSegments();
+    }
+}
+
+void
+EventLog::recover()
+{
+    createDirectory(_path);
+
+    vector<Ice::Long> firsts;
+    vector<string> names = readDirectory(_path);
+    for(vector<string>::const_iterator p = names.begin(); p != names.end(); ++p)
+    {
+        if(p->size() == 24 && p->compare(20, 4, ".log") == 0 &&
+           p->find_first_not_of("0123456789") == 20)
+        {
+            firsts.push_back(IceUtil::Int64(0));
+            istringstream is(p->substr(0, 20));
+            is >> firsts.back();
+        }
+    }
+    sort(firsts.begin(), firsts.end());
+
+    for(vector<Ice::Long>::const_iterator p = firsts.begin(); p != firsts.end(); ++p)
+    {
+        const string path = segmentPath(*p);
+        IceUtilInternal::structstat buf;
+        if(IceUtilInternal::stat(path, &buf) == -1)
+        {
+            throw Ice::FileException(__FILE__, __LINE__, errno, path);
+        }
+
+        Segment segment;
+        segment.first = *p;
+        segment.count = 0;
+        segment.timestamp = 0;
+        segment.size = 0;
+
+        //
+        // Find the records of the segment, a record partially written
+        // when the service stopped is ignored.
+        //
+        EventLogSegmentViewPtr view = new EventLogSegmentView(path, *p, static_cast<size_t>(buf.st_size));
+        while(view->size() - segment.size >= recordHeaderSize)
+        {
+            Ice::Int size;
+            Ice::Long seq;
+            Ice::Long timestamp;
+            readRecordHeader(view->begin() + segment.size, size, seq, timestamp);
+            if(size < static_cast<Ice::Int>(recordHeaderSize - 4) ||
+               view->size() - segment.size - 4 < static_cast<size_t>(size) ||
+               seq != segment.first + segment.count)
+            {
+                break;
+            }
+
+            if(segment.count == 0)
+            {
+                segment.timestamp = timestamp;
+            }
+            _timestamp = timestamp;
+            segment.size += 4 + static_cast<size_t>(size);
+            ++segment.count;
+        }
+
+        if(segment.count == 0 || (!_segments.empty() && segment.first < _segments.back().first +
+                                  _segments.back().count))
+        {
+            IceUtilInternal::remove(path);
+            continue;
+        }
+        _segments.push_back(segment);
+    }
+
+    if(!_segments.empty())
+    {
+        _head = _written = _segments.back().first + _segments.back().count;
+    }
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topic > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+        out << _name << ": event log recovered " << _segments.size() << " segments, next sequence number: "
+            << _head;
+    }
+}
+
+void
+EventLog::write(const deque<Event>& events, Ice::Long seq)
+{
+    Ice::OutputStream os(_instance->communicator(), Ice::currentEncoding);
+    Ice::Long count = 0;
+    for(deque<Event>::const_iterator p = events.begin(); p != events.end(); ++p)
+    {
+        if(_fd == -1)
+        {
+            const string path = segmentPath(seq);
+            _fd = IceUtilInternal::open(path, O_WRONLY|O_CREAT|O_TRUNC|O_BINARY);
+            if(_fd == -1)
+            {
+                throw Ice::FileException(__FILE__, __LINE__, errno, path);
+            }
+
+            Segment segment;
+            segment.first = seq;
+            segment.count = 0;
+            segment.timestamp = p->timestamp;
+            segment.size = 0;
+
+            Lock sync(*this);
+            _segments.push_back(segment);
+        }
+
+        Ice::OutputStream::size_type pos = os.startSize();
+        os.write(seq++);
+        os.write(p->timestamp);
+        os.write(p->data);
+        os.endSize(pos);
+        ++count;
+
+        if(_segments.back().size + os.b.size() >= _segmentSize)
+        {
+            writeSegment(os, count);
+            os.b.clear();
+            count = 0;
+            closeSegment();
+        }
+    }
+
+    if(count > 0)
+    {
+        writeSegment(os, count);
+    }
+}
+
+void
+EventLog::writeSegment(const Ice::OutputStream& os, Ice::Long count)
+{
+    const Ice::Byte* p = os.b.begin();
+    size_t n = os.b.size();
+    while(n > 0)
+    {
+#ifdef _WIN32
+        int r = _write(_fd, p, static_cast<unsigned int>(n));
+#else
+        ssize_t r = ::write(_fd, p, n);
+#endif
+        if(r == -1)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            throw Ice::FileException(__FILE__, __LINE__, errno, segmentPath(_segments.back().first));
+        }
+        p += r;
+        n -= static_cast<size_t>(r);
+    }
+
+    if(_sync)
+    {
+#ifdef _WIN32
+        int r = _commit(_fd);
+#else
+        int r = fsync(_fd);
+#endif
+        if(r == -1)
+        {
+            throw Ice::FileException(__FILE__, __LINE__, errno, segmentPath(_segments.back().first));
+        }
+    }
+
+    Lock sync(*this);
+    _segments.back().size += os.b.size();
+    _segments.back().count += count;
+}
+
+void
+EventLog::closeSegment()
+{
+    if(_fd != -1)
+    {
+        IceUtilInternal::close(_fd);
+        _fd = -1;
+    }
+}
+
+void
+EventLog::removeSegments()
+{
+    //
+    // Called with the mutex locked. The last segment is never removed,
+    // it provides the sequence number of the next event on restart.
+    //
+    Ice::Long size = 0;
+    for(vector<Segment>::const_iterator p = _segments.begin(); p != _segments.end(); ++p)
+    {
+        size += static_cast<Ice::Long>(p->size);
+    }
+
+    const Ice::Long now = IceUtil::Time::now().toMilliSeconds();
+    while(_segments.size() > 1)
+    {
+        if((_retentionSize <= 0 || size <= _retentionSize) &&
+           (_retentionTime <= 0 || _segments[1].timestamp >= now - _retentionTime))
+        {
+            break;
+        }
+
+        TraceLevelsPtr traceLevels = _instance->traceLevels();
+        if(traceLevels->topic > 0)
+        {
+            Ice::Trace out(traceLevels->logger, traceLevels->topicCat);
+            out << _name << ": event log removing events " << _segments[0].first << " to "
+                << _segments[1].first - 1;
+        }
+
+        IceUtilInternal::remove(segmentPath(_segments[0].first));
+        size -= static_cast<Ice::Long>(_segments[0].size);
+        _segments.erase(_segments.begin());
+    }
+}
+
+string
+EventLog::segmentPath(Ice::Long first) const
+{
+    ostringstream os;
+    os << _path << '/' << setfill('0') << setw(20) << first << ".log";
+    return os.str();
+}
+
+bool
+EventLog::map(Ice::Long& next, EventLogSegmentViewPtr& view, size_t& offset)
+{
+    Segment segment;
+    {
+        Lock sync(*this);
+        while(true)
+        {
+            //
+            // The removed events are skipped.
+            //
+            if(!_segments.empty() && next < _segments.front().first)
+            {
+                next = _segments.front().first;
+            }
+
+            if(next >= _written)
+            {
+                return false;
+            }
+
+            vector<Segment>::const_iterator p = _segments.end();
+            while(p != _segments.begin() && (p - 1)->first > next)
+            {
+                --p;
+            }
+
+            //
+            // Skip the events which couldn't be written.
+            //
+            if(p == _segments.begin())
+            {
+                next = _written;
+                continue;
+            }
+            --p;
+            if(next >= p->first + p->count)
+            {
+                next = p + 1 != _segments.end() ? (p + 1)->first : _written;
+                continue;
+            }
+            segment = *p;
+            break;
+        }
+    }
+
+    if(view && view->first() == segment.first && offset == view->size())
+    {
+        //
+        // The segment grew since it was mapped, the next event follows
+        // the records already read.
+        //
+        view = new EventLogSegmentView(segmentPath(segment.first), segment.first, segment.size);
+        return true;
+    }
+
+    view = new EventLogSegmentView(segmentPath(segment.first), segment.first, segment.size);
+    offset = 0;
+    for(Ice::Long seq = segment.first; seq < next; ++seq)
+    {
+        Ice::Int size;
+        Ice::Long s;
+        Ice::Long timestamp;
+        readRecordHeader(view->begin() + offset, size, s, timestamp);
+        offset += 4 + static_cast<size_t>(size);
+    }
+    return true;
+}
+
+bool
+EventLog::readPending(Ice::Long& next, size_t max, EventDataSeq& events)
+{
+    Lock sync(*this);
+    if(next < _written)
+    {
+        return true; // The events have been written in the meantime, read them from the segments.
+    }
+
+    while(events.size() < max && next < _head)
+    {
+        size_t i = static_cast<size_t>(next - _written);
+        events.push_back(i < _writing.size() ? _writing[i].data : _pending[i - _writing.size()].data);
+        ++next;
+    }
+    return next < _head;
+}
@@ -0,0 +1,166 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef ICESTORM_EVENT_LOG_H
+#define ICESTORM_EVENT_LOG_H
+
+#include <IceStorm/IceStormInternal.h>
+#include <IceUtil/Thread.h>
+#include <IceUtil/Monitor.h>
+#include <deque>
+
+namespace IceStorm
+{
+
+class Instance;
+typedef IceUtil::Handle<Instance> InstancePtr;
+
+//
+// A read-only view of the records of an event log segment. The segment
+// file is memory-mapped if possible, otherwise it's read in memory.
+//
+class EventLogSegmentView : public IceUtil::Shared
+{
+public:
+
+    EventLogSegmentView(const std::string&, Ice::Long, size_t);
+    ~EventLogSegmentView();
+
+    Ice::Long first() const { return _first; }
+    const Ice::Byte* begin() const { return _data; }
+    const Ice::Byte* end() const { return _data + _size; }
+    size_t size() const { return _size; }
+
+private:
+
+    const Ice::Long _first;
+    Ice::Byte* _data;
+    size_t _size;
+    bool _mapped;
+    std::vector<Ice::Byte> _buffer;
+};
+typedef IceUtil::Handle<EventLogSegmentView> EventLogSegmentViewPtr;
+
+class EventLog;
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
+//
+// Reads the events of an event log starting at a given sequence number.
+// The events written to the log segments are decoded from the segment
+// views, the events which are not written yet are read from the log
+// memory.
+//
+class EventLogReader : public IceUtil::Shared
+{
+public:
+
+    EventLogReader(const EventLogPtr&, Ice::Long);
+
+    //
+    // Reads up to the given number of events. Returns false once all the
+    // events of the log have been read, in which case the events with a
+    // sequence number greater or equal to next() are the events appended
+    // to the log after this call.
+    //
+    bool read(size_t, EventDataSeq&);
+    Ice::Long next() const;
+
+private:
+
+    const EventLogPtr _log;
+    Ice::Long _next;
+    EventLogSegmentViewPtr _view;
+    size_t _offset;
+};
+typedef IceUtil::Handle<EventLogReader> EventLogReaderPtr;
+
+//
+// The event log of a topic. The published events are appended to the log
+// with a sequence number and a timestamp, and a writer thread writes them
+// in batches to append-only segment files. The oldest segments are removed
+// once the log exceeds its retention size or time.
+//
+class EventLog : public IceUtil::Thread, private IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    EventLog(const InstancePtr&, const std::string&, const std::string&);
+
+    //
+    // Appends the given events to the log and returns the sequence number
+    // of the first event. The sequence number of each event is also added
+    // to its context.
+    //
+    Ice::Long append(const EventDataSeq&);
+
+    //
+    // Returns a reader for the events with a sequence number greater or
+    // equal to the given sequence number.
+    //
+    EventLogReaderPtr createReader(Ice::Long);
+
+    //
+    // Returns the sequence number of the first event appended at or after
+    // the given time (in milliseconds since the epoch).
+    //
+    Ice::Long find(Ice::Long);
+
+    //
+    // Writes the pending events and stops the writer thread. If remove is
+    // true, the log segments are removed.
+    //
+    void destroy(bool);
+
+    virtual void run();
+
+private:
+
+    friend class EventLogReader;
+
+    struct Event
+    {
+        Ice::Long timestamp;
+        EventDataPtr data;
+    };
+
+    struct Segment
+    {
+        Ice::Long first; // The sequence number of the first event.
+        Ice::Long count; // The number of events written to the segment.
+        Ice::Long timestamp; // The timestamp of the first event.
+        size_t size; // The number of bytes written to the segment.
+    };
+
+    void recover();
+    void write(const std::deque<Event>&, Ice::Long);
+    void writeSegment(const Ice::OutputStream&, Ice::Long);
+    void closeSegment();
+    void removeSegments();
+    std::string segmentPath(Ice::Long) const;
+
+    bool map(Ice::Long&, EventLogSegmentViewPtr&, size_t&);
+    bool readPending(Ice::Long&, size_t, EventDataSeq&);
+
+    const InstancePtr _instance;
+    const std::string _name;
+    const std::string _path;
+    const size_t _segmentSize;
+    const Ice::Long _retentionSize;
+    const Ice::Long _retentionTime;
+    const bool _sync;
+
+    std::vector<Segment> _segments;
+    int _fd; // The descriptor of the last segment if it's open for writing.
+
+    Ice::Long _head; // The sequence number of the next appended event.
+    Ice::Long _written; // The sequence number of the next written event.
+    Ice::Long _timestamp; // The timestamp of the last appended event.
+    std::deque<Event> _pending; // The events to write.
+    std::deque<Event> _writing; // The events being written by the writer thread.
+    bool _destroyed;
+};
+
+}
+
+#endif
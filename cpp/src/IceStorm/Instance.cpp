@@ -8,11 +8,15 @@
 #include <IceStorm/NodeI.h>
 #include <IceStorm/InstrumentationI.h>
 #include <IceUtil/Timer.h>
+#include <IceUtil/StringUtil.h>
+#include <IceUtil/FileUtil.h>
 
 #include <Ice/InstrumentationI.h>
 #include <Ice/Communicator.h>
 #include <Ice/Properties.h>
 #include <Ice/TraceUtil.h>
+#include <Ice/LocalException.h>
+#include <iomanip>
 
 using namespace std;
 using namespace IceStorm;
@@ -51,7 +55,9 @@ PersistentInstance::PersistentInstance(
     Instance(instanceName, name, communicator, publishAdapter, topicAdapter, nodeAdapter, nodeProxy),
     _dbLock(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name) + "/icedb.lock"),
     _dbEnv(communicator->getProperties()->getPropertyWithDefault(name + ".LMDB.Path", name), 2,
-           IceDB::getMapSize(communicator->getProperties()->getPropertyAsInt(name + ".LMDB.MapSize")))
+           IceDB::getMapSize(communicator->getProperties()->getPropertyAsInt(name + ".LMDB.MapSize"))),
+    _groupCommit(_dbEnv, IceUtil::Time::milliSeconds(
+                     communicator->getProperties()->getPropertyAsInt(name + ".LMDB.GroupCommitWindow")))
 {
     try
     {
@@ -59,12 +65,35 @@ PersistentInstance::PersistentInstance(
         dbContext.encoding.minor = 1;
         dbContext.encoding.major = 1;
 
+        const Ice::PropertiesPtr properties = communicator->getProperties();
+        const int maxMapSize = properties->getPropertyAsInt(name + ".LMDB.MaxMapSize");
+        _dbEnv.setMapGrowth(properties->getPropertyAsIntWithDefault(name + ".LMDB.MapGrowthThreshold", 90),
+                            static_cast<size_t>(max(maxMapSize, 0)) * 1024 * 1024);
+
         IceDB::ReadWriteTxn txn(_dbEnv);
 
         _lluMap = LLUMap(txn, "llu", dbContext, MDB_CREATE);
         _subscriberMap = SubscriberMap(txn, "subscribers", dbContext, MDB_CREATE, compareSubscriberRecordKey);
 
         txn.commit();
+
+        //
+        // The events of the topics listed in <service>.EventLog.Topics, or
+        // of all the topics if it's set to *, are kept in an event log.
+        //
+        vector<string> topics;
+        IceUtilInternal::splitString(properties->getProperty(name + ".EventLog.Topics"), ", \t\r\n", topics);
+        if(!topics.empty())
+        {
+            _eventLogTopics.insert(topics.begin(), topics.end());
+            _eventLogPath = properties->getPropertyWithDefault(name + ".EventLog.Path",
+                                                               properties->getPropertyWithDefault(name + ".LMDB.Path",
+                                                                                                  name) + "/events");
+            if(IceUtilInternal::mkdir(_eventLogPath, 0777) == -1 && errno != EEXIST)
+            {
+                throw Ice::FileException(__FILE__, __LINE__, errno, _eventLogPath);
+            }
+        }
     }
     catch(...)
     {
@@ -75,9 +104,38 @@ PersistentInstance::PersistentInstance(
     }
 }
 
+string
+PersistentInstance::eventLogPath(const string& topic) const
+{
+    if(_eventLogTopics.find(topic) == _eventLogTopics.end() && _eventLogTopics.find("*") == _eventLogTopics.end())
+    {
+        return string();
+    }
+
+    //
+    // Escape the characters of the topic name which might not be valid
+    // in a directory name.
+    //
+    ostringstream os;
+    os << _eventLogPath << '/';
+    for(string::const_iterator p = topic.begin(); p != topic.end(); ++p)
+    {
+        if(isalnum(static_cast<unsigned char>(*p)) || *p == '-' || *p == '_')
+        {
+            os << *p;
+        }
+        else
+        {
+            os << '%' << hex << setw(2) << setfill('0') << static_cast<int>(static_cast<unsigned char>(*p)) << dec;
+        }
+    }
+    return os.str();
+}
+
 void
 PersistentInstance::destroy()
 {
+    _groupCommit.destroy();
     _dbEnv.close();
     dbContext.communicator = 0;
 
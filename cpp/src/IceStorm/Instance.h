@@ -12,6 +12,7 @@
 #include <IceStorm/Election.h>
 #include <IceStorm/Instrumentation.h>
 #include <IceStorm/Util.h>
+#include <set>
 
 namespace IceUtil
 {
@@ -132,17 +133,24 @@ public:
                        const IceStormElection::NodePrx& = 0);
 
     const IceDB::Env& dbEnv() const { return _dbEnv; }
+    IceDB::GroupCommit& groupCommit() { return _groupCommit; }
     LLUMap lluMap() const { return _lluMap; }
     SubscriberMap subscriberMap() const { return _subscriberMap; }
 
+    // Returns the event log directory of the topic, or an empty string if the topic has no event log.
+    std::string eventLogPath(const std::string&) const;
+
     virtual void destroy();
 
 private:
 
     IceUtilInternal::FileLock _dbLock;
     IceDB::Env _dbEnv;
+    IceDB::GroupCommit _groupCommit;
     LLUMap _lluMap;
     SubscriberMap _subscriberMap;
+    std::string _eventLogPath;
+    std::set<std::string> _eventLogTopics;
 };
 typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 
@@ -12,7 +12,8 @@ IceStormService_targetdir       := $(libdir)
 IceStormService_dependencies    := IceGrid Glacier2 IceBox IceDB
 IceStormService_cppflags        := $(if $(lmdb_includedir),-I$(lmdb_includedir))
 IceStormService_devinstall      := no
-IceStormService_sources         := $(addprefix $(currentdir)/,Instance.cpp \
+IceStormService_sources         := $(addprefix $(currentdir)/,EventLog.cpp \
+                                                             Instance.cpp \
                                                              InstrumentationI.cpp \
                                                              NodeI.cpp \
                                                              Observers.cpp \
@@ -10,10 +10,77 @@ using namespace std;
 using namespace IceStorm;
 using namespace IceStormElection;
 
+namespace
+{
+
+struct PendingInit
+{
+    int id;
+    ReplicaObserverPrx observer;
+    Ice::AsyncResultPtr result;
+    bool resync; // True if the observer is resynced with the updates it missed.
+};
+
+}
+
+class Observers::UpdateCallback : public IceUtil::Shared
+{
+public:
+
+    UpdateCallback(const ObserversPtr& observers, const ObserverInfoPtr& info, Ice::Long first, Ice::Long last) :
+        _observers(observers), _info(info), _first(first), _last(last)
+    {
+    }
+
+    void
+    response()
+    {
+        _observers->acknowledged(_info, _first, _last);
+    }
+
+    void
+    exception(const Ice::Exception& ex)
+    {
+        if(dynamic_cast<const Ice::OperationNotExistException*>(&ex))
+        {
+            _observers->unsupported(_info, _first);
+        }
+        else
+        {
+            _observers->failed(_info, "update", ex);
+        }
+    }
+
+private:
+
+    const ObserversPtr _observers;
+    const ObserverInfoPtr _info;
+    const Ice::Long _first;
+    const Ice::Long _last;
+};
+
+Observers::ObserverInfo::ObserverInfo(int i, const ReplicaObserverPrx& o, Ice::Long last) :
+    id(i), observer(o), sent(last), acknowledged(last), outstanding(0), legacy(false)
+{
+}
+
 Observers::Observers(const InstancePtr& instance) :
     _traceLevels(instance->traceLevels()),
-    _majority(0)
+    _maxBatchSize(static_cast<size_t>(max(1, instance->communicator()->getProperties()->getPropertyAsIntWithDefault(
+                                              instance->serviceName() + ".Replication.MaxBatchSize", 100)))),
+    _maxOutstandingBatches(max(1, instance->communicator()->getProperties()->getPropertyAsIntWithDefault(
+                                   instance->serviceName() + ".Replication.MaxOutstandingBatches", 4))),
+    // The log is only useful if this replica is part of a replica group.
+    _logSize(instance->nodeAdapter() ?
+             static_cast<size_t>(max(0, instance->communicator()->getProperties()->getPropertyAsIntWithDefault(
+                                         instance->serviceName() + ".Replication.LogSize", 10000))) : 0),
+    _majority(0),
+    _last(0),
+    _logValid(false)
 {
+    _base.generation = 0;
+    _base.iteration = 0;
+    _logBase = _base;
 }
 
 void
@@ -25,36 +92,53 @@ Observers::setMajority(unsigned int majority)
 bool
 Observers::check()
 {
-    Lock sync(*this);
-    if(_observers.size() >= _majority)
+    //
+    // Ping the observers which aren't waiting for the acknowledgement of
+    // an update, the acknowledgement of the update checks the others.
+    //
+    vector<pair<ObserverInfoPtr, Ice::AsyncResultPtr> > pings;
     {
-        vector<ObserverInfo>::iterator p = _observers.begin();
-        while(p != _observers.end())
+        Lock sync(*this);
+        if(_observers.size() >= _majority)
+        {
+            for(vector<ObserverInfoPtr>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
+            {
+                if((*p)->outstanding == 0)
+                {
+                    pings.push_back(make_pair(*p, Ice::AsyncResultPtr()));
+                }
+            }
+        }
+    }
+
+    for(vector<pair<ObserverInfoPtr, Ice::AsyncResultPtr> >::iterator p = pings.begin(); p != pings.end(); ++p)
+    {
+        try
+        {
+            p->second = p->first->observer->begin_ice_ping();
+        }
+        catch(const Ice::Exception& ex)
+        {
+            failed(p->first, "ice_ping", ex);
+        }
+    }
+
+    for(vector<pair<ObserverInfoPtr, Ice::AsyncResultPtr> >::const_iterator p = pings.begin(); p != pings.end(); ++p)
+    {
+        if(p->second)
         {
             try
             {
-                p->observer->ice_ping();
+                p->first->observer->end_ice_ping(p->second);
             }
             catch(const Ice::Exception& ex)
             {
-                if(_traceLevels->replication > 0)
-                {
-                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                    out << "ice_ping failed: " << ex;
-                }
-                int id = p->id;
-                p = _observers.erase(p);
-
-                // COMPILERFIX: Just using following causes double unlock with C++Builder 2007
-                //IceUtil::Mutex::Lock sync(_reapedMutex);
-                _reapedMutex.lock();
-                _reaped.push_back(id);
-                _reapedMutex.unlock();
-                continue;
+                failed(p->first, "ice_ping", ex);
             }
-            ++p;
         }
     }
+
+    Lock sync(*this);
     return _majority == 0 || _observers.size() >= _majority;
 }
 
@@ -63,6 +147,8 @@ Observers::clear()
 {
     Lock sync(*this);
     _observers.clear();
+    trim();
+    notifyAll();
 }
 
 void
@@ -82,19 +168,49 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
 
     Lock sync(*this);
     _observers.clear();
+    trim();
 
-    vector<ObserverInfo> observers;
-
+    //
+    // Get the updates missed by each slave before logging the log update
+    // of the new generation.
+    //
+    vector<pair<bool, ReplicaUpdateSeq> > updates;
     for(set<GroupNodeInfo>::const_iterator p = slaves.begin(); p != slaves.end(); ++p)
+    {
+        updates.push_back(make_pair(false, ReplicaUpdateSeq()));
+        updates.back().first = findUpdates(p->llu, updates.back().second);
+    }
+    appendGeneration(llu);
+    _base = llu;
+
+    vector<PendingInit> pending;
+
+    vector<pair<bool, ReplicaUpdateSeq> >::const_iterator q = updates.begin();
+    for(set<GroupNodeInfo>::const_iterator p = slaves.begin(); p != slaves.end(); ++p, ++q)
     {
         try
         {
             assert(p->observer);
 
-            ReplicaObserverPrx observer = ReplicaObserverPrx::uncheckedCast(p->observer);
-
-            Ice::AsyncResultPtr result = observer->begin_init(llu, content);
-            observers.push_back(ObserverInfo(p->id, observer, result));
+            PendingInit info;
+            info.id = p->id;
+            info.observer = ReplicaObserverPrx::uncheckedCast(p->observer);
+            info.resync = q->first;
+            if(info.resync)
+            {
+                if(_traceLevels->replication > 0)
+                {
+                    Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                    out << "resync " << p->id << " from llu " << p->llu.generation << "/" << p->llu.iteration
+                        << " with " << q->second.size() << " updates";
+                }
+                info.result = info.observer->begin_resync(p->llu, llu, q->second);
+            }
+            else
+            {
+                info.result = info.observer->begin_init(llu, content);
+            }
+            pending.push_back(info);
         }
         catch(const Ice::Exception& ex)
         {
@@ -107,12 +223,41 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
         }
     }
 
-    for(vector<ObserverInfo>::iterator p = observers.begin(); p != observers.end(); ++p)
+    vector<ObserverInfoPtr> observers;
+    for(vector<PendingInit>::const_iterator p = pending.begin(); p != pending.end(); ++p)
     {
+        bool legacy = false;
         try
         {
-            p->observer->end_init(p->result);
-            p->result = 0;
+            if(p->resync)
+            {
+                try
+                {
+                    p->observer->end_resync(p->result);
+                }
+                catch(const ObserverInconsistencyException& ex)
+                {
+                    if(_traceLevels->replication > 0)
+                    {
+                        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+                        out << "resync on " << p->id << " failed: " << ex.reason;
+                    }
+                    p->observer->init(llu, content);
+                }
+                catch(const Ice::OperationNotExistException&)
+                {
+                    //
+                    // The observer is a replica of a previous version, it
+                    // doesn't support resync or update either.
+                    //
+                    p->observer->init(llu, content);
+                    legacy = true;
+                }
+            }
+            else
+            {
+                p->observer->end_init(p->result);
+            }
         }
         catch(const Ice::Exception& ex)
         {
@@ -123,88 +268,432 @@ Observers::init(const set<GroupNodeInfo>& slaves, const LogUpdate& llu, const To
             }
             throw;
         }
+        observers.push_back(new ObserverInfo(p->id, p->observer, _last));
+        observers.back()->legacy = legacy;
     }
 
     _observers.swap(observers);
 }
 
-void
+Ice::Long
 Observers::createTopic(const LogUpdate& llu, const string& name)
+{
+    ReplicaUpdate update;
+    update.llu = llu;
+    update.kind = ReplicaUpdateCreateTopic;
+    update.topic = name;
+    return queue(update);
+}
+
+Ice::Long
+Observers::destroyTopic(const LogUpdate& llu, const string& id)
+{
+    ReplicaUpdate update;
+    update.llu = llu;
+    update.kind = ReplicaUpdateDestroyTopic;
+    update.topic = id;
+    return queue(update);
+}
+
+Ice::Long
+Observers::addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec)
+{
+    ReplicaUpdate update;
+    update.llu = llu;
+    update.kind = ReplicaUpdateAddSubscriber;
+    update.topic = name;
+    update.record = rec;
+    return queue(update);
+}
+
+Ice::Long
+Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
+{
+    ReplicaUpdate update;
+    update.llu = llu;
+    update.kind = ReplicaUpdateRemoveSubscriber;
+    update.topic = name;
+    update.subscribers = id;
+    return queue(update);
+}
+
+void
+Observers::wait(Ice::Long update)
 {
     Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    while(true)
     {
-        p->result = p->observer->begin_createTopic(llu, name);
+        vector<ObserverInfoPtr>::const_iterator p = _observers.begin();
+        while(p != _observers.end() && (*p)->acknowledged >= update)
+        {
+            ++p;
+        }
+        if(p == _observers.end())
+        {
+            break;
+        }
+        IceUtil::Monitor<IceUtil::Mutex>::wait();
+    }
+
+    // If we now no longer have the majority of observers we raise.
+    if(_observers.size() < _majority)
+    {
+        // TODO: Trace here?
+        //Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+        //out << op;
+        throw Ice::UnknownException(__FILE__, __LINE__);
     }
-    wait("createTopic");
 }
 
 void
-Observers::destroyTopic(const LogUpdate& llu, const string& id)
+Observers::log(const ReplicaUpdate& update)
+{
+    Lock sync(*this);
+    append(update);
+}
+
+void
+Observers::resetLog(const LogUpdate& llu)
 {
     Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    _logValid = true;
+    _logBase = llu;
+    _log.clear();
+    _generations.clear();
+}
+
+void
+Observers::logGeneration(const LogUpdate& llu)
+{
+    Lock sync(*this);
+    appendGeneration(llu);
+}
+
+bool
+Observers::getUpdates(const LogUpdate& from, const LogUpdate& llu, ReplicaUpdateSeq& updates) const
+{
+    Lock sync(*this);
+    if(!_logValid)
+    {
+        return false;
+    }
+
+    if((_log.empty() ? _logBase : _log.back().llu) != lastUpdate(llu))
     {
-        p->result = p->observer->begin_destroyTopic(llu, id);
+        return false;
     }
-    wait("destroyTopic");
+    return findUpdates(from, updates);
 }
 
-void
-Observers::addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec)
+Ice::Long
+Observers::queue(const ReplicaUpdate& update)
 {
     Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+
+    append(update);
+
+    _updates.push_back(update);
+    ++_last;
+
+    //
+    // The update is sent right away to the observers which can accept
+    // another batch, otherwise it's sent with the next batch once a batch
+    // is acknowledged.
+    //
+    for(vector<ObserverInfoPtr>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
-        p->result = p->observer->begin_addSubscriber(llu, name, rec);
+        send(*p);
     }
-    wait("addSubscriber");
+    trim();
+    return _last;
 }
 
 void
-Observers::removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id)
+Observers::send(const ObserverInfoPtr& info)
+{
+    //
+    // Called with the mutex locked.
+    //
+    if(info->legacy)
+    {
+        sendLegacy(info);
+        return;
+    }
+
+    while(info->outstanding < _maxOutstandingBatches && info->sent < _last)
+    {
+        const Ice::Long front = _last - static_cast<Ice::Long>(_updates.size()) + 1;
+        const Ice::Long first = info->sent + 1;
+        const Ice::Long last = min(_last, first + static_cast<Ice::Long>(_maxBatchSize) - 1);
+        assert(first >= front);
+
+        ReplicaUpdateSeq updates(_updates.begin() + static_cast<ptrdiff_t>(first - front),
+                                 _updates.begin() + static_cast<ptrdiff_t>(last - front + 1));
+        const LogUpdate& prev = first == front ? _base : _updates[static_cast<size_t>(first - front - 1)].llu;
+
+        info->observer->begin_update(prev, updates,
+                                     newCallback_ReplicaObserver_update(new UpdateCallback(this, info, first, last),
+                                                                        &UpdateCallback::response,
+                                                                        &UpdateCallback::exception));
+        info->sent = last;
+        ++info->outstanding;
+    }
+}
+
+void
+Observers::sendLegacy(const ObserverInfoPtr& info)
+{
+    //
+    // Called with the mutex locked. The updates are sent one at a time
+    // with the operation of each update to an observer which doesn't
+    // support update, like the replicas of previous versions expect.
+    //
+    if(info->outstanding > 0 || info->sent >= _last)
+    {
+        return;
+    }
+
+    const Ice::Long front = _last - static_cast<Ice::Long>(_updates.size()) + 1;
+    const Ice::Long n = info->sent + 1;
+    assert(n >= front);
+    const ReplicaUpdate& update = _updates[static_cast<size_t>(n - front)];
+
+    IceUtil::Handle<UpdateCallback> cb = new UpdateCallback(this, info, n, n);
+    switch(update.kind)
+    {
+    case ReplicaUpdateCreateTopic:
+        info->observer->begin_createTopic(update.llu, update.topic,
+                                          newCallback_ReplicaObserver_createTopic(cb, &UpdateCallback::response,
+                                                                                  &UpdateCallback::exception));
+        break;
+    case ReplicaUpdateDestroyTopic:
+        info->observer->begin_destroyTopic(update.llu, update.topic,
+                                           newCallback_ReplicaObserver_destroyTopic(cb, &UpdateCallback::response,
+                                                                                    &UpdateCallback::exception));
+        break;
+    case ReplicaUpdateAddSubscriber:
+        info->observer->begin_addSubscriber(update.llu, update.topic, update.record,
+                                            newCallback_ReplicaObserver_addSubscriber(cb, &UpdateCallback::response,
+                                                                                      &UpdateCallback::exception));
+        break;
+    case ReplicaUpdateRemoveSubscriber:
+        info->observer->begin_removeSubscriber(update.llu, update.topic, update.subscribers,
+                                               newCallback_ReplicaObserver_removeSubscriber(
+                                                   cb, &UpdateCallback::response, &UpdateCallback::exception));
+        break;
+    }
+    info->sent = n;
+    ++info->outstanding;
+}
+
+void
+Observers::unsupported(const ObserverInfoPtr& info, Ice::Long first)
 {
     Lock sync(*this);
-    for(vector<ObserverInfo>::iterator p = _observers.begin(); p != _observers.end(); ++p)
+    if(find(info) == _observers.end())
     {
-        p->result = p->observer->begin_removeSubscriber(llu, name, id);
+        return; // The observer was removed.
     }
-    wait("removeSubscriber");
+
+    if(!info->legacy && _traceLevels->replication > 0)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+        out << "replica " << info->id << " doesn't support update, sending the updates one at a time";
+    }
+
+    //
+    // The batches already sent to the observer all fail, the updates are
+    // sent again one at a time once they all failed.
+    //
+    info->legacy = true;
+    info->sent = min(info->sent, first - 1);
+    --info->outstanding;
+    send(info);
 }
 
 void
-Observers::wait(const string& op)
+Observers::acknowledged(const ObserverInfoPtr& info, Ice::Long first, Ice::Long last)
 {
-    vector<ObserverInfo>::iterator p = _observers.begin();
-    while(p != _observers.end())
+    Lock sync(*this);
+    if(find(info) == _observers.end())
     {
-        try
+        return; // The observer was removed.
+    }
+
+    --info->outstanding;
+    if(first == info->acknowledged + 1)
+    {
+        info->acknowledged = last;
+        map<Ice::Long, Ice::Long>::iterator p = info->batches.begin();
+        while(p != info->batches.end() && p->first == info->acknowledged + 1)
         {
-            p->result->waitForCompleted();
-            p->result->throwLocalException();
+            info->acknowledged = p->second;
+            info->batches.erase(p++);
         }
-        catch(const Ice::Exception& ex)
-        {
-            if(_traceLevels->replication > 0)
-            {
-                Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-                out << op << ": " << ex;
-            }
-            int id = p->id;
-            p = _observers.erase(p);
+    }
+    else
+    {
+        info->batches.insert(make_pair(first, last));
+    }
 
-            IceUtil::Mutex::Lock sync(_reapedMutex);
-            _reaped.push_back(id);
-            continue;
-        }
+    send(info);
+    trim();
+    notifyAll();
+}
+
+void
+Observers::failed(const ObserverInfoPtr& info, const string& op, const Ice::Exception& ex)
+{
+    Lock sync(*this);
+    vector<ObserverInfoPtr>::iterator p = find(info);
+    if(p == _observers.end())
+    {
+        return; // The observer was already removed.
+    }
+
+    if(_traceLevels->replication > 0)
+    {
+        Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
+        out << op << " failed: " << ex;
+    }
+    _observers.erase(p);
+
+    {
+        IceUtil::Mutex::Lock lock(_reapedMutex);
+        _reaped.push_back(info->id);
+    }
+
+    trim();
+    notifyAll();
+}
+
+vector<Observers::ObserverInfoPtr>::iterator
+Observers::find(const ObserverInfoPtr& info)
+{
+    //
+    // Called with the mutex locked.
+    //
+    vector<ObserverInfoPtr>::iterator p = _observers.begin();
+    while(p != _observers.end() && p->get() != info.get())
+    {
         ++p;
     }
-    // If we now no longer have the majority of observers we raise.
-    if(_observers.size() < _majority)
+    return p;
+}
+
+void
+Observers::trim()
+{
+    //
+    // Called with the mutex locked. Remove the updates acknowledged by
+    // all the observers.
+    //
+    Ice::Long acknowledged = _last;
+    for(vector<ObserverInfoPtr>::const_iterator p = _observers.begin(); p != _observers.end(); ++p)
     {
-        // TODO: Trace here?
-        //Ice::Trace out(_traceLevels->logger, _traceLevels->replicationCat);
-        //out << op;
-        throw Ice::UnknownException(__FILE__, __LINE__);
+        acknowledged = min(acknowledged, (*p)->acknowledged);
+    }
+
+    Ice::Long front = _last - static_cast<Ice::Long>(_updates.size()) + 1;
+    while(!_updates.empty() && front <= acknowledged)
+    {
+        _base = _updates.front().llu;
+        _updates.pop_front();
+        ++front;
+    }
+}
+
+void
+Observers::append(const ReplicaUpdate& update)
+{
+    //
+    // Called with the mutex locked. The log is only kept once it's reset
+    // with a log update known by the other replicas.
+    //
+    if(!_logValid)
+    {
+        return;
+    }
+
+    _log.push_back(update);
+    while(_log.size() > _logSize)
+    {
+        _logBase = _log.front().llu;
+        _log.pop_front();
+    }
+
+    // Forget the generations which started before the start of the log.
+    while(!_generations.empty() && _generations.begin()->first < _logBase)
+    {
+        _generations.erase(_generations.begin());
+    }
+}
+
+void
+Observers::appendGeneration(const LogUpdate& llu)
+{
+    //
+    // Called with the mutex locked. A new generation doesn't change the
+    // state of the replica, the llu of the generation is equivalent to
+    // the llu of the last update in the log. The log is reset if it
+    // isn't valid yet.
+    //
+    if(!_logValid)
+    {
+        _logValid = true;
+        _logBase = llu;
+        _log.clear();
+        _generations.clear();
+        return;
+    }
+    LogUpdate last = _log.empty() ? _logBase : _log.back().llu;
+    if(llu != last)
+    {
+        _generations[llu] = last;
+    }
+}
+
+LogUpdate
+Observers::lastUpdate(const LogUpdate& llu) const
+{
+    //
+    // Called with the mutex locked. The llu of a generation is replaced
+    // by the llu preceding it, there are no updates in between.
+    //
+    LogUpdate last = llu;
+    map<LogUpdate, LogUpdate>::const_iterator p;
+    while((p = _generations.find(last)) != _generations.end())
+    {
+        last = p->second;
+    }
+    return last;
+}
+
+bool
+Observers::findUpdates(const LogUpdate& from, ReplicaUpdateSeq& updates) const
+{
+    //
+    // Called with the mutex locked.
+    //
+    if(!_logValid)
+    {
+        return false;
+    }
+
+    LogUpdate llu = lastUpdate(from);
+    deque<ReplicaUpdate>::const_iterator p = _log.begin();
+    if(llu != _logBase)
+    {
+        while(p != _log.end() && p->llu != llu)
+        {
+            ++p;
+        }
+        if(p == _log.end())
+        {
+            return false;
+        }
+        ++p;
     }
+    updates.assign(p, _log.end());
+    return true;
 }
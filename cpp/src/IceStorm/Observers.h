@@ -9,6 +9,7 @@
 #include <IceUtil/IceUtil.h>
 #include <IceStorm/Election.h>
 #include <IceStorm/Replica.h>
+#include <deque>
 
 #ifdef __SUNPRO_CC
 #  pragma error_messages(off,hidef)
@@ -25,7 +26,15 @@ typedef IceUtil::Handle<TraceLevels> TraceLevelsPtr;
 namespace IceStormElection
 {
 
-class Observers : public IceUtil::Shared, public IceUtil::Mutex
+//
+// The observers of the master. The updates are queued and sent to each
+// observer in batches, several batches can be waiting for their
+// acknowledgement. The updates applied by this replica are also kept in
+// a log, along with the llu of the new generations, to resync the
+// replicas with the updates they missed rather than with the full
+// content.
+//
+class Observers : public IceUtil::Shared, private IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
     Observers(const IceStorm::InstancePtr&);
@@ -37,27 +46,88 @@ public:
     void clear();
 
     void init(const std::set<IceStormElection::GroupNodeInfo>&, const LogUpdate&, const TopicContentSeq&);
-    void createTopic(const LogUpdate&, const std::string&);
-    void destroyTopic(const LogUpdate&, const std::string&);
-    void addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
-    void removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+
+    //
+    // Queue an update for the observers and return its number, wait()
+    // waits for the acknowledgement of the update by the observers.
+    //
+    Ice::Long createTopic(const LogUpdate&, const std::string&);
+    Ice::Long destroyTopic(const LogUpdate&, const std::string&);
+    Ice::Long addSubscriber(const LogUpdate&, const std::string&, const IceStorm::SubscriberRecord&);
+    Ice::Long removeSubscriber(const LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+
+    //
+    // Wait for the observers to acknowledge the given update, raises if
+    // there are no longer enough observers for replication.
+    //
+    void wait(Ice::Long);
+
     void getReapedSlaves(std::vector<int>&);
 
+    // Log an update applied by this replica.
+    void log(const ReplicaUpdate&);
+    void resetLog(const LogUpdate&);
+
+    // Log the llu of a new generation, the state of this replica is unchanged.
+    void logGeneration(const LogUpdate&);
+
+    //
+    // Get the updates applied since the given log update, returns false
+    // if they are no longer in the log or if the log doesn't end with the
+    // given last log update.
+    //
+    bool getUpdates(const LogUpdate&, const LogUpdate&, ReplicaUpdateSeq&) const;
+
 private:
 
-    void wait(const std::string&);
+    class ObserverInfo : public IceUtil::Shared
+    {
+    public:
+
+        ObserverInfo(int, const ReplicaObserverPrx&, Ice::Long);
+
+        const int id;
+        const ReplicaObserverPrx observer;
+        Ice::Long sent; // The last update sent to the observer.
+        Ice::Long acknowledged; // The last update acknowledged along with all the previous updates.
+        std::map<Ice::Long, Ice::Long> batches; // The batches acknowledged out of order.
+        int outstanding; // The number of batches waiting for their acknowledgement.
+        bool legacy; // True if the observer doesn't support update, the updates are sent one at a time.
+    };
+    typedef IceUtil::Handle<ObserverInfo> ObserverInfoPtr;
+
+    class UpdateCallback;
+    friend class UpdateCallback;
+
+    Ice::Long queue(const ReplicaUpdate&);
+    void send(const ObserverInfoPtr&);
+    void sendLegacy(const ObserverInfoPtr&);
+    void acknowledged(const ObserverInfoPtr&, Ice::Long, Ice::Long);
+    void unsupported(const ObserverInfoPtr&, Ice::Long);
+    void failed(const ObserverInfoPtr&, const std::string&, const Ice::Exception&);
+    std::vector<ObserverInfoPtr>::iterator find(const ObserverInfoPtr&);
+    void trim();
+    void append(const ReplicaUpdate&);
+    void appendGeneration(const LogUpdate&);
+    LogUpdate lastUpdate(const LogUpdate&) const;
+    bool findUpdates(const LogUpdate&, ReplicaUpdateSeq&) const;
 
     const IceStorm::TraceLevelsPtr _traceLevels;
+    const size_t _maxBatchSize;
+    const int _maxOutstandingBatches;
+    const size_t _logSize;
     unsigned int _majority;
-    struct ObserverInfo
-    {
-        ObserverInfo(int i, const ReplicaObserverPrx& o, const Ice::AsyncResultPtr& r = 0) :
-            id(i), observer(o), result (r) {}
-        int id;
-        ReplicaObserverPrx observer;
-        ::Ice::AsyncResultPtr result;
-    };
-    std::vector<ObserverInfo> _observers;
+    std::vector<ObserverInfoPtr> _observers;
+
+    std::deque<ReplicaUpdate> _updates; // The updates not acknowledged by all the observers.
+    Ice::Long _last; // The number of the last queued update.
+    LogUpdate _base; // The log update of the update preceding the first update in _updates.
+
+    bool _logValid; // True once the log is reset with a log update shared with the other replicas.
+    LogUpdate _logBase; // The log update preceding the first update in _log.
+    std::deque<ReplicaUpdate> _log;
+    std::map<LogUpdate, LogUpdate> _generations; // The llu of each generation in the log and the llu preceding it.
+
     IceUtil::Mutex _reapedMutex;
     std::vector<int> _reaped;
 };
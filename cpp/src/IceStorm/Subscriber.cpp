@@ -3,6 +3,7 @@
 //
 
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/EventLog.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/NodeI.h>
@@ -21,6 +22,12 @@ using namespace IceStormElection;
 namespace
 {
 
+//
+// The number of events read at once from the event log when replaying
+// events.
+//
+const size_t replayBatchSize = 100;
+
 class PerSubscriberPublisherI : public Ice::BlobjectArray
 {
 public:
@@ -44,21 +51,8 @@ public:
         // Use cached reads.
         CachedReadHelper unlock(_instance->node(), __FILE__, __LINE__);
 
-        EventDataPtr event = new EventData(
-            current.operation,
-            current.mode,
-            Ice::ByteSeq(),
-            current.ctx);
-
-        //
-        // COMPILERBUG: gcc 4.0.1 doesn't like this.
-        //
-        //event->data.swap(Ice::ByteSeq(inParams.first, inParams.second));
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event->data.swap(data);
-
         EventDataSeq e;
-        e.push_back(event);
+        e.push_back(new PublishedEvent(inParams, current));
         _subscriber->queue(false, e);
         return true;
     }
@@ -70,6 +64,13 @@ private:
 };
 typedef IceUtil::Handle<PerSubscriberPublisherI> PerSubscriberPublisherIPtr;
 
+int
+eventCost(const Ice::Context& context)
+{
+    Ice::Context::const_iterator p = context.find("cost");
+    return p != context.end() ? atoi(p->second.c_str()) : 0;
+}
+
 IceStorm::Instrumentation::SubscriberState
 toSubscriberState(Subscriber::SubscriberState s)
 {
@@ -184,6 +185,26 @@ private:
     const SubscriberBatchPtr _subscriber;
 };
 
+class ReplayTimerTask : public IceUtil::TimerTask
+{
+public:
+
+    ReplayTimerTask(const SubscriberPtr& subscriber) :
+        _subscriber(subscriber)
+    {
+    }
+
+    virtual void
+    runTimerTask()
+    {
+        _subscriber->replay();
+    }
+
+private:
+
+    const SubscriberPtr _subscriber;
+};
+
 }
 
 SubscriberBatch::SubscriberBatch(
@@ -222,9 +243,14 @@ SubscriberBatch::doFlush()
         return;
     }
 
+    if(!hasEvents())
+    {
+        --_outstanding;
+        return;
+    }
+
     EventDataSeq v;
     v.swap(_events);
-    assert(!v.empty());
 
     if(_observer)
     {
@@ -260,7 +286,11 @@ SubscriberBatch::doFlush()
         return;
     }
 
-    if(_events.empty() && _outstanding == 0 && _shutdown)
+    if(_outstanding == 0 && _replay)
+    {
+        flush();
+    }
+    else if(_events.empty() && _outstanding == 0 && _shutdown)
     {
         _lock.notify();
     }
@@ -289,11 +319,11 @@ SubscriberBatch::sent(bool sentSynchronously)
         _observer->delivered(_outstandingCount);
     }
 
-    if(_events.empty() && _outstanding == 0 && _shutdown)
+    if(_events.empty() && _outstanding == 0 && _shutdown && !_replay)
     {
         _lock.notify();
     }
-    else if(!_events.empty())
+    else if(!_events.empty() || _replay)
     {
         flush();
     }
@@ -320,7 +350,7 @@ SubscriberOneway::flush()
     //
     // If the subscriber isn't online we're done.
     //
-    if(_state != SubscriberStateOnline || _events.empty())
+    if(_state != SubscriberStateOnline || !hasEvents())
     {
         return;
     }
@@ -361,9 +391,21 @@ SubscriberOneway::flush()
         }
     }
 
-    if(_events.empty() && _outstanding == 0 && _shutdown)
+    if(_events.empty() && _outstanding == 0)
     {
-        _lock.notify();
+        if(_replay)
+        {
+            //
+            // All the replayed events were sent synchronously, send the
+            // next ones from the timer thread rather than holding the
+            // subscriber lock until the replay completes.
+            //
+            scheduleReplay();
+        }
+        else if(_shutdown)
+        {
+            _lock.notify();
+        }
     }
 }
 
@@ -389,7 +431,7 @@ SubscriberOneway::sent(bool sentSynchronously)
     {
         _lock.notify();
     }
-    else if(_outstanding <= 0 && !_events.empty())
+    else if(_outstanding <= 0 && (!_events.empty() || _replay))
     {
         flush();
     }
@@ -415,7 +457,7 @@ SubscriberTwoway::flush()
     //
     // If the subscriber isn't online we're done.
     //
-    if(_state != SubscriberStateOnline || _events.empty())
+    if(_state != SubscriberStateOnline || !hasEvents())
     {
         return;
     }
@@ -477,12 +519,8 @@ SubscriberLink::flush()
     {
         if(_rec.cost != 0)
         {
-            int cost = 0;
-            Ice::Context::const_iterator q = (*p)->context.find("cost");
-            if(q != (*p)->context.end())
-            {
-                cost = atoi(q->second.c_str());
-            }
+            const PublishedEvent* event = dynamic_cast<const PublishedEvent*>(p->get());
+            int cost = event ? event->cost() : eventCost((*p)->context);
             if(cost > _rec.cost)
             {
                 p = v.erase(p);
@@ -502,7 +540,32 @@ SubscriberLink::flush()
                 _outstandingCount = static_cast<Ice::Int>(v.size());
                 _observer->outstanding(_outstandingCount);
             }
-            _obj->begin_forward(v, Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
+
+            //
+            // Marshal the forward request parameters with the shared
+            // encoding of the published events rather than marshaling
+            // the events again for each link.
+            //
+            Ice::CommunicatorPtr communicator = _instance->communicator();
+            Ice::OutputStream os(communicator, _obj->ice_getEncodingVersion());
+            os.startEncapsulation();
+            os.writeSize(static_cast<Ice::Int>(v.size()));
+            for(p = v.begin(); p != v.end(); ++p)
+            {
+                const PublishedEvent* event = dynamic_cast<const PublishedEvent*>(p->get());
+                if(event)
+                {
+                    os.writeBlob(event->encoded(communicator));
+                }
+                else
+                {
+                    os.write(*p);
+                }
+            }
+            os.endEncapsulation();
+
+            _obj->begin_ice_invoke("forward", Ice::Normal, os.finished(),
+                                   Ice::newCallback(static_cast<Subscriber*>(this), &Subscriber::completed));
         }
         catch(const Ice::Exception& ex)
         {
@@ -513,6 +576,42 @@ SubscriberLink::flush()
 
 }
 
+PublishedEvent::PublishedEvent(const pair<const Ice::Byte*, const Ice::Byte*>& inParams, const Ice::Current& current) :
+    _cost(eventCost(current.ctx))
+{
+    op = current.operation;
+    mode = current.mode;
+    data.assign(inParams.first, inParams.second);
+    context = current.ctx;
+}
+
+int
+PublishedEvent::cost() const
+{
+    return _cost;
+}
+
+const Ice::ByteSeq&
+PublishedEvent::encoded(const Ice::CommunicatorPtr& communicator) const
+{
+    IceUtil::Mutex::Lock sync(_mutex);
+    if(_encoded.empty())
+    {
+        //
+        // The event members are encoded the same way with the 1.0 and 1.1
+        // encodings (the operation mode enumeration has less than 127
+        // enumerators), the encoding is valid for all the links.
+        //
+        Ice::OutputStream os(communicator, Ice::currentEncoding);
+        os.write(op);
+        os.write(mode);
+        os.write(data);
+        os.write(context);
+        os.finished(_encoded);
+    }
+    return _encoded;
+}
+
 SubscriberPtr
 Subscriber::create(
     const InstancePtr& instance,
@@ -655,7 +754,7 @@ Subscriber::record() const
 }
 
 bool
-Subscriber::queue(bool forwarded, const EventDataSeq& events)
+Subscriber::queue(bool forwarded, const EventDataSeq& events, Ice::Long seq)
 {
     IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
 
@@ -685,7 +784,21 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
     case SubscriberStateOnline:
     {
-        for(EventDataSeq::const_iterator p = events.begin(); p != events.end(); ++p)
+        //
+        // Skip the events which are or were already replayed from the
+        // event log.
+        //
+        EventDataSeq::const_iterator first = events.begin();
+        if(seq >= 0 && (_replay || seq < _liveSeq))
+        {
+            if(_replay)
+            {
+                break;
+            }
+            first += static_cast<ptrdiff_t>(min(_liveSeq - seq, static_cast<Ice::Long>(events.size())));
+        }
+
+        for(EventDataSeq::const_iterator p = first; p != events.end(); ++p)
         {
             if(static_cast<int>(_events.size()) == _instance->sendQueueSizeMax())
             {
@@ -704,7 +817,7 @@ Subscriber::queue(bool forwarded, const EventDataSeq& events)
 
         if(_observer)
         {
-            _observer->queued(static_cast<Ice::Int>(events.size()));
+            _observer->queued(static_cast<Ice::Int>(events.end() - first));
         }
         flush();
         break;
@@ -860,12 +973,14 @@ Subscriber::error(bool dec, const Ice::Exception& e)
         _next = now + _instance->discardInterval();
         ++_currentRetry;
         _events.clear();
+        _replay = 0;
         setState(SubscriberStateOffline);
     }
     // Errored out.
     else if(_state < SubscriberStateError)
     {
         _events.clear();
+        _replay = 0;
         setState(SubscriberStateError);
 
         TraceLevelsPtr traceLevels = _instance->traceLevels();
@@ -911,7 +1026,7 @@ Subscriber::completed(const Ice::AsyncResultPtr& result)
         //
         _currentRetry = 0;
 
-        if(_events.empty() && _outstanding == 0 && _shutdown)
+        if(_events.empty() && _outstanding == 0 && _shutdown && !_replay)
         {
             _lock.notify();
         }
@@ -940,6 +1055,24 @@ Subscriber::shutdown()
     _observer.detach();
 }
 
+void
+Subscriber::resume(const EventLogReaderPtr& reader)
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    _replay = reader;
+    scheduleReplay();
+}
+
+void
+Subscriber::replay()
+{
+    IceUtil::Monitor<IceUtil::RecMutex>::Lock sync(_lock);
+    if(_state == SubscriberStateOnline && _replay)
+    {
+        flush();
+    }
+}
+
 void
 Subscriber::updateObserver()
 {
@@ -972,6 +1105,7 @@ Subscriber::Subscriber(
     _state(SubscriberStateOnline),
     _outstanding(0),
     _outstandingCount(1),
+    _liveSeq(0),
     _currentRetry(0)
 {
     if(_proxy && _instance->publisherReplicaProxy())
@@ -1042,6 +1176,53 @@ Subscriber::setState(Subscriber::SubscriberState state)
     }
 }
 
+bool
+Subscriber::hasEvents()
+{
+    //
+    // Called with the lock held. Once the queued events are sent, the next
+    // events to replay are read from the event log until the replay
+    // catches up with the events queued by the topic.
+    //
+    if(_events.empty() && _replay)
+    {
+        try
+        {
+            if(!_replay->read(replayBatchSize, _events))
+            {
+                _liveSeq = _replay->next();
+                _replay = 0;
+            }
+        }
+        catch(const Ice::Exception& ex)
+        {
+            Ice::Warning warn(_instance->traceLevels()->logger);
+            warn << _instance->traceLevels()->subscriberCat << ":"
+                 << _instance->communicator()->identityToString(_rec.id) << " event log replay failed: " << ex;
+            _replay = 0;
+        }
+
+        if(_observer && !_events.empty())
+        {
+            _observer->queued(static_cast<Ice::Int>(_events.size()));
+        }
+    }
+    return !_events.empty();
+}
+
+void
+Subscriber::scheduleReplay()
+{
+    try
+    {
+        _instance->timer()->schedule(new ReplayTimerTask(this), IceUtil::Time());
+    }
+    catch(const IceUtil::IllegalArgumentException&)
+    {
+        // The timer is destroyed, the service is shutting down.
+    }
+}
+
 bool
 IceStorm::operator==(const SubscriberPtr& subscriber, const Ice::Identity& id)
 {
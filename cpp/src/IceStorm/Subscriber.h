@@ -17,6 +17,33 @@ namespace IceStorm
 class Instance;
 typedef IceUtil::Handle<Instance> InstancePtr;
 
+class EventLogReader;
+typedef IceUtil::Handle<EventLogReader> EventLogReaderPtr;
+
+//
+// An event received from a publisher. The same event instance is queued
+// by all the subscribers of the topic. Its cost and its encoding for the
+// topic links are computed once and shared by all the links the event is
+// forwarded to, instead of being computed again by each link.
+//
+class PublishedEvent : public EventData
+{
+public:
+
+    PublishedEvent(const std::pair<const Ice::Byte*, const Ice::Byte*>&, const Ice::Current&);
+
+    int cost() const;
+    const Ice::ByteSeq& encoded(const Ice::CommunicatorPtr&) const;
+
+private:
+
+    const int _cost;
+
+    IceUtil::Mutex _mutex;
+    mutable Ice::ByteSeq _encoded;
+};
+typedef IceUtil::Handle<PublishedEvent> PublishedEventPtr;
+
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
@@ -30,8 +57,13 @@ public:
     Ice::Identity id() const; // Return the id of the subscriber.
     IceStorm::SubscriberRecord record() const; // Get the subscriber record.
 
-    // Returns false if the subscriber should be reaped.
-    bool queue(bool, const EventDataSeq&);
+    // Returns false if the subscriber should be reaped. The sequence
+    // number of the first event is -1 if the topic has no event log.
+    bool queue(bool, const EventDataSeq&, Ice::Long = -1);
+
+    // Replay the events of the event log before the new events.
+    void resume(const EventLogReaderPtr&);
+    void replay();
     bool reap();
     void resetIfReaped();
     bool errored() const;
@@ -59,6 +91,8 @@ public:
 protected:
 
     void setState(SubscriberState);
+    bool hasEvents();
+    void scheduleReplay();
 
     Subscriber(const InstancePtr&, const IceStorm::SubscriberRecord&, const Ice::ObjectPrx&, int, int);
 
@@ -80,6 +114,9 @@ protected:
     int _outstandingCount; // The current number of outstanding events when batching events (only used for metrics).
     EventDataSeq _events; // The queue of events to send.
 
+    EventLogReaderPtr _replay; // The reader of the events to replay, if any.
+    Ice::Long _liveSeq; // The sequence number of the first event queued once the replay completed.
+
     // The next time to try sending a new event if we're offline.
     IceUtil::Time _next;
     int _currentRetry;
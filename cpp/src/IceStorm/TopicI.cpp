@@ -5,11 +5,13 @@
 #include <IceStorm/TopicI.h>
 #include <IceStorm/Instance.h>
 #include <IceStorm/Subscriber.h>
+#include <IceStorm/EventLog.h>
 #include <IceStorm/TraceLevels.h>
 #include <IceStorm/NodeI.h>
 #include <IceStorm/Observers.h>
 #include <IceStorm/Util.h>
 #include <Ice/LoggerUtil.h>
+#include <IceUtil/StringUtil.h>
 #include <algorithm>
 
 using namespace std;
@@ -27,6 +29,23 @@ logError(const Ice::CommunicatorPtr& com, const IceDB::LMDBException& ex)
     error << "LMDB error: " << ex;
 }
 
+bool
+getResumeQoS(const QoS& qos, const string& name, Ice::Long& value)
+{
+    QoS::const_iterator p = qos.find(name);
+    if(p == qos.end())
+    {
+        return false;
+    }
+
+    istringstream is(IceUtilInternal::trim(p->second));
+    if(!(is >> value) || !is.eof() || value < 0)
+    {
+        throw BadQoS("invalid " + name + " (positive numeric value required): " + p->second);
+    }
+    return true;
+}
+
 //
 // The servant has a 1-1 association with a topic. It is used to
 // receive events from Publishers.
@@ -46,17 +65,8 @@ public:
                const Ice::Current& current)
     {
         // The publish call does a cached read.
-        EventDataPtr event = new EventData(current.operation, current.mode, Ice::ByteSeq(), current.ctx);
-
-        //
-        // COMPILERBUG: gcc 4.0.1 doesn't like this.
-        //
-        //event->data.swap(Ice::ByteSeq(inParams.first, inParams.second));
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event->data.swap(data);
-
         EventDataSeq v;
-        v.push_back(event);
+        v.push_back(new PublishedEvent(inParams, current));
         _topic->publish(false, v);
 
         return true;
@@ -353,6 +363,13 @@ TopicImpl::TopicImpl(
         // non-replicated case we could allocate a null-topic impl here.
         _servant = new TopicI(this, instance);
 
+        const string eventLogPath = _instance->eventLogPath(_name);
+        if(!eventLogPath.empty())
+        {
+            _eventLog = new EventLog(_instance, _name, eventLogPath);
+            _eventLog->start();
+        }
+
         //
         // Create a servant per topic to receive event data. If the
         // category is empty then we are in backwards compatibility
@@ -525,48 +542,105 @@ TopicImpl::subscribeAndGetPublisher(const QoS& qos, const Ice::ObjectPrx& obj)
         }
     }
 
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
-
-    SubscriberRecord record;
-    record.id = id;
-    record.obj = obj;
-    record.theQoS = qos;
-    record.topicName = _name;
-    record.link = false;
-    record.cost = 0;
-
-    vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
-    if(p != _subscribers.end())
+    //
+    // The resumeFromSequence and resumeFromTime QoS replay the events of
+    // the event log from the given sequence number or time (in
+    // milliseconds since the epoch) before the new events.
+    //
+    Ice::Long seq = -1;
+    Ice::Long timestamp = -1;
+    const bool resumeFromSequence = getResumeQoS(qos, "resumeFromSequence", seq);
+    const bool resumeFromTime = getResumeQoS(qos, "resumeFromTime", timestamp);
+    if(resumeFromSequence || resumeFromTime)
     {
-        throw AlreadySubscribed();
+        if(!_eventLog)
+        {
+            throw BadQoS("resuming a subscription requires a topic with an event log");
+        }
+        if(resumeFromSequence && resumeFromTime)
+        {
+            throw BadQoS("resumeFromSequence and resumeFromTime QoS can't be used together");
+        }
+        if(resumeFromTime)
+        {
+            seq = _eventLog->find(timestamp);
+        }
     }
 
-    LogUpdate llu;
-
-    SubscriberPtr subscriber = Subscriber::create(_instance, record);
-    try
+    SubscriberPtr subscriber;
+    Ice::Long group = 0;
+    Ice::Long update;
     {
-        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+        IceUtil::Mutex::Lock sync(_subscribersMutex);
 
-        SubscriberRecordKey key;
-        key.topic = _id;
-        key.id = subscriber->id();
+        SubscriberRecord record;
+        record.id = id;
+        record.obj = obj;
+        record.theQoS = qos;
+        record.topicName = _name;
+        record.link = false;
+        record.cost = 0;
 
-        _subscriberMap.put(txn, key, record);
+        vector<SubscriberPtr>::iterator p = find(_subscribers.begin(), _subscribers.end(), record.id);
+        if(p != _subscribers.end())
+        {
+            throw AlreadySubscribed();
+        }
 
-        llu = getIncrementedLLU(txn, _lluMap);
+        LogUpdate llu;
 
-        txn.commit();
+        subscriber = Subscriber::create(_instance, record);
+        try
+        {
+            IceDB::GroupTxn txn(_instance->groupCommit());
+
+            SubscriberRecordKey key;
+            key.topic = _id;
+            key.id = subscriber->id();
+
+            _subscriberMap.put(txn, key, record);
+
+            llu = getIncrementedLLU(txn, _lluMap);
+
+            txn.commit();
+            group = txn.group();
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+            throw; // will become UnknownException in caller
+        }
+
+        //
+        // Start the replay before adding the subscriber, the events
+        // published from now on are skipped by the subscriber until the
+        // replay catches up with them.
+        //
+        if(seq >= 0)
+        {
+            subscriber->resume(_eventLog->createReader(seq));
+        }
+
+        _subscribers.push_back(subscriber);
+
+        update = _instance->observers()->addSubscriber(llu, _name, record);
+    }
+
+    //
+    // Wait for the subscription to be committed and acknowledged by the
+    // observers once the lock is released, other subscriptions can join
+    // its group or be sent to the observers in the meantime.
+    //
+    try
+    {
+        _instance->groupCommit().wait(group);
     }
     catch(const IceDB::LMDBException& ex)
     {
         logError(_instance->communicator(), ex);
         throw; // will become UnknownException in caller
     }
-
-    _subscribers.push_back(subscriber);
-
-    _instance->observers()->addSubscriber(llu, _name, record);
+    _instance->observers()->wait(update);
 
     return subscriber->proxy();
 }
@@ -599,10 +673,14 @@ TopicImpl::unsubscribe(const Ice::ObjectPrx& subscriber)
         }
     }
 
-    IceUtil::Mutex::Lock sync(_subscribersMutex);
-    Ice::IdentitySeq ids;
-    ids.push_back(id);
-    removeSubscribers(ids);
+    Ice::Long update;
+    {
+        IceUtil::Mutex::Lock sync(_subscribersMutex);
+        Ice::IdentitySeq ids;
+        ids.push_back(id);
+        update = removeSubscribers(ids);
+    }
+    _instance->observers()->wait(update);
 }
 
 TopicLinkPrx
@@ -676,7 +754,11 @@ TopicImpl::link(const TopicPrx& topic, Ice::Int cost)
 
     _subscribers.push_back(subscriber);
 
-    _instance->observers()->addSubscriber(llu, _name, record);
+    Ice::Long update = _instance->observers()->addSubscriber(llu, _name, record);
+
+    // Wait for the observers once the lock is released.
+    sync.release();
+    _instance->observers()->wait(update);
 }
 
 void
@@ -713,7 +795,11 @@ TopicImpl::unlink(const TopicPrx& topic)
 
     Ice::IdentitySeq ids;
     ids.push_back(id);
-    removeSubscribers(ids);
+    Ice::Long update = removeSubscribers(ids);
+
+    // Wait for the observers once the lock is released.
+    sync.release();
+    _instance->observers()->wait(update);
 }
 
 void
@@ -736,7 +822,11 @@ TopicImpl::reap(const Ice::IdentitySeq& ids)
         }
     }
 
-    removeSubscribers(ids);
+    Ice::Long update = removeSubscribers(ids);
+
+    // Wait for the observers once the lock is released.
+    sync.release();
+    _instance->observers()->wait(update);
 }
 
 void
@@ -751,6 +841,12 @@ TopicImpl::shutdown()
         (*p)->shutdown();
     }
 
+    // Write the pending events of the event log.
+    if(_eventLog)
+    {
+        _eventLog->destroy(false);
+    }
+
     _observer.detach();
 }
 
@@ -808,9 +904,13 @@ TopicImpl::destroy()
 
     // destroyInternal clears out the topic content.
     LogUpdate llu = {0,0};
-    _instance->observers()->destroyTopic(destroyInternal(llu, true), _name);
+    Ice::Long update = _instance->observers()->destroyTopic(destroyInternal(llu, true), _name);
 
     _observer.detach();
+
+    // Wait for the observers once the lock is released.
+    sync.release();
+    _instance->observers()->wait(update);
 }
 
 TopicContent
@@ -965,6 +1065,7 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         // in parallel.
         //
         vector<SubscriberPtr> copy;
+        Ice::Long seq = -1;
         {
             IceUtil::Mutex::Lock sync(_subscribersMutex);
             if(_observer)
@@ -978,6 +1079,16 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
                     _observer->published();
                 }
             }
+
+            //
+            // The events are appended to the event log while the mutex is
+            // locked, this ensures a subscriber replaying the log doesn't
+            // miss the events published while it's added.
+            //
+            if(_eventLog)
+            {
+                seq = _eventLog->append(events);
+            }
             copy = _subscribers;
         }
 
@@ -987,7 +1098,7 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         //
         for(vector<SubscriberPtr>::const_iterator p = copy.begin(); p != copy.end(); ++p)
         {
-            if(!(*p)->queue(forwarded, events) && (*p)->reap())
+            if(!(*p)->queue(forwarded, events, seq) && (*p)->reap())
             {
                 reap.push_back((*p)->id());
             }
@@ -1000,8 +1111,12 @@ TopicImpl::publish(bool forwarded, const EventDataSeq& events)
         }
         if(!unlock.getMaster())
         {
-            IceUtil::Mutex::Lock sync(_subscribersMutex);
-            removeSubscribers(reap);
+            Ice::Long update;
+            {
+                IceUtil::Mutex::Lock sync(_subscribersMutex);
+                update = removeSubscribers(reap);
+            }
+            _instance->observers()->wait(update);
             return;
         }
         masterInternal = TopicInternalPrx::uncheckedCast(unlock.getMaster()->ice_identity(_id));
@@ -1249,6 +1364,11 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
     }
     _subscribers.clear();
 
+    if(_eventLog)
+    {
+        _eventLog->destroy(true);
+    }
+
     _instance->topicAdapter()->remove(_id);
 
     _servant = 0;
@@ -1256,7 +1376,7 @@ TopicImpl::destroyInternal(const LogUpdate& origLLU, bool master)
     return llu;
 }
 
-void
+Ice::Long
 TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
 {
     // First update the database
@@ -1313,6 +1433,7 @@ TopicImpl::removeSubscribers(const Ice::IdentitySeq& ids)
             }
         }
 
-        _instance->observers()->removeSubscriber(llu, _name, ids);
+        return _instance->observers()->removeSubscriber(llu, _name, ids);
     }
+    return 0;
 }
@@ -22,6 +22,9 @@ typedef IceUtil::Handle<PersistentInstance> PersistentInstancePtr;
 class Subscriber;
 typedef IceUtil::Handle<Subscriber> SubscriberPtr;
 
+class EventLog;
+typedef IceUtil::Handle<EventLog> EventLogPtr;
+
 class TopicImpl : public IceUtil::Shared
 {
 public:
@@ -65,7 +68,8 @@ public:
 private:
 
     IceStormElection::LogUpdate destroyInternal(const IceStormElection::LogUpdate&, bool);
-    void removeSubscribers(const Ice::IdentitySeq&);
+    // Returns the observers update, 0 if no subscriber was removed.
+    Ice::Long removeSubscribers(const Ice::IdentitySeq&);
 
     //
     // Immutable members.
@@ -82,6 +86,8 @@ private:
 
     Ice::ObjectPtr _servant; // The topic implementation servant.
 
+    EventLogPtr _eventLog; // The event log of the topic, if any.
+
     // Mutex protecting the subscribers.
     IceUtil::Mutex _subscribersMutex;
 
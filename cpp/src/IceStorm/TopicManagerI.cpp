@@ -114,14 +114,18 @@ private:
     const TopicManagerImplPtr _impl;
 };
 
-class ReplicaObserverI : public ReplicaObserver
+class ReplicaObserverI : public ReplicaObserver, private IceUtil::Monitor<IceUtil::Mutex>
 {
 public:
 
     ReplicaObserverI(const PersistentInstancePtr& instance, const TopicManagerImplPtr& impl) :
         _instance(instance),
-        _impl(impl)
+        _impl(impl),
+        _timeout(IceUtil::Time::seconds(instance->communicator()->getProperties()->getPropertyAsIntWithDefault(
+                                            instance->serviceName() + ".Election.ResponseTimeout", 10)))
     {
+        _applied.generation = -1;
+        _applied.iteration = 0;
     }
 
     virtual void init(const LogUpdate& llu, const TopicContentSeq& content, const Ice::Current&)
@@ -132,6 +136,7 @@ public:
             node->checkObserverInit(llu.generation);
         }
         _impl->observerInit(llu, content);
+        applied(llu);
     }
 
     virtual void createTopic(const LogUpdate& llu, const string& name, const Ice::Current&)
@@ -139,7 +144,11 @@ public:
         try
         {
             ObserverUpdateHelper unlock(_instance->node(), llu.generation, __FILE__, __LINE__);
-            _impl->observerCreateTopic(llu, name);
+            ReplicaUpdate update;
+            update.llu = llu;
+            update.kind = ReplicaUpdateCreateTopic;
+            update.topic = name;
+            _impl->observerUpdate(update);
         }
         catch(const ObserverInconsistencyException& e)
         {
@@ -148,6 +157,7 @@ public:
             _instance->node()->recovery(llu.generation);
             throw;
         }
+        applied(llu);
     }
 
     virtual void destroyTopic(const LogUpdate& llu, const string& name, const Ice::Current&)
@@ -155,7 +165,11 @@ public:
         try
         {
             ObserverUpdateHelper unlock(_instance->node(), llu.generation, __FILE__, __LINE__);
-            _impl->observerDestroyTopic(llu, name);
+            ReplicaUpdate update;
+            update.llu = llu;
+            update.kind = ReplicaUpdateDestroyTopic;
+            update.topic = name;
+            _impl->observerUpdate(update);
         }
         catch(const ObserverInconsistencyException& e)
         {
@@ -164,6 +178,7 @@ public:
             _instance->node()->recovery(llu.generation);
             throw;
         }
+        applied(llu);
     }
 
     virtual void addSubscriber(const LogUpdate& llu, const string& name, const SubscriberRecord& rec,
@@ -172,7 +187,12 @@ public:
         try
         {
             ObserverUpdateHelper unlock(_instance->node(), llu.generation, __FILE__, __LINE__);
-            _impl->observerAddSubscriber(llu, name, rec);
+            ReplicaUpdate update;
+            update.llu = llu;
+            update.kind = ReplicaUpdateAddSubscriber;
+            update.topic = name;
+            update.record = rec;
+            _impl->observerUpdate(update);
         }
         catch(const ObserverInconsistencyException& e)
         {
@@ -181,6 +201,7 @@ public:
             _instance->node()->recovery(llu.generation);
             throw;
         }
+        applied(llu);
     }
 
     virtual void removeSubscriber(const LogUpdate& llu, const string& name, const Ice::IdentitySeq& id,
@@ -189,7 +210,12 @@ public:
         try
         {
             ObserverUpdateHelper unlock(_instance->node(), llu.generation, __FILE__, __LINE__);
-            _impl->observerRemoveSubscriber(llu, name, id);
+            ReplicaUpdate update;
+            update.llu = llu;
+            update.kind = ReplicaUpdateRemoveSubscriber;
+            update.topic = name;
+            update.subscribers = id;
+            _impl->observerUpdate(update);
         }
         catch(const ObserverInconsistencyException& e)
         {
@@ -198,12 +224,103 @@ public:
             _instance->node()->recovery(llu.generation);
             throw;
         }
+        applied(llu);
+    }
+
+    virtual void update(const LogUpdate& prev, const ReplicaUpdateSeq& updates, const Ice::Current&)
+    {
+        try
+        {
+            {
+                //
+                // The master doesn't wait for the acknowledgement of a batch
+                // before sending the next batch, so the batches can be
+                // dispatched concurrently. Wait for the previous batch to be
+                // applied.
+                //
+                Lock sync(*this);
+                IceUtil::Time timeout = IceUtil::Time::now(IceUtil::Time::Monotonic) + _timeout;
+                while(_applied.generation == prev.generation && _applied < prev)
+                {
+                    IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+                    if(now >= timeout || !timedWait(timeout - now))
+                    {
+                        break;
+                    }
+                }
+                if(_applied != prev)
+                {
+                    throw ObserverInconsistencyException("update doesn't follow the last applied update");
+                }
+            }
+
+            ObserverUpdateHelper unlock(_instance->node(), prev.generation, __FILE__, __LINE__);
+            for(ReplicaUpdateSeq::const_iterator p = updates.begin(); p != updates.end(); ++p)
+            {
+                _impl->observerUpdate(*p);
+            }
+        }
+        catch(const ObserverInconsistencyException& e)
+        {
+            inconsistent();
+            Ice::Warning warn(_instance->traceLevels()->logger);
+            warn << "ReplicaObserverI::update: ObserverInconsistencyException: " << e.reason;
+            _instance->node()->recovery(prev.generation);
+            throw;
+        }
+        catch(...)
+        {
+            inconsistent();
+            throw;
+        }
+        applied(updates.empty() ? prev : updates.back().llu);
+    }
+
+    virtual void resync(const LogUpdate& from, const LogUpdate& llu, const ReplicaUpdateSeq& updates,
+                        const Ice::Current&)
+    {
+        NodeIPtr node = _instance->node();
+        if(node)
+        {
+            node->checkObserverInit(llu.generation);
+        }
+
+        // If the resync fails, the master initializes the observer with the full content.
+        try
+        {
+            _impl->observerResync(from, llu, updates);
+        }
+        catch(...)
+        {
+            inconsistent();
+            throw;
+        }
+        applied(llu);
     }
 
 private:
 
+    void applied(const LogUpdate& llu)
+    {
+        Lock sync(*this);
+        _applied = llu;
+        notifyAll();
+    }
+
+    void inconsistent()
+    {
+        //
+        // The following updates are rejected until the observer is
+        // initialized again.
+        //
+        LogUpdate llu = { -1, 0 };
+        applied(llu);
+    }
+
     const PersistentInstancePtr _instance;
     const TopicManagerImplPtr _impl;
+    const IceUtil::Time _timeout;
+    LogUpdate _applied; // The log update of the last applied update.
 };
 
 class TopicManagerSyncI : public TopicManagerSync
@@ -220,6 +337,11 @@ public:
         _impl->getContent(llu, content);
     }
 
+    virtual bool getUpdates(const LogUpdate& from, LogUpdate& llu, ReplicaUpdateSeq& updates, const Ice::Current&)
+    {
+        return _impl->getUpdates(from, llu, updates);
+    }
+
 private:
 
     const TopicManagerImplPtr _impl;
@@ -305,42 +427,53 @@ TopicManagerImpl::TopicManagerImpl(const PersistentInstancePtr& instance) :
 TopicPrx
 TopicManagerImpl::create(const string& name)
 {
-    Lock sync(*this);
-
-    reap();
-    if(_topics.find(name) != _topics.end())
+    TopicPrx topic;
+    Ice::Long update;
     {
-        throw TopicExists(name);
-    }
+        Lock sync(*this);
 
-    // Identity is <instanceName>/topic.<topicname>
-    Ice::Identity id = nameToIdentity(_instance, name);
+        reap();
+        if(_topics.find(name) != _topics.end())
+        {
+            throw TopicExists(name);
+        }
 
-    LogUpdate llu;
-    try
-    {
-        IceDB::ReadWriteTxn txn(_instance->dbEnv());
+        // Identity is <instanceName>/topic.<topicname>
+        Ice::Identity id = nameToIdentity(_instance, name);
 
-        SubscriberRecordKey key;
-        key.topic = id;
-        SubscriberRecord rec;
-        rec.link = false;
-        rec.cost = 0;
+        LogUpdate llu;
+        try
+        {
+            IceDB::ReadWriteTxn txn(_instance->dbEnv());
 
-        _subscriberMap.put(txn, key, rec);
+            SubscriberRecordKey key;
+            key.topic = id;
+            SubscriberRecord rec;
+            rec.link = false;
+            rec.cost = 0;
 
-        llu = getIncrementedLLU(txn, _lluMap);
+            _subscriberMap.put(txn, key, rec);
 
-        txn.commit();
-    }
-    catch(const IceDB::LMDBException& ex)
-    {
-        logError(_instance->communicator(), ex);
-        throw; // will become UnknownException in caller
+            llu = getIncrementedLLU(txn, _lluMap);
+
+            txn.commit();
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+            throw; // will become UnknownException in caller
+        }
+
+        update = _instance->observers()->createTopic(llu, name);
+        topic = installTopic(name, id, true);
     }
 
-    _instance->observers()->createTopic(llu, name);
-    return installTopic(name, id, true);
+    //
+    // Wait for the observers to acknowledge the update once the lock is
+    // released, other updates can be sent to the observers meanwhile.
+    //
+    _instance->observers()->wait(update);
+    return topic;
 }
 
 TopicPrx
@@ -493,6 +626,75 @@ TopicManagerImpl::observerInit(const LogUpdate& llu, const TopicContentSeq& cont
     }
     // Clear the set of observers.
     _instance->observers()->clear();
+    _instance->observers()->resetLog(llu);
+}
+
+void
+TopicManagerImpl::observerResync(const LogUpdate& from, const LogUpdate& llu, const ReplicaUpdateSeq& updates)
+{
+    Lock sync(*this);
+
+    TraceLevelsPtr traceLevels = _instance->traceLevels();
+    if(traceLevels->topicMgr > 0)
+    {
+        Ice::Trace out(traceLevels->logger, traceLevels->topicMgrCat);
+        out << "resync from llu " << from.generation << "/" << from.iteration << " to llu "
+            << llu.generation << "/" << llu.iteration << " with " << updates.size() << " updates";
+    }
+
+    if(getLastLogUpdate() != from)
+    {
+        throw ObserverInconsistencyException("resync from an unknown llu");
+    }
+
+    // The updates are applied in order, each update also updates the llu.
+    for(ReplicaUpdateSeq::const_iterator p = updates.begin(); p != updates.end(); ++p)
+    {
+        observerUpdate(*p);
+    }
+
+    // The llu of a new generation doesn't come with an update.
+    if((updates.empty() ? from : updates.back().llu) != llu)
+    {
+        try
+        {
+            IceDB::ReadWriteTxn txn(_instance->dbEnv());
+            _lluMap.put(txn, lluDbKey, llu);
+            txn.commit();
+        }
+        catch(const IceDB::LMDBException& ex)
+        {
+            logError(_instance->communicator(), ex);
+            throw; // will become UnknownException in caller
+        }
+        _instance->observers()->logGeneration(llu);
+    }
+
+    // Clear the set of observers.
+    _instance->observers()->clear();
+}
+
+void
+TopicManagerImpl::observerUpdate(const ReplicaUpdate& update)
+{
+    switch(update.kind)
+    {
+    case ReplicaUpdateCreateTopic:
+        observerCreateTopic(update.llu, update.topic);
+        break;
+    case ReplicaUpdateDestroyTopic:
+        observerDestroyTopic(update.llu, update.topic);
+        break;
+    case ReplicaUpdateAddSubscriber:
+        observerAddSubscriber(update.llu, update.topic, update.record);
+        break;
+    case ReplicaUpdateRemoveSubscriber:
+        observerRemoveSubscriber(update.llu, update.topic, update.subscribers);
+        break;
+    }
+
+    // Log the update to resync the other replicas with it.
+    _instance->observers()->log(update);
 }
 
 void
@@ -608,6 +810,13 @@ TopicManagerImpl::getContent(LogUpdate& llu, TopicContentSeq& content)
     }
 }
 
+bool
+TopicManagerImpl::getUpdates(const LogUpdate& from, LogUpdate& llu, ReplicaUpdateSeq& updates)
+{
+    llu = getLastLogUpdate();
+    return _instance->observers()->getUpdates(from, llu, updates);
+}
+
 LogUpdate
 TopicManagerImpl::getLastLogUpdate() const
 {
@@ -631,7 +840,26 @@ TopicManagerImpl::sync(const Ice::ObjectPrx& master)
 {
     TopicManagerSyncPrx sync = TopicManagerSyncPrx::uncheckedCast(master);
 
+    //
+    // Get the updates applied since our last log update if the master
+    // still has them in its log, otherwise get the full content.
+    //
+    LogUpdate from = getLastLogUpdate();
     LogUpdate llu;
+    try
+    {
+        ReplicaUpdateSeq updates;
+        if(sync->getUpdates(from, llu, updates))
+        {
+            observerResync(from, llu, updates);
+            return;
+        }
+    }
+    catch(const Ice::OperationNotExistException&)
+    {
+        // The master doesn't support getUpdates.
+    }
+
     TopicContentSeq content;
     sync->getContent(llu, content);
 
@@ -49,9 +49,14 @@ public:
     void observerAddSubscriber(const IceStormElection::LogUpdate&, const std::string&,
                                const IceStorm::SubscriberRecord&);
     void observerRemoveSubscriber(const IceStormElection::LogUpdate&, const std::string&, const Ice::IdentitySeq&);
+    void observerUpdate(const IceStormElection::ReplicaUpdate&);
+    void observerResync(const IceStormElection::LogUpdate&, const IceStormElection::LogUpdate&,
+                        const IceStormElection::ReplicaUpdateSeq&);
 
     // Sync methods.
     void getContent(IceStormElection::LogUpdate&, IceStormElection::TopicContentSeq&);
+    bool getUpdates(const IceStormElection::LogUpdate&, IceStormElection::LogUpdate&,
+                    IceStormElection::ReplicaUpdateSeq&);
 
     // Replica methods.
     virtual IceStormElection::LogUpdate getLastLogUpdate() const;
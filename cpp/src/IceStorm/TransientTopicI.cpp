@@ -38,21 +38,8 @@ public:
                const Ice::Current& current)
     {
         // Use cached reads.
-        EventDataPtr event = new EventData(
-            current.operation,
-            current.mode,
-            Ice::ByteSeq(),
-            current.ctx);
-
-        //
-        // COMPILERBUG: gcc 4.0.1 doesn't like this.
-        //
-        //event->data.swap(Ice::ByteSeq(inParams.first, inParams.second));
-        Ice::ByteSeq data(inParams.first, inParams.second);
-        event->data.swap(data);
-
         EventDataSeq v;
-        v.push_back(event);
+        v.push_back(new PublishedEvent(inParams, current));
         _impl->publish(false, v);
 
         return true;
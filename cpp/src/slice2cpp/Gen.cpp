@@ -226,6 +226,93 @@ writeDataMemberInitializers(IceUtilInternal::Output& C, const DataMemberList& me
     }
 }
 
+bool
+hasViewMetaData(const StringList& metaData)
+{
+    for(StringList::const_iterator q = metaData.begin(); q != metaData.end(); ++q)
+    {
+        if(q->find("cpp:view-type:") == 0 || q->find("cpp:range") == 0 || *q == "cpp:array")
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//
+// Operations whose parameters can be passed directly to a collocated servant: the servant
+// must be called with the same types as the proxy and the parameters must not reference
+// memory or class instances owned by the caller.
+//
+bool
+supportsCollocatedDispatch(const OperationPtr& p)
+{
+    ClassDefPtr cl = ClassDefPtr::dynamicCast(p->container());
+    if(cl->hasMetaData("amd") || p->hasMetaData("amd") || p->hasMarshaledResult() ||
+       p->sendsClasses(false) || p->returnsClasses(false) || hasViewMetaData(p->getMetaData()))
+    {
+        return false;
+    }
+
+    ParamDeclList paramList = p->parameters();
+    for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+    {
+        if(hasViewMetaData((*q)->getMetaData()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+writeCollocatedDispatchLambda(IceUtilInternal::Output& C, const OperationPtr& p, const string& resultT,
+                              const string& returnValueS, const string& servantT, const string& scope)
+{
+    TypePtr ret = p->returnType();
+    ParamDeclList paramList = p->parameters();
+    ParamDeclList outParams = p->outParameters();
+
+    const bool resultStruct = (ret ? 1 : 0) + outParams.size() > 1;
+    string result;
+    if(resultStruct)
+    {
+        result = "v.";
+    }
+
+    vector<string> args;
+    for(ParamDeclList::const_iterator q = paramList.begin(); q != paramList.end(); ++q)
+    {
+        if((*q)->isOutParam())
+        {
+            args.push_back(result.empty() ? string("v") : result + fixKwd((*q)->name()));
+        }
+        else
+        {
+            args.push_back(paramPrefix + (*q)->name());
+        }
+    }
+    args.push_back("current");
+
+    C << "[&](" << servantT << "* servant, const " << getUnqualified("::Ice::Current&", scope) << " current)";
+    C << sb;
+    if(resultStruct || (!ret && !outParams.empty()))
+    {
+        C << nl << resultT << " v;";
+    }
+    C << nl;
+    if(ret)
+    {
+        C << (resultStruct ? result + returnValueS + " = " : string("return "));
+    }
+    C << "servant->" << fixKwd(p->name()) << spar << args << epar << ";";
+    if(resultStruct || (!ret && !outParams.empty()))
+    {
+        C << nl << "return v;";
+    }
+    C << eb;
+}
+
 void
 writeInParamsLambda(IceUtilInternal::Output& C, const OperationPtr& p, const ParamDeclList& inParams,
                     const string& scope)
@@ -7204,6 +7291,23 @@ Slice::Gen::Cpp11ProxyVisitor::visitOperation(const OperationPtr& p)
     {
         C << nl << "_checkTwowayOnly(" << flatName << ");";
     }
+    if(supportsCollocatedDispatch(p))
+    {
+        string servantT = getUnqualified(fixKwd(cl->scope() + cl->name() + (cl->isInterface() ? "" : "Disp")),
+                                         clScope);
+        C << nl << "if(outAsync->invokeCollocated<" << servantT << ">(" << flatName << ", ";
+        C << getUnqualified(operationModeToString(p->sendMode(), true), clScope) << ", context,";
+        C.inc();
+        C << nl;
+        writeCollocatedDispatchLambda(C, p, futureT, returnValueS, servantT, clScope);
+        C << "," << nl;
+        throwUserExceptionLambda(C, p->throws(), clScope);
+        C.dec();
+        C << "))";
+        C << sb;
+        C << nl << "return;";
+        C << eb;
+    }
     C << nl << "outAsync->invoke(" << flatName << ", ";
     C << getUnqualified(operationModeToString(p->sendMode(), true), clScope) << ", "
       << getUnqualified(opFormatTypeToString(p, true), clScope) << ", context,";
@@ -49,6 +49,26 @@ TestControllerI::TestControllerI(const string& endpoint)
     id.name = "barC";
     current.objectIdFiltersAccept.push_back(id);
     _configurations.push_back(current);
+
+    current = TestConfiguration();
+    current.description = "Many category and object id filters";
+    current.cases.push_back(TestCase("cat0/fooD:" + endpoint, true));
+    current.cases.push_back(TestCase("cat777/fooD:" + endpoint, true));
+    current.cases.push_back(TestCase("cat1000/fooD:" + endpoint, false));
+    current.cases.push_back(TestCase("cat/fooD:" + endpoint, false));
+    current.cases.push_back(TestCase("bar/foo512:" + endpoint, true));
+    current.cases.push_back(TestCase("bar/foo1000:" + endpoint, false));
+    current.cases.push_back(TestCase("baz/foo512:" + endpoint, false));
+    for(int i = 0; i < 1000; ++i)
+    {
+        ostringstream os;
+        os << i;
+        current.categoryFiltersAccept.push_back("cat" + os.str());
+        id.category = "bar";
+        id.name = "foo" + os.str();
+        current.objectIdFiltersAccept.push_back(id);
+    }
+    _configurations.push_back(current);
 };
 
 void
@@ -227,6 +227,46 @@ class Glacier2StaticFilteringTestSuite(Glacier2TestSuite):
                         (False, '"a funny id/that might mess it up":tcp -h 127.0.0.1 -p 12010')], []),
                 ]
 
+        #
+        # The address rules matching the end of the host are checked together,
+        # the others one after the other. With Glacier2.Client.Trace.Reject >= 3
+        # all the rules are checked one after the other, the results must be the
+        # same.
+        #
+        addressTestcases = [
+                ('testing suffix address rules',
+                        ('*host 127.0.0.1:12010 *.0.0.9', '', '', '', '', ''),
+                        [(True, 'hello1:tcp -h localhost -p 12010'),
+                        (True, 'hello2:tcp -h 127.0.0.1 -p 12010'),
+                        (False, 'hello3:tcp -h 127.0.0.1 -p 12011'),
+                        (False, 'hello4:tcp -h localhost.invalid -p 12010'),
+                        (False, 'hello5:tcp -h 127.0.0.3 -p 12010'),
+                        (False, 'hello6:tcp -h localhost -p 12010:tcp -h 127.0.0.3 -p 12010'),
+                        (False, 'hello7:tcp -h localhost -p 12010:tcp -h 127.0.0.1 -p 12010'),
+                        (True, 'hello8:tcp -h localhost -p 12010:tcp -h localhost -p 12011'),
+                        (False, 'hello9 @ foo')], []),
+                ('testing wildcard and range address rules',
+                        ('127.0.0.[1-3] local*st 127.*.1:[12000-12009,12011]', '', '', '', '', ''),
+                        [(True, 'hello1:tcp -h 127.0.0.1 -p 12010'),
+                        (True, 'hello2:tcp -h localhost -p 12010'),
+                        (False, 'hello3:tcp -h 127.0.0.4 -p 12010'),
+                        (False, 'hello4:tcp -h 127.0.0.11 -p 12011'),
+                        (False, 'hello5:tcp -h localhostx -p 12010'),
+                        (False, 'hello6:tcp -h 127.1.0.4 -p 12011'),
+                        (False, 'hello7:tcp -h 127.1.0.1 -p 12010')], []),
+                ('testing suffix and range reject address rules',
+                        ('', '*host:12011 127.0.0.[2-9] *.invalid', '', '', '', ''),
+                        [(False, 'hello1:tcp -h localhost -p 12011'),
+                        (True, 'hello2:tcp -h localhost -p 12010'),
+                        (False, 'hello3:tcp -h 127.0.0.5 -p 12010'),
+                        (True, 'hello4:tcp -h 127.0.0.1 -p 12010'),
+                        (False, 'hello5:tcp -h host.invalid -p 12010:tcp -h localhost.invalid -p 12010'),
+                        (False, 'hello6:tcp -h host.invalid -p 12010')], []),
+                ]
+        testcases.extend(addressTestcases)
+        testcases.extend([(description + ' with reject tracing', args, attacks, ["Glacier2.Client.Trace.Reject=3"])
+                          for (description, args, attacks, xtraConfig) in addressTestcases])
+
         if not limitedTests:
             testcases.extend([
                     ('testing reject all',
@@ -290,7 +330,7 @@ class Glacier2StaticFilteringTestSuite(Glacier2TestSuite):
             current.writeln("WARNING: You are running this test with SSL disabled and the network ")
             current.writeln("         configuration for this host does not permit the other tests ")
             current.writeln("         to run correctly.")
-        elif len(testcases) < 6:
+        elif limitedTests:
             current.writeln("WARNING: The network configuration for this host does not permit all ")
             current.writeln("         tests to run correctly, some tests have been disabled.")
 
@@ -3,6 +3,7 @@
 //
 
 #include <Ice/Ice.h>
+#include <IceUtil/Thread.h>
 #include <TestHelper.h>
 #include <Test.h>
 
@@ -10,6 +11,121 @@ using namespace std;
 using namespace Ice;
 using namespace Test;
 
+namespace
+{
+
+class ServantI : public Test::TestIntf
+{
+public:
+
+    virtual void
+    transient(const Ice::Current&)
+    {
+    }
+
+    virtual void
+    deactivate(const Ice::Current&)
+    {
+    }
+};
+
+Identity
+servantIdentity(const string& prefix, int i)
+{
+    ostringstream os;
+    os << prefix << "-" << i;
+    Identity ident;
+    ident.name = os.str();
+    ident.category = i % 2 == 0 ? "" : "category";
+    return ident;
+}
+
+//
+// Adds, finds and removes the facets of its own identities and its facet
+// of the identities shared with the other threads.
+//
+class ServantMapThread : public IceUtil::Thread
+{
+public:
+
+    ServantMapThread(const ObjectAdapterPtr& adapter, int id, int count) :
+        _adapter(adapter),
+        _id(id),
+        _count(count)
+    {
+    }
+
+    virtual void
+    run()
+    {
+        ostringstream os;
+        os << "servant-" << _id;
+        const string prefix = os.str();
+        os.str("");
+        os << "facet-" << _id;
+        const string facet = os.str();
+
+        ObjectPtr servant = ICE_MAKE_SHARED(ServantI);
+        for(int loop = 0; loop < 3; ++loop)
+        {
+            for(int i = 0; i < _count; ++i)
+            {
+                _adapter->add(servant, servantIdentity(prefix, i));
+                _adapter->addFacet(servant, servantIdentity(prefix, i), "a");
+                _adapter->addFacet(servant, servantIdentity(prefix, i), "b");
+                _adapter->addFacet(servant, servantIdentity("shared", i), facet);
+            }
+
+            for(int i = 0; i < _count; ++i)
+            {
+                Identity ident = servantIdentity(prefix, i);
+                test(_adapter->find(ident) == servant);
+                test(_adapter->findFacet(ident, "a") == servant);
+                test(!_adapter->findFacet(ident, "c"));
+                test(_adapter->findAllFacets(ident).size() == 3);
+                test(_adapter->findFacet(servantIdentity("shared", i), facet) == servant);
+                try
+                {
+                    _adapter->addFacet(servant, ident, "a");
+                    test(false);
+                }
+                catch(const AlreadyRegisteredException&)
+                {
+                }
+            }
+
+            for(int i = 0; i < _count; ++i)
+            {
+                Identity ident = servantIdentity(prefix, i);
+                test(_adapter->removeFacet(ident, "a") == servant);
+                FacetMap facets = _adapter->findAllFacets(ident);
+                test(facets.size() == 2 && facets.find("") != facets.end() && facets.find("b") != facets.end());
+                test(_adapter->removeAllFacets(ident).size() == 2);
+                test(!_adapter->find(ident));
+                test(_adapter->findAllFacets(ident).empty());
+                try
+                {
+                    _adapter->remove(ident);
+                    test(false);
+                }
+                catch(const NotRegisteredException&)
+                {
+                }
+                test(_adapter->removeFacet(servantIdentity("shared", i), facet) == servant);
+            }
+        }
+    }
+
+private:
+
+    const ObjectAdapterPtr _adapter;
+    const int _id;
+    const int _count;
+};
+typedef IceUtil::Handle<ServantMapThread> ServantMapThreadPtr;
+
+}
+
 TestIntfPrxPtr
 allTests(Test::TestHelper* helper)
 {
@@ -198,6 +314,52 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing servant map with concurrent updates... " << flush;
+    {
+        //
+        // Enough identities to use all the shards of the servant map and
+        // to grow and shrink them.
+        //
+        const int threadCount = 4;
+        const int count = 2000;
+        Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("");
+        ObjectPtr servant = ICE_MAKE_SHARED(ServantI);
+        for(int i = 0; i < count; ++i)
+        {
+            adapter->add(servant, servantIdentity("shared", i));
+        }
+
+        vector<ServantMapThreadPtr> threads;
+        for(int i = 0; i < threadCount; ++i)
+        {
+            threads.push_back(new ServantMapThread(adapter, i, count));
+        }
+        vector<IceUtil::ThreadControl> controls;
+        for(vector<ServantMapThreadPtr>::const_iterator p = threads.begin(); p != threads.end(); ++p)
+        {
+            controls.push_back((*p)->start());
+        }
+        for(vector<IceUtil::ThreadControl>::iterator p = controls.begin(); p != controls.end(); ++p)
+        {
+            p->join();
+        }
+
+        //
+        // Only the servants added before the threads remain.
+        //
+        for(int i = 0; i < count; ++i)
+        {
+            Identity ident = servantIdentity("shared", i);
+            FacetMap facets = adapter->findAllFacets(ident);
+            test(facets.size() == 1 && facets.begin()->first == "" && facets.begin()->second == servant);
+            test(!adapter->find(servantIdentity("servant-0", i)));
+            test(adapter->removeAllFacets(ident).size() == 1);
+            test(!adapter->find(ident));
+        }
+        adapter->destroy();
+    }
+    cout << "ok" << endl;
+
     cout << "deactivating object adapter in the server... " << flush;
     obj->deactivate();
     cout << "ok" << endl;
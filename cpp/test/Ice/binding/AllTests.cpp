@@ -801,6 +801,191 @@ allTests(Test::TestHelper* helper)
     }
     cout << "ok" << endl;
 
+    cout << "testing per request binding and latency-aware endpoint selection... " << flush;
+    {
+        vector<RemoteObjectAdapterPrxPtr> adapters;
+        adapters.push_back(com->createObjectAdapter("AdapterLeast1", "default"));
+        adapters.push_back(com->createObjectAdapter("AdapterLeast2", "default"));
+
+        TestIntfPrxPtr test = createTestIntfPrx(adapters);
+        test = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                  test->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, LeastOutstanding)));
+        test(test->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, LeastOutstanding));
+        test = ICE_UNCHECKED_CAST(TestIntfPrx, test->ice_connectionCached(false));
+        test(!test->ice_isConnectionCached());
+
+        //
+        // Without outstanding requests, the endpoints are used randomly.
+        //
+        set<string> names;
+        names.insert("AdapterLeast1");
+        names.insert("AdapterLeast2");
+        while(!names.empty())
+        {
+            names.erase(test->getAdapterName());
+        }
+
+        //
+        // A request waiting for its response on the connection to the
+        // first adapter steers the requests to the second adapter.
+        //
+        TestIntfPrxPtr slow = adapters[0]->getTestIntf();
+        slow->ice_ping();
+#ifdef ICE_CPP11_MAPPING
+        auto f = slow->sleepAsync(1000);
+#else
+        Ice::AsyncResultPtr r = slow->begin_sleep(1000);
+#endif
+        for(int i = 0; i < 10; ++i)
+        {
+            test(test->getAdapterName() == "AdapterLeast2");
+        }
+#ifdef ICE_CPP11_MAPPING
+        f.get();
+#else
+        slow->end_sleep(r);
+#endif
+
+        //
+        // Once the requests to the first adapter are slower, the requests
+        // are sent to the second adapter.
+        //
+        test = ICE_UNCHECKED_CAST(TestIntfPrx,
+                                  test->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, LeastLatency)));
+        test(test->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, LeastLatency));
+        for(int i = 0; i < 5; ++i)
+        {
+            slow->sleep(100);
+        }
+        for(int i = 0; i < 10; ++i)
+        {
+            test(test->getAdapterName() == "AdapterLeast2");
+        }
+
+        deactivate(com, adapters);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection pool... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter("AdapterPool", "default");
+
+        Ice::PropertiesPtr properties = communicator->getProperties();
+        properties->setProperty("Pooled", communicator->proxyToString(adapter->getTestIntf()));
+        properties->setProperty("Pooled.ConnectionPoolSize", "2");
+        TestIntfPrxPtr cached = ICE_UNCHECKED_CAST(TestIntfPrx, communicator->propertyToProxy("Pooled"));
+        TestIntfPrxPtr test = ICE_UNCHECKED_CAST(TestIntfPrx, cached->ice_connectionCached(false));
+        TestIntfPrxPtr single = ICE_UNCHECKED_CAST(TestIntfPrx, adapter->getTestIntf()->ice_connectionCached(false));
+        properties->setProperty("Pooled", "");
+        properties->setProperty("Pooled.ConnectionPoolSize", "");
+
+        //
+        // Without outstanding requests, the pool doesn't grow.
+        //
+        Ice::ConnectionPtr c1 = test->ice_getConnection();
+        test(test->ice_getConnection() == c1);
+        test(single->ice_getConnection() == c1);
+
+        //
+        // A request waiting for its response makes the pooled proxy use
+        // a new connection while the proxy without a pool and the proxy
+        // caching its connection keep using the busy connection.
+        //
+        test(cached->ice_getConnection() == c1);
+#ifdef ICE_CPP11_MAPPING
+        auto f = test->sleepAsync(500);
+#else
+        Ice::AsyncResultPtr r = test->begin_sleep(500);
+#endif
+        test(single->ice_getConnection() == c1);
+        test(cached->ice_getConnection() == c1);
+        Ice::ConnectionPtr c2 = test->ice_getConnection();
+        test(c2 != c1);
+#ifdef ICE_CPP11_MAPPING
+        f.get();
+#else
+        test->end_sleep(r);
+#endif
+
+        //
+        // The pool doesn't grow beyond its size.
+        //
+        for(int i = 0; i < 10; ++i)
+        {
+            Ice::ConnectionPtr c = test->ice_getConnection();
+            test(c == c1 || c == c2);
+            test->ice_ping();
+        }
+
+        com->deactivateObjectAdapter(adapter);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing connection pool with large messages... " << flush;
+    {
+        RemoteObjectAdapterPrxPtr adapter = com->createObjectAdapter("AdapterPoolLarge", "default");
+
+        //
+        // The payload is sent by reference, from the segments of the
+        // request. The small send buffer and the server which doesn't
+        // read while its only thread dispatches sleep keep the request
+        // in the send queue of the connection.
+        //
+        Ice::InitializationData initData;
+        initData.properties = communicator->getProperties()->clone();
+        initData.properties->setProperty("Ice.ZeroCopySize", "64");
+        initData.properties->setProperty("Ice.ConnectionPool.LargeMessageSize", "64");
+        initData.properties->setProperty("Ice.TCP.SndSize", "32768");
+        initData.properties->setProperty("Pooled", communicator->proxyToString(adapter->getTestIntf()));
+        initData.properties->setProperty("Pooled.ConnectionPoolSize", "2");
+        Ice::CommunicatorPtr pooledCommunicator = Ice::initialize(initData);
+        TestIntfPrxPtr test = ICE_UNCHECKED_CAST(TestIntfPrx, pooledCommunicator->propertyToProxy("Pooled")->
+                                                 ice_connectionCached(false));
+
+        Ice::ConnectionPtr c1 = test->ice_getConnection();
+#ifdef ICE_CPP11_MAPPING
+        auto f1 = test->sleepAsync(100);
+        Ice::ConnectionPtr c2 = test->ice_getConnection();
+        f1.get();
+#else
+        Ice::AsyncResultPtr r1 = test->begin_sleep(100);
+        Ice::ConnectionPtr c2 = test->ice_getConnection();
+        test->end_sleep(r1);
+#endif
+        test(c2 != c1);
+
+        //
+        // Both connections have a pending request, the connection sending
+        // a payload larger than Ice.ConnectionPool.LargeMessageSize is
+        // considered busier.
+        //
+        Test::ByteSeq bytes(900 * 1024);
+        TestIntfPrxPtr fixed1 = ICE_UNCHECKED_CAST(TestIntfPrx, test->ice_fixed(c1)->ice_oneway());
+        TestIntfPrxPtr fixed2 = ICE_UNCHECKED_CAST(TestIntfPrx, test->ice_fixed(c2));
+#ifdef ICE_CPP11_MAPPING
+        auto f2 = fixed2->sleepAsync(1000);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        auto f3 = fixed1->sendBytesAsync(bytes);
+#else
+        Ice::AsyncResultPtr r2 = fixed2->begin_sleep(1000);
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        Ice::AsyncResultPtr r3 = fixed1->begin_sendBytes(bytes);
+#endif
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        test(test->ice_getConnection() == c2);
+#ifdef ICE_CPP11_MAPPING
+        f2.get();
+        f3.get();
+#else
+        fixed2->end_sleep(r2);
+        fixed1->end_sendBytes(r3);
+#endif
+
+        pooledCommunicator->destroy();
+        com->deactivateObjectAdapter(adapter);
+    }
+    cout << "ok" << endl;
+
     cout << "testing endpoint mode filtering... " << flush;
     {
         vector<RemoteObjectAdapterPrxPtr> adapters;
@@ -102,3 +102,19 @@ TestI::getAdapterName(const Ice::Current& current)
 {
     return current.adapter->getName();
 }
+
+void
+TestI::sleep(Ice::Int ms, const Ice::Current&)
+{
+    IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(ms));
+}
+
+#ifdef ICE_CPP11_MAPPING
+void
+TestI::sendBytes(Test::ByteSeq, const Ice::Current&)
+#else
+void
+TestI::sendBytes(const Test::ByteSeq&, const Ice::Current&)
+#endif
+{
+}
@@ -50,6 +50,12 @@ class TestI : public Test::TestIntf
 public:
 
     virtual std::string getAdapterName(const Ice::Current&);
+    virtual void sleep(Ice::Int, const Ice::Current&);
+#ifdef ICE_CPP11_MAPPING
+    virtual void sendBytes(Test::ByteSeq, const Ice::Current&);
+#else
+    virtual void sendBytes(const Test::ByteSeq&, const Ice::Current&);
+#endif
 };
 
 #endif
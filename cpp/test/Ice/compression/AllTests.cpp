@@ -0,0 +1,84 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+
+namespace
+{
+
+Ice::ByteSeq
+createData(size_t size)
+{
+    //
+    // Compressible data, the messages must be compressed by every codec.
+    //
+    Ice::ByteSeq seq(size);
+    for(size_t i = 0; i < seq.size(); ++i)
+    {
+        seq[i] = static_cast<Ice::Byte>(i % 16);
+    }
+    return seq;
+}
+
+}
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+    Ice::PropertiesPtr properties = communicator->getProperties();
+
+    //
+    // The endpoint of the test driver, which forwards the messages to the
+    // server and records their compression status.
+    //
+    Test::TestIntfPrxPtr proxy = ICE_UNCHECKED_CAST(Test::TestIntfPrx,
+        communicator->stringToProxy("test:" + helper->getTestEndpoint(10))->ice_compress(true));
+
+    Ice::ByteSeq small = createData(10);
+    Ice::ByteSeq large = createData(10 * 1024);
+
+    cout << "testing compression with the codec of the communicator... " << flush;
+    {
+        test(proxy->echo(small) == small);
+        test(proxy->echo(large) == large);
+    }
+    cout << "ok" << endl;
+
+    cout << "testing compression with the codec of the proxy... " << flush;
+    {
+        //
+        // The requests sent over the same connection are compressed with
+        // the codec of their proxy, and the replies with the codec of the
+        // request.
+        //
+        Ice::StringSeq codecs = properties->getPropertyAsList("Test.Codecs");
+        for(Ice::StringSeq::const_iterator p = codecs.begin(); p != codecs.end(); ++p)
+        {
+            properties->setProperty("Test.Proxy", communicator->proxyToString(proxy));
+            properties->setProperty("Test.Proxy.CompressionCodec", *p);
+            Test::TestIntfPrxPtr prx = ICE_UNCHECKED_CAST(Test::TestIntfPrx,
+                communicator->propertyToProxy("Test.Proxy")->ice_compress(true));
+            test(prx->ice_getConnection() == proxy->ice_getConnection());
+
+            Ice::PropertyDict props = communicator->proxyToProperty(prx, "Test");
+            test(props["Test.CompressionCodec"] == *p);
+
+            test(prx->echo(small) == small);
+            test(prx->echo(large) == large);
+        }
+
+        properties->setProperty("Test.Proxy", communicator->proxyToString(proxy));
+        properties->setProperty("Test.Proxy.CompressionCodec", "");
+        Ice::ObjectPrxPtr prx = communicator->propertyToProxy("Test.Proxy");
+        test(communicator->proxyToProperty(prx, "Test").count("Test.CompressionCodec") == 0);
+    }
+    cout << "ok" << endl;
+
+    proxy->shutdown();
+}
@@ -0,0 +1,20 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+Ice::ByteSeq
+TestIntfI::echo(ICE_IN(Ice::ByteSeq) seq, const Ice::Current&)
+{
+    return seq;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
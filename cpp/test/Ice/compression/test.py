@@ -0,0 +1,117 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+import select, socket, struct
+import NetworkProxy
+
+codecIds = { "bzip2" : 2, "zlib" : 3, "lz4" : 4, "zstd" : 5 }
+
+#
+# The codecs Ice is built with, the zlib, lz4 and zstd codecs are only built on Linux
+# if found by pkg-config.
+#
+codecs = ["bzip2"]
+if isinstance(platform, Linux):
+    for (codec, package) in [("zlib", "zlib"), ("lz4", "liblz4"), ("zstd", "libzstd")]:
+        if os.system("pkg-config --exists {0} 2> /dev/null".format(package)) == 0:
+            codecs.append(codec)
+
+#
+# Forwards the Ice protocol messages between the client and the server and records the
+# compression status of the requests and replies sent in each direction. It also emulates
+# a server of a previous version, which only supports bzip2, by clearing the codecs
+# advertised in the validate connection message of the server.
+#
+class CompressionSpyConnection(NetworkProxy.BaseConnection):
+
+    def __init__(self, s, remote, spy):
+        NetworkProxy.BaseConnection.__init__(self, s, remote)
+        self.spy = spy
+
+    def run(self):
+        try:
+            self.remoteSocket = socket.create_connection(("127.0.0.1", self.spy.serverPort))
+            buffers = { self.socket : bytearray(), self.remoteSocket : bytearray() }
+            while not self.closed:
+                readables, writeables, exceptions = select.select([self.socket, self.remoteSocket], [], [])
+                for r in readables:
+                    data = r.recv(4096)
+                    if len(data) == 0:
+                        self.closed = True
+                        break
+                    fromClient = r == self.socket
+                    buffer = buffers[r] + bytearray(data)
+                    while len(buffer) >= 14:
+                        size = struct.unpack("<i", bytes(buffer[10:14]))[0]
+                        if len(buffer) < size:
+                            break
+                        message = self.spy.received(fromClient, buffer[0:size])
+                        (self.remoteSocket if fromClient else self.socket).sendall(bytes(message))
+                        buffer = buffer[size:]
+                    buffers[r] = buffer
+        except Exception as ex:
+            pass
+        finally:
+            self.close()
+
+class CompressionSpy(NetworkProxy.BaseProxy):
+
+    def __init__(self, port, serverPort, oldServer):
+        self.serverPort = serverPort
+        self.oldServer = oldServer
+        self.statuses = { True : set(), False : set() }
+        NetworkProxy.BaseProxy.__init__(self, port)
+
+    def createConnection(self, socket, peer):
+        return CompressionSpyConnection(socket, peer, self)
+
+    def received(self, fromClient, message):
+        messageType = message[8]
+        if messageType == 3 and self.oldServer:
+            message[9] = 0
+        elif messageType in [0, 1, 2]:
+            with self.cond:
+                self.statuses[fromClient].add(message[9])
+        return message
+
+class CompressionTestCase(ClientServerTestCase):
+
+    def __init__(self, name, codec, oldServer=False):
+        ClientServerTestCase.__init__(self, name, client=Client(props={
+            "Ice.Compression.Codec" : codec,
+            "Test.Codecs" : " ".join(codecs)
+        }))
+        self.oldServer = oldServer
+
+    def canRun(self, current):
+        return current.config.buildPlatform not in ["iphonesimulator", "iphoneos"]
+
+    def runClientSide(self, current):
+        spy = CompressionSpy(current.driver.getTestPort(10), current.driver.getTestPort(0), self.oldServer)
+        try:
+            ClientServerTestCase.runClientSide(self, current)
+        finally:
+            spy.terminate()
+
+        current.write("testing compression status of the messages... ")
+        for fromClient in [True, False]:
+            statuses = spy.statuses[fromClient]
+            if self.oldServer:
+                #
+                # Only bzip2 is used with a server which doesn't advertise its codecs.
+                #
+                if not codecIds["bzip2"] in statuses or max(statuses) > codecIds["bzip2"]:
+                    raise RuntimeError("unexpected compression status {0}".format(sorted(statuses)))
+            else:
+                for codec in codecs:
+                    if not codecIds[codec] in statuses:
+                        raise RuntimeError("no message compressed with {0}".format(codec))
+        current.writeln("ok")
+
+TestSuite(__name__,
+          [CompressionTestCase("client/server with {0} compression".format(c), c) for c in codecs] +
+          [CompressionTestCase("client/server with bzip2-only server", codecs[-1], oldServer=True)],
+          options={ "protocol" : ["tcp"], "ipv6" : [False], "compress" : [False] },
+          multihost=False)
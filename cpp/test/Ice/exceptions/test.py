@@ -0,0 +1,15 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# Also run the collocated test with the direct dispatch of synchronous invocations, the
+# exceptions raised by the servant must be the same as with a marshaled reply (C++11 only).
+#
+TestSuite(__name__, [
+    ClientServerTestCase(),
+    ClientAMDServerTestCase(),
+    CollocatedTestCase(),
+    CollocatedTestCase(name="collocated with direct dispatch", props={ "Ice.CollocationDirectDispatch" : 1 })
+])
@@ -0,0 +1,19 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# Also run the test with the work-stealing mode for the adapter thread pools, the
+# serialize mode must still guarantee in-order dispatch.
+#
+workStealingProps = {
+    "TestAdapter1.ThreadPool.Mode" : "WorkStealing",
+    "TestAdapter2.ThreadPool.Mode" : "WorkStealing"
+}
+
+TestSuite(__name__, [
+    ClientServerTestCase(server=Server(readyCount=2)),
+    ClientServerTestCase(name="client/server with work-stealing thread pools",
+                         server=Server(readyCount=2, props=workStealingProps))
+])
@@ -626,6 +626,19 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
         test(sm2->receivedBytes - sm1->receivedBytes == requestSz + static_cast<int>(bs.size()) + 4);
         test(sm2->sentBytes - sm1->sentBytes == replySz);
 
+        test(!cm2->compressedBytes && !cm2->uncompressedBytes && !cm2->compressionTime);
+
+        //
+        // Compressed messages update the compression metrics of the connection.
+        //
+        bs.resize(1024 * 100);
+        ICE_UNCHECKED_CAST(MetricsPrx, metrics->ice_compress(true))->opByteS(bs);
+
+        cm2 = ICE_DYNAMIC_CAST(IceMX::ConnectionMetrics, clientMetrics->getMetricsView("View", timestamp)["Connection"][0]);
+        test(cm2->compressedBytes && cm2->uncompressedBytes && cm2->compressionTime);
+        test(*cm2->uncompressedBytes > static_cast<Ice::Long>(bs.size()));
+        test(*cm2->compressedBytes < *cm2->uncompressedBytes);
+
         props["IceMX.Metrics.View.Map.Connection.GroupBy"] = "state";
         updateProps(clientProps, serverProps, update.get(), props, "Connection");
 
@@ -836,6 +849,47 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
         testAttribute(clientMetrics, clientProps, update.get(), "EndpointLookup", "endpointPort", port, c);
 
         cout << "ok" << endl;
+
+        cout << "testing host resolver metrics... " << flush;
+
+        props["IceMX.Metrics.View.Map.HostResolver.GroupBy"] = "id";
+        updateProps(clientProps, serverProps, update.get(), props, "HostResolver");
+        test(clientMetrics->getMetricsView("View", timestamp)["HostResolver"].empty());
+
+        c();
+
+        map = toMap(clientMetrics->getMetricsView("View", timestamp)["HostResolver"]);
+        test(map.size() == 1);
+        IceMX::HostResolverMetricsPtr hm = ICE_DYNAMIC_CAST(IceMX::HostResolverMetrics, map["localhost"]);
+        test(hm && hm->current == 0 && hm->total == 1 && hm->failures == 0 && hm->hits == 0 && hm->coalesced == 0);
+
+        {
+            //
+            // Use a dedicated communicator to cache the resolved addresses, the second
+            // connection establishment is served by the cache of the resolver.
+            //
+            Ice::InitializationData initData;
+            initData.properties = communicator->getProperties()->clone();
+            initData.properties->setProperty("Ice.HostResolver.CacheTTL", "60");
+            Ice::CommunicatorHolder ich(initData);
+            IceMX::MetricsAdminPrxPtr cacheMetrics = ICE_CHECKED_CAST(IceMX::MetricsAdminPrx, ich->getAdmin(), "Metrics");
+            test(cacheMetrics->getMetricsView("View", timestamp)["HostResolver"].empty());
+
+            Connect cc(ich->stringToProxy(communicator->proxyToString(prx)));
+            cc();
+            cc();
+
+            map = toMap(cacheMetrics->getMetricsView("View", timestamp)["HostResolver"]);
+            test(map.size() == 1);
+            hm = ICE_DYNAMIC_CAST(IceMX::HostResolverMetrics, map["localhost"]);
+            test(hm && hm->current == 0 && hm->total == 2 && hm->failures == 0 && hm->hits == 1 && hm->coalesced == 0);
+        }
+
+        testAttribute(clientMetrics, clientProps, update.get(), "HostResolver", "parent", "Communicator", c);
+        testAttribute(clientMetrics, clientProps, update.get(), "HostResolver", "id", "localhost", c);
+        testAttribute(clientMetrics, clientProps, update.get(), "HostResolver", "host", "localhost", c);
+
+        cout << "ok" << endl;
 #endif
     }
 
@@ -1499,6 +1553,37 @@ allTests(Test::TestHelper* helper, const CommunicatorObserverIPtr& obsv)
     }
     cout << "ok" << endl;
 
+    cout << "testing buffer pool metrics... " << flush;
+
+    props["IceMX.Metrics.View.Map.BufferPool.GroupBy"] = "id";
+    updateProps(clientProps, serverProps, update.get(), props, "BufferPool");
+
+    //
+    // There's one metrics object per size class, from 256 bytes to 64KB.
+    //
+    map = toMap(clientMetrics->getMetricsView("View", timestamp)["BufferPool"]);
+    test(map.size() == 9);
+    test(map.find("256") != map.end() && map.find("65536") != map.end());
+    IceMX::BufferPoolMetricsPtr bm1 = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, map["256"]);
+    test(bm1->id == "256" && bm1->current == 1);
+
+    for(int i = 0; i < 10; ++i)
+    {
+        metrics->op();
+    }
+
+    //
+    // The buffer of a request is returned to the pool once the request
+    // completes, the next requests reuse it.
+    //
+    map = toMap(clientMetrics->getMetricsView("View", timestamp)["BufferPool"]);
+    IceMX::BufferPoolMetricsPtr bm2 = ICE_DYNAMIC_CAST(IceMX::BufferPoolMetrics, map["256"]);
+    test(bm2->allocations >= bm1->allocations + 10);
+    test(bm2->hits >= bm1->hits + 9);
+    test(bm2->hits <= bm2->allocations);
+
+    cout << "ok" << endl;
+
     cout << "testing metrics view enable/disable..." << flush;
 
     Ice::StringSeq disabledViews;
@@ -238,4 +238,102 @@ batchOneways(const Test::MyClassPrxPtr& p)
         batch1->opByteSOneway(bs1);
         batch1->ice_getConnection()->flushBatchRequests(Ice::ICE_SCOPED_ENUM(CompressBatch, BasedOnProxy));
     }
+
+    if(batch->ice_getConnection())
+    {
+        //
+        // Time-based auto flush, configured for the communicator or for a
+        // proxy: the batches are flushed without explicit flush.
+        //
+        for(int j = 0; j < 2; ++j)
+        {
+            Ice::InitializationData initData;
+            initData.properties = p->ice_getCommunicator()->getProperties()->clone();
+            if(j == 0)
+            {
+                initData.properties->setProperty("Ice.BatchAutoFlushDelay", "50");
+            }
+            else
+            {
+                initData.properties->setProperty("Batch", p->ice_toString());
+                initData.properties->setProperty("Batch.BatchAutoFlushDelay", "50");
+            }
+            Ice::CommunicatorHolder ich(initData);
+
+            Test::MyClassPrxPtr batch5 = ICE_UNCHECKED_CAST(Test::MyClassPrx,
+                j == 0 ? ich->stringToProxy(p->ice_toString()) : ich->propertyToProxy("Batch"))->ice_batchOneway();
+            if(j == 1)
+            {
+                test(batch5->ice_getCommunicator()->proxyToProperty(batch5, "Batch")["Batch.BatchAutoFlushDelay"] ==
+                     "50");
+            }
+
+            //
+            // Wait for the batch requests flushed by the previous tests to be
+            // dispatched, this also resets the call count.
+            //
+            do
+            {
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            }
+            while(p->opByteSOnewayCallCount() > 0);
+
+            for(i = 0; i < 3; ++i)
+            {
+                batch5->opByteSOneway(bs1);
+            }
+
+            count = 0;
+            for(i = 0; i < 500 && count < 3; ++i)
+            {
+                count += p->opByteSOnewayCallCount();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            test(count == 3);
+        }
+
+        //
+        // Adaptive auto flush: the batches are flushed when they reach the
+        // minimum batch size (4KB) if the connection keeps up, they are only
+        // flushed when they reach 1MB without it. Each request is larger
+        // than the minimum batch size so with an established connection
+        // each request flushes the previous ones and only the last request
+        // is still queued.
+        //
+        {
+            Ice::InitializationData initData;
+            initData.properties = p->ice_getCommunicator()->getProperties()->clone();
+            initData.properties->setProperty("Ice.BatchAutoFlushAdaptive", "1");
+            Ice::CommunicatorHolder ich(initData);
+
+            Test::MyClassPrxPtr batch6 =
+                ICE_UNCHECKED_CAST(Test::MyClassPrx, ich->stringToProxy(p->ice_toString()))->ice_batchOneway();
+            batch6->ice_getConnection(); // Establish the connection
+
+            p->opByteSOnewayCallCount(); // Reset the call count
+            for(i = 0; i < 10; ++i)
+            {
+                batch6->opByteSOneway(bs1);
+            }
+
+            count = 0;
+            for(i = 0; i < 500 && count < 9; ++i)
+            {
+                count += p->opByteSOnewayCallCount();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            test(count == 9);
+            IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+            count += p->opByteSOnewayCallCount();
+            test(count == 9);
+
+            batch6->ice_flushBatchRequests();
+            for(i = 0; i < 500 && count < 10; ++i)
+            {
+                count += p->opByteSOnewayCallCount();
+                IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(10));
+            }
+            test(count == 10);
+        }
+    }
 }
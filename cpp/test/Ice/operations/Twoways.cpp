@@ -425,6 +425,32 @@ twoways(const Ice::CommunicatorPtr& communicator, const Test::MyClassPrxPtr& p)
         test(rso[7] == Ice::Byte(0xf4));
     }
 
+    {
+        //
+        // Large sequences, sent by reference if they are larger than Ice.ZeroCopySize.
+        //
+        Test::ByteS bsi1(64 * 1024);
+        Test::ByteS bsi2(128 * 1024);
+        for(Test::ByteS::size_type i = 0; i < bsi2.size(); ++i)
+        {
+            if(i < bsi1.size())
+            {
+                bsi1[i] = static_cast<Ice::Byte>(i % 251);
+            }
+            bsi2[i] = static_cast<Ice::Byte>(i % 253);
+        }
+
+        Test::ByteS bso;
+        Test::ByteS rso;
+
+        rso = p->opByteS(bsi1, bsi2, bso);
+        test(bso.size() == bsi1.size());
+        test(std::equal(bsi1.rbegin(), bsi1.rend(), bso.begin()));
+        test(rso.size() == bsi1.size() + bsi2.size());
+        test(std::equal(bsi1.begin(), bsi1.end(), rso.begin()));
+        test(std::equal(bsi2.begin(), bsi2.end(), rso.begin() + bsi1.size()));
+    }
+
     {
         Test::BoolS bsi1;
         Test::BoolS bsi2;
@@ -0,0 +1,55 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+testcases = [
+    ClientServerTestCase(),
+    ClientAMDServerTestCase(),
+    CollocatedTestCase()
+]
+
+#
+# Also run the collocated test with the direct dispatch of synchronous invocations, which
+# doesn't marshal the requests and replies (C++11 only).
+#
+testcases += [ CollocatedTestCase(name="collocated with direct dispatch", props={ "Ice.CollocationDirectDispatch" : 1 }) ]
+
+#
+# Also run the test with a small zero-copy threshold to send most of the byte sequences
+# by reference.
+#
+testcases += [ ClientServerTestCase(name="client/server with zero-copy", props={ "Ice.ZeroCopySize" : 1 }) ]
+
+#
+# Also run the test with the messages larger than 1KB sent in fragments, with and without
+# compression.
+#
+testcases += [
+    ClientServerTestCase(name="client/server with message fragments", props={ "Ice.MessageFragmentSize" : 1 }),
+    ClientServerTestCase(name="client/server with compressed message fragments",
+                         props={ "Ice.MessageFragmentSize" : 1, "Ice.Override.Compress" : 1 })
+]
+
+#
+# Also run the test with the work-stealing mode for the client and server thread pools.
+#
+workStealingProps = {
+    "Ice.ThreadPool.Client.Mode" : "WorkStealing",
+    "Ice.ThreadPool.Client.SizeMax" : 4,
+    "Ice.ThreadPool.Server.Mode" : "WorkStealing",
+    "Ice.ThreadPool.Server.SizeMax" : 4
+}
+testcases += [ ClientServerTestCase(name="client/server with work-stealing thread pools", props=workStealingProps) ]
+
+#
+# Also run the test with all the messages compressed with zlib, if Ice is built with zlib support.
+#
+if isinstance(platform, Linux) and os.system("pkg-config --exists zlib 2> /dev/null") == 0:
+    zlibProps = {
+        "Ice.Override.Compress" : 1,
+        "Ice.Compression.Codec" : "zlib"
+    }
+    testcases += [ ClientServerTestCase(name="client/server with zlib compression", props=zlibProps) ]
+
+TestSuite(__name__, testcases)
@@ -486,6 +486,12 @@ allTests(Test::TestHelper* helper)
     prop->setProperty(property, "Ordered");
     b1 = communicator->propertyToProxy(propertyPrefix);
     test(b1->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, Ordered));
+    prop->setProperty(property, "LeastLatency");
+    b1 = communicator->propertyToProxy(propertyPrefix);
+    test(b1->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, LeastLatency));
+    prop->setProperty(property, "LeastOutstanding");
+    b1 = communicator->propertyToProxy(propertyPrefix);
+    test(b1->ice_getEndpointSelection() == Ice::ICE_ENUM(EndpointSelectionType, LeastOutstanding));
     prop->setProperty(property, "");
 
     property = propertyPrefix + ".CollocationOptimized";
@@ -550,6 +556,8 @@ allTests(Test::TestHelper* helper)
     test(proxyProps["Test.ConnectionCached"] == "1");
     test(proxyProps["Test.PreferSecure"] == "0");
     test(proxyProps["Test.EndpointSelection"] == "Ordered");
+    test(communicator->proxyToProperty(b1->ice_endpointSelection(Ice::ICE_ENUM(EndpointSelectionType, LeastLatency)),
+                                       "Test")["Test.EndpointSelection"] == "LeastLatency");
     test(proxyProps["Test.LocatorCacheTimeout"] == "100");
     test(proxyProps["Test.InvocationTimeout"] == "1234");
 
@@ -570,6 +578,18 @@ allTests(Test::TestHelper* helper)
     test(proxyProps["Test.Locator.Router.LocatorCacheTimeout"] == "200");
     test(proxyProps["Test.Locator.Router.InvocationTimeout"] == "1500");
 
+    prop->setProperty("Pooled", "test");
+    prop->setProperty("Pooled.ConnectionPoolSize", "4");
+    b1 = communicator->propertyToProxy("Pooled");
+    test(communicator->proxyToProperty(b1, "Test")["Test.ConnectionPoolSize"] == "4");
+    test(!Ice::targetEqualTo(b1, communicator->stringToProxy("test")));
+    prop->setProperty("Pooled.ConnectionPoolSize", "1");
+    b1 = communicator->propertyToProxy("Pooled");
+    test(communicator->proxyToProperty(b1, "Test").count("Test.ConnectionPoolSize") == 0);
+    test(Ice::targetEqualTo(b1, communicator->stringToProxy("test")));
+    prop->setProperty("Pooled", "");
+    prop->setProperty("Pooled.ConnectionPoolSize", "");
+
     cout << "ok" << endl;
 
     cout << "testing ice_getCommunicator... " << flush;
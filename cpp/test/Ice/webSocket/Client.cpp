@@ -0,0 +1,144 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <Ice/WSUtil.h>
+#include <TestHelper.h>
+
+#include <string.h>
+
+using namespace std;
+
+namespace
+{
+
+bool
+isValidUTF8(const string& s)
+{
+    return IceInternal::wsIsValidUTF8(reinterpret_cast<const Ice::Byte*>(s.data()), s.size());
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int, char**)
+{
+    cout << "testing masking... " << flush;
+    {
+        const Ice::Byte mask[4] = { 0x12, 0x34, 0x56, 0x78 };
+
+        vector<Ice::Byte> src(300);
+        for(size_t i = 0; i < src.size(); ++i)
+        {
+            src[i] = static_cast<Ice::Byte>(i * 7);
+        }
+
+        //
+        // Check all the lengths up to several vectors, with unaligned buffers
+        // and all the key offsets, against a byte at a time masking.
+        //
+        for(size_t start = 0; start < 4; ++start)
+        {
+            for(size_t offset = 0; offset < 4; ++offset)
+            {
+                for(size_t n = 0; n + start < src.size(); ++n)
+                {
+                    vector<Ice::Byte> expected(n + 1, 0xff);
+                    for(size_t i = 0; i < n; ++i)
+                    {
+                        expected[i] = static_cast<Ice::Byte>(src[start + i] ^ mask[(offset + i) % 4]);
+                    }
+
+                    vector<Ice::Byte> dst(n + 1, 0xff);
+                    IceInternal::wsMask(&dst[0], &src[start], n, mask, offset);
+                    test(dst == expected);
+
+                    //
+                    // Masking in place and unmasking.
+                    //
+                    vector<Ice::Byte> buf(src.begin() + static_cast<ptrdiff_t>(start), src.end());
+                    IceInternal::wsMask(&buf[0], &buf[0], n, mask, offset);
+                    test(memcmp(&buf[0], &expected[0], n) == 0);
+                    IceInternal::wsMask(&buf[0], &buf[0], n, mask, offset);
+                    test(equal(buf.begin(), buf.end(), src.begin() + static_cast<ptrdiff_t>(start)));
+                }
+            }
+        }
+
+        //
+        // Masking a payload in several chunks is the same as masking it at once.
+        //
+        vector<Ice::Byte> expected(src.size());
+        IceInternal::wsMask(&expected[0], &src[0], src.size(), mask, 0);
+        for(size_t chunk = 1; chunk < 70; ++chunk)
+        {
+            vector<Ice::Byte> dst(src.size());
+            for(size_t pos = 0; pos < src.size(); pos += chunk)
+            {
+                IceInternal::wsMask(&dst[pos], &src[pos], min(chunk, src.size() - pos), mask, pos);
+            }
+            test(dst == expected);
+        }
+    }
+    cout << "ok" << endl;
+
+    cout << "testing UTF-8 validation... " << flush;
+    {
+        test(isValidUTF8(""));
+        test(isValidUTF8("hello"));
+        test(isValidUTF8(string(1000, 'a')));
+        test(isValidUTF8("caf\xc3\xa9"));                           // U+00E9
+        test(isValidUTF8("\xe2\x82\xac"));                          // U+20AC
+        test(isValidUTF8("\xf0\x9f\x98\x80"));                      // U+1F600
+        test(isValidUTF8("\xef\xbf\xbf"));                          // U+FFFF
+        test(isValidUTF8("\xf4\x8f\xbf\xbf"));                      // U+10FFFF
+        test(isValidUTF8("\xed\x9f\xbf"));                          // U+D7FF
+        test(isValidUTF8(string(100, 'a') + "\xc3\xa9" + string(100, 'b') + "\xe2\x82\xac"));
+
+        test(!isValidUTF8("\x80"));                                 // Unexpected continuation byte
+        test(!isValidUTF8("\xc3"));                                 // Truncated sequence
+        test(!isValidUTF8("\xe2\x82"));
+        test(!isValidUTF8("\xc3\x28"));                             // Invalid continuation byte
+        test(!isValidUTF8("\xe2\x28\xac"));
+        test(!isValidUTF8("\xe2\x82\x28"));
+        test(!isValidUTF8("\xf0\x9f\x98\x28"));
+        test(!isValidUTF8("\xc0\xaf"));                             // Overlong encodings
+        test(!isValidUTF8("\xc1\xbf"));
+        test(!isValidUTF8("\xe0\x80\xaf"));
+        test(!isValidUTF8("\xf0\x80\x80\xaf"));
+        test(!isValidUTF8("\xed\xa0\x80"));                         // Surrogates
+        test(!isValidUTF8("\xed\xbf\xbf"));
+        test(!isValidUTF8("\xf4\x90\x80\x80"));                     // Above U+10FFFF
+        test(!isValidUTF8("\xf5\x80\x80\x80"));
+        test(!isValidUTF8("\xff"));
+
+        //
+        // Invalid bytes at every position of a long ASCII string, to check
+        // the vectorized ASCII checks.
+        //
+        for(size_t i = 0; i < 100; ++i)
+        {
+            string s(100, 'a');
+            s[i] = '\x80';
+            test(!isValidUTF8(s));
+            s[i] = '\xc3';
+            test(!isValidUTF8(s));
+            if(i < 99)
+            {
+                s[i + 1] = '\xa9';
+                test(isValidUTF8(s));
+            }
+        }
+    }
+    cout << "ok" << endl;
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,10 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs        := client
+$(test)_cppflags        := -I$(srcdir)
+
+$(test)_client_sources  := Client.cpp
+
+tests += $(test)
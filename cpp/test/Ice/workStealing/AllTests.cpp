@@ -0,0 +1,94 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <Test.h>
+
+using namespace std;
+
+void
+allTests(Test::TestHelper* helper)
+{
+    Ice::CommunicatorPtr communicator = helper->communicator();
+
+    Test::TestIntfPrxPtr proxy1 =
+        ICE_UNCHECKED_CAST(Test::TestIntfPrx, communicator->stringToProxy("test:" + helper->getTestEndpoint()));
+    Test::TestIntfPrxPtr proxy2 =
+        ICE_UNCHECKED_CAST(Test::TestIntfPrx, communicator->stringToProxy("test:" + helper->getTestEndpoint(1)));
+
+    const int connectionCount = 4;
+
+    cout << "testing concurrent dispatch... " << flush;
+    {
+        //
+        // Each call is sent over its own connection and blocks until all
+        // the calls are dispatched, the work-stealing executor of the
+        // server thread pool must dispatch them concurrently.
+        //
+        vector<Test::TestIntfPrxPtr> proxies;
+        for(int i = 0; i < connectionCount; ++i)
+        {
+            ostringstream os;
+            os << "concurrent-" << i;
+            proxies.push_back(ICE_UNCHECKED_CAST(Test::TestIntfPrx, proxy1->ice_connectionId(os.str())));
+        }
+
+#ifdef ICE_CPP11_MAPPING
+        vector<future<bool>> results;
+        for(vector<Test::TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            results.push_back((*p)->waitForConcurrentCallsAsync(connectionCount, 30000));
+        }
+        for(vector<future<bool>>::iterator p = results.begin(); p != results.end(); ++p)
+        {
+            test(p->get());
+        }
+#else
+        vector<Ice::AsyncResultPtr> results;
+        for(vector<Test::TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            results.push_back((*p)->begin_waitForConcurrentCalls(connectionCount, 30000));
+        }
+        for(size_t i = 0; i < results.size(); ++i)
+        {
+            test(proxies[i]->end_waitForConcurrentCalls(results[i]));
+        }
+#endif
+    }
+    cout << "ok" << endl;
+
+    cout << "testing serialized dispatch... " << flush;
+    {
+        //
+        // With Serialize=1, the oneway calls of a connection must be
+        // dispatched one at a time and in order even though they are
+        // executed by different executor threads.
+        //
+        vector<Test::TestIntfPrxPtr> proxies;
+        for(int i = 0; i < connectionCount; ++i)
+        {
+            ostringstream os;
+            os << "serialized-" << i;
+            proxies.push_back(ICE_UNCHECKED_CAST(Test::TestIntfPrx, proxy2->ice_connectionId(os.str())));
+        }
+
+        for(int value = 1; value <= 500; ++value)
+        {
+            for(int i = 0; i < connectionCount; ++i)
+            {
+                proxies[i]->ice_oneway()->serialized(i, value);
+            }
+        }
+
+        for(vector<Test::TestIntfPrxPtr>::const_iterator p = proxies.begin(); p != proxies.end(); ++p)
+        {
+            (*p)->ice_ping();
+        }
+        test(proxy2->checkSerialized());
+    }
+    cout << "ok" << endl;
+
+    proxy1->shutdown();
+}
@@ -0,0 +1,47 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestHelper.h>
+#include <TestI.h>
+
+using namespace std;
+
+class Server : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Server::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+
+    properties->setProperty("TestAdapter1.Endpoints", getTestEndpoint());
+    properties->setProperty("TestAdapter1.ThreadPool.Size", "1");
+    properties->setProperty("TestAdapter1.ThreadPool.SizeMax", "4");
+    properties->setProperty("TestAdapter1.ThreadPool.Mode", "WorkStealing");
+    Ice::ObjectAdapterPtr adapter1 = communicator->createObjectAdapter("TestAdapter1");
+    adapter1->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+
+    properties->setProperty("TestAdapter2.Endpoints", getTestEndpoint(1));
+    properties->setProperty("TestAdapter2.ThreadPool.Size", "1");
+    properties->setProperty("TestAdapter2.ThreadPool.SizeMax", "4");
+    properties->setProperty("TestAdapter2.ThreadPool.Serialize", "1");
+    properties->setProperty("TestAdapter2.ThreadPool.Mode", "WorkStealing");
+    Ice::ObjectAdapterPtr adapter2 = communicator->createObjectAdapter("TestAdapter2");
+    adapter2->add(ICE_MAKE_SHARED(TestIntfI), Ice::stringToIdentity("test"));
+
+    adapter1->activate();
+    adapter2->activate();
+
+    serverReady();
+
+    communicator->waitForShutdown();
+}
+
+DEFINE_TEST(Server)
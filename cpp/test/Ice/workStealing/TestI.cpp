@@ -0,0 +1,72 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <TestI.h>
+
+using namespace std;
+
+TestIntfI::TestIntfI() :
+    _calls(0),
+    _serialized(true)
+{
+}
+
+bool
+TestIntfI::waitForConcurrentCalls(int count, int timeout, const Ice::Current&)
+{
+    Lock sync(*this);
+    if(++_calls >= count)
+    {
+        notifyAll();
+        return true;
+    }
+
+    IceUtil::Time end = IceUtil::Time::now(IceUtil::Time::Monotonic) + IceUtil::Time::milliSeconds(timeout);
+    while(_calls < count)
+    {
+        IceUtil::Time now = IceUtil::Time::now(IceUtil::Time::Monotonic);
+        if(now >= end || !timedWait(end - now))
+        {
+            return _calls >= count;
+        }
+    }
+    return true;
+}
+
+void
+TestIntfI::serialized(int connection, int value, const Ice::Current&)
+{
+    {
+        Lock sync(*this);
+        if(_dispatching.find(connection) != _dispatching.end() || _values[connection] + 1 != value)
+        {
+            _serialized = false;
+        }
+        _dispatching.insert(connection);
+        _values[connection] = value;
+    }
+
+    //
+    // Give a chance to another thread to dispatch a call from the same
+    // connection if the calls aren't serialized.
+    //
+    IceUtil::ThreadControl::yield();
+
+    Lock sync(*this);
+    _dispatching.erase(connection);
+}
+
+bool
+TestIntfI::checkSerialized(const Ice::Current&)
+{
+    Lock sync(*this);
+    return _serialized;
+}
+
+void
+TestIntfI::shutdown(const Ice::Current& current)
+{
+    current.adapter->getCommunicator()->shutdown();
+}
@@ -0,0 +1,33 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#ifndef TEST_I_H
+#define TEST_I_H
+
+#include <Test.h>
+#include <IceUtil/Monitor.h>
+
+#include <map>
+#include <set>
+
+class TestIntfI : public Test::TestIntf, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    TestIntfI();
+
+    virtual bool waitForConcurrentCalls(int, int, const Ice::Current&);
+    virtual void serialized(int, int, const Ice::Current&);
+    virtual bool checkSerialized(const Ice::Current&);
+    virtual void shutdown(const Ice::Current&);
+
+private:
+
+    int _calls;
+    std::map<int, int> _values;
+    std::set<int> _dispatching;
+    bool _serialized;
+};
+
+#endif
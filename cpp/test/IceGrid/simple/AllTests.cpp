@@ -3,6 +3,7 @@
 //
 
 #include <IceUtil/IceUtil.h>
+#include <IceUtil/FileUtil.h>
 #include <Ice/Ice.h>
 #include <IceGrid/IceGrid.h>
 #include <TestHelper.h>
@@ -335,5 +336,30 @@ allTestsWithDeploy(Test::TestHelper* helper)
 
     admin->stopServer("server");
 
+    cout << "testing database info and copy... " << flush;
+    {
+        IceGrid::DatabaseInfo info = admin->getDatabaseInfo();
+        test(info.pageSize > 0);
+        test(info.usedPages > 0 && info.usedPages * info.pageSize <= info.mapSize);
+
+        //
+        // The registry runs in the test directory.
+        //
+        const string path = "registry-copy";
+        admin->copyDatabase(path, true);
+        test(IceUtilInternal::fileExists(path + "/data.mdb"));
+        try
+        {
+            admin->copyDatabase(path, false);
+            test(false);
+        }
+        catch(const IceGrid::FileNotAvailableException&)
+        {
+        }
+        IceUtilInternal::remove(path + "/data.mdb");
+        IceUtilInternal::rmdir(path);
+    }
+    cout << "ok" << endl;
+
     session->destroy();
 }
@@ -0,0 +1,122 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+import random, time
+
+class IcePatch2CalcTestCase(ClientTestCase):
+
+    def runClientSide(self, current):
+
+        def test(b):
+            if not b:
+                raise RuntimeError('test assertion failed')
+
+        def normalize(path):
+            return path.replace("\\", "/").lstrip("./")
+
+        datadir = os.path.join(current.testsuite.getPath(), "data")
+        calc = IcePatch2Calc(quiet=True)
+
+        #
+        # Runs icepatch2calc and returns the files which were checksummed
+        # and the contents of the IcePatch2.sum and IcePatch2.chunks files.
+        #
+        def run(args):
+            calc.run(current, args=["-V", "-Z"] + args + [datadir])
+            checksummed = set()
+            for line in calc.getOutput(current).split("\n"):
+                if line.startswith("checksum: "):
+                    checksummed.add(normalize(line[len("checksum: "):].strip()))
+            sums = {}
+            with open(os.path.join(datadir, "IcePatch2.sum"), "r") as f:
+                for line in f.readlines():
+                    fields = line.strip().split("\t")
+                    sums[normalize(fields[0])] = fields[1]
+            with open(os.path.join(datadir, "IcePatch2.chunks"), "rb") as f:
+                chunks = f.read()
+            return (checksummed, sums, chunks)
+
+        #
+        # The stats of the files modified in the last second aren't saved,
+        # the files are given an older modification time.
+        #
+        mtime = time.time() - 24 * 60 * 60
+        def write(path, data):
+            with open(os.path.join(datadir, path), "wb") as f:
+                f.write(data)
+            os.utime(os.path.join(datadir, path), (mtime, mtime))
+
+        try:
+            current.write("creating IcePatch2 data directory... ")
+            if os.path.exists(datadir):
+                shutil.rmtree(datadir)
+            files = ["large"]
+            for i in range(0, 50):
+                files.append("dir{0}/file{1}".format(i % 5, i))
+            for f in files:
+                if not os.path.exists(os.path.dirname(os.path.join(datadir, f))):
+                    os.makedirs(os.path.dirname(os.path.join(datadir, f)))
+                write(f, os.urandom(2 * 1024 * 1024 if f == "large" else random.randint(1, 64 * 1024)))
+            current.writeln("ok")
+
+            current.write("testing checksums computation... ")
+            (checksummed, sums, chunks) = run(["-t", "1"])
+            test(checksummed == set(files))
+            test(set(sums.keys()) >= set(files))
+            current.writeln("ok")
+
+            current.write("testing checksums reuse... ")
+            (checksummed, sums2, chunks2) = run([])
+            test(len(checksummed) == 0)
+            test(sums2 == sums and chunks2 == chunks)
+
+            #
+            # A file modified without changing its size and modification
+            # time keeps its previous checksum, unless the checksums are
+            # forced.
+            #
+            with open(os.path.join(datadir, "large"), "rb") as f:
+                data = bytearray(f.read())
+            data[1024 * 1024] = (data[1024 * 1024] + 1) % 256
+            write("large", bytes(data))
+            (checksummed, sums2, chunks2) = run([])
+            test(len(checksummed) == 0)
+            test(sums2 == sums and chunks2 == chunks)
+
+            #
+            # A file which size changed is checksummed again.
+            #
+            with open(os.path.join(datadir, files[1]), "rb") as f:
+                data = f.read()
+            write(files[1], data + b"updated")
+            (checksummed, sums2, chunks2) = run([])
+            test(checksummed == set([files[1]]))
+            test(sums2[files[1]] != sums[files[1]])
+            for f in files[2:]:
+                test(sums2[f] == sums[f])
+            test(sums2["large"] == sums["large"])
+            current.writeln("ok")
+
+            current.write("testing forced checksums computation... ")
+            (checksummed, sums3, chunks3) = run(["-f", "-t", "4"])
+            test(checksummed == set(files))
+            test(sums3["large"] != sums["large"] and chunks3 != chunks)
+            test(sums3[files[1]] == sums2[files[1]])
+            for f in files[2:]:
+                test(sums3[f] == sums[f])
+            current.writeln("ok")
+
+            current.write("testing parallel checksums computation... ")
+            (checksummed, sums4, chunks4) = run(["-f", "-t", "1"])
+            test(checksummed == set(files))
+            test(sums4 == sums3 and chunks4 == chunks3)
+            (checksummed, sums4, chunks4) = run(["-f", "-t", "16"])
+            test(checksummed == set(files))
+            test(sums4 == sums3 and chunks4 == chunks3)
+            current.writeln("ok")
+        finally:
+            shutil.rmtree(datadir, ignore_errors=True)
+
+TestSuite(__name__, [ IcePatch2CalcTestCase() ], multihost=False)
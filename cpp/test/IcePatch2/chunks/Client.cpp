@@ -0,0 +1,312 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/FileUtil.h>
+#include <IcePatch2/ClientUtil.h>
+#include <IcePatch2/FileServer.h>
+#include <TestHelper.h>
+#include <algorithm>
+#include <fstream>
+#include <set>
+
+using namespace std;
+using namespace IcePatch2;
+
+namespace
+{
+
+Ice::ByteSeq
+readFile(const string& path)
+{
+    ifstream in(IceUtilInternal::streamFilename(path).c_str(), ios::binary);
+    test(in);
+    return Ice::ByteSeq((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+class PatcherFeedbackI : public PatcherFeedback
+{
+public:
+
+    virtual bool
+    noFileSummary(const string&)
+    {
+        return true;
+    }
+
+    virtual bool
+    checksumStart()
+    {
+        return true;
+    }
+
+    virtual bool
+    checksumProgress(const string&)
+    {
+        return true;
+    }
+
+    virtual bool
+    checksumEnd()
+    {
+        return true;
+    }
+
+    virtual bool
+    fileListStart()
+    {
+        return true;
+    }
+
+    virtual bool
+    fileListProgress(Ice::Int)
+    {
+        return true;
+    }
+
+    virtual bool
+    fileListEnd()
+    {
+        return true;
+    }
+
+    virtual bool
+    patchStart(const string&, Ice::Long, Ice::Long, Ice::Long)
+    {
+        return true;
+    }
+
+    virtual bool
+    patchProgress(Ice::Long, Ice::Long, Ice::Long, Ice::Long)
+    {
+        return true;
+    }
+
+    virtual bool
+    patchEnd()
+    {
+        return true;
+    }
+};
+
+//
+// Forwards the requests to a file server and records the chunks and the
+// compressed files requested by the patcher.
+//
+class FileServerForwarderI : public Ice::Blobject, private IceUtil::Mutex
+{
+public:
+
+    FileServerForwarderI(const FileServerPrx& server) : _server(server)
+    {
+    }
+
+    virtual bool
+    ice_invoke(const vector<Ice::Byte>& inParams, vector<Ice::Byte>& outParams, const Ice::Current& current)
+    {
+        if(current.operation == "getChunks" || current.operation == "getLargeFileCompressed" ||
+           current.operation == "getFileCompressed")
+        {
+            Ice::InputStream in(current.adapter->getCommunicator(), current.encoding, inParams);
+            in.startEncapsulation();
+            string path;
+            in.read(path);
+            IceUtil::Mutex::Lock sync(*this);
+            if(current.operation == "getChunks")
+            {
+                Ice::IntSeq indexes;
+                in.read(indexes);
+                _chunks[path].insert(indexes.begin(), indexes.end());
+            }
+            else
+            {
+                _files.insert(path);
+            }
+        }
+        return _server->ice_invoke(current.operation, current.mode, inParams, outParams, current.ctx);
+    }
+
+    set<Ice::Int>
+    chunks(const string& path)
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        return _chunks[path];
+    }
+
+    bool
+    downloaded(const string& path)
+    {
+        IceUtil::Mutex::Lock sync(*this);
+        return _files.find(path) != _files.end();
+    }
+
+private:
+
+    const FileServerPrx _server;
+    map<string, set<Ice::Int> > _chunks;
+    set<string> _files;
+};
+typedef IceUtil::Handle<FileServerForwarderI> FileServerForwarderIPtr;
+
+void
+patch(const FileServerPrx& server, const string& dir)
+{
+    PatcherPtr patcher = PatcherFactory::create(server, new PatcherFeedbackI, dir, false, 100, 1);
+    test(patcher->prepare());
+    test(patcher->patch(""));
+    patcher->finish();
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    test(argc == 2);
+    string testDir = argv[1];
+
+    //
+    // The server of the original files and the server of the updated
+    // files. Only a part of the `large' file was updated.
+    //
+    FileServerPrx server1 = FileServerPrx::checkedCast(
+        communicator->stringToProxy("IcePatch2/server:" + getTestEndpoint(0)));
+    test(server1);
+    FileServerPrx server2 = FileServerPrx::checkedCast(
+        communicator->stringToProxy("IcePatch2/server:" + getTestEndpoint(1)));
+    test(server2);
+
+    communicator->getProperties()->setProperty("ForwarderAdapter.Endpoints", getTestEndpoint(2));
+    Ice::ObjectAdapterPtr adapter = communicator->createObjectAdapter("ForwarderAdapter");
+    FileServerForwarderIPtr forwarder = new FileServerForwarderI(server2);
+    FileServerPrx forwarderPrx = FileServerPrx::uncheckedCast(
+        adapter->add(forwarder, Ice::stringToIdentity("forwarder")));
+    adapter->activate();
+
+    string clientDir = testDir + "/client";
+
+    cout << "patching original files... " << flush;
+    patch(server1, clientDir);
+    test(readFile(clientDir + "/large") == readFile(testDir + "/server1/large"));
+    cout << "ok" << endl;
+
+    cout << "testing patching of the updated chunks... " << flush;
+    {
+        ChunkInfoSeq chunks1 = server1->getChunkInfoSeq("large");
+        ChunkInfoSeq chunks2 = server2->getChunkInfoSeq("large");
+        test(!chunks1.empty() && !chunks2.empty());
+
+        set<Ice::ByteSeq> checksums;
+        for(ChunkInfoSeq::const_iterator p = chunks1.begin(); p != chunks1.end(); ++p)
+        {
+            checksums.insert(p->checksum);
+        }
+        set<Ice::Int> updated;
+        for(size_t i = 0; i < chunks2.size(); ++i)
+        {
+            if(checksums.find(chunks2[i].checksum) == checksums.end())
+            {
+                updated.insert(static_cast<Ice::Int>(i));
+            }
+        }
+        test(!updated.empty() && updated.size() < chunks2.size());
+
+        patch(forwarderPrx, clientDir);
+
+        //
+        // Only the updated chunks are requested, the file isn't downloaded
+        // again: the patcher falls back to downloading the whole file if
+        // the checksum of the rebuilt file doesn't match.
+        //
+        test(forwarder->chunks("large") == updated);
+        test(!forwarder->downloaded("large"));
+        test(readFile(clientDir + "/large") == readFile(testDir + "/server2/large"));
+
+        //
+        // The unchanged files aren't patched.
+        //
+        test(forwarder->chunks("small").empty());
+        test(!forwarder->downloaded("small"));
+    }
+    cout << "ok" << endl;
+
+    cout << "testing getChunks limits... " << flush;
+    {
+        ChunkInfoSeq chunks = server2->getChunkInfoSeq("large");
+        Ice::ByteSeq data = readFile(testDir + "/server2/large");
+
+        //
+        // The chunks returned by a single call are limited to 1MB.
+        //
+        Ice::IntSeq indexes;
+        Ice::Long size = 0;
+        for(size_t i = 0; i < chunks.size() && size + chunks[i].size <= 1024 * 1024; ++i)
+        {
+            indexes.push_back(static_cast<Ice::Int>(i));
+            size += chunks[i].size;
+        }
+        test(indexes.size() < chunks.size());
+
+        Ice::ByteSeq bytes = server2->getChunks("large", indexes);
+        test(bytes.size() == static_cast<size_t>(size));
+        test(equal(bytes.begin(), bytes.end(), data.begin()));
+
+        indexes.push_back(static_cast<Ice::Int>(indexes.size()));
+        try
+        {
+            server2->getChunks("large", indexes);
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+
+        indexes.clear();
+        for(size_t i = 0; i < chunks.size(); ++i)
+        {
+            indexes.push_back(static_cast<Ice::Int>(i));
+        }
+        try
+        {
+            server2->getChunks("large", indexes);
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+
+        indexes.clear();
+        indexes.push_back(static_cast<Ice::Int>(chunks.size()));
+        try
+        {
+            server2->getChunks("large", indexes);
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+
+        indexes.clear();
+        indexes.push_back(0);
+        try
+        {
+            server2->getChunks("small", indexes);
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+    }
+    cout << "ok" << endl;
+}
+
+DEFINE_TEST(Client)
@@ -0,0 +1,8 @@
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+$(test)_programs = client
+$(test)_dependencies = IcePatch2 TestCommon Ice
+
+tests += $(test)
@@ -0,0 +1,42 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+class IcePatch2ChunksTestCase(ClientServerTestCase):
+
+    def __init__(self):
+        server = lambda i: IcePatch2Server(args=["{{testdir}}/server{0}".format(i)],
+                                           props=lambda process, current: {
+                                               "IcePatch2.Endpoints" : current.getTestEndpoint(i - 1)
+                                           })
+        ClientServerTestCase.__init__(self, "client/server", servers=[server(1), server(2)],
+                                      client=Client(args=["{testdir}"], props={ "Ice.MessageSizeMax" : 2048 }))
+
+    def setupServerSide(self, current):
+        testdir = current.testsuite.getPath()
+        self.teardownServerSide(current, True)
+
+        current.write("creating IcePatch2 data directories... ")
+        large = bytearray(os.urandom(4 * 1024 * 1024))
+        small = os.urandom(64 * 1024)
+        for i in [1, 2]:
+            datadir = os.path.join(testdir, "server{0}".format(i))
+            os.makedirs(datadir)
+            if i == 2:
+                #
+                # Update a small part in the middle of the large file.
+                #
+                large[2 * 1024 * 1024:2 * 1024 * 1024 + 4096] = os.urandom(4096)
+            with open(os.path.join(datadir, "large"), "wb") as f:
+                f.write(large)
+            with open(os.path.join(datadir, "small"), "wb") as f:
+                f.write(small)
+            IcePatch2Calc(args=[datadir]).run(current)
+        current.writeln("ok")
+
+    def teardownServerSide(self, current, success):
+        for d in ["server1", "server2", "client"]:
+            shutil.rmtree(os.path.join(current.testsuite.getPath(), d), ignore_errors=True)
+
+TestSuite(__name__, [ IcePatch2ChunksTestCase() ], multihost=False)
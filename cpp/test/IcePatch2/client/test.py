@@ -0,0 +1,81 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+import bz2, filecmp, random
+
+class IcePatch2ClientTestCase(ClientServerTestCase):
+
+    def __init__(self):
+        ClientServerTestCase.__init__(self, "client/server",
+                                      server=IcePatch2Server(args=["{testdir}/server"],
+                                                             props=lambda process, current: {
+                                                                 "IcePatch2.Endpoints" : current.getTestEndpoint(0)
+                                                             }))
+
+    def setupServerSide(self, current):
+        serverdir = os.path.join(current.testsuite.getPath(), "server")
+        if os.path.exists(serverdir):
+            shutil.rmtree(serverdir)
+
+        current.write("creating IcePatch2 data directory... ")
+        self.files = []
+        for i in range(0, 200):
+            self.files.append(os.path.join("dir{0}".format(i % 10), "file{0}".format(i)))
+        self.files.append("large")
+        self.files.append("corrupted")
+        for f in self.files:
+            path = os.path.join(serverdir, f)
+            if not os.path.exists(os.path.dirname(path)):
+                os.makedirs(os.path.dirname(path))
+            with open(path, "wb") as fd:
+                if f == "large":
+                    fd.write(os.urandom(3 * 1024 * 1024))
+                elif f == "corrupted":
+                    fd.write(b"a" * 200000)
+                else:
+                    fd.write(os.urandom(random.randint(0, 64 * 1024)))
+        IcePatch2Calc(args=[serverdir]).run(current)
+        current.writeln("ok")
+
+    def teardownServerSide(self, current, success):
+        shutil.rmtree(os.path.join(current.testsuite.getPath(), "server"), ignore_errors=True)
+        shutil.rmtree(os.path.join(current.testsuite.getPath(), "client"), ignore_errors=True)
+
+    def runClientSide(self, current):
+
+        def test(b):
+            if not b:
+                raise RuntimeError('test assertion failed')
+
+        serverdir = os.path.join(current.testsuite.getPath(), "server")
+        clientdir = os.path.join(current.testsuite.getPath(), "client")
+        client = IcePatch2Client(props={ "IcePatch2Client.Proxy" : "IcePatch2/server:" + current.getTestEndpoint(0) })
+
+        for concurrency in [1, 4, 16]:
+            current.write("testing download with {0} concurrent downloads... ".format(concurrency))
+            if os.path.exists(clientdir):
+                shutil.rmtree(clientdir)
+            client.run(current, args=["-t", clientdir], props={ "IcePatch2Client.Concurrency" : concurrency })
+            for f in self.files:
+                test(filecmp.cmp(os.path.join(serverdir, f), os.path.join(clientdir, f), shallow=False))
+            current.writeln("ok")
+
+        current.write("testing corrupted file... ")
+        #
+        # Replace the compressed file served for `corrupted' with a valid
+        # compressed file of the same size and different contents, the
+        # client must detect that the checksum doesn't match.
+        #
+        path = os.path.join(serverdir, "corrupted.bz2")
+        data = bz2.compress(b"b" * 200000, 5)
+        test(len(data) == os.path.getsize(path))
+        with open(path, "wb") as fd:
+            fd.write(data)
+        shutil.rmtree(clientdir)
+        client.run(current, args=["-t", clientdir], props={ "IcePatch2Client.Concurrency" : 4 }, exitstatus=1)
+        test(client.getOutput(current).find("checksum mismatch for `corrupted'") >= 0)
+        current.writeln("ok")
+
+TestSuite(__name__, [ IcePatch2ClientTestCase() ], multihost=False)
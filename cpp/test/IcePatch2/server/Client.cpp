@@ -0,0 +1,193 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceUtil/FileUtil.h>
+#include <IcePatch2/FileServer.h>
+#include <IcePatch2/Metrics.h>
+#include <TestHelper.h>
+#include <algorithm>
+#include <fstream>
+#include <list>
+
+using namespace std;
+using namespace IcePatch2;
+
+namespace
+{
+
+const int fileCount = 4;
+
+string
+getPath(int i)
+{
+    ostringstream os;
+    os << "file" << i;
+    return os.str();
+}
+
+Ice::ByteSeq
+readFile(const string& path)
+{
+    ifstream in(IceUtilInternal::streamFilename(path).c_str(), ios::binary);
+    test(in);
+    return Ice::ByteSeq((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+}
+
+void
+writeFile(const string& path, const Ice::ByteSeq& bytes)
+{
+    ofstream out(IceUtilInternal::streamFilename(path).c_str(), ios::binary | ios::trunc);
+    test(out);
+    out.write(reinterpret_cast<const char*>(&bytes[0]), static_cast<streamsize>(bytes.size()));
+    out.close();
+    test(out);
+}
+
+Ice::ByteSeq
+getFile(const FileServerPrx& server, const string& path)
+{
+    return server->getLargeFileCompressed(path, 0, 1024 * 1024);
+}
+
+IceMX::FileMetricsPtr
+getFileMetrics(const IceMX::MetricsAdminPrx& metrics, const string& path)
+{
+    Ice::Long timestamp;
+    IceMX::MetricsView view = metrics->getMetricsView("View", timestamp);
+    IceMX::MetricsMap& files = view["File"];
+    for(IceMX::MetricsMap::const_iterator p = files.begin(); p != files.end(); ++p)
+    {
+        if((*p)->id == path)
+        {
+            IceMX::FileMetricsPtr m = IceMX::FileMetricsPtr::dynamicCast(*p);
+            test(m);
+            return m;
+        }
+    }
+    return 0;
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    Ice::PropertiesPtr properties = communicator->getProperties();
+    string dataDir = properties->getProperty("IcePatch2.Directory");
+    test(!dataDir.empty());
+    size_t cacheSize = static_cast<size_t>(properties->getPropertyAsIntWithDefault("IcePatch2.CacheSize", 100));
+
+    FileServerPrx server = FileServerPrx::checkedCast(
+        communicator->stringToProxy("IcePatch2/server:" + getTestEndpoint(0)));
+    test(server);
+
+    IceMX::MetricsAdminPrx metrics = IceMX::MetricsAdminPrx::checkedCast(
+        communicator->stringToProxy("IcePatch2Server/admin -f Metrics:" + getTestEndpoint(1)));
+    test(metrics);
+
+    cout << "testing file cache... " << flush;
+    {
+        //
+        // Download the files in an order which evicts files from a small
+        // cache and compute the expected hits with the same LRU policy.
+        //
+        const int order[] = { 0, 0, 1, 0, 2, 1, 3, 0, 3, 2, 1, 0 };
+        vector<Ice::Long> total(fileCount, 0);
+        vector<Ice::Long> hits(fileCount, 0);
+        vector<Ice::Long> bytes(fileCount, 0);
+        list<int> cached;
+        for(size_t i = 0; i < sizeof(order) / sizeof(order[0]); ++i)
+        {
+            int f = order[i];
+            Ice::ByteSeq data = getFile(server, getPath(f));
+            test(data == readFile(dataDir + "/" + getPath(f) + ".bz2"));
+
+            ++total[f];
+            bytes[f] += static_cast<Ice::Long>(data.size());
+            list<int>::iterator p = find(cached.begin(), cached.end(), f);
+            if(p != cached.end())
+            {
+                ++hits[f];
+                cached.erase(p);
+            }
+            if(cacheSize > 0)
+            {
+                cached.push_front(f);
+                if(cached.size() > cacheSize)
+                {
+                    cached.pop_back();
+                }
+            }
+        }
+        cout << "ok" << endl;
+
+        cout << "testing File metrics... " << flush;
+        for(int f = 0; f < fileCount; ++f)
+        {
+            IceMX::FileMetricsPtr m = getFileMetrics(metrics, getPath(f));
+            test(m);
+            test(m->total == total[f] && m->current == 0);
+            test(m->hits == hits[f]);
+            test(m->bytes == bytes[f]);
+        }
+        test(!getFileMetrics(metrics, "unknown"));
+        cout << "ok" << endl;
+    }
+
+    cout << "testing modified files... " << flush;
+    {
+        //
+        // Truncate a file which is open in the cache, the server must
+        // reopen it instead of reading past the end of the mapping.
+        //
+        string path = dataDir + "/" + getPath(0) + ".bz2";
+        Ice::ByteSeq data = getFile(server, getPath(0));
+        Ice::ByteSeq truncated(data.begin(), data.begin() + data.size() / 2);
+        writeFile(path, truncated);
+        test(getFile(server, getPath(0)) == truncated);
+        test(getFile(server, getPath(0)) == truncated);
+
+#ifndef _WIN32
+        //
+        // Replace a file like icepatch2calc does, the server must serve
+        // the new file rather than the one still open in the cache (Windows
+        // doesn't allow replacing or removing an open file).
+        //
+        path = dataDir + "/" + getPath(1) + ".bz2";
+        data = getFile(server, getPath(1));
+        Ice::ByteSeq replaced(data.rbegin(), data.rend());
+        writeFile(path + ".temp", replaced);
+        test(IceUtilInternal::rename(path + ".temp", path) == 0);
+        test(getFile(server, getPath(1)) == replaced);
+
+        //
+        // A removed file can't be served anymore.
+        //
+        path = dataDir + "/" + getPath(2) + ".bz2";
+        getFile(server, getPath(2));
+        test(IceUtilInternal::remove(path) == 0);
+        try
+        {
+            getFile(server, getPath(2));
+            test(false);
+        }
+        catch(const FileAccessException&)
+        {
+        }
+#endif
+        server->ice_ping();
+    }
+    cout << "ok" << endl;
+}
+
+DEFINE_TEST(Client)
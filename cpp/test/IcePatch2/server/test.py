@@ -0,0 +1,39 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+class IcePatch2ServerTestCase(ClientServerTestCase):
+
+    def __init__(self, name, cacheSize):
+        ClientServerTestCase.__init__(self, name,
+                                      server=IcePatch2Server(props=lambda process, current: {
+                                          "IcePatch2.Endpoints" : current.getTestEndpoint(0),
+                                          "Ice.Admin.Endpoints" : current.getTestEndpoint(1),
+                                          "Ice.Admin.InstanceName" : "IcePatch2Server",
+                                          "IceMX.Metrics.View.GroupBy" : "id",
+                                      }),
+                                      props={ "IcePatch2.Directory" : "{testdir}/data",
+                                              "IcePatch2.CacheSize" : cacheSize })
+
+    def setupServerSide(self, current):
+        #
+        # The client modifies the files, each test case uses new files.
+        #
+        datadir = os.path.join(current.testsuite.getPath(), "data")
+        if os.path.exists(datadir):
+            shutil.rmtree(datadir)
+        os.makedirs(datadir)
+        for i in range(0, 4):
+            with open(os.path.join(datadir, "file{0}".format(i)), "wb") as f:
+                f.write(os.urandom(16 * 1024 * (i + 1)))
+        IcePatch2Calc(args=["-z", datadir]).run(current)
+
+    def teardownServerSide(self, current, success):
+        shutil.rmtree(os.path.join(current.testsuite.getPath(), "data"), ignore_errors=True)
+
+TestSuite(__name__, [
+    IcePatch2ServerTestCase("client/server with small cache", 2),
+    IcePatch2ServerTestCase("client/server with cache disabled", 0),
+    IcePatch2ServerTestCase("client/server with default cache", 100),
+], multihost=False)
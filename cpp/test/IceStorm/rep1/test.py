@@ -13,7 +13,8 @@
 props = {
     "IceStorm.Election.MasterTimeout" : 2,
     "IceStorm.Election.ElectionTimeout" : 2,
-    "IceStorm.Election.ResponseTimeout" : 2
+    "IceStorm.Election.ResponseTimeout" : 2,
+    "IceStorm.Trace.Replication" : 1
 }
 
 icestorm = [ IceStorm(replica=i, nreplicas=3, props = props) for i in range(0,3) ]
@@ -277,6 +278,25 @@ class IceStormRep1TestCase(IceStormTestCase):
         runtest("--twoway", "--cycle")
         current.writeln("ok")
 
+        current.write("testing resync of a restarted replica... ")
+        sys.stdout.flush()
+        stopReplica(0)
+
+        topics = ["resync{0}".format(i) for i in range(0, 10)]
+        self.runadmin(current, "create " + " ".join(topics))
+        self.runadmin(current, "destroy " + " ".join(topics[0:5]))
+
+        startReplica(0)
+
+        # The master resyncs the replica with the 15 updates it missed rather than with the full content.
+        self.icestorm[2].expect(current, "resync 0 from llu [0-9]+/[0-9]+ with 15 updates")
+
+        adminForReplica(0, "destroy resync0", "error: couldn't find topic `resync0'")
+        adminForReplica(0, "create resync9", "error: topic `resync9' exists")
+
+        self.runadmin(current, "destroy " + " ".join(topics[5:10]))
+        current.writeln("ok")
+
         current.write("stopping replicas... ")
         sys.stdout.flush()
         self.stopIceStorm(current)
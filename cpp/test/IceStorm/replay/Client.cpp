@@ -0,0 +1,229 @@
+//
+// Copyright (c) ZeroC, Inc. All rights reserved.
+//
+
+#include <Ice/Ice.h>
+#include <IceStorm/IceStorm.h>
+#include <TestHelper.h>
+
+using namespace std;
+using namespace Ice;
+using namespace IceStorm;
+using namespace Test;
+
+namespace
+{
+
+//
+// Records the sequence numbers of the events received from the topic.
+//
+class SubscriberI : public Ice::Blobject, public IceUtil::Monitor<IceUtil::Mutex>
+{
+public:
+
+    virtual bool
+    ice_invoke(const ByteSeq&, ByteSeq&, const Current& current)
+    {
+        Context::const_iterator p = current.ctx.find("IceStorm.Sequence");
+        test(p != current.ctx.end());
+
+        Lock sync(*this);
+        istringstream is(p->second);
+        Long seq;
+        test(is >> seq);
+        _received.push_back(seq);
+        notifyAll();
+        return true;
+    }
+
+    void
+    waitForEvents(Long first, Long last)
+    {
+        Lock sync(*this);
+        while(_received.size() < static_cast<size_t>(last - first))
+        {
+            test(timedWait(IceUtil::Time::seconds(30)));
+        }
+
+        test(_received.size() == static_cast<size_t>(last - first));
+        for(vector<Long>::size_type i = 0; i < _received.size(); ++i)
+        {
+            test(_received[i] == first + static_cast<Long>(i));
+        }
+    }
+
+private:
+
+    vector<Long> _received;
+};
+typedef IceUtil::Handle<SubscriberI> SubscriberIPtr;
+
+void
+publish(const ObjectPrx& publisher, int count)
+{
+    ByteSeq inParams;
+    OutputStream out(publisher->ice_getCommunicator());
+    out.startEncapsulation();
+    out.endEncapsulation();
+    out.finished(inParams);
+
+    for(int i = 0; i < count; ++i)
+    {
+        ByteSeq outParams;
+        publisher->ice_invoke("event", Normal, inParams, outParams);
+    }
+}
+
+ObjectPrx
+subscribe(const ObjectAdapterPtr& adapter, const TopicPrx& topic, const SubscriberIPtr& subscriber,
+          const string& name, const string& value)
+{
+    QoS qos;
+    qos["reliability"] = "ordered";
+    qos[name] = value;
+    ObjectPrx proxy = adapter->addWithUUID(subscriber);
+    topic->subscribeAndGetPublisher(qos, proxy);
+    return proxy;
+}
+
+string
+toString(Long value)
+{
+    ostringstream os;
+    os << value;
+    return os.str();
+}
+
+}
+
+class Client : public Test::TestHelper
+{
+public:
+
+    void run(int, char**);
+};
+
+void
+Client::run(int argc, char** argv)
+{
+    Ice::CommunicatorHolder communicator = initialize(argc, argv);
+    PropertiesPtr properties = communicator->getProperties();
+    string managerProxy = properties->getProperty("IceStormAdmin.TopicManager.Default");
+    if(managerProxy.empty())
+    {
+        ostringstream os;
+        os << argv[0] << ": property `IceStormAdmin.TopicManager.Default' is not set";
+        throw invalid_argument(os.str());
+    }
+
+    IceStorm::TopicManagerPrx manager =
+        IceStorm::TopicManagerPrx::checkedCast(communicator->stringToProxy(managerProxy));
+    if(!manager)
+    {
+        ostringstream os;
+        os << argv[0] << ": `" << managerProxy << "' is not running";
+        throw invalid_argument(os.str());
+    }
+
+    if(argc != 2)
+    {
+        throw invalid_argument("client publish|resume");
+    }
+
+    ObjectAdapterPtr adapter = communicator->createObjectAdapterWithEndpoints("ReplayAdapter", "default");
+    adapter->activate();
+
+    string action(argv[1]);
+    if(action == "publish")
+    {
+        TopicPrx topic = manager->create("replay");
+        ObjectPrx publisher = topic->getPublisher()->ice_twoway();
+
+        cerr << "testing replay from a sequence number... " << flush;
+        publish(publisher, 100);
+
+        SubscriberIPtr subscriber1 = new SubscriberI();
+        ObjectPrx proxy1 = subscribe(adapter, topic, subscriber1, "resumeFromSequence", "0");
+        subscriber1->waitForEvents(0, 100);
+
+        SubscriberIPtr subscriber2 = new SubscriberI();
+        ObjectPrx proxy2 = subscribe(adapter, topic, subscriber2, "resumeFromSequence", "50");
+        subscriber2->waitForEvents(50, 100);
+        cerr << "ok" << endl;
+
+        cerr << "testing replay from a time... " << flush;
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        Long now = IceUtil::Time::now().toMilliSeconds();
+        IceUtil::ThreadControl::sleep(IceUtil::Time::milliSeconds(100));
+        publish(publisher, 10);
+
+        SubscriberIPtr subscriber3 = new SubscriberI();
+        ObjectPrx proxy3 = subscribe(adapter, topic, subscriber3, "resumeFromTime", toString(now));
+        subscriber3->waitForEvents(100, 110);
+        cerr << "ok" << endl;
+
+        cerr << "testing replayed and published events... " << flush;
+        publish(publisher, 10);
+        subscriber1->waitForEvents(0, 120);
+        subscriber2->waitForEvents(50, 120);
+        subscriber3->waitForEvents(100, 120);
+        cerr << "ok" << endl;
+
+        cerr << "testing invalid QoS... " << flush;
+        try
+        {
+            subscribe(adapter, topic, new SubscriberI(), "resumeFromSequence", "abc");
+            test(false);
+        }
+        catch(const BadQoS&)
+        {
+        }
+
+        try
+        {
+            QoS qos;
+            qos["resumeFromSequence"] = "0";
+            qos["resumeFromTime"] = "0";
+            topic->subscribeAndGetPublisher(qos, adapter->addWithUUID(new SubscriberI()));
+            test(false);
+        }
+        catch(const BadQoS&)
+        {
+        }
+
+        TopicPrx other = manager->create("other");
+        try
+        {
+            subscribe(adapter, other, new SubscriberI(), "resumeFromSequence", "0");
+            test(false);
+        }
+        catch(const BadQoS&)
+        {
+        }
+        other->destroy();
+        cerr << "ok" << endl;
+
+        topic->unsubscribe(proxy1);
+        topic->unsubscribe(proxy2);
+        topic->unsubscribe(proxy3);
+    }
+    else
+    {
+        test(action == "resume");
+
+        cerr << "testing replay after restart... " << flush;
+        TopicPrx topic = manager->retrieve("replay");
+        SubscriberIPtr subscriber = new SubscriberI();
+        ObjectPrx proxy = subscribe(adapter, topic, subscriber, "resumeFromSequence", "0");
+        subscriber->waitForEvents(0, 120);
+
+        publish(topic->getPublisher()->ice_twoway(), 1);
+        subscriber->waitForEvents(0, 121);
+
+        topic->unsubscribe(proxy);
+        topic->destroy();
+        cerr << "ok" << endl;
+    }
+}
+
+DEFINE_TEST(Client)
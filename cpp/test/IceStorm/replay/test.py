@@ -0,0 +1,46 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) ZeroC, Inc. All rights reserved.
+#
+
+#
+# The events of the replay topic are kept in an event log, the second
+# IceStorm instance uses the database and the event log of the first one.
+#
+props = { "IceStorm.EventLog.Topics" : "replay" }
+icestorm1 = IceStorm(createDb=True, cleanDb=False, props=props)
+icestorm2 = IceStorm(createDb=False, cleanDb=True, props=props)
+
+
+class IceStormReplayTestCase(TestCase):
+
+    def __init__(self, name, icestorm, *args, **kargs):
+        TestCase.__init__(self, name, *args, **kargs)
+        self.icestorm = icestorm
+
+    def init(self, mapping, testsuite):
+        TestCase.init(self, mapping, testsuite)
+        self.servers = [self.icestorm]
+
+    def runWithDriver(self, current):
+        current.driver.runClientServerTestCase(current)
+
+    def teardownClientSide(self, current, success):
+        self.icestorm.shutdown(current)
+
+class ReplayClient(IceStormProcess, Client):
+
+    processType = "client"
+
+    def __init__(self, instanceName=None, instance=None, *args, **kargs):
+        Client.__init__(self, *args, **kargs)
+        IceStormProcess.__init__(self, instanceName, instance)
+
+    getParentProps = Client.getProps # Used by IceStormProcess to get the client properties
+
+TestSuite(__file__, [
+    IceStormReplayTestCase("replay publish", icestorm1,
+                           client=ClientTestCase(client=ReplayClient(instance=icestorm1, args=["publish"]))),
+    IceStormReplayTestCase("replay resume", icestorm2,
+                           client=ClientTestCase(client=ReplayClient(instance=icestorm2, args=["resume"]))),
+], multihost=False)
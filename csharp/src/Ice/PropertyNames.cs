@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Thu Oct 25 22:10:11 2018
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 09:28:45 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -36,6 +36,9 @@ namespace IceInternal
              new Property(@"^Ice\.Admin\.Locator\.PreferSecure$", false, null),
              new Property(@"^Ice\.Admin\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^Ice\.Admin\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^Ice\.Admin\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Ice\.Admin\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^Ice\.Admin\.Locator\.CompressionCodec$", false, null),
              new Property(@"^Ice\.Admin\.Locator\.Locator$", false, null),
              new Property(@"^Ice\.Admin\.Locator\.Router$", false, null),
              new Property(@"^Ice\.Admin\.Locator\.CollocationOptimized$", false, null),
@@ -48,6 +51,9 @@ namespace IceInternal
              new Property(@"^Ice\.Admin\.Router\.PreferSecure$", false, null),
              new Property(@"^Ice\.Admin\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^Ice\.Admin\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^Ice\.Admin\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Ice\.Admin\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^Ice\.Admin\.Router\.CompressionCodec$", false, null),
              new Property(@"^Ice\.Admin\.Router\.Locator$", false, null),
              new Property(@"^Ice\.Admin\.Router\.Router$", false, null),
              new Property(@"^Ice\.Admin\.Router\.CollocationOptimized$", false, null),
@@ -59,6 +65,7 @@ namespace IceInternal
              new Property(@"^Ice\.Admin\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^Ice\.Admin\.ThreadPool\.StackSize$", false, null),
              new Property(@"^Ice\.Admin\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^Ice\.Admin\.ThreadPool\.Mode$", false, null),
              new Property(@"^Ice\.Admin\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^Ice\.Admin\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^Ice\.Admin\.MessageSizeMax$", false, null),
@@ -72,13 +79,20 @@ namespace IceInternal
              new Property(@"^Ice\.Admin\.ServerId$", false, null),
              new Property(@"^Ice\.BackgroundLocatorCacheUpdates$", false, null),
              new Property(@"^Ice\.BatchAutoFlush$", true, null),
+             new Property(@"^Ice\.BatchAutoFlushAdaptive$", false, null),
+             new Property(@"^Ice\.BatchAutoFlushDelay$", false, null),
              new Property(@"^Ice\.BatchAutoFlushSize$", false, null),
+             new Property(@"^Ice\.BufferPool\.MaxCached$", false, null),
              new Property(@"^Ice\.ChangeUser$", false, null),
              new Property(@"^Ice\.ClassGraphDepthMax$", false, null),
              new Property(@"^Ice\.ClientAccessPolicyProtocol$", false, null),
+             new Property(@"^Ice\.Compression\.Codec$", false, null),
              new Property(@"^Ice\.Compression\.Level$", false, null),
              new Property(@"^Ice\.CollectObjects$", false, null),
+             new Property(@"^Ice\.CollocationDirectDispatch$", false, null),
              new Property(@"^Ice\.Config$", false, null),
+             new Property(@"^Ice\.ConnectionPool\.LargeMessageSize$", false, null),
+             new Property(@"^Ice\.ConnectionPool\.Size$", false, null),
              new Property(@"^Ice\.ConsoleListener$", false, null),
              new Property(@"^Ice\.Default\.CollocationOptimized$", false, null),
              new Property(@"^Ice\.Default\.EncodingVersion$", false, null),
@@ -89,6 +103,9 @@ namespace IceInternal
              new Property(@"^Ice\.Default\.Locator\.PreferSecure$", false, null),
              new Property(@"^Ice\.Default\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^Ice\.Default\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^Ice\.Default\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Ice\.Default\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^Ice\.Default\.Locator\.CompressionCodec$", false, null),
              new Property(@"^Ice\.Default\.Locator\.Locator$", false, null),
              new Property(@"^Ice\.Default\.Locator\.Router$", false, null),
              new Property(@"^Ice\.Default\.Locator\.CollocationOptimized$", false, null),
@@ -104,6 +121,9 @@ namespace IceInternal
              new Property(@"^Ice\.Default\.Router\.PreferSecure$", false, null),
              new Property(@"^Ice\.Default\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^Ice\.Default\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^Ice\.Default\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Ice\.Default\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^Ice\.Default\.Router\.CompressionCodec$", false, null),
              new Property(@"^Ice\.Default\.Router\.Locator$", false, null),
              new Property(@"^Ice\.Default\.Router\.Router$", false, null),
              new Property(@"^Ice\.Default\.Router\.CollocationOptimized$", false, null),
@@ -116,6 +136,9 @@ namespace IceInternal
              new Property(@"^Ice\.FactoryAssemblies$", false, null),
              new Property(@"^Ice\.HTTPProxyHost$", false, null),
              new Property(@"^Ice\.HTTPProxyPort$", false, null),
+             new Property(@"^Ice\.HostResolver\.CacheTTL$", false, null),
+             new Property(@"^Ice\.HostResolver\.NegativeCacheTTL$", false, null),
+             new Property(@"^Ice\.HostResolver\.Size$", false, null),
              new Property(@"^Ice\.ImplicitContext$", false, null),
              new Property(@"^Ice\.InitPlugins$", false, null),
              new Property(@"^Ice\.IPv4$", false, null),
@@ -123,6 +146,7 @@ namespace IceInternal
              new Property(@"^Ice\.LogFile$", false, null),
              new Property(@"^Ice\.LogFile\.SizeMax$", false, null),
              new Property(@"^Ice\.LogStdErr\.Convert$", false, null),
+             new Property(@"^Ice\.MessageFragmentSize$", false, null),
              new Property(@"^Ice\.MessageSizeMax$", false, null),
              new Property(@"^Ice\.Nohup$", false, null),
              new Property(@"^Ice\.NullHandleAbort$", false, null),
@@ -152,6 +176,7 @@ namespace IceInternal
              new Property(@"^Ice\.ThreadPool\.Client\.SizeWarn$", false, null),
              new Property(@"^Ice\.ThreadPool\.Client\.StackSize$", false, null),
              new Property(@"^Ice\.ThreadPool\.Client\.Serialize$", false, null),
+             new Property(@"^Ice\.ThreadPool\.Client\.Mode$", false, null),
              new Property(@"^Ice\.ThreadPool\.Client\.ThreadIdleTime$", false, null),
              new Property(@"^Ice\.ThreadPool\.Client\.ThreadPriority$", false, null),
              new Property(@"^Ice\.ThreadPool\.Server\.Size$", false, null),
@@ -159,6 +184,7 @@ namespace IceInternal
              new Property(@"^Ice\.ThreadPool\.Server\.SizeWarn$", false, null),
              new Property(@"^Ice\.ThreadPool\.Server\.StackSize$", false, null),
              new Property(@"^Ice\.ThreadPool\.Server\.Serialize$", false, null),
+             new Property(@"^Ice\.ThreadPool\.Server\.Mode$", false, null),
              new Property(@"^Ice\.ThreadPool\.Server\.ThreadIdleTime$", false, null),
              new Property(@"^Ice\.ThreadPool\.Server\.ThreadPriority$", false, null),
              new Property(@"^Ice\.ThreadPriority$", false, null),
@@ -189,6 +215,7 @@ namespace IceInternal
              new Property(@"^Ice\.CacheMessageBuffers$", false, null),
              new Property(@"^Ice\.ThreadInterruptSafe$", false, null),
              new Property(@"^Ice\.Voip$", true, null),
+             new Property(@"^Ice\.ZeroCopySize$", false, null),
              null
         };
 
@@ -216,6 +243,9 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Multicast\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Locator\.Locator$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Locator\.Router$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Locator\.CollocationOptimized$", false, null),
@@ -228,6 +258,9 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Multicast\.Router\.PreferSecure$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Router\.Locator$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Router\.Router$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.Router\.CollocationOptimized$", false, null),
@@ -239,6 +272,7 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Multicast\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceDiscovery\.Multicast\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceDiscovery\.Multicast\.MessageSizeMax$", false, null),
@@ -253,6 +287,9 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Reply\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Locator\.Locator$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Locator\.Router$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Locator\.CollocationOptimized$", false, null),
@@ -265,6 +302,9 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Reply\.Router\.PreferSecure$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Router\.Locator$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Router\.Router$", false, null),
              new Property(@"^IceDiscovery\.Reply\.Router\.CollocationOptimized$", false, null),
@@ -276,6 +316,7 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Reply\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceDiscovery\.Reply\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceDiscovery\.Reply\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceDiscovery\.Reply\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceDiscovery\.Reply\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceDiscovery\.Reply\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceDiscovery\.Reply\.MessageSizeMax$", false, null),
@@ -290,6 +331,9 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Locator\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Locator\.Locator$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Locator\.Router$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Locator\.CollocationOptimized$", false, null),
@@ -302,6 +346,9 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Locator\.Router\.PreferSecure$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Router\.Locator$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Router\.Router$", false, null),
              new Property(@"^IceDiscovery\.Locator\.Router\.CollocationOptimized$", false, null),
@@ -313,6 +360,7 @@ namespace IceInternal
              new Property(@"^IceDiscovery\.Locator\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceDiscovery\.Locator\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceDiscovery\.Locator\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceDiscovery\.Locator\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceDiscovery\.Locator\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceDiscovery\.Locator\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceDiscovery\.Locator\.MessageSizeMax$", false, null),
@@ -340,6 +388,9 @@ namespace IceInternal
              new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.Locator$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.Router$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Locator\.CollocationOptimized$", false, null),
@@ -352,6 +403,9 @@ namespace IceInternal
              new Property(@"^IceLocatorDiscovery\.Reply\.Router\.PreferSecure$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Router\.Locator$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Router\.Router$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.Router\.CollocationOptimized$", false, null),
@@ -363,6 +417,7 @@ namespace IceInternal
              new Property(@"^IceLocatorDiscovery\.Reply\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Reply\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceLocatorDiscovery\.Reply\.MessageSizeMax$", false, null),
@@ -377,6 +432,9 @@ namespace IceInternal
              new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.Locator$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.Router$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Locator\.CollocationOptimized$", false, null),
@@ -389,6 +447,9 @@ namespace IceInternal
              new Property(@"^IceLocatorDiscovery\.Locator\.Router\.PreferSecure$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Router\.Locator$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Router\.Router$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.Router\.CollocationOptimized$", false, null),
@@ -400,6 +461,7 @@ namespace IceInternal
              new Property(@"^IceLocatorDiscovery\.Locator\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceLocatorDiscovery\.Locator\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceLocatorDiscovery\.Locator\.MessageSizeMax$", false, null),
@@ -444,6 +506,9 @@ namespace IceInternal
              new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.PreferSecure$", false, null),
              new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.InvocationTimeout$", false, null),
+             new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.CompressionCodec$", false, null),
              new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.Locator$", false, null),
              new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.Router$", false, null),
              new Property(@"^IceBoxAdmin\.ServiceManager\.Proxy\.CollocationOptimized$", false, null),
@@ -465,6 +530,9 @@ namespace IceInternal
              new Property(@"^IceBridge\.Source\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceBridge\.Source\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceBridge\.Source\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceBridge\.Source\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceBridge\.Source\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceBridge\.Source\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceBridge\.Source\.Locator\.Locator$", false, null),
              new Property(@"^IceBridge\.Source\.Locator\.Router$", false, null),
              new Property(@"^IceBridge\.Source\.Locator\.CollocationOptimized$", false, null),
@@ -477,6 +545,9 @@ namespace IceInternal
              new Property(@"^IceBridge\.Source\.Router\.PreferSecure$", false, null),
              new Property(@"^IceBridge\.Source\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceBridge\.Source\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceBridge\.Source\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceBridge\.Source\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceBridge\.Source\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceBridge\.Source\.Router\.Locator$", false, null),
              new Property(@"^IceBridge\.Source\.Router\.Router$", false, null),
              new Property(@"^IceBridge\.Source\.Router\.CollocationOptimized$", false, null),
@@ -488,6 +559,7 @@ namespace IceInternal
              new Property(@"^IceBridge\.Source\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceBridge\.Source\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceBridge\.Source\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceBridge\.Source\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceBridge\.Source\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceBridge\.Source\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceBridge\.Source\.MessageSizeMax$", false, null),
@@ -517,6 +589,9 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Server\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Locator\.Locator$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Locator\.Router$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Locator\.CollocationOptimized$", false, null),
@@ -529,6 +604,9 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Server\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Router\.Locator$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Router\.Router$", false, null),
              new Property(@"^IceGridAdmin\.Server\.Router\.CollocationOptimized$", false, null),
@@ -540,6 +618,7 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Server\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGridAdmin\.Server\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGridAdmin\.Server\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGridAdmin\.Server\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGridAdmin\.Server\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGridAdmin\.Server\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGridAdmin\.Server\.MessageSizeMax$", false, null),
@@ -557,6 +636,9 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.Locator$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.Router$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Locator\.CollocationOptimized$", false, null),
@@ -569,6 +651,9 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.Locator$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.Router$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.Router\.CollocationOptimized$", false, null),
@@ -580,6 +665,7 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Reply\.MessageSizeMax$", false, null),
@@ -594,6 +680,9 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.Locator$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.Router$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Locator\.CollocationOptimized$", false, null),
@@ -606,6 +695,9 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.Locator$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.Router$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.Router\.CollocationOptimized$", false, null),
@@ -617,6 +709,7 @@ namespace IceInternal
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGridAdmin\.Discovery\.Locator\.MessageSizeMax$", false, null),
@@ -638,6 +731,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.AdminRouter\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Locator\.CollocationOptimized$", false, null),
@@ -650,6 +746,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.AdminRouter\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.Router\.CollocationOptimized$", false, null),
@@ -661,6 +760,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.AdminRouter\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.AdminRouter\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.AdminRouter\.MessageSizeMax$", false, null),
@@ -676,6 +776,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Node\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Node\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Node\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Node\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Node\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Node\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Node\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Node\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Node\.Locator\.CollocationOptimized$", false, null),
@@ -688,6 +791,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Node\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Node\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Node\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Node\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Node\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Node\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Node\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Node\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Node\.Router\.CollocationOptimized$", false, null),
@@ -699,6 +805,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Node\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Node\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Node\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Node\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Node\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Node\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Node\.MessageSizeMax$", false, null),
@@ -725,6 +832,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Node\.UserAccountMapper\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Node\.UserAccountMapper\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Node\.UserAccountMapper\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Node\.UserAccountMapper\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Node\.UserAccountMapper\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Node\.UserAccountMapper\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Node\.UserAccountMapper\.Locator$", false, null),
              new Property(@"^IceGrid\.Node\.UserAccountMapper\.Router$", false, null),
              new Property(@"^IceGrid\.Node\.UserAccountMapper\.CollocationOptimized$", false, null),
@@ -737,6 +847,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminPermissionsVerifier\.CollocationOptimized$", false, null),
@@ -754,6 +867,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Locator\.CollocationOptimized$", false, null),
@@ -766,6 +882,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.Router\.CollocationOptimized$", false, null),
@@ -777,6 +896,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSessionManager\.MessageSizeMax$", false, null),
@@ -785,6 +905,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.AdminSSLPermissionsVerifier\.CollocationOptimized$", false, null),
@@ -801,6 +924,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Client\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Locator\.CollocationOptimized$", false, null),
@@ -813,6 +939,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Client\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.Router\.CollocationOptimized$", false, null),
@@ -824,6 +953,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Client\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Client\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Registry\.Client\.MessageSizeMax$", false, null),
@@ -840,6 +970,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Locator\.CollocationOptimized$", false, null),
@@ -852,6 +985,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Discovery\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.Router\.CollocationOptimized$", false, null),
@@ -863,6 +999,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Discovery\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Discovery\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Registry\.Discovery\.MessageSizeMax$", false, null),
@@ -882,6 +1019,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Internal\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Locator\.CollocationOptimized$", false, null),
@@ -894,6 +1034,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Internal\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.Router\.CollocationOptimized$", false, null),
@@ -905,10 +1048,14 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Internal\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Internal\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Registry\.Internal\.MessageSizeMax$", false, null),
+             new Property(@"^IceGrid\.Registry\.LMDB\.GroupCommitWindow$", false, null),
+             new Property(@"^IceGrid\.Registry\.LMDB\.MapGrowthThreshold$", false, null),
              new Property(@"^IceGrid\.Registry\.LMDB\.MapSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.LMDB\.MaxMapSize$", false, null),
              new Property(@"^IceGrid\.Registry\.LMDB\.Path$", false, null),
              new Property(@"^IceGrid\.Registry\.NodeSessionTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.EndpointSelection$", false, null),
@@ -916,6 +1063,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.PermissionsVerifier\.CollocationOptimized$", false, null),
@@ -936,6 +1086,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Server\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Locator\.CollocationOptimized$", false, null),
@@ -948,6 +1101,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Server\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.Router\.CollocationOptimized$", false, null),
@@ -959,6 +1115,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.Server\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Registry\.Server\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Registry\.Server\.MessageSizeMax$", false, null),
@@ -974,6 +1131,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Locator\.CollocationOptimized$", false, null),
@@ -986,6 +1146,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.Router\.CollocationOptimized$", false, null),
@@ -997,6 +1160,7 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.Mode$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IceGrid\.Registry\.SessionManager\.MessageSizeMax$", false, null),
@@ -1006,6 +1170,9 @@ namespace IceInternal
              new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.PreferSecure$", false, null),
              new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.LocatorCacheTimeout$", false, null),
              new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.InvocationTimeout$", false, null),
+             new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.ConnectionPoolSize$", false, null),
+             new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.CompressionCodec$", false, null),
              new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.Locator$", false, null),
              new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.Router$", false, null),
              new Property(@"^IceGrid\.Registry\.SSLPermissionsVerifier\.CollocationOptimized$", false, null),
@@ -1042,6 +1209,9 @@ namespace IceInternal
              new Property(@"^IcePatch2\.Locator\.PreferSecure$", false, null),
              new Property(@"^IcePatch2\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^IcePatch2\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^IcePatch2\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IcePatch2\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^IcePatch2\.Locator\.CompressionCodec$", false, null),
              new Property(@"^IcePatch2\.Locator\.Locator$", false, null),
              new Property(@"^IcePatch2\.Locator\.Router$", false, null),
              new Property(@"^IcePatch2\.Locator\.CollocationOptimized$", false, null),
@@ -1054,6 +1224,9 @@ namespace IceInternal
              new Property(@"^IcePatch2\.Router\.PreferSecure$", false, null),
              new Property(@"^IcePatch2\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^IcePatch2\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^IcePatch2\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^IcePatch2\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^IcePatch2\.Router\.CompressionCodec$", false, null),
              new Property(@"^IcePatch2\.Router\.Locator$", false, null),
              new Property(@"^IcePatch2\.Router\.Router$", false, null),
              new Property(@"^IcePatch2\.Router\.CollocationOptimized$", false, null),
@@ -1065,17 +1238,21 @@ namespace IceInternal
              new Property(@"^IcePatch2\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^IcePatch2\.ThreadPool\.StackSize$", false, null),
              new Property(@"^IcePatch2\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^IcePatch2\.ThreadPool\.Mode$", false, null),
              new Property(@"^IcePatch2\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^IcePatch2\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^IcePatch2\.MessageSizeMax$", false, null),
+             new Property(@"^IcePatch2\.CacheSize$", false, null),
              new Property(@"^IcePatch2\.Directory$", false, null),
              new Property(@"^IcePatch2\.InstanceName$", false, null),
+             new Property(@"^IcePatch2\.ReadAhead$", false, null),
              null
         };
 
         public static Property[] IcePatch2ClientProps =
         {
              new Property(@"^IcePatch2Client\.ChunkSize$", false, null),
+             new Property(@"^IcePatch2Client\.Concurrency$", false, null),
              new Property(@"^IcePatch2Client\.Directory$", false, null),
              new Property(@"^IcePatch2Client\.Proxy$", false, null),
              new Property(@"^IcePatch2Client\.Remove$", false, null),
@@ -1160,6 +1337,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.Client\.Locator\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.Client\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.Client\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.Client\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.Client\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.Client\.Locator\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.Client\.Locator\.Locator$", false, null),
              new Property(@"^Glacier2\.Client\.Locator\.Router$", false, null),
              new Property(@"^Glacier2\.Client\.Locator\.CollocationOptimized$", false, null),
@@ -1172,6 +1352,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.Client\.Router\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.Client\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.Client\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.Client\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.Client\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.Client\.Router\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.Client\.Router\.Locator$", false, null),
              new Property(@"^Glacier2\.Client\.Router\.Router$", false, null),
              new Property(@"^Glacier2\.Client\.Router\.CollocationOptimized$", false, null),
@@ -1183,6 +1366,7 @@ namespace IceInternal
              new Property(@"^Glacier2\.Client\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^Glacier2\.Client\.ThreadPool\.StackSize$", false, null),
              new Property(@"^Glacier2\.Client\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^Glacier2\.Client\.ThreadPool\.Mode$", false, null),
              new Property(@"^Glacier2\.Client\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^Glacier2\.Client\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^Glacier2\.Client\.MessageSizeMax$", false, null),
@@ -1207,6 +1391,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.PermissionsVerifier\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.PermissionsVerifier\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.PermissionsVerifier\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.PermissionsVerifier\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.PermissionsVerifier\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.PermissionsVerifier\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.PermissionsVerifier\.Locator$", false, null),
              new Property(@"^Glacier2\.PermissionsVerifier\.Router$", false, null),
              new Property(@"^Glacier2\.PermissionsVerifier\.CollocationOptimized$", false, null),
@@ -1218,6 +1405,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.SSLPermissionsVerifier\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.SSLPermissionsVerifier\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.SSLPermissionsVerifier\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.SSLPermissionsVerifier\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.SSLPermissionsVerifier\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.SSLPermissionsVerifier\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.SSLPermissionsVerifier\.Locator$", false, null),
              new Property(@"^Glacier2\.SSLPermissionsVerifier\.Router$", false, null),
              new Property(@"^Glacier2\.SSLPermissionsVerifier\.CollocationOptimized$", false, null),
@@ -1235,6 +1425,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.Server\.Locator\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.Server\.Locator\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.Server\.Locator\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.Server\.Locator\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.Server\.Locator\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.Server\.Locator\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.Server\.Locator\.Locator$", false, null),
              new Property(@"^Glacier2\.Server\.Locator\.Router$", false, null),
              new Property(@"^Glacier2\.Server\.Locator\.CollocationOptimized$", false, null),
@@ -1247,6 +1440,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.Server\.Router\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.Server\.Router\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.Server\.Router\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.Server\.Router\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.Server\.Router\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.Server\.Router\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.Server\.Router\.Locator$", false, null),
              new Property(@"^Glacier2\.Server\.Router\.Router$", false, null),
              new Property(@"^Glacier2\.Server\.Router\.CollocationOptimized$", false, null),
@@ -1258,6 +1454,7 @@ namespace IceInternal
              new Property(@"^Glacier2\.Server\.ThreadPool\.SizeWarn$", false, null),
              new Property(@"^Glacier2\.Server\.ThreadPool\.StackSize$", false, null),
              new Property(@"^Glacier2\.Server\.ThreadPool\.Serialize$", false, null),
+             new Property(@"^Glacier2\.Server\.ThreadPool\.Mode$", false, null),
              new Property(@"^Glacier2\.Server\.ThreadPool\.ThreadIdleTime$", false, null),
              new Property(@"^Glacier2\.Server\.ThreadPool\.ThreadPriority$", false, null),
              new Property(@"^Glacier2\.Server\.MessageSizeMax$", false, null),
@@ -1272,6 +1469,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.SessionManager\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.SessionManager\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.SessionManager\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.SessionManager\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.SessionManager\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.SessionManager\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.SessionManager\.Locator$", false, null),
              new Property(@"^Glacier2\.SessionManager\.Router$", false, null),
              new Property(@"^Glacier2\.SessionManager\.CollocationOptimized$", false, null),
@@ -1282,6 +1482,9 @@ namespace IceInternal
              new Property(@"^Glacier2\.SSLSessionManager\.PreferSecure$", false, null),
              new Property(@"^Glacier2\.SSLSessionManager\.LocatorCacheTimeout$", false, null),
              new Property(@"^Glacier2\.SSLSessionManager\.InvocationTimeout$", false, null),
+             new Property(@"^Glacier2\.SSLSessionManager\.BatchAutoFlushDelay$", false, null),
+             new Property(@"^Glacier2\.SSLSessionManager\.ConnectionPoolSize$", false, null),
+             new Property(@"^Glacier2\.SSLSessionManager\.CompressionCodec$", false, null),
              new Property(@"^Glacier2\.SSLSessionManager\.Locator$", false, null),
              new Property(@"^Glacier2\.SSLSessionManager\.Router$", false, null),
              new Property(@"^Glacier2\.SSLSessionManager\.CollocationOptimized$", false, null),
@@ -1771,6 +1771,13 @@ namespace Ice
         /// <returns>The new proxy with the specified endpoint selection policy.</returns>
         public ObjectPrx ice_endpointSelection(EndpointSelectionType newType)
         {
+            //
+            // LeastLatency and LeastOutstanding are only supported by the C++ run time.
+            //
+            if(newType != EndpointSelectionType.Random && newType != EndpointSelectionType.Ordered)
+            {
+                throw new ArgumentException("unsupported value passed to ice_endpointSelection: " + newType);
+            }
             if(newType == _reference.getEndpointSelection())
             {
                 return this;
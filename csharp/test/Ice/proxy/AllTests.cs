@@ -646,6 +646,24 @@ namespace Ice
                 {
                 }
 
+                try
+                {
+                    baseProxy.ice_endpointSelection(Ice.EndpointSelectionType.LeastLatency);
+                    test(false);
+                }
+                catch(ArgumentException)
+                {
+                }
+
+                try
+                {
+                    baseProxy.ice_endpointSelection(Ice.EndpointSelectionType.LeastOutstanding);
+                    test(false);
+                }
+                catch(ArgumentException)
+                {
+                }
+
                 try
                 {
                     baseProxy.ice_locatorCacheTimeout(0);
@@ -1823,6 +1823,13 @@ public class ObjectPrxHelperBase implements ObjectPrx, java.io.Serializable
     public final ObjectPrx
     ice_endpointSelection(Ice.EndpointSelectionType newType)
     {
+        //
+        // LeastLatency and LeastOutstanding are only supported by the C++ run time.
+        //
+        if(newType != Ice.EndpointSelectionType.Random && newType != Ice.EndpointSelectionType.Ordered)
+        {
+            throw new IllegalArgumentException("unsupported value passed to ice_endpointSelection: " + newType);
+        }
         if(newType == _reference.getEndpointSelection())
         {
             return this;
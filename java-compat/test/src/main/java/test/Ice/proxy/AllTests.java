@@ -654,6 +654,24 @@ public class AllTests
         {
         }
 
+        try
+        {
+            base.ice_endpointSelection(Ice.EndpointSelectionType.LeastLatency);
+            test(false);
+        }
+        catch(IllegalArgumentException e)
+        {
+        }
+
+        try
+        {
+            base.ice_endpointSelection(Ice.EndpointSelectionType.LeastOutstanding);
+            test(false);
+        }
+        catch(IllegalArgumentException e)
+        {
+        }
+
         try
         {
             base.ice_locatorCacheTimeout(0);
@@ -1226,6 +1226,13 @@ public interface ObjectPrx
      **/
     default ObjectPrx _ice_endpointSelection(EndpointSelectionType newType)
     {
+        //
+        // LeastLatency and LeastOutstanding are only supported by the C++ run time.
+        //
+        if(newType != EndpointSelectionType.Random && newType != EndpointSelectionType.Ordered)
+        {
+            throw new IllegalArgumentException("unsupported value passed to ice_endpointSelection: " + newType);
+        }
         if(newType == _getReference().getEndpointSelection())
         {
             return this;
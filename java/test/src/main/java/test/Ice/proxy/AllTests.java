@@ -657,6 +657,24 @@ public class AllTests
         {
         }
 
+        try
+        {
+            base.ice_endpointSelection(EndpointSelectionType.LeastLatency);
+            test(false);
+        }
+        catch(IllegalArgumentException e)
+        {
+        }
+
+        try
+        {
+            base.ice_endpointSelection(EndpointSelectionType.LeastOutstanding);
+            test(false);
+        }
+        catch(IllegalArgumentException e)
+        {
+        }
+
         try
         {
             base.ice_locatorCacheTimeout(0);
@@ -8,6 +8,7 @@ Ice._ModuleRegistry.require(module,
         "../Ice/ArrayUtil",
         "../Ice/AsyncResult",
         "../Ice/Debug",
+        "../Ice/EndpointTypes",
         "../Ice/FormatType",
         "../Ice/OutgoingAsync",
         "../Ice/ReferenceMode",
@@ -21,6 +22,7 @@ Ice._ModuleRegistry.require(module,
 const ArrayUtil = Ice.ArrayUtil;
 const AsyncResultBase = Ice.AsyncResultBase;
 const Debug = Ice.Debug;
+const EndpointSelectionType = Ice.EndpointSelectionType;
 const OutgoingAsync = Ice.OutgoingAsync;
 const ProxyFlushBatch = Ice.ProxyFlushBatch;
 const ProxyGetConnection = Ice.ProxyGetConnection;
@@ -220,6 +222,13 @@ class ObjectPrx
 
     ice_endpointSelection(newType)
     {
+        //
+        // LeastLatency and LeastOutstanding are only supported by the C++ run time.
+        //
+        if(newType !== EndpointSelectionType.Random && newType !== EndpointSelectionType.Ordered)
+        {
+            throw new RangeError("unsupported value passed to ice_endpointSelection: " + newType);
+        }
         if(newType === this._reference.getEndpointSelection())
         {
             return this;
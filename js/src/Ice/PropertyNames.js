@@ -1,7 +1,7 @@
 //
 // Copyright (c) ZeroC, Inc. All rights reserved.
 //
-// Generated by makeprops.py from file ../config/PropertyNames.xml, Thu Oct 25 22:10:11 2018
+// Generated by makeprops.py from file ../config/PropertyNames.xml, Sun Oct 18 09:28:45 2026
 
 // IMPORTANT: Do not edit this file -- any edits made here will be lost!
 
@@ -39,6 +39,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.Locator\.PreferSecure/", false, null),
     new Property("/^Ice\.Admin\.Locator\.LocatorCacheTimeout/", false, null),
     new Property("/^Ice\.Admin\.Locator\.InvocationTimeout/", false, null),
+    new Property("/^Ice\.Admin\.Locator\.BatchAutoFlushDelay/", false, null),
+    new Property("/^Ice\.Admin\.Locator\.ConnectionPoolSize/", false, null),
+    new Property("/^Ice\.Admin\.Locator\.CompressionCodec/", false, null),
     new Property("/^Ice\.Admin\.Locator\.Locator/", false, null),
     new Property("/^Ice\.Admin\.Locator\.Router/", false, null),
     new Property("/^Ice\.Admin\.Locator\.CollocationOptimized/", false, null),
@@ -51,6 +54,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.Router\.PreferSecure/", false, null),
     new Property("/^Ice\.Admin\.Router\.LocatorCacheTimeout/", false, null),
     new Property("/^Ice\.Admin\.Router\.InvocationTimeout/", false, null),
+    new Property("/^Ice\.Admin\.Router\.BatchAutoFlushDelay/", false, null),
+    new Property("/^Ice\.Admin\.Router\.ConnectionPoolSize/", false, null),
+    new Property("/^Ice\.Admin\.Router\.CompressionCodec/", false, null),
     new Property("/^Ice\.Admin\.Router\.Locator/", false, null),
     new Property("/^Ice\.Admin\.Router\.Router/", false, null),
     new Property("/^Ice\.Admin\.Router\.CollocationOptimized/", false, null),
@@ -62,6 +68,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ThreadPool\.SizeWarn/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.StackSize/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.Serialize/", false, null),
+    new Property("/^Ice\.Admin\.ThreadPool\.Mode/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.Admin\.ThreadPool\.ThreadPriority/", false, null),
     new Property("/^Ice\.Admin\.MessageSizeMax/", false, null),
@@ -75,13 +82,20 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Admin\.ServerId/", false, null),
     new Property("/^Ice\.BackgroundLocatorCacheUpdates/", false, null),
     new Property("/^Ice\.BatchAutoFlush/", true, null),
+    new Property("/^Ice\.BatchAutoFlushAdaptive/", false, null),
+    new Property("/^Ice\.BatchAutoFlushDelay/", false, null),
     new Property("/^Ice\.BatchAutoFlushSize/", false, null),
+    new Property("/^Ice\.BufferPool\.MaxCached/", false, null),
     new Property("/^Ice\.ChangeUser/", false, null),
     new Property("/^Ice\.ClassGraphDepthMax/", false, null),
     new Property("/^Ice\.ClientAccessPolicyProtocol/", false, null),
+    new Property("/^Ice\.Compression\.Codec/", false, null),
     new Property("/^Ice\.Compression\.Level/", false, null),
     new Property("/^Ice\.CollectObjects/", false, null),
+    new Property("/^Ice\.CollocationDirectDispatch/", false, null),
     new Property("/^Ice\.Config/", false, null),
+    new Property("/^Ice\.ConnectionPool\.LargeMessageSize/", false, null),
+    new Property("/^Ice\.ConnectionPool\.Size/", false, null),
     new Property("/^Ice\.ConsoleListener/", false, null),
     new Property("/^Ice\.Default\.CollocationOptimized/", false, null),
     new Property("/^Ice\.Default\.EncodingVersion/", false, null),
@@ -92,6 +106,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Default\.Locator\.PreferSecure/", false, null),
     new Property("/^Ice\.Default\.Locator\.LocatorCacheTimeout/", false, null),
     new Property("/^Ice\.Default\.Locator\.InvocationTimeout/", false, null),
+    new Property("/^Ice\.Default\.Locator\.BatchAutoFlushDelay/", false, null),
+    new Property("/^Ice\.Default\.Locator\.ConnectionPoolSize/", false, null),
+    new Property("/^Ice\.Default\.Locator\.CompressionCodec/", false, null),
     new Property("/^Ice\.Default\.Locator\.Locator/", false, null),
     new Property("/^Ice\.Default\.Locator\.Router/", false, null),
     new Property("/^Ice\.Default\.Locator\.CollocationOptimized/", false, null),
@@ -107,6 +124,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.Default\.Router\.PreferSecure/", false, null),
     new Property("/^Ice\.Default\.Router\.LocatorCacheTimeout/", false, null),
     new Property("/^Ice\.Default\.Router\.InvocationTimeout/", false, null),
+    new Property("/^Ice\.Default\.Router\.BatchAutoFlushDelay/", false, null),
+    new Property("/^Ice\.Default\.Router\.ConnectionPoolSize/", false, null),
+    new Property("/^Ice\.Default\.Router\.CompressionCodec/", false, null),
     new Property("/^Ice\.Default\.Router\.Locator/", false, null),
     new Property("/^Ice\.Default\.Router\.Router/", false, null),
     new Property("/^Ice\.Default\.Router\.CollocationOptimized/", false, null),
@@ -119,6 +139,9 @@ PropertyNames.IceProps =
     new Property("/^Ice\.FactoryAssemblies/", false, null),
     new Property("/^Ice\.HTTPProxyHost/", false, null),
     new Property("/^Ice\.HTTPProxyPort/", false, null),
+    new Property("/^Ice\.HostResolver\.CacheTTL/", false, null),
+    new Property("/^Ice\.HostResolver\.NegativeCacheTTL/", false, null),
+    new Property("/^Ice\.HostResolver\.Size/", false, null),
     new Property("/^Ice\.ImplicitContext/", false, null),
     new Property("/^Ice\.InitPlugins/", false, null),
     new Property("/^Ice\.IPv4/", false, null),
@@ -126,6 +149,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.LogFile/", false, null),
     new Property("/^Ice\.LogFile\.SizeMax/", false, null),
     new Property("/^Ice\.LogStdErr\.Convert/", false, null),
+    new Property("/^Ice\.MessageFragmentSize/", false, null),
     new Property("/^Ice\.MessageSizeMax/", false, null),
     new Property("/^Ice\.Nohup/", false, null),
     new Property("/^Ice\.NullHandleAbort/", false, null),
@@ -155,6 +179,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Client\.SizeWarn/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.StackSize/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.Serialize/", false, null),
+    new Property("/^Ice\.ThreadPool\.Client\.Mode/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Client\.ThreadPriority/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Size/", false, null),
@@ -162,6 +187,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.ThreadPool\.Server\.SizeWarn/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.StackSize/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.Serialize/", false, null),
+    new Property("/^Ice\.ThreadPool\.Server\.Mode/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadIdleTime/", false, null),
     new Property("/^Ice\.ThreadPool\.Server\.ThreadPriority/", false, null),
     new Property("/^Ice\.ThreadPriority/", false, null),
@@ -192,6 +218,7 @@ PropertyNames.IceProps =
     new Property("/^Ice\.CacheMessageBuffers/", false, null),
     new Property("/^Ice\.ThreadInterruptSafe/", false, null),
     new Property("/^Ice\.Voip/", true, null),
+    new Property("/^Ice\.ZeroCopySize/", false, null),
 ];
 
 PropertyNames.validProps =
@@ -578,6 +578,26 @@
                 test(!(ex instanceof TestError), ex);
             }
 
+            try
+            {
+                base.ice_endpointSelection(Ice.EndpointSelectionType.LeastLatency);
+                test(false);
+            }
+            catch(ex)
+            {
+                test(ex instanceof RangeError, ex);
+            }
+
+            try
+            {
+                base.ice_endpointSelection(Ice.EndpointSelectionType.LeastOutstanding);
+                test(false);
+            }
+            catch(ex)
+            {
+                test(ex instanceof RangeError, ex);
+            }
+
             try
             {
                 base.ice_locatorCacheTimeout(0);
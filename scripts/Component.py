@@ -17,7 +17,7 @@ class Ice(Component):
         "mx" : [False, True],
     }
 
-    # All option values for IceGrid/IceStorm/Glacier2/IceDiscovery tests.
+    # All option values for IceGrid/IceStorm/Glacier2/IceDiscovery/IcePatch2 tests.
     serviceOptions = {
         "protocol" : ["tcp", "wss"],
         "compress" : [False, True],
@@ -69,6 +69,7 @@ class Ice(Component):
         elif isinstance(mapping, CppMapping) and config.uwp:
             return (["Ice/.*", "IceSSL/configuration"],
                     ["Ice/background",
+                     "Ice/compression",         # The message forwarder isn't supported with UWP
                      "Ice/echo",
                      "Ice/faultTolerance",
                      "Ice/gc",
@@ -113,10 +114,10 @@ class Ice(Component):
         if isinstance(platform, Linux):
             if platform.getLinuxId() in ["centos", "rhel", "fedora"] and current.config.buildPlatform == "x86":
                 #
-                # Don't test Glacier2/IceStorm/IceGrid services with multilib platforms. We only
+                # Don't test Glacier2/IceStorm/IceGrid/IcePatch2 services with multilib platforms. We only
                 # build services for the native platform.
                 #
-                if parent in ["Glacier2", "IceStorm", "IceGrid"]:
+                if parent in ["Glacier2", "IceStorm", "IceGrid", "IcePatch2"]:
                     return False
         elif isinstance(platform, Linux):
             #
@@ -127,9 +128,9 @@ class Ice(Component):
                 if parent in ["Glacier2", "IceBridge"] and current.config.buildConfig.find("Debug") >= 0:
                     return False
 
-        # No C++11 tests for IceStorm, IceGrid, etc
+        # No C++11 tests for IceStorm, IceGrid, IcePatch2, etc
         if isinstance(mapping, CppMapping) and current.config.cpp11:
-            if parent in ["IceStorm", "IceBridge"]:
+            if parent in ["IceStorm", "IceBridge", "IcePatch2"]:
                 return False
             elif parent in ["IceGrid"] and testId not in ["IceGrid/simple"]:
                 return False
@@ -167,11 +168,11 @@ class Ice(Component):
         parent = re.match(r'^([\w]*).*', testcase.getTestSuite().getId()).group(1)
         if isinstance(testcase, ClientServerTestCase) and parent in ["Ice", "IceBox"]:
             return self.coreOptions
-        elif parent in ["IceGrid", "Glacier2", "IceStorm", "IceDiscovery", "IceBridge"]:
+        elif parent in ["IceGrid", "Glacier2", "IceStorm", "IceDiscovery", "IceBridge", "IcePatch2"]:
             return self.serviceOptions
 
     def getRunOrder(self):
-        return ["Slice", "IceUtil", "Ice", "IceSSL", "IceBox", "Glacier2", "IceGrid", "IceStorm"]
+        return ["Slice", "IceUtil", "Ice", "IceSSL", "IceBox", "Glacier2", "IceGrid", "IceStorm", "IcePatch2"]
 
     def isCross(self, testId):
         return testId in [
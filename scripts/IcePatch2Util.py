@@ -14,7 +14,7 @@ class IcePatch2Client(ProcessFromBinDir, ProcessIsReleaseOnly, Process):
     def __init__(self, *args, **kargs):
         Process.__init__(self, exe="icepatch2client", mapping=Mapping.getByName("cpp"), *args, **kargs)
 
-class IcePatch2Server(ProcessFromBinDir, ProcessIsReleaseOnly, Process):
+class IcePatch2Server(ProcessFromBinDir, ProcessIsReleaseOnly, Server):
 
     def __init__(self, *args, **kargs):
-        Process.__init__(self, exe="icepatch2server", mapping=Mapping.getByName("cpp"), *args, **kargs)
+        Server.__init__(self, exe="icepatch2server", ready="IcePatch2", mapping=Mapping.getByName("cpp"), *args, **kargs)
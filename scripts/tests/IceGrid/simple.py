@@ -11,6 +11,10 @@ serverProps = {
 registryProps = {
     "IceGrid.Registry.DynamicRegistration" : 1
 }
+# Run the registry database updates in nested transactions of group commits
+groupCommitProps = {
+    "IceGrid.Registry.LMDB.GroupCommitWindow" : 5
+}
 registryTraceProps = {
     "IceGrid.Registry.Trace.Discovery": 2
 }
@@ -37,5 +41,9 @@ if isinstance(platform, Windows) or os.getuid() != 0:
                                                                          outfilters=outfilters,
                                                                          traceProps=clientTraceProps),
                                                     server=IceGridServer(props=serverProps))),
-        IceGridTestCase("with deployment", client=IceGridClient(args=["--with-deploy"]))
+        IceGridTestCase("with deployment", client=IceGridClient(args=["--with-deploy"])),
+        IceGridTestCase("with deployment and group commit",
+                        icegridregistry=[IceGridRegistryMaster(props=groupCommitProps),
+                                         IceGridRegistrySlave(1, props=groupCommitProps)],
+                        client=IceGridClient(args=["--with-deploy"]))
     ], multihost=False)